@@ -0,0 +1,64 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/arena.hpp>
+
+// HELPERS
+// -------
+
+
+/** \brief Build the containers of a single request with `size` entries.
+ */
+template <typename Vector, typename String, typename Map>
+void request(size_t size)
+{
+    Map map;
+    Vector values;
+    for (size_t i = 0; i < size; ++i) {
+        String key(32, static_cast<char>('A' + i % 26));
+        key += std::to_string(i).c_str();
+        map.emplace(key, static_cast<int>(i));
+        values.push_back(static_cast<int>(i));
+    }
+    bench::consume(map);
+    bench::consume(values);
+}
+
+
+template <typename Function>
+void requests(bench::reporter &reporter,
+    const std::string &implementation,
+    Function function)
+{
+    for (size_t size: reporter.sizes()) {
+        size_t repeat = reporter.repeat(size);
+        double elapsed = bench::measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                function(size);
+            }
+        });
+        reporter.record("request", implementation, "build", size, repeat, elapsed);
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(arena)
+{
+    requests(reporter, "std::allocator", [](size_t size) {
+        request<itl::vector<int>, itl::string, itl::map<itl::string, int>>(size);
+    });
+    requests(reporter, "arena", [](size_t size) {
+        itl::arena arena;
+        itl::arena::scope scope(arena);
+        request<itl::arena::vector<int>, itl::arena::string, itl::arena::map<itl::arena::string, int>>(size);
+    });
+}
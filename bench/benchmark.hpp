@@ -0,0 +1,423 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <new>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace bench
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Single timed measurement.
+ */
+struct result
+{
+    std::string container;
+    std::string implementation;
+    std::string operation;
+    size_t size;
+    size_t repeat;
+    double nanoseconds;
+};
+
+
+/** \brief Object size of a single implementation.
+ */
+struct footprint
+{
+    std::string container;
+    std::string implementation;
+    size_t bytes;
+};
+
+
+/** \brief Collects measurements and serializes them to JSON.
+ */
+class reporter
+{
+public:
+    reporter(size_t min_size, size_t max_size, size_t budget);
+
+    const std::vector<size_t> & sizes() const;
+    size_t repeat(size_t size) const;
+
+    void record(const std::string &container,
+        const std::string &implementation,
+        const std::string &operation,
+        size_t size,
+        size_t repeat,
+        double nanoseconds);
+
+    void record_size(const std::string &container,
+        const std::string &implementation,
+        size_t bytes);
+
+    void write(std::ostream &stream) const;
+
+private:
+    std::vector<size_t> sizes_;
+    size_t budget_;
+    std::vector<result> results_;
+    std::vector<footprint> footprints_;
+};
+
+
+/** \brief Uninitialized storage for `count` objects of type T.
+ *
+ *  Lifetimes are managed manually so construction and destruction
+ *  can be timed separately.
+ */
+template <typename T>
+class storage
+{
+public:
+    explicit storage(size_t count);
+
+    T * operator[](size_t index);
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type block;
+    std::vector<block> blocks_;
+};
+
+
+typedef void (*benchmark)(reporter &);
+
+std::vector<std::pair<std::string, benchmark>> & registry();
+
+
+/** \brief Adds a benchmark to the global registry on construction.
+ */
+struct registration
+{
+    registration(const char *name, benchmark function);
+};
+
+
+#define BENCHMARK(name)                                                 \
+    static void bench_##name(bench::reporter &reporter);                \
+    static bench::registration register_##name(#name, bench_##name);   \
+    static void bench_##name(bench::reporter &reporter)
+
+
+// FUNCTIONS
+// ---------
+
+
+/** \brief Prevent the compiler from discarding `value`.
+ */
+template <typename T>
+inline void consume(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(&value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+
+/** \brief Time a callable, returning the elapsed nanoseconds.
+ */
+template <typename Function>
+double measure(Function function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+
+/** \brief Time every generic container operation for a single type.
+ *
+ *  `Ops` describes how to build and query the container:
+ *      value_type                      input element type
+ *      value(i)                        i-th input element
+ *      construct(ptr, first, last)     placement-construct from a range
+ *      push(container, value)          insert a single element
+ *      lookup_enabled                  whether `lookup` is defined
+ *      lookup(container, i, value)     look up the i-th input element
+ *      iterate_enabled                 whether the container is iterable
+ */
+template <typename Ops, typename Container>
+void run(reporter &reporter,
+    const std::string &container,
+    const std::string &implementation);
+
+
+/** \brief Time `Itl` and `Std` with identical inputs.
+ */
+template <typename Ops, typename Itl, typename Std>
+void compare(reporter &reporter,
+    const std::string &container);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline reporter::reporter(size_t min_size,
+        size_t max_size,
+        size_t budget):
+    budget_(budget)
+{
+    for (size_t size = min_size; size <= max_size; size *= 10) {
+        sizes_.push_back(size);
+    }
+}
+
+
+inline auto reporter::sizes() const
+    -> const std::vector<size_t> &
+{
+    return sizes_;
+}
+
+
+inline size_t reporter::repeat(size_t size) const
+{
+    return size >= budget_ ? 1 : budget_ / size;
+}
+
+
+inline void reporter::record(const std::string &container,
+    const std::string &implementation,
+    const std::string &operation,
+    size_t size,
+    size_t repeat,
+    double nanoseconds)
+{
+    results_.push_back({container, implementation, operation, size, repeat, nanoseconds});
+}
+
+
+inline void reporter::record_size(const std::string &container,
+    const std::string &implementation,
+    size_t bytes)
+{
+    footprints_.push_back({container, implementation, bytes});
+}
+
+
+inline void reporter::write(std::ostream &stream) const
+{
+    stream << "{\n    \"sizes\": [";
+    for (size_t i = 0; i < footprints_.size(); ++i) {
+        const footprint &f = footprints_[i];
+        stream << (i ? ",\n" : "\n")
+               << "        {"
+               << "\"container\": \"" << f.container << "\", "
+               << "\"implementation\": \"" << f.implementation << "\", "
+               << "\"bytes\": " << f.bytes
+               << "}";
+    }
+    stream << "\n    ],\n    \"benchmarks\": [";
+    for (size_t i = 0; i < results_.size(); ++i) {
+        const result &r = results_[i];
+        double per_repeat = r.nanoseconds / r.repeat;
+        stream << (i ? ",\n" : "\n")
+               << "        {"
+               << "\"container\": \"" << r.container << "\", "
+               << "\"implementation\": \"" << r.implementation << "\", "
+               << "\"operation\": \"" << r.operation << "\", "
+               << "\"size\": " << r.size << ", "
+               << "\"repeat\": " << r.repeat << ", "
+               << "\"nanoseconds\": " << per_repeat << ", "
+               << "\"nanoseconds_per_element\": " << per_repeat / r.size
+               << "}";
+    }
+    stream << "\n    ]\n}\n";
+}
+
+
+template <typename T>
+storage<T>::storage(size_t count):
+    blocks_(count)
+{}
+
+
+template <typename T>
+T * storage<T>::operator[](size_t index)
+{
+    return reinterpret_cast<T*>(&blocks_[index]);
+}
+
+
+inline auto registry()
+    -> std::vector<std::pair<std::string, benchmark>> &
+{
+    static std::vector<std::pair<std::string, benchmark>> benchmarks;
+    return benchmarks;
+}
+
+
+inline registration::registration(const char *name,
+    benchmark function)
+{
+    registry().emplace_back(name, function);
+}
+
+
+template <typename Ops, typename Container>
+void lookup(reporter &reporter,
+    const std::string &container,
+    const std::string &implementation,
+    Container &object,
+    const std::vector<typename Ops::value_type> &input,
+    size_t repeat,
+    std::true_type)
+{
+    double elapsed = measure([&]() {
+        for (size_t r = 0; r < repeat; ++r) {
+            for (size_t i = 0; i < input.size(); ++i) {
+                consume(Ops::lookup(object, i, input[i]));
+            }
+        }
+    });
+    reporter.record(container, implementation, "lookup", input.size(), repeat, elapsed);
+}
+
+
+template <typename Ops, typename Container>
+void lookup(reporter &,
+    const std::string &,
+    const std::string &,
+    Container &,
+    const std::vector<typename Ops::value_type> &,
+    size_t,
+    std::false_type)
+{}
+
+
+template <typename Ops, typename Container>
+void iterate(reporter &reporter,
+    const std::string &container,
+    const std::string &implementation,
+    Container &object,
+    size_t size,
+    size_t repeat,
+    std::true_type)
+{
+    double elapsed = measure([&]() {
+        for (size_t r = 0; r < repeat; ++r) {
+            for (const auto &value: object) {
+                consume(value);
+            }
+        }
+    });
+    reporter.record(container, implementation, "iterate", size, repeat, elapsed);
+}
+
+
+template <typename Ops, typename Container>
+void iterate(reporter &,
+    const std::string &,
+    const std::string &,
+    Container &,
+    size_t,
+    size_t,
+    std::false_type)
+{}
+
+
+template <typename Ops, typename Container>
+void run(reporter &reporter,
+    const std::string &container,
+    const std::string &implementation)
+{
+    reporter.record_size(container, implementation, sizeof(Container));
+    for (size_t size: reporter.sizes()) {
+        size_t repeat = reporter.repeat(size);
+        std::vector<typename Ops::value_type> input;
+        input.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            input.push_back(Ops::value(i));
+        }
+
+        storage<Container> objects(repeat);
+        storage<Container> copies(repeat);
+        storage<Container> moved(repeat);
+        storage<Container> pushed(repeat);
+        double elapsed;
+
+        elapsed = measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                Ops::construct(objects[r], input.begin(), input.end());
+            }
+        });
+        reporter.record(container, implementation, "construct", size, repeat, elapsed);
+
+        elapsed = measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                ::new (copies[r]) Container(*objects[r]);
+            }
+        });
+        reporter.record(container, implementation, "copy", size, repeat, elapsed);
+
+        elapsed = measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                ::new (moved[r]) Container(std::move(*copies[r]));
+            }
+        });
+        reporter.record(container, implementation, "move", size, repeat, elapsed);
+
+        elapsed = measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                moved[r]->~Container();
+            }
+        });
+        reporter.record(container, implementation, "destroy", size, repeat, elapsed);
+
+        for (size_t r = 0; r < repeat; ++r) {
+            ::new (pushed[r]) Container();
+        }
+        elapsed = measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                for (const auto &value: input) {
+                    Ops::push(*pushed[r], value);
+                }
+            }
+        });
+        reporter.record(container, implementation, "push", size, repeat, elapsed);
+
+        lookup<Ops>(reporter, container, implementation, *objects[0], input, repeat,
+            std::integral_constant<bool, Ops::lookup_enabled>());
+        iterate<Ops>(reporter, container, implementation, *objects[0], size, repeat,
+            std::integral_constant<bool, Ops::iterate_enabled>());
+
+        for (size_t r = 0; r < repeat; ++r) {
+            objects[r]->~Container();
+            copies[r]->~Container();
+            pushed[r]->~Container();
+        }
+    }
+}
+
+
+template <typename Ops, typename Itl, typename Std>
+void compare(reporter &reporter,
+    const std::string &container)
+{
+    run<Ops, Std>(reporter, container, "std");
+    run<Ops, Itl>(reporter, container, "itl");
+}
+
+}   /* bench */
@@ -0,0 +1,64 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/btree_map.hpp>
+#include <itl/map.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct btree_map_ops
+{
+    typedef std::pair<int, int> value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return value_type(static_cast<int>(i), static_cast<int>(i));
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value.first);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(btree_map)
+{
+    bench::compare<btree_map_ops, itl::btree_map<int, int>, std::map<int, int>>(reporter, "btree_map");
+    bench::run<btree_map_ops, itl::map<int, int>>(reporter, "btree_map", "itl::map");
+    bench::run<btree_map_ops, itl::static_::btree_map<int, int>>(reporter, "btree_map", "itl::static_");
+}
+
+
+BENCHMARK(btree_multimap)
+{
+    bench::compare<btree_map_ops, itl::btree_multimap<int, int>, std::multimap<int, int>>(reporter, "btree_multimap");
+    bench::run<btree_map_ops, itl::multimap<int, int>>(reporter, "btree_multimap", "itl::multimap");
+    bench::run<btree_map_ops, itl::static_::btree_multimap<int, int>>(reporter, "btree_multimap", "itl::static_");
+}
@@ -0,0 +1,64 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/btree_set.hpp>
+#include <itl/set.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct btree_set_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(btree_set)
+{
+    bench::compare<btree_set_ops, itl::btree_set<int>, std::set<int>>(reporter, "btree_set");
+    bench::run<btree_set_ops, itl::set<int>>(reporter, "btree_set", "itl::set");
+    bench::run<btree_set_ops, itl::static_::btree_set<int>>(reporter, "btree_set", "itl::static_");
+}
+
+
+BENCHMARK(btree_multiset)
+{
+    bench::compare<btree_set_ops, itl::btree_multiset<int>, std::multiset<int>>(reporter, "btree_multiset");
+    bench::run<btree_set_ops, itl::multiset<int>>(reporter, "btree_multiset", "itl::multiset");
+    bench::run<btree_set_ops, itl::static_::btree_multiset<int>>(reporter, "btree_multiset", "itl::static_");
+}
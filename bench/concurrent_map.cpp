@@ -0,0 +1,144 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/concurrent_map.hpp>
+#include <itl/map.hpp>
+
+#include <mutex>
+#include <thread>
+
+// HELPERS
+// -------
+
+
+/** \brief Global mutex around an `itl::map`, the baseline.
+ */
+class locked_ordered_map
+{
+public:
+    bool lookup(int key, long long &sum) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.lower_bound(key);
+        if (it == map_.end()) {
+            return false;
+        }
+        sum += it->second;
+        return true;
+    }
+
+    void insert(int key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.insert({key, key});
+    }
+
+    void erase(int key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        map_.erase(key);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    itl::map<int, int> map_;
+};
+
+
+/** \brief Adapts `itl::concurrent_map` to the baseline interface.
+ */
+class skiplist_map
+{
+public:
+    bool lookup(int key, long long &sum) const
+    {
+        auto it = map_.lower_bound(key);
+        if (it == map_.end()) {
+            return false;
+        }
+        sum += it->second;
+        return true;
+    }
+
+    void insert(int key)
+    {
+        map_.insert({key, key});
+    }
+
+    void erase(int key)
+    {
+        map_.erase(key);
+    }
+
+private:
+    itl::concurrent_map<int, int> map_;
+};
+
+
+/** \brief Time `threads` threads running 80% lookups, 10% inserts and 10% erases.
+ */
+template <typename Map>
+void scale(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    const size_t operations = 1000000;
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        Map map;
+        for (size_t i = 0; i < size; ++i) {
+            map.insert(static_cast<int>(i));
+        }
+
+        double elapsed = bench::measure([&]() {
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t) {
+                pool.emplace_back([&map, t, threads, size, operations]() {
+                    uint64_t state = t + 1;
+                    long long sum = 0;
+                    for (size_t i = 0; i < operations / threads; ++i) {
+                        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                        int key = static_cast<int>((state >> 33) % size);
+                        switch ((state >> 20) % 10) {
+                            case 0:
+                                map.insert(key);
+                                break;
+                            case 1:
+                                map.erase(key);
+                                break;
+                            default:
+                                map.lookup(key, sum);
+                                break;
+                        }
+                    }
+                    bench::consume(sum);
+                });
+            }
+            for (auto &thread: pool) {
+                thread.join();
+            }
+        });
+        std::string operation = "threads_" + std::to_string(threads);
+        reporter.record("concurrent_map", implementation, operation, size, operations, elapsed);
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(concurrent_map)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size > 1000000) {
+            break;
+        }
+        scale<locked_ordered_map>(reporter, "mutex", size);
+        scale<skiplist_map>(reporter, "skiplist", size);
+    }
+}
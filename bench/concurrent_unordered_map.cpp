@@ -0,0 +1,112 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/concurrent_unordered_map.hpp>
+#include <itl/unordered_map.hpp>
+
+#include <mutex>
+#include <thread>
+
+// HELPERS
+// -------
+
+
+/** \brief Global mutex around an `itl::unordered_map`, the baseline.
+ */
+class locked_map
+{
+public:
+    template <typename Visitor>
+    bool find_and(int key, Visitor visit) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = map_.find(key);
+        if (it == map_.end()) {
+            return false;
+        }
+        visit(*it);
+        return true;
+    }
+
+    template <typename Visitor>
+    bool insert_or_visit(const std::pair<const int, int> &value, Visitor visit)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto result = map_.insert(value);
+        if (!result.second) {
+            visit(*result.first);
+        }
+        return result.second;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    itl::unordered_map<int, int> map_;
+};
+
+
+/** \brief Time `threads` threads running 90% lookups and 10% upserts.
+ */
+template <typename Map>
+void scale(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    const size_t operations = 1000000;
+    for (size_t threads = 1; threads <= 64; threads *= 2) {
+        Map map;
+        for (size_t i = 0; i < size; ++i) {
+            map.insert_or_visit({static_cast<int>(i), 0}, [](std::pair<const int, int> &) {});
+        }
+
+        double elapsed = bench::measure([&]() {
+            std::vector<std::thread> pool;
+            for (size_t t = 0; t < threads; ++t) {
+                pool.emplace_back([&map, t, threads, size, operations]() {
+                    uint64_t state = t + 1;
+                    long long sum = 0;
+                    for (size_t i = 0; i < operations / threads; ++i) {
+                        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                        int key = static_cast<int>((state >> 33) % size);
+                        if ((state >> 20) % 10 == 0) {
+                            map.insert_or_visit({key, 1}, [](std::pair<const int, int> &item) {
+                                ++item.second;
+                            });
+                        } else {
+                            map.find_and(key, [&sum](const std::pair<const int, int> &item) {
+                                sum += item.second;
+                            });
+                        }
+                    }
+                    bench::consume(sum);
+                });
+            }
+            for (auto &thread: pool) {
+                thread.join();
+            }
+        });
+        std::string operation = "threads_" + std::to_string(threads);
+        reporter.record("concurrent_unordered_map", implementation, operation, size, operations, elapsed);
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(concurrent_unordered_map)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size > 1000000) {
+            break;
+        }
+        scale<locked_map>(reporter, "mutex", size);
+        scale<itl::concurrent_unordered_map<int, int>>(reporter, "sharded", size);
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/flat_hash_map.hpp>
+#include <itl/incremental_unordered_map.hpp>
+
+#include <algorithm>
+#include <random>
+
+// HELPERS
+// -------
+
+
+/** \brief Time random lookups with a loop of `find` against `find_batch`.
+ *
+ *  Only maps of at least a million elements are timed, so the table
+ *  does not fit in the last-level cache. Each map is probed once per
+ *  element, so `nanoseconds_per_element` is the time per key.
+ */
+template <typename Container>
+void find_batch(bench::reporter &reporter,
+    const std::string &implementation)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size < 1000000) {
+            continue;
+        }
+
+        Container map;
+        for (size_t i = 0; i < size; ++i) {
+            map.emplace(static_cast<int>(i), static_cast<int>(i));
+        }
+        std::vector<int> keys(size);
+        std::mt19937 generator(static_cast<unsigned>(size));
+        std::uniform_int_distribution<int> distribution(0, static_cast<int>(size - 1));
+        std::generate(keys.begin(), keys.end(), [&]() { return distribution(generator); });
+        std::vector<typename Container::const_iterator> found(size);
+        const Container &object = map;
+
+        double elapsed = bench::measure([&]() {
+            for (size_t i = 0; i < size; ++i) {
+                found[i] = object.find(keys[i]);
+            }
+        });
+        bench::consume(found);
+        reporter.record("find_batch", implementation, "find", size, 1, elapsed);
+
+        elapsed = bench::measure([&]() {
+            object.find_batch(keys.begin(), keys.end(), found.begin());
+        });
+        bench::consume(found);
+        reporter.record("find_batch", implementation, "find_batch", size, 1, elapsed);
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(find_batch)
+{
+    find_batch<itl::flat_hash_map<int, int>>(reporter, "itl::flat_hash_map");
+    find_batch<itl::incremental_unordered_map<int, int>>(reporter, "itl::incremental_unordered_map");
+}
@@ -0,0 +1,56 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/flat_hash_map.hpp>
+#include <itl/unordered_map.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct flat_hash_map_ops
+{
+    typedef std::pair<int, int> value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return value_type(static_cast<int>(i), static_cast<int>(i));
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value.first);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(flat_hash_map)
+{
+    bench::compare<flat_hash_map_ops, itl::flat_hash_map<int, int>, std::unordered_map<int, int>>(reporter, "flat_hash_map");
+    bench::run<flat_hash_map_ops, itl::unordered_map<int, int>>(reporter, "flat_hash_map", "itl::unordered_map");
+    bench::run<flat_hash_map_ops, itl::static_::flat_hash_map<int, int>>(reporter, "flat_hash_map", "itl::static_");
+}
@@ -0,0 +1,48 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/forward_list.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct forward_list_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = false;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.push_front(value);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(forward_list)
+{
+    bench::compare<forward_list_ops, itl::forward_list<int>, std::forward_list<int>>(reporter, "forward_list");
+    bench::run<forward_list_ops, itl::static_::forward_list<int>>(reporter, "forward_list", "itl::static_");
+}
@@ -0,0 +1,101 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/incremental_unordered_map.hpp>
+#include <itl/unordered_map.hpp>
+
+#include <algorithm>
+#include <cstdint>
+
+// OPERATIONS
+// ----------
+
+
+struct incremental_unordered_map_ops
+{
+    typedef std::pair<int, int> value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return value_type(static_cast<int>(i), static_cast<int>(i));
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value.first);
+    }
+};
+
+// HELPERS
+// -------
+
+
+/** \brief Record percentiles of per-insert latency, growing from empty.
+ *
+ *  Keys are scattered, so neither table benefits from sequential
+ *  identity hashes landing in adjacent buckets.
+ */
+template <typename Container>
+void latency(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    Container container;
+    std::vector<double> samples(size);
+    for (size_t i = 0; i < size; ++i) {
+        int key = static_cast<int>(static_cast<uint32_t>(i) * 0x9E3779B1u);
+        samples[i] = bench::measure([&]() {
+            container.insert({key, key});
+        });
+    }
+    bench::consume(container);
+    std::sort(samples.begin(), samples.end());
+
+    static const std::pair<const char*, double> percentiles[] = {
+        {"insert_p50", 0.5},
+        {"insert_p99", 0.99},
+        {"insert_p99.9", 0.999},
+        {"insert_p99.99", 0.9999},
+        {"insert_max", 1.0},
+    };
+    for (const auto &percentile: percentiles) {
+        size_t index = static_cast<size_t>(percentile.second * (size - 1));
+        reporter.record("incremental_unordered_map", implementation, percentile.first, size, 1, samples[index]);
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(incremental_unordered_map)
+{
+    bench::run<incremental_unordered_map_ops, itl::incremental_unordered_map<int, int>>(reporter, "incremental_unordered_map", "itl");
+    bench::run<incremental_unordered_map_ops, itl::unordered_map<int, int>>(reporter, "incremental_unordered_map", "itl::unordered_map");
+
+    for (size_t size: reporter.sizes()) {
+        latency<itl::incremental_unordered_map<int, int>>(reporter, "itl", size);
+        latency<itl::unordered_map<int, int>>(reporter, "itl::unordered_map", size);
+    }
+}
@@ -0,0 +1,138 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/interval_map.hpp>
+#include <itl/map.hpp>
+
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Ranges keyed by lower bound in an `itl::map`, searched by hand, the baseline.
+ */
+class manual_map
+{
+public:
+    void build(const std::vector<std::pair<itl::interval<int>, int>> &ranges)
+    {
+        for (const auto &range: ranges) {
+            map_.emplace_hint(map_.end(), range.first.lower, std::make_pair(range.first.upper, range.second));
+        }
+    }
+
+    int lookup(int key) const
+    {
+        auto it = map_.upper_bound(key);
+        if (it == map_.begin() || !(key < (--it)->second.first)) {
+            return -1;
+        }
+        return it->second.second;
+    }
+
+private:
+    itl::map<int, std::pair<int, int>> map_;
+};
+
+
+/** \brief Adapts `itl::interval_map` to the baseline interface.
+ */
+class coalescing_map
+{
+public:
+    void build(const std::vector<std::pair<itl::interval<int>, int>> &ranges)
+    {
+        map_ = itl::interval_map<int, int>::from_sorted(ranges.begin(), ranges.end());
+    }
+
+    int lookup(int key) const
+    {
+        auto it = map_.find(key);
+        return it == map_.end() ? -1 : it->second;
+    }
+
+    void assign(int lower, int upper, int value)
+    {
+        map_.assign({lower, upper}, value);
+    }
+
+private:
+    itl::interval_map<int, int> map_;
+};
+
+
+/** \brief Time building from sorted ranges, then point lookups over them.
+ */
+template <typename Map>
+void stab(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    // ranges of 10 keys with gaps of 6, values cycling so none coalesce
+    std::vector<std::pair<itl::interval<int>, int>> ranges;
+    for (size_t i = 0; i < size; ++i) {
+        int lower = static_cast<int>(i * 16);
+        ranges.push_back({{lower, lower + 10}, static_cast<int>(i % 7)});
+    }
+
+    // warm the allocator, so neither side pays the first page faults
+    {
+        Map warm;
+        warm.build(ranges);
+    }
+
+    Map map;
+    double elapsed = bench::measure([&]() {
+        map.build(ranges);
+    });
+    reporter.record("interval_map", implementation, "from_sorted", size, size, elapsed);
+
+    const size_t lookups = 1000000;
+    uint64_t state = 1;
+    long long sum = 0;
+    elapsed = bench::measure([&]() {
+        for (size_t i = 0; i < lookups; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            sum += map.lookup(static_cast<int>((state >> 33) % (size * 16)));
+        }
+    });
+    bench::consume(sum);
+    reporter.record("interval_map", implementation, "find", size, lookups, elapsed);
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(interval_map)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size > 1000000) {
+            break;
+        }
+        stab<manual_map>(reporter, "manual", size);
+        stab<coalescing_map>(reporter, "interval_map", size);
+
+        // overwriting random windows, splitting and coalescing as it goes
+        coalescing_map map;
+        map.build({{{0, static_cast<int>(size * 16)}, 0}});
+        const size_t updates = 100000;
+        uint64_t state = 1;
+        double elapsed = bench::measure([&]() {
+            for (size_t i = 0; i < updates; ++i) {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                int lower = static_cast<int>((state >> 33) % (size * 16));
+                map.assign(lower, lower + 1 + static_cast<int>((state >> 20) % 32), static_cast<int>(state & 3));
+            }
+        });
+        bench::consume(map.lookup(0));
+        reporter.record("interval_map", "interval_map", "assign", size, updates, elapsed);
+    }
+}
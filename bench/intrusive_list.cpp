@@ -0,0 +1,130 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/intrusive_list.hpp>
+#include <itl/list.hpp>
+
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Task owned by a scheduler, in one of its queues at a time.
+ */
+struct task
+{
+    size_t queue = 0;
+    itl::list<task*>::iterator position;
+    itl::list_hook hook;
+    long long work = 1;
+};
+
+typedef itl::intrusive_list<task, &task::hook> intrusive_queue;
+typedef itl::list<task*> pointer_queue;
+
+
+void push(pointer_queue &queue, task &item)
+{
+    queue.push_back(&item);
+    item.position = std::prev(queue.end());
+}
+
+
+void push(intrusive_queue &queue, task &item)
+{
+    queue.push_back(item);
+}
+
+
+void erase(pointer_queue &queue, task &item)
+{
+    queue.erase(item.position);
+}
+
+
+void erase(intrusive_queue &queue, task &item)
+{
+    queue.erase(queue.iterator_to(item));
+}
+
+
+long long work(const task *item)
+{
+    return item->work;
+}
+
+
+long long work(const task &item)
+{
+    return item.work;
+}
+
+
+/** \brief Move random tasks between 3 queues (ready, waiting, timer), then drain the queues in order.
+ */
+template <typename Queue>
+void schedule(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    std::vector<task> tasks(size);
+    std::vector<Queue> queues(3);
+    for (size_t i = 0; i < size; ++i) {
+        tasks[i].queue = i % queues.size();
+        push(queues[tasks[i].queue], tasks[i]);
+    }
+
+    const size_t operations = 1000000;
+    uint64_t state = 1;
+    double elapsed = bench::measure([&]() {
+        for (size_t i = 0; i < operations; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            task &item = tasks[(state >> 33) % size];
+            size_t target = (item.queue + 1 + (state >> 20) % 2) % queues.size();
+            erase(queues[item.queue], item);
+            push(queues[target], item);
+            item.queue = target;
+        }
+    });
+    reporter.record("intrusive_list", implementation, "move", size, operations, elapsed);
+
+    long long sum = 0;
+    size_t repeat = operations / size + 1;
+    elapsed = bench::measure([&]() {
+        for (size_t r = 0; r < repeat; ++r) {
+            for (const Queue &queue: queues) {
+                for (const auto &item: queue) {
+                    sum += work(item);
+                }
+            }
+        }
+    });
+    bench::consume(sum);
+    reporter.record("intrusive_list", implementation, "iterate", size, repeat * size, elapsed);
+
+    for (Queue &queue: queues) {
+        queue.clear();
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(intrusive_list)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size > 1000000) {
+            break;
+        }
+        schedule<pointer_queue>(reporter, "itl::list<T*>", size);
+        schedule<intrusive_queue>(reporter, "itl::intrusive_list", size);
+    }
+}
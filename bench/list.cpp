@@ -0,0 +1,48 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/list.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct list_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = false;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.push_back(value);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(list)
+{
+    bench::compare<list_ops, itl::list<int>, std::list<int>>(reporter, "list");
+    bench::run<list_ops, itl::static_::list<int>>(reporter, "list", "itl::static_");
+}
@@ -0,0 +1,91 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+
+// HELPERS
+// -------
+
+
+static void usage(const char *program)
+{
+    std::cerr << "usage: " << program
+              << " [--min N] [--max N] [--budget N] [--filter NAME]... [--output FILE]\n"
+              << "\n"
+              << "    --min N         smallest element count (default 10)\n"
+              << "    --max N         largest element count (default 10000000)\n"
+              << "    --budget N      elements processed per measurement (default 1000000)\n"
+              << "    --filter NAME   only run the named benchmark, may be repeated\n"
+              << "    --output FILE   write JSON to FILE instead of stdout\n";
+}
+
+
+// SUITE
+// -----
+
+
+int main(int argc, char *argv[])
+{
+    size_t min_size = 10;
+    size_t max_size = 10000000;
+    size_t budget = 1000000;
+    std::vector<std::string> filters;
+    std::string output;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        if (i + 1 == argc) {
+            usage(argv[0]);
+            return 1;
+        } else if (std::strcmp(arg, "--min") == 0) {
+            min_size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--max") == 0) {
+            max_size = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--budget") == 0) {
+            budget = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--filter") == 0) {
+            filters.push_back(argv[++i]);
+        } else if (std::strcmp(arg, "--output") == 0) {
+            output = argv[++i];
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (min_size == 0 || budget == 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    bench::reporter reporter(min_size, max_size, budget);
+    for (const auto &benchmark: bench::registry()) {
+        bool selected = filters.empty();
+        for (const auto &filter: filters) {
+            selected |= filter == benchmark.first;
+        }
+        if (selected) {
+            std::cerr << "running " << benchmark.first << "\n";
+            benchmark.second(reporter);
+        }
+    }
+
+    if (output.empty()) {
+        reporter.write(std::cout);
+    } else {
+        std::ofstream stream(output);
+        reporter.write(stream);
+    }
+
+    return 0;
+}
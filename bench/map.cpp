@@ -0,0 +1,61 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/map.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct map_ops
+{
+    typedef std::pair<int, int> value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return value_type(static_cast<int>(i), static_cast<int>(i));
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value.first);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(map)
+{
+    bench::compare<map_ops, itl::map<int, int>, std::map<int, int>>(reporter, "map");
+    bench::run<map_ops, itl::static_::map<int, int>>(reporter, "map", "itl::static_");
+}
+
+
+BENCHMARK(multimap)
+{
+    bench::compare<map_ops, itl::multimap<int, int>, std::multimap<int, int>>(reporter, "multimap");
+    bench::run<map_ops, itl::static_::multimap<int, int>>(reporter, "multimap", "itl::static_");
+}
@@ -0,0 +1,88 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/mapped_vector.hpp>
+#include <itl/vector.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+// HELPERS
+// -------
+
+
+/** \brief Time opening a column of `size` integers and summing it.
+ */
+template <typename Load>
+void load(bench::reporter &reporter,
+    const std::string &implementation,
+    const std::string &path,
+    Load function)
+{
+    for (size_t size: reporter.sizes()) {
+        {
+            std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+            for (size_t i = 0; i < size; ++i) {
+                int value = static_cast<int>(i);
+                stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            }
+        }
+
+        size_t repeat = reporter.repeat(size);
+        double open = 0;
+        double iterate = 0;
+        for (size_t r = 0; r < repeat; ++r) {
+            function(path, open, iterate);
+        }
+        reporter.record("mapped_vector", implementation, "open", size, repeat, open);
+        reporter.record("mapped_vector", implementation, "iterate", size, repeat, iterate);
+    }
+    std::remove(path.c_str());
+}
+
+
+template <typename Container>
+void sum(const Container &container,
+    double &iterate)
+{
+    iterate += bench::measure([&]() {
+        long long total = 0;
+        for (int value: container) {
+            total += value;
+        }
+        bench::consume(total);
+    });
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(mapped_vector)
+{
+    std::string path = "itl_bench_mapped_vector.bin";
+    load(reporter, "read", path, [](const std::string &path, double &open, double &iterate) {
+        itl::vector<int> column;
+        open += bench::measure([&]() {
+            std::ifstream stream(path, std::ios::binary | std::ios::ate);
+            column.resize(static_cast<size_t>(stream.tellg()) / sizeof(int));
+            stream.seekg(0);
+            stream.read(reinterpret_cast<char*>(column.data()), column.size() * sizeof(int));
+        });
+        sum(column, iterate);
+    });
+    load(reporter, "mmap", path, [](const std::string &path, double &open, double &iterate) {
+        itl::mapped_vector<const int> column;
+        open += bench::measure([&]() {
+            column.open(path);
+            column.advise(itl::map_advice::sequential);
+        });
+        sum(column, iterate);
+    });
+}
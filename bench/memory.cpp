@@ -0,0 +1,83 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/memory.hpp>
+
+// HELPERS
+// -------
+
+
+/** \brief Time the lifecycle of `size` independent smart pointers.
+ */
+template <typename Pointer, typename Factory>
+void lifecycle(bench::reporter &reporter,
+    const std::string &implementation,
+    Factory factory)
+{
+    for (size_t size: reporter.sizes()) {
+        bench::storage<Pointer> objects(size);
+        bench::storage<Pointer> copies(size);
+        bench::storage<Pointer> moved(size);
+        double elapsed;
+
+        elapsed = bench::measure([&]() {
+            for (size_t i = 0; i < size; ++i) {
+                ::new (objects[i]) Pointer(factory(static_cast<int>(i)));
+            }
+        });
+        reporter.record("shared_ptr", implementation, "construct", size, 1, elapsed);
+
+        elapsed = bench::measure([&]() {
+            for (size_t i = 0; i < size; ++i) {
+                ::new (copies[i]) Pointer(*objects[i]);
+            }
+        });
+        reporter.record("shared_ptr", implementation, "copy", size, 1, elapsed);
+
+        elapsed = bench::measure([&]() {
+            for (size_t i = 0; i < size; ++i) {
+                ::new (moved[i]) Pointer(std::move(*copies[i]));
+            }
+        });
+        reporter.record("shared_ptr", implementation, "move", size, 1, elapsed);
+
+        elapsed = bench::measure([&]() {
+            for (size_t i = 0; i < size; ++i) {
+                bench::consume(*moved[i]->get());
+            }
+        });
+        reporter.record("shared_ptr", implementation, "lookup", size, 1, elapsed);
+
+        elapsed = bench::measure([&]() {
+            for (size_t i = 0; i < size; ++i) {
+                moved[i]->~Pointer();
+                copies[i]->~Pointer();
+            }
+        });
+        reporter.record("shared_ptr", implementation, "destroy", size, 1, elapsed);
+
+        for (size_t i = 0; i < size; ++i) {
+            objects[i]->~Pointer();
+        }
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(shared_ptr)
+{
+    lifecycle<std::shared_ptr<int>>(reporter, "std", [](int i) {
+        return std::make_shared<int>(i);
+    });
+    lifecycle<itl::shared_ptr<int>>(reporter, "itl", [](int i) {
+        return itl::make_shared<int>(i);
+    });
+}
@@ -0,0 +1,141 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/node_pool.hpp>
+
+#include <thread>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Time insert/erase churn on a map holding `size` keys, then a full iteration.
+ */
+template <typename Map>
+void churn_map(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    Map map;
+    for (size_t i = 0; i < size; ++i) {
+        map.emplace(static_cast<int>(i * 2), static_cast<int>(i));
+    }
+
+    const size_t operations = 1000000;
+    uint64_t state = 1;
+    double elapsed = bench::measure([&]() {
+        for (size_t i = 0; i < operations; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            int key = static_cast<int>((state >> 33) % (size * 2));
+            if (!map.erase(key)) {
+                map.emplace(key, key);
+            }
+        }
+    });
+    reporter.record("node_pool", implementation, "map_churn", size, operations, elapsed);
+
+    // after churn, default nodes are scattered across the heap
+    long long sum = 0;
+    size_t repeat = operations / size + 1;
+    elapsed = bench::measure([&]() {
+        for (size_t r = 0; r < repeat; ++r) {
+            for (const auto &item: map) {
+                sum += item.second;
+            }
+        }
+    });
+    bench::consume(sum);
+    reporter.record("node_pool", implementation, "map_iterate", size, repeat * map.size(), elapsed);
+}
+
+
+/** \brief Time a list built by interleaving pushes and pops at both ends, then a full iteration.
+ */
+template <typename List>
+void churn_list(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    List list;
+    const size_t operations = 1000000;
+    double elapsed = bench::measure([&]() {
+        for (size_t i = 0; i < operations; ++i) {
+            list.push_back(static_cast<int>(i));
+            if (list.size() > size) {
+                list.pop_front();
+            }
+        }
+    });
+    reporter.record("node_pool", implementation, "list_churn", size, operations, elapsed);
+
+    long long sum = 0;
+    size_t repeat = operations / size + 1;
+    elapsed = bench::measure([&]() {
+        for (size_t r = 0; r < repeat; ++r) {
+            for (int value: list) {
+                sum += value;
+            }
+        }
+    });
+    bench::consume(sum);
+    reporter.record("node_pool", implementation, "list_iterate", size, repeat * list.size(), elapsed);
+}
+
+
+/** \brief Time map churn on 4 threads, each with its own map.
+ */
+template <typename Map>
+void churn_threads(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    const size_t threads = 4;
+    const size_t operations = 1000000;
+    double elapsed = bench::measure([&]() {
+        std::vector<std::thread> pool;
+        for (size_t t = 0; t < threads; ++t) {
+            pool.emplace_back([t, threads, size, operations]() {
+                Map map;
+                uint64_t state = t + 1;
+                for (size_t i = 0; i < operations / threads; ++i) {
+                    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                    int key = static_cast<int>((state >> 33) % (size * 2));
+                    if (!map.erase(key)) {
+                        map.emplace(key, key);
+                    }
+                }
+                bench::consume(map.size());
+            });
+        }
+        for (auto &thread: pool) {
+            thread.join();
+        }
+    });
+    reporter.record("node_pool", implementation, "map_churn_threads_4", size, operations, elapsed);
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(node_pool)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size > 1000000) {
+            break;
+        }
+        churn_map<itl::map<int, int>>(reporter, "std::allocator", size);
+        churn_map<itl::pooled::map<int, int>>(reporter, "node_pool", size);
+        churn_list<itl::list<int>>(reporter, "std::allocator", size);
+        churn_list<itl::pooled::list<int>>(reporter, "node_pool", size);
+        churn_threads<itl::map<int, int>>(reporter, "std::allocator", size);
+        churn_threads<itl::pooled::map<int, int>>(reporter, "node_pool", size);
+    }
+}
@@ -0,0 +1,65 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/btree_set.hpp>
+#include <itl/order_statistic_set.hpp>
+
+#include <set>
+
+// OPERATIONS
+// ----------
+
+
+struct order_statistic_set_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+// the cost of maintaining subtree sizes, against the plain B-tree
+BENCHMARK(order_statistic_set)
+{
+    bench::compare<order_statistic_set_ops, itl::order_statistic_set<int>, itl::btree_set<int>>(reporter, "order_statistic_set");
+    bench::run<order_statistic_set_ops, std::set<int>>(reporter, "order_statistic_set", "std::set");
+}
+
+
+BENCHMARK(order_statistic_multiset)
+{
+    bench::compare<order_statistic_set_ops, itl::order_statistic_multiset<int>, itl::btree_multiset<int>>(reporter, "order_statistic_multiset");
+    bench::run<order_statistic_set_ops, std::multiset<int>>(reporter, "order_statistic_multiset", "std::multiset");
+}
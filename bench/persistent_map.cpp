@@ -0,0 +1,175 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/map.hpp>
+#include <itl/persistent_map.hpp>
+#include <itl/persistent_vector.hpp>
+#include <itl/vector.hpp>
+
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Snapshots by copying an `itl::map` before each update, the baseline.
+ */
+class copied_map
+{
+public:
+    void set(int key, int value)
+    {
+        itl::map<int, int> next(versions_.back());
+        next[key] = value;
+        versions_.push_back(std::move(next));
+    }
+
+    void batch(const std::vector<int> &keys)
+    {
+        itl::map<int, int> next(versions_.back());
+        for (int key: keys) {
+            next[key] = key;
+        }
+        versions_.push_back(std::move(next));
+    }
+
+    int at(int key) const
+    {
+        return versions_.back().at(key);
+    }
+
+    std::vector<itl::map<int, int>> versions_ = std::vector<itl::map<int, int>>(1);
+};
+
+
+/** \brief Snapshots as versions of an `itl::persistent_map`.
+ */
+class shared_map
+{
+public:
+    void set(int key, int value)
+    {
+        versions_.push_back(versions_.back().set(key, value));
+    }
+
+    void batch(const std::vector<int> &keys)
+    {
+        auto next = versions_.back().transient();
+        for (int key: keys) {
+            next.insert_or_assign(key, key);
+        }
+        versions_.push_back(next.persistent());
+    }
+
+    int at(int key) const
+    {
+        return versions_.back().at(key);
+    }
+
+    std::vector<itl::persistent_map<int, int>> versions_ = std::vector<itl::persistent_map<int, int>>(1);
+};
+
+
+/** \brief Time single and batched updates that each keep the previous snapshot.
+ */
+template <typename Map>
+void snapshot(bench::reporter &reporter,
+    const std::string &implementation,
+    size_t size)
+{
+    const size_t updates = 256;
+    Map map;
+    std::vector<int> keys;
+    for (size_t i = 0; i < size; ++i) {
+        keys.push_back(static_cast<int>(i));
+    }
+    map.batch(keys);
+
+    uint64_t state = 1;
+    double elapsed = bench::measure([&]() {
+        for (size_t i = 0; i < updates; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            map.set(static_cast<int>((state >> 33) % size), static_cast<int>(i));
+        }
+    });
+    bench::consume(map.at(0));
+    reporter.record("persistent_map", implementation, "set", size, updates, elapsed);
+
+    keys.resize(std::min<size_t>(size, 1000));
+    elapsed = bench::measure([&]() {
+        for (size_t i = 0; i < updates / 16; ++i) {
+            map.batch(keys);
+        }
+    });
+    bench::consume(map.at(0));
+    reporter.record("persistent_map", implementation, "batch", size, updates / 16 * keys.size(), elapsed);
+}
+
+
+/** \brief Time updates of a vector that each keep the previous snapshot.
+ */
+template <typename Vector, typename Set>
+void snapshot_vector(bench::reporter &reporter,
+    const std::string &implementation,
+    const Vector &initial,
+    Set set)
+{
+    const size_t updates = 256;
+    std::vector<Vector> versions(1, initial);
+    size_t size = initial.size();
+
+    uint64_t state = 1;
+    double elapsed = bench::measure([&]() {
+        for (size_t i = 0; i < updates; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            versions.push_back(set(versions.back(), (state >> 33) % size, static_cast<int>(i)));
+        }
+    });
+    bench::consume(versions.back()[0]);
+    reporter.record("persistent_vector", implementation, "set", size, updates, elapsed);
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(persistent_map)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size > 100000) {
+            break;
+        }
+        snapshot<copied_map>(reporter, "copy", size);
+        snapshot<shared_map>(reporter, "persistent", size);
+    }
+}
+
+
+BENCHMARK(persistent_vector)
+{
+    for (size_t size: reporter.sizes()) {
+        if (size > 100000) {
+            break;
+        }
+        itl::vector<int> copied;
+        auto shared = itl::persistent_vector<int>().transient();
+        for (size_t i = 0; i < size; ++i) {
+            copied.push_back(static_cast<int>(i));
+            shared.push_back(static_cast<int>(i));
+        }
+        snapshot_vector(reporter, "copy", copied, [](const itl::vector<int> &x, size_t i, int value) {
+            itl::vector<int> next(x);
+            next[i] = value;
+            return next;
+        });
+        snapshot_vector(reporter, "persistent", shared.persistent(), [](const itl::persistent_vector<int> &x, size_t i, int value) {
+            return x.set(i, value);
+        });
+    }
+}
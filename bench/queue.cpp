@@ -0,0 +1,48 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/queue.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct queue_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = false;
+    static const bool iterate_enabled = false;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(typename Container::container_type(first, last));
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.push(value);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(queue)
+{
+    bench::compare<queue_ops, itl::queue<int>, std::queue<int>>(reporter, "queue");
+    bench::run<queue_ops, itl::static_::queue<int>>(reporter, "queue", "itl::static_");
+}
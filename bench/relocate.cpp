@@ -0,0 +1,85 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/memory.hpp>
+#include <itl/relocate.hpp>
+#include <itl/vector.hpp>
+
+#include <vector>
+
+// HELPERS
+// -------
+
+
+/** \brief Time relocating `size` smart pointers between buffers.
+ */
+template <typename Relocatable>
+void relocate(bench::reporter &reporter,
+    const std::string &implementation)
+{
+    typedef itl::shared_ptr<int> pointer;
+    for (size_t size: reporter.sizes()) {
+        bench::storage<pointer> source(size);
+        bench::storage<pointer> destination(size);
+        for (size_t i = 0; i < size; ++i) {
+            ::new (source[i]) pointer(itl::make_shared<int>(static_cast<int>(i)));
+        }
+
+        double elapsed = bench::measure([&]() {
+            itl::uninitialized_relocate(source[0], source[0] + size, destination[0], Relocatable());
+        });
+        reporter.record("shared_ptr", implementation, "relocate", size, 1, elapsed);
+
+        for (size_t i = 0; i < size; ++i) {
+            destination[i]->~pointer();
+        }
+    }
+}
+
+
+/** \brief Time appending `size` empty smart pointers to an empty vector.
+ *
+ *  Empty pointers keep reference counting out, so the time is growth.
+ */
+template <typename Vector>
+void push_back(bench::reporter &reporter,
+    const std::string &implementation)
+{
+    typedef itl::shared_ptr<int> pointer;
+    for (size_t size: reporter.sizes()) {
+        size_t repeat = reporter.repeat(size);
+        double elapsed = bench::measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                Vector vector;
+                for (size_t i = 0; i < size; ++i) {
+                    vector.push_back(pointer());
+                }
+                bench::consume(vector.data());
+            }
+        });
+        reporter.record("shared_ptr", implementation, "push_back", size, repeat, elapsed);
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(relocate)
+{
+    relocate<std::false_type>(reporter, "move");
+    relocate<std::true_type>(reporter, "memcpy");
+}
+
+
+BENCHMARK(vector_growth)
+{
+    push_back<std::vector<itl::shared_ptr<int>>>(reporter, "std");
+    push_back<itl::vector<itl::shared_ptr<int>>>(reporter, "itl");
+}
@@ -0,0 +1,61 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/set.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct set_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(set)
+{
+    bench::compare<set_ops, itl::set<int>, std::set<int>>(reporter, "set");
+    bench::run<set_ops, itl::static_::set<int>>(reporter, "set", "itl::static_");
+}
+
+
+BENCHMARK(multiset)
+{
+    bench::compare<set_ops, itl::multiset<int>, std::multiset<int>>(reporter, "multiset");
+    bench::run<set_ops, itl::static_::multiset<int>>(reporter, "multiset", "itl::static_");
+}
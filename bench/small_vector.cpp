@@ -0,0 +1,56 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/small_vector.hpp>
+#include <itl/vector.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct small_vector_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.push_back(value);
+    }
+
+    template <typename Container>
+    static value_type lookup(const Container &container, size_t i, const value_type &)
+    {
+        return container[i];
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(small_vector)
+{
+    bench::compare<small_vector_ops, itl::small_vector<int, 8>, std::vector<int>>(reporter, "small_vector");
+    bench::run<small_vector_ops, itl::static_::small_vector<int, 8>>(reporter, "small_vector", "itl::static_");
+    bench::run<small_vector_ops, itl::vector<int>>(reporter, "small_vector", "itl::vector");
+}
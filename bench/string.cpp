@@ -0,0 +1,54 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/string.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct string_ops
+{
+    typedef char value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>('a' + i % 26);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.push_back(value);
+    }
+
+    template <typename Container>
+    static value_type lookup(const Container &container, size_t i, const value_type &)
+    {
+        return container[i];
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(string)
+{
+    bench::compare<string_ops, itl::string, std::string>(reporter, "string");
+    bench::run<string_ops, itl::static_::string>(reporter, "string", "itl::static_");
+}
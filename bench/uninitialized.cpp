@@ -0,0 +1,71 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/allocator.hpp>
+#include <itl/string.hpp>
+#include <itl/vector.hpp>
+
+#include <cstring>
+
+// HELPERS
+// -------
+
+
+/** \brief Time growing a buffer by `size` bytes and filling it.
+ */
+template <typename Container, typename Grow>
+void grow(bench::reporter &reporter,
+    const std::string &container,
+    const std::string &implementation,
+    Grow function)
+{
+    for (size_t size: reporter.sizes()) {
+        size_t repeat = reporter.repeat(size);
+        std::vector<char> input(size, 'A');
+        double elapsed = bench::measure([&]() {
+            for (size_t r = 0; r < repeat; ++r) {
+                Container buffer;
+                char *data = function(buffer, size);
+                std::memcpy(data, input.data(), size);
+                bench::consume(buffer);
+            }
+        });
+        reporter.record(container, implementation, "fill", size, repeat, elapsed);
+    }
+}
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(uninitialized)
+{
+    typedef std::vector<char> std_vector;
+    typedef itl::vector<char, itl::default_init_allocator<char>> itl_vector;
+
+    grow<std_vector>(reporter, "vector", "resize", [](std_vector &buffer, size_t size) {
+        buffer.resize(size);
+        return buffer.data();
+    });
+    grow<itl_vector>(reporter, "vector", "append_uninitialized", [](itl_vector &buffer, size_t size) {
+        return buffer.append_uninitialized(size).data();
+    });
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    // itl::string::append_uninitialized needs C++23 resize_and_overwrite
+    typedef std::string std_string;
+    typedef itl::string itl_string;
+    grow<std_string>(reporter, "string", "resize", [](std_string &buffer, size_t size) {
+        buffer.resize(size);
+        return &buffer[0];
+    });
+    grow<itl_string>(reporter, "string", "append_uninitialized", [](itl_string &buffer, size_t size) {
+        return buffer.append_uninitialized(size).data();
+    });
+#endif
+}
@@ -0,0 +1,61 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/unordered_map.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct unordered_map_ops
+{
+    typedef std::pair<int, int> value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return value_type(static_cast<int>(i), static_cast<int>(i));
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value.first);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(unordered_map)
+{
+    bench::compare<unordered_map_ops, itl::unordered_map<int, int>, std::unordered_map<int, int>>(reporter, "unordered_map");
+    bench::run<unordered_map_ops, itl::static_::unordered_map<int, int>>(reporter, "unordered_map", "itl::static_");
+}
+
+
+BENCHMARK(unordered_multimap)
+{
+    bench::compare<unordered_map_ops, itl::unordered_multimap<int, int>, std::unordered_multimap<int, int>>(reporter, "unordered_multimap");
+    bench::run<unordered_map_ops, itl::static_::unordered_multimap<int, int>>(reporter, "unordered_multimap", "itl::static_");
+}
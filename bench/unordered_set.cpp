@@ -0,0 +1,61 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/unordered_set.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct unordered_set_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.insert(value);
+    }
+
+    template <typename Container>
+    static size_t lookup(const Container &container, size_t, const value_type &value)
+    {
+        return container.count(value);
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(unordered_set)
+{
+    bench::compare<unordered_set_ops, itl::unordered_set<int>, std::unordered_set<int>>(reporter, "unordered_set");
+    bench::run<unordered_set_ops, itl::static_::unordered_set<int>>(reporter, "unordered_set", "itl::static_");
+}
+
+
+BENCHMARK(unordered_multiset)
+{
+    bench::compare<unordered_set_ops, itl::unordered_multiset<int>, std::unordered_multiset<int>>(reporter, "unordered_multiset");
+    bench::run<unordered_set_ops, itl::static_::unordered_multiset<int>>(reporter, "unordered_multiset", "itl::static_");
+}
@@ -0,0 +1,54 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include "benchmark.hpp"
+#include <itl/vector.hpp>
+
+// OPERATIONS
+// ----------
+
+
+struct vector_ops
+{
+    typedef int value_type;
+    static const bool lookup_enabled = true;
+    static const bool iterate_enabled = true;
+
+    static value_type value(size_t i)
+    {
+        return static_cast<value_type>(i);
+    }
+
+    template <typename Container, typename Iter>
+    static void construct(Container *ptr, Iter first, Iter last)
+    {
+        ::new (ptr) Container(first, last);
+    }
+
+    template <typename Container>
+    static void push(Container &container, const value_type &value)
+    {
+        container.push_back(value);
+    }
+
+    template <typename Container>
+    static value_type lookup(const Container &container, size_t i, const value_type &)
+    {
+        return container[i];
+    }
+};
+
+// BENCHMARKS
+// ----------
+
+
+BENCHMARK(vector)
+{
+    bench::compare<vector_ops, itl::vector<int>, std::vector<int>>(reporter, "vector");
+    bench::run<vector_ops, itl::static_::vector<int>>(reporter, "vector", "itl::static_");
+}
@@ -0,0 +1,154 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "relocate.hpp"
+
+#if __cplusplus >= 201703L
+#   include <memory_resource>
+#   if defined(__cpp_lib_memory_resource)
+#       define ITL_HAS_PMR 1
+#   endif
+#endif
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Allocator adaptor default-initializing argument-less elements.
+ *
+ *  Containers value-initialize elements on `resize(n)`, zeroing
+ *  trivial types. With this adaptor, the elements are left
+ *  uninitialized instead, so buffers may be grown and then filled
+ *  by I/O or decoders without writing the memory twice.
+ */
+template <typename T, typename Alloc = std::allocator<T>>
+class default_init_allocator: public Alloc
+{
+protected:
+    typedef std::allocator_traits<Alloc> Traits;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    template <typename U>
+    struct rebind
+    {
+        typedef default_init_allocator<U, typename Traits::template rebind_alloc<U>> other;
+    };
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Alloc::Alloc;
+    default_init_allocator() = default;
+    default_init_allocator(const Alloc &alloc) noexcept;
+
+    template <typename U, typename A>
+    default_init_allocator(const default_init_allocator<U, A> &other) noexcept;
+
+    template <typename U>
+    void construct(U *p) noexcept(std::is_nothrow_default_constructible<U>::value);
+
+    template <typename U, typename... Ts>
+    void construct(U *p, Ts&&... ts);
+};
+
+
+// FUNCTIONS
+// ---------
+
+
+/** \brief Swap two allocator-aware containers.
+ *
+ *  Swapping containers whose allocators compare unequal and do not
+ *  propagate is undefined, as for `std::pmr` containers using
+ *  different resources. These exchange elements instead, each
+ *  container keeping its own allocator.
+ */
+template <typename Container>
+void allocator_aware_swap(Container &left, Container &right);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, typename Alloc>
+default_init_allocator<T, Alloc>::default_init_allocator(const Alloc &alloc) noexcept:
+    Alloc(alloc)
+{}
+
+
+template <typename T, typename Alloc>
+template <typename U, typename A>
+default_init_allocator<T, Alloc>::default_init_allocator(const default_init_allocator<U, A> &other) noexcept:
+    Alloc(static_cast<const A&>(other))
+{}
+
+
+template <typename T, typename Alloc>
+template <typename U>
+void default_init_allocator<T, Alloc>::construct(U *p) noexcept(std::is_nothrow_default_constructible<U>::value)
+{
+    ::new (static_cast<void*>(p)) U;
+}
+
+
+template <typename T, typename Alloc>
+template <typename U, typename... Ts>
+void default_init_allocator<T, Alloc>::construct(U *p,
+    Ts&&... ts)
+{
+    Traits::construct(static_cast<Alloc&>(*this), p, std::forward<Ts>(ts)...);
+}
+
+
+template <typename Container>
+void allocator_aware_swap(Container &left,
+    Container &right)
+{
+    typedef std::allocator_traits<typename Container::allocator_type> Traits;
+    if (Traits::propagate_on_container_swap::value || left.get_allocator() == right.get_allocator()) {
+        left.swap(right);
+    } else {
+        Container temp(std::move(left));
+        left = std::move(right);
+        right = std::move(temp);
+    }
+}
+
+
+// TRAITS
+// ------
+
+
+template <typename T, typename Alloc>
+struct is_trivially_relocatable<default_init_allocator<T, Alloc>>: is_trivially_relocatable<Alloc>
+{};
+
+
+/** \brief Whether `Alloc` default-initializes argument-less elements.
+ */
+template <typename Alloc>
+struct is_default_init_allocator: std::false_type
+{};
+
+
+template <typename T, typename Alloc>
+struct is_default_init_allocator<default_init_allocator<T, Alloc>>: std::true_type
+{};
+
+}   /* itl */
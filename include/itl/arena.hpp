@@ -0,0 +1,412 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <new>
+#include <type_traits>
+#include "deque.hpp"
+#include "forward_list.hpp"
+#include "list.hpp"
+#include "map.hpp"
+#include "queue.hpp"
+#include "relocate.hpp"
+#include "set.hpp"
+#include "stack.hpp"
+#include "string.hpp"
+#include "unordered_map.hpp"
+#include "unordered_set.hpp"
+#include "vector.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+template <typename T>
+class arena_allocator;
+
+
+/** \brief Monotonic bump allocator.
+ *
+ *  Allocations are carved from chunks of geometrically increasing
+ *  size, and deallocation only reclaims the most recent allocation.
+ *  Requests larger than the next chunk get a chunk of their own,
+ *  without advancing the growth further.
+ *  `release()` frees every allocation at once, retaining the last
+ *  chunk for reuse, so a request-scoped arena settles into a single
+ *  chunk and releases in O(1).
+ *
+ *  Default-constructed `arena_allocator`s use the thread's current
+ *  arena: a thread-local arena, unless another arena is installed
+ *  with `arena::scope`. Containers must not outlive the arena, or
+ *  be used after `release()`.
+ */
+class arena
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    class scope;
+
+    template <typename T>
+    using vector = itl::vector<T, arena_allocator<T>>;
+
+    template <typename T>
+    using deque = itl::deque<T, arena_allocator<T>>;
+
+    template <typename T>
+    using list = itl::list<T, arena_allocator<T>>;
+
+    template <typename T>
+    using forward_list = itl::forward_list<T, arena_allocator<T>>;
+
+    template <typename T>
+    using queue = itl::queue<T, std::deque<T, arena_allocator<T>>>;
+
+    template <typename T>
+    using stack = itl::stack<T, std::deque<T, arena_allocator<T>>>;
+
+    template <typename Char, typename Traits = std::char_traits<Char>>
+    using basic_string = itl::basic_string<Char, Traits, arena_allocator<Char>>;
+
+    typedef basic_string<char> string;
+    typedef basic_string<wchar_t> wstring;
+    typedef basic_string<char16_t> u16string;
+    typedef basic_string<char32_t> u32string;
+
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    using map = itl::map<Key, Value, Compare, arena_allocator<std::pair<const Key, Value>>>;
+
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    using multimap = itl::multimap<Key, Value, Compare, arena_allocator<std::pair<const Key, Value>>>;
+
+    template <typename T, typename Compare = std::less<T>>
+    using set = itl::set<T, Compare, arena_allocator<T>>;
+
+    template <typename T, typename Compare = std::less<T>>
+    using multiset = itl::multiset<T, Compare, arena_allocator<T>>;
+
+    template <
+        typename Key,
+        typename Value,
+        typename Hash = std::hash<Key>,
+        typename Pred = std::equal_to<Key>
+    >
+    using unordered_map = itl::unordered_map<Key, Value, Hash, Pred, arena_allocator<std::pair<const Key, Value>>>;
+
+    template <
+        typename Key,
+        typename Value,
+        typename Hash = std::hash<Key>,
+        typename Pred = std::equal_to<Key>
+    >
+    using unordered_multimap = itl::unordered_multimap<Key, Value, Hash, Pred, arena_allocator<std::pair<const Key, Value>>>;
+
+    template <
+        typename Key,
+        typename Hash = std::hash<Key>,
+        typename Pred = std::equal_to<Key>
+    >
+    using unordered_set = itl::unordered_set<Key, Hash, Pred, arena_allocator<Key>>;
+
+    template <
+        typename Key,
+        typename Hash = std::hash<Key>,
+        typename Pred = std::equal_to<Key>
+    >
+    using unordered_multiset = itl::unordered_multiset<Key, Hash, Pred, arena_allocator<Key>>;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    explicit arena(size_t chunk_size = 4096);
+    arena(const arena &other) = delete;
+    arena & operator=(const arena &other) = delete;
+    ~arena();
+
+    static arena & current() noexcept;
+
+    void * allocate(size_t bytes, size_t alignment);
+    void deallocate(void *ptr, size_t bytes) noexcept;
+    void release() noexcept;
+
+private:
+    struct chunk
+    {
+        chunk *next;
+        size_t size;
+    };
+
+    static arena *& installed() noexcept;
+    void grow(size_t bytes);
+
+    chunk *head_;
+    char *cursor_;
+    char *end_;
+    size_t chunk_size_;
+};
+
+
+/** \brief Installs an arena as the thread's current arena.
+ */
+class arena::scope
+{
+public:
+    explicit scope(arena &resource) noexcept;
+    scope(const scope &other) = delete;
+    scope & operator=(const scope &other) = delete;
+    ~scope();
+
+private:
+    arena *previous_;
+};
+
+
+/** \brief Allocator drawing from an `itl::arena`.
+ */
+template <typename T>
+class arena_allocator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef arena_allocator<U> other;
+    };
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    arena_allocator() noexcept;
+    arena_allocator(arena &resource) noexcept;
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U> &other) noexcept;
+
+    T * allocate(size_type n);
+    void deallocate(T *p, size_type n) noexcept;
+    arena * resource() const noexcept;
+
+private:
+    arena *arena_;
+};
+
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T> &left, const arena_allocator<U> &right) noexcept;
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T> &left, const arena_allocator<U> &right) noexcept;
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline arena::arena(size_t chunk_size):
+    head_(nullptr),
+    cursor_(nullptr),
+    end_(nullptr),
+    chunk_size_(chunk_size ? chunk_size : 1)
+{}
+
+
+inline arena::~arena()
+{
+    while (head_) {
+        chunk *next = head_->next;
+        ::operator delete(head_);
+        head_ = next;
+    }
+}
+
+
+inline auto arena::installed() noexcept
+    -> arena *&
+{
+    static thread_local arena *resource = nullptr;
+    return resource;
+}
+
+
+inline auto arena::current() noexcept
+    -> arena &
+{
+    static thread_local arena local;
+    arena *resource = installed();
+    return resource ? *resource : local;
+}
+
+
+inline void arena::grow(size_t bytes)
+{
+    if (bytes > SIZE_MAX - sizeof(chunk)) {
+        throw std::bad_alloc();
+    }
+    size_t size = chunk_size_ > bytes ? chunk_size_ : bytes;
+    chunk *block = static_cast<chunk*>(::operator new(sizeof(chunk) + size));
+    block->next = head_;
+    block->size = size;
+    head_ = block;
+    cursor_ = reinterpret_cast<char*>(block + 1);
+    end_ = cursor_ + size;
+
+    // double from the schedule, not from an oversized request
+    if (chunk_size_ <= (SIZE_MAX - sizeof(chunk)) / 2) {
+        chunk_size_ *= 2;
+    }
+}
+
+
+inline void * arena::allocate(size_t bytes,
+    size_t alignment)
+{
+    uintptr_t address = reinterpret_cast<uintptr_t>(cursor_);
+    size_t padding = (alignment - address % alignment) % alignment;
+    if (bytes > SIZE_MAX - alignment) {
+        throw std::bad_alloc();
+    }
+    if (!cursor_ || padding + bytes > static_cast<size_t>(end_ - cursor_)) {
+        grow(bytes + alignment);
+        address = reinterpret_cast<uintptr_t>(cursor_);
+        padding = (alignment - address % alignment) % alignment;
+    }
+
+    char *ptr = cursor_ + padding;
+    cursor_ = ptr + bytes;
+    return ptr;
+}
+
+
+inline void arena::deallocate(void *ptr,
+    size_t bytes) noexcept
+{
+    // reclaim the most recent allocation, such as a growing vector
+    char *first = static_cast<char*>(ptr);
+    if (first + bytes == cursor_) {
+        cursor_ = first;
+    }
+}
+
+
+inline void arena::release() noexcept
+{
+    if (!head_) {
+        return;
+    }
+
+    chunk *next = head_->next;
+    while (next) {
+        chunk *following = next->next;
+        ::operator delete(next);
+        next = following;
+    }
+    head_->next = nullptr;
+    cursor_ = reinterpret_cast<char*>(head_ + 1);
+    end_ = cursor_ + head_->size;
+}
+
+
+inline arena::scope::scope(arena &resource) noexcept:
+    previous_(installed())
+{
+    installed() = &resource;
+}
+
+
+inline arena::scope::~scope()
+{
+    installed() = previous_;
+}
+
+
+template <typename T>
+arena_allocator<T>::arena_allocator() noexcept:
+    arena_(&arena::current())
+{}
+
+
+template <typename T>
+arena_allocator<T>::arena_allocator(arena &resource) noexcept:
+    arena_(&resource)
+{}
+
+
+template <typename T>
+template <typename U>
+arena_allocator<T>::arena_allocator(const arena_allocator<U> &other) noexcept:
+    arena_(other.resource())
+{}
+
+
+template <typename T>
+T * arena_allocator<T>::allocate(size_type n)
+{
+    if (n > SIZE_MAX / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+}
+
+
+template <typename T>
+void arena_allocator<T>::deallocate(T *p,
+    size_type n) noexcept
+{
+    arena_->deallocate(p, n * sizeof(T));
+}
+
+
+template <typename T>
+arena * arena_allocator<T>::resource() const noexcept
+{
+    return arena_;
+}
+
+
+template <typename T, typename U>
+bool operator==(const arena_allocator<T> &left,
+    const arena_allocator<U> &right) noexcept
+{
+    return left.resource() == right.resource();
+}
+
+
+template <typename T, typename U>
+bool operator!=(const arena_allocator<T> &left,
+    const arena_allocator<U> &right) noexcept
+{
+    return left.resource() != right.resource();
+}
+
+
+// TRAITS
+// ------
+
+
+template <typename T>
+struct is_trivially_relocatable<arena_allocator<T>>: std::true_type
+{};
+
+}   /* itl */
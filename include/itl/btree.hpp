@@ -0,0 +1,2119 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "relocate.hpp"
+
+
+namespace itl
+{
+namespace btree
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Target size of a node, in bytes, spanning four cache lines.
+ */
+constexpr size_t node_bytes = 256;
+
+
+/** \brief Values stored in each node, at least 3.
+ */
+template <typename T>
+constexpr size_t node_slots() noexcept;
+
+
+/** \brief Empty subtree size of uncounted nodes.
+ */
+template <bool Counted>
+struct node_total
+{};
+
+
+/** \brief Values in the subtree of a node, for order-statistic trees.
+ */
+template <>
+struct node_total<true>
+{
+    size_t total = 0;
+};
+
+
+/** \brief Node of a B-tree, storing values in sorted order.
+ *
+ *  Leaves are just this header and the values. Internal nodes extend
+ *  it with one more child than values. Counted nodes also track the
+ *  size of their subtree. Boxed nodes store pointers to separately
+ *  allocated values instead.
+ */
+template <typename T, size_t Slots, bool Counted, bool Boxed>
+struct node: node_total<Counted>
+{
+    typedef typename std::conditional<Boxed, T*, T>::type stored_type;
+
+    node *parent;
+    uint16_t position;
+    uint16_t count;
+    bool leaf;
+    typename std::aligned_storage<sizeof(stored_type), alignof(stored_type)>::type slots[Slots];
+
+    T * value(size_t i) noexcept;
+    T * value(size_t i, std::true_type) noexcept;
+    T * value(size_t i, std::false_type) noexcept;
+    stored_type * slot(size_t i) noexcept;
+    node *& child(size_t i) noexcept;
+};
+
+
+template <typename T, size_t Slots, bool Counted, bool Boxed>
+struct internal_node: node<T, Slots, Counted, Boxed>
+{
+    node<T, Slots, Counted, Boxed> *children[Slots + 1];
+};
+
+
+/** \brief Bidirectional iterator over the values of a tree.
+ *
+ *  The end iterator is one past the last value of the rightmost leaf.
+ */
+template <typename Node, typename T>
+class iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef T * pointer;
+    typedef T & reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    iterator() noexcept;
+    iterator(Node *node, size_t position) noexcept;
+
+    template <
+        typename U,
+        typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type
+    >
+    iterator(const iterator<Node, U> &other) noexcept;
+
+    reference operator*() const;
+    pointer operator->() const;
+    iterator & operator++();
+    iterator operator++(int);
+    iterator & operator--();
+    iterator operator--(int);
+
+    template <typename U>
+    bool operator==(const iterator<Node, U> &other) const noexcept;
+
+    template <typename U>
+    bool operator!=(const iterator<Node, U> &other) const noexcept;
+
+    Node * node() const noexcept;
+    size_t position() const noexcept;
+
+private:
+    Node *node_;
+    size_t position_;
+};
+
+
+/** \brief B-tree of values sorted by key, shared by the btree containers.
+ *
+ *  Each node packs up to `node_slots<T>()` values in a node of about
+ *  `node_bytes`, so a lookup touches one node per level rather than
+ *  one per comparison. Inserts and erases shift values within nodes,
+ *  and therefore invalidate all iterators and references.
+ *
+ *  Splits that append to the rightmost node leave the left node full,
+ *  so trees built from sorted input are densely packed.
+ *
+ *  Shifting values relocates them, which must not throw. Values whose
+ *  move may throw, such as types with only a copy constructor, are
+ *  boxed: nodes hold pointers to values allocated one by one, as in
+ *  `std::map`, and shift the pointers. Nodes are allocated before any
+ *  is modified, so a throwing insert leaves the values unchanged.
+ */
+template <
+    typename Key,
+    typename T,
+    typename Compare,
+    typename Alloc,
+    bool Multi,
+    bool Counted = false
+>
+class tree
+{
+protected:
+    typedef tree<Key, T, Compare, Alloc, Multi, Counted> This;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+    typedef typename slot_type<T>::type Slot;
+    typedef std::integral_constant<bool, !std::is_nothrow_move_constructible<Slot>::value> Boxed;
+    typedef typename std::conditional<Boxed::value, T*, T>::type Stored;
+    typedef btree::node<T, node_slots<Stored>(), Counted, Boxed::value> Node;
+    typedef btree::internal_node<T, node_slots<Stored>(), Counted, Boxed::value> Internal;
+    typedef typename AllocTraits::template rebind_alloc<Node> LeafAlloc;
+    typedef typename AllocTraits::template rebind_alloc<Internal> InternalAlloc;
+    typedef std::allocator_traits<LeafAlloc> LeafTraits;
+    typedef std::allocator_traits<InternalAlloc> InternalTraits;
+    typedef typename std::conditional<std::is_same<Key, T>::value, const T, T>::type Value;
+
+    static constexpr size_t slots = node_slots<Stored>();
+    static constexpr size_t min_slots = (slots - 1) / 2;
+
+    static const Key & key(const T &value);
+    static const Key & key(const T &value, std::true_type);
+    static const Key & key(const T &value, std::false_type);
+
+    Node * make_node(bool leaf);
+    void free_node(Node *node) noexcept;
+    void destroy(Node *node) noexcept;
+    void reset() noexcept;
+    void construct_value(Node *node, size_t i, T &&value);
+    void construct_value(Node *node, size_t i, T &&value, std::true_type);
+    void construct_value(Node *node, size_t i, T &&value, std::false_type);
+    void destroy_value(Node *node, size_t i) noexcept;
+    void destroy_value(Node *node, size_t i, std::true_type) noexcept;
+    void destroy_value(Node *node, size_t i, std::false_type) noexcept;
+    static void transfer(Stored *dst, Stored *src) noexcept;
+    static void set_child(Node *parent, size_t i, Node *child) noexcept;
+
+    template <typename K>
+    size_t lower_index(Node *node, const K &key) const;
+    template <typename K>
+    size_t upper_index(Node *node, const K &key) const;
+    template <typename K>
+    auto lower(const K &key) const -> btree::iterator<Node, Value>;
+    template <typename K>
+    auto upper(const K &key) const -> btree::iterator<Node, Value>;
+    template <typename K>
+    auto find_key(const K &key) const -> btree::iterator<Node, Value>;
+
+    Node * split(Node *node, size_t &i);
+    auto insert_position(const Key &key) -> std::pair<btree::iterator<Node, Value>, bool>;
+    auto insert_at(btree::iterator<Node, Value> position, T &&value) -> btree::iterator<Node, Value>;
+    auto insert_value(T &&value) -> std::pair<btree::iterator<Node, Value>, bool>;
+    auto insert_hint(btree::iterator<Node, Value> hint, T &&value) -> btree::iterator<Node, Value>;
+
+    static auto result(std::pair<btree::iterator<Node, Value>, bool> inserted, std::true_type)
+        -> btree::iterator<Node, Value>;
+    static auto result(std::pair<btree::iterator<Node, Value>, bool> inserted, std::false_type)
+        -> std::pair<btree::iterator<Node, Value>, bool>;
+
+    void rotate_right(Node *left, Node *node, Node *&tracked, size_t &i);
+    void rotate_left(Node *node, Node *right, Node *&tracked, size_t &i);
+    void merge_nodes(Node *left, Node *right, Node *&tracked, size_t &i);
+    void rebalance(Node *node, Node *&tracked, size_t &i);
+    auto normalize(Node *node, size_t i) const -> btree::iterator<Node, Value>;
+
+    static void add_total(Node *node, bool inserted) noexcept;
+    static void add_total(Node *node, bool inserted, std::true_type) noexcept;
+    static void add_total(Node *node, bool inserted, std::false_type) noexcept;
+    static void recount(Node *node) noexcept;
+    static void recount(Node *node, std::true_type) noexcept;
+    static void recount(Node *node, std::false_type) noexcept;
+
+    auto select(size_t k) const -> btree::iterator<Node, Value>;
+    template <typename K>
+    size_t lower_rank(const K &key) const;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef T value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef typename AllocTraits::pointer pointer;
+    typedef typename AllocTraits::const_pointer const_pointer;
+    typedef btree::iterator<Node, Value> iterator;
+    typedef btree::iterator<Node, const T> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef typename std::conditional<Multi, iterator, std::pair<iterator, bool>>::type insert_result;
+
+    class value_compare
+    {
+    public:
+        bool operator()(const value_type &left, const value_type &right) const;
+
+    protected:
+        friend class tree;
+        value_compare(key_compare comp);
+
+        key_compare comp;
+    };
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    tree();
+    explicit tree(const key_compare &comp, const allocator_type &alloc = allocator_type());
+    explicit tree(const allocator_type &alloc);
+
+    template <typename Iter>
+    tree(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    template <typename Iter>
+    tree(Iter first, Iter last, const allocator_type &alloc);
+
+    tree(std::initializer_list<value_type> list, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    tree(std::initializer_list<value_type> list, const allocator_type &alloc);
+    tree(const This &other);
+    tree(const This &other, const allocator_type &alloc);
+    tree(This &&other) noexcept;
+    tree(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept;
+    This & operator=(std::initializer_list<value_type> list);
+    ~tree();
+
+    // ITERATORS
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+
+    // MODIFIERS
+    insert_result insert(const value_type &value);
+    insert_result insert(value_type &&value);
+    iterator insert(const_iterator hint, const value_type &value);
+    iterator insert(const_iterator hint, value_type &&value);
+
+    template <typename Iter>
+    void insert(Iter first, Iter last);
+
+    void insert(std::initializer_list<value_type> list);
+
+    template <typename... Ts>
+    insert_result emplace(Ts&&... ts);
+
+    template <typename... Ts>
+    iterator emplace_hint(const_iterator hint, Ts&&... ts);
+
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type &key);
+    void clear() noexcept;
+    void swap(This &other) noexcept;
+    void merge(This &other);
+
+    // OBSERVERS
+    key_compare key_comp() const;
+    value_compare value_comp() const;
+
+    // OPERATIONS
+    iterator find(const key_type &key);
+    const_iterator find(const key_type &key) const;
+    size_type count(const key_type &key) const;
+    iterator lower_bound(const key_type &key);
+    const_iterator lower_bound(const key_type &key) const;
+    iterator upper_bound(const key_type &key);
+    const_iterator upper_bound(const key_type &key) const;
+    std::pair<iterator, iterator> equal_range(const key_type &key);
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const;
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+
+    // counted trees only
+    iterator nth(size_type k);
+    const_iterator nth(size_type k) const;
+    size_type rank(const key_type &key) const;
+    size_type count_range(const key_type &first, const key_type &last) const;
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type rank(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count_range(const K &first, const K &last) const;
+
+    // ALLOCATOR
+    allocator_type get_allocator() const;
+
+private:
+    Node *root_;
+    Node *leftmost_;
+    Node *rightmost_;
+    size_t size_;
+    key_compare comp_;
+    allocator_type alloc_;
+};
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator==(const tree<Key, T, Compare, Alloc, Multi, Counted> &left, const tree<Key, T, Compare, Alloc, Multi, Counted> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator!=(const tree<Key, T, Compare, Alloc, Multi, Counted> &left, const tree<Key, T, Compare, Alloc, Multi, Counted> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator<(const tree<Key, T, Compare, Alloc, Multi, Counted> &left, const tree<Key, T, Compare, Alloc, Multi, Counted> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator<=(const tree<Key, T, Compare, Alloc, Multi, Counted> &left, const tree<Key, T, Compare, Alloc, Multi, Counted> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator>(const tree<Key, T, Compare, Alloc, Multi, Counted> &left, const tree<Key, T, Compare, Alloc, Multi, Counted> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator>=(const tree<Key, T, Compare, Alloc, Multi, Counted> &left, const tree<Key, T, Compare, Alloc, Multi, Counted> &right);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T>
+constexpr size_t node_slots() noexcept
+{
+    // header: parent pointer, position, count and leaf flag
+    return (node_bytes - 2 * sizeof(void*)) / sizeof(T) < 3 ? 3 : (node_bytes - 2 * sizeof(void*)) / sizeof(T);
+}
+
+
+template <typename T, size_t Slots, bool Counted, bool Boxed>
+T * node<T, Slots, Counted, Boxed>::value(size_t i) noexcept
+{
+    return value(i, std::integral_constant<bool, Boxed>());
+}
+
+
+template <typename T, size_t Slots, bool Counted, bool Boxed>
+T * node<T, Slots, Counted, Boxed>::value(size_t i,
+    std::true_type) noexcept
+{
+    return *slot(i);
+}
+
+
+template <typename T, size_t Slots, bool Counted, bool Boxed>
+T * node<T, Slots, Counted, Boxed>::value(size_t i,
+    std::false_type) noexcept
+{
+    return slot(i);
+}
+
+
+template <typename T, size_t Slots, bool Counted, bool Boxed>
+auto node<T, Slots, Counted, Boxed>::slot(size_t i) noexcept
+    -> stored_type *
+{
+    return reinterpret_cast<stored_type*>(&slots[i]);
+}
+
+
+template <typename T, size_t Slots, bool Counted, bool Boxed>
+auto node<T, Slots, Counted, Boxed>::child(size_t i) noexcept
+    -> node *&
+{
+    return static_cast<internal_node<T, Slots, Counted, Boxed>*>(this)->children[i];
+}
+
+
+template <typename Node, typename T>
+iterator<Node, T>::iterator() noexcept:
+    node_(nullptr),
+    position_(0)
+{}
+
+
+template <typename Node, typename T>
+iterator<Node, T>::iterator(Node *node,
+        size_t position) noexcept:
+    node_(node),
+    position_(position)
+{}
+
+
+template <typename Node, typename T>
+template <typename U, typename>
+iterator<Node, T>::iterator(const iterator<Node, U> &other) noexcept:
+    node_(other.node()),
+    position_(other.position())
+{}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator*() const
+    -> reference
+{
+    return *node_->value(position_);
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator->() const
+    -> pointer
+{
+    return node_->value(position_);
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator++()
+    -> iterator &
+{
+    if (!node_->leaf) {
+        // leftmost value of the right subtree
+        node_ = node_->child(position_ + 1);
+        while (!node_->leaf) {
+            node_ = node_->child(0);
+        }
+        position_ = 0;
+        return *this;
+    }
+
+    if (++position_ < node_->count) {
+        return *this;
+    }
+    // climb to the first ancestor with a value to the right
+    iterator last(*this);
+    while (position_ == node_->count && node_->parent) {
+        position_ = node_->position;
+        node_ = node_->parent;
+    }
+    if (position_ == node_->count) {
+        *this = last;
+    }
+    return *this;
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator++(int)
+    -> iterator
+{
+    iterator copy(*this);
+    ++*this;
+    return copy;
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator--()
+    -> iterator &
+{
+    if (!node_->leaf) {
+        // rightmost value of the left subtree
+        node_ = node_->child(position_);
+        while (!node_->leaf) {
+            node_ = node_->child(node_->count);
+        }
+        position_ = node_->count - 1;
+        return *this;
+    }
+
+    while (position_ == 0 && node_->parent) {
+        position_ = node_->position;
+        node_ = node_->parent;
+    }
+    --position_;
+    return *this;
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator--(int)
+    -> iterator
+{
+    iterator copy(*this);
+    --*this;
+    return copy;
+}
+
+
+template <typename Node, typename T>
+template <typename U>
+bool iterator<Node, T>::operator==(const iterator<Node, U> &other) const noexcept
+{
+    return node_ == other.node() && position_ == other.position();
+}
+
+
+template <typename Node, typename T>
+template <typename U>
+bool iterator<Node, T>::operator!=(const iterator<Node, U> &other) const noexcept
+{
+    return !(*this == other);
+}
+
+
+template <typename Node, typename T>
+Node * iterator<Node, T>::node() const noexcept
+{
+    return node_;
+}
+
+
+template <typename Node, typename T>
+size_t iterator<Node, T>::position() const noexcept
+{
+    return position_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::key(const T &value)
+    -> const Key &
+{
+    return key(value, std::is_same<Key, T>());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::key(const T &value,
+        std::true_type)
+    -> const Key &
+{
+    return value;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::key(const T &value,
+        std::false_type)
+    -> const Key &
+{
+    return value.first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::make_node(bool leaf)
+    -> Node *
+{
+    Node *node;
+    if (leaf) {
+        LeafAlloc alloc(alloc_);
+        node = ::new (static_cast<void*>(LeafTraits::allocate(alloc, 1))) Node;
+    } else {
+        InternalAlloc alloc(alloc_);
+        node = ::new (static_cast<void*>(InternalTraits::allocate(alloc, 1))) Internal;
+    }
+    node->parent = nullptr;
+    node->position = 0;
+    node->count = 0;
+    node->leaf = leaf;
+    return node;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::free_node(Node *node) noexcept
+{
+    if (node->leaf) {
+        LeafAlloc alloc(alloc_);
+        LeafTraits::deallocate(alloc, node, 1);
+    } else {
+        InternalAlloc alloc(alloc_);
+        InternalTraits::deallocate(alloc, static_cast<Internal*>(node), 1);
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::destroy(Node *node) noexcept
+{
+    if (!node->leaf) {
+        for (size_t i = 0; i <= node->count; ++i) {
+            destroy(node->child(i));
+        }
+    }
+    for (size_t i = 0; i < node->count; ++i) {
+        destroy_value(node, i);
+    }
+    free_node(node);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::reset() noexcept
+{
+    root_ = nullptr;
+    leftmost_ = nullptr;
+    rightmost_ = nullptr;
+    size_ = 0;
+}
+
+
+/** \brief Construct `value` into the empty slot `i` of `node`.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::construct_value(Node *node,
+    size_t i,
+    T &&value)
+{
+    construct_value(node, i, std::move(value), Boxed());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::construct_value(Node *node,
+    size_t i,
+    T &&value,
+    std::true_type)
+{
+    T *box = AllocTraits::allocate(alloc_, 1);
+    try {
+        AllocTraits::construct(alloc_, box, std::move(value));
+    } catch (...) {
+        AllocTraits::deallocate(alloc_, box, 1);
+        throw;
+    }
+    ::new (static_cast<void*>(node->slot(i))) Stored(box);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::construct_value(Node *node,
+    size_t i,
+    T &&value,
+    std::false_type)
+{
+    AllocTraits::construct(alloc_, node->value(i), std::move(value));
+}
+
+
+/** \brief Destroy the value in slot `i` of `node`, leaving it empty.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::destroy_value(Node *node,
+    size_t i) noexcept
+{
+    destroy_value(node, i, Boxed());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::destroy_value(Node *node,
+    size_t i,
+    std::true_type) noexcept
+{
+    T *box = node->value(i);
+    AllocTraits::destroy(alloc_, box);
+    AllocTraits::deallocate(alloc_, box, 1);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::destroy_value(Node *node,
+    size_t i,
+    std::false_type) noexcept
+{
+    AllocTraits::destroy(alloc_, node->value(i));
+}
+
+
+/** \brief Relocate a value into an empty slot, leaving `src` empty.
+ *
+ *  Both slots belong to this tree, so the value keeps its allocator
+ *  and is moved directly, through its mutable `slot_type`. Boxed
+ *  values stay in place, and only their pointers move.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::transfer(Stored *dst,
+    Stored *src) noexcept
+{
+    typedef typename std::conditional<Boxed::value, T*, Slot>::type Moved;
+    Moved *value = reinterpret_cast<Moved*>(src);
+    ::new (static_cast<void*>(dst)) Moved(std::move(*value));
+    value->~Moved();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::set_child(Node *parent,
+    size_t i,
+    Node *child) noexcept
+{
+    parent->child(i) = child;
+    child->parent = parent;
+    child->position = static_cast<uint16_t>(i);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K>
+size_t tree<Key, T, Compare, Alloc, Multi, Counted>::lower_index(Node *node,
+    const K &key) const
+{
+    size_t first = 0;
+    size_t last = node->count;
+    while (first < last) {
+        size_t middle = (first + last) / 2;
+        if (comp_(This::key(*node->value(middle)), key)) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K>
+size_t tree<Key, T, Compare, Alloc, Multi, Counted>::upper_index(Node *node,
+    const K &key) const
+{
+    size_t first = 0;
+    size_t last = node->count;
+    while (first < last) {
+        size_t middle = (first + last) / 2;
+        if (comp_(key, This::key(*node->value(middle)))) {
+            last = middle;
+        } else {
+            first = middle + 1;
+        }
+    }
+    return first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::lower(const K &key) const
+    -> iterator
+{
+    // the deepest candidate is the smallest
+    iterator it(rightmost_, rightmost_ ? rightmost_->count : 0);
+    Node *node = root_;
+    while (node) {
+        size_t i = lower_index(node, key);
+        if (i < node->count) {
+            it = iterator(node, i);
+        }
+        if (node->leaf) {
+            break;
+        }
+        node = node->child(i);
+    }
+    return it;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::upper(const K &key) const
+    -> iterator
+{
+    iterator it(rightmost_, rightmost_ ? rightmost_->count : 0);
+    Node *node = root_;
+    while (node) {
+        size_t i = upper_index(node, key);
+        if (i < node->count) {
+            it = iterator(node, i);
+        }
+        if (node->leaf) {
+            break;
+        }
+        node = node->child(i);
+    }
+    return it;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::find_key(const K &key) const
+    -> iterator
+{
+    iterator it = lower(key);
+    if (it.node() && it.position() < it.node()->count && !comp_(key, This::key(*it))) {
+        return it;
+    }
+    return it.node() ? iterator(rightmost_, rightmost_->count) : it;
+}
+
+
+/** \brief Split a full node, returning the node holding insert position `i`.
+ *
+ *  Values after the median move to a new right sibling, and the median
+ *  moves to the parent, which is split first if it is also full. The
+ *  new nodes of every level are allocated before any is modified.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::split(Node *node,
+        size_t &i)
+    -> Node *
+{
+    // appending keeps the left node full, for sorted inserts
+    size_t median = i == slots ? slots - 1 : slots / 2;
+    Node *sibling = make_node(node->leaf);
+    try {
+        if (!node->parent) {
+            Node *root = make_node(false);
+            set_child(root, 0, node);
+            root_ = root;
+        } else if (node->parent->count == slots) {
+            size_t position = node->position;
+            split(node->parent, position);
+        }
+    } catch (...) {
+        free_node(sibling);
+        throw;
+    }
+
+    Node *parent = node->parent;
+    size_t position = node->position;
+    for (size_t j = median + 1; j < slots; ++j) {
+        transfer(sibling->slot(j - median - 1), node->slot(j));
+    }
+    if (!node->leaf) {
+        for (size_t j = median + 1; j <= slots; ++j) {
+            set_child(sibling, j - median - 1, node->child(j));
+        }
+    }
+    sibling->count = static_cast<uint16_t>(slots - median - 1);
+
+    for (size_t j = parent->count; j > position; --j) {
+        transfer(parent->slot(j), parent->slot(j - 1));
+        set_child(parent, j + 1, parent->child(j));
+    }
+    transfer(parent->slot(position), node->slot(median));
+    set_child(parent, position + 1, sibling);
+    ++parent->count;
+    node->count = static_cast<uint16_t>(median);
+    recount(node);
+    recount(sibling);
+    recount(parent);
+
+    if (node == rightmost_) {
+        rightmost_ = sibling;
+    }
+    if (i > median) {
+        i -= median + 1;
+        return sibling;
+    }
+    return node;
+}
+
+
+/** \brief Leaf position to insert `key`, or the equal key of a unique tree.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert_position(const Key &key)
+    -> std::pair<iterator, bool>
+{
+    Node *node = root_;
+    if (!node) {
+        return std::make_pair(iterator(), true);
+    }
+    while (true) {
+        size_t i = Multi ? upper_index(node, key) : lower_index(node, key);
+        if (!Multi && i < node->count && !comp_(key, This::key(*node->value(i)))) {
+            return std::make_pair(iterator(node, i), false);
+        }
+        if (node->leaf) {
+            return std::make_pair(iterator(node, i), true);
+        }
+        node = node->child(i);
+    }
+}
+
+
+/** \brief Insert `value` before `position`, which may be any iterator.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert_at(iterator position,
+        T &&value)
+    -> iterator
+{
+    Node *node = position.node();
+    size_t i = position.position();
+    if (!root_) {
+        root_ = leftmost_ = rightmost_ = node = make_node(true);
+        i = 0;
+    } else if (!node->leaf) {
+        // after the rightmost value of the left subtree
+        node = node->child(i);
+        while (!node->leaf) {
+            node = node->child(node->count);
+        }
+        i = node->count;
+    }
+
+    if (node->count == slots) {
+        node = split(node, i);
+    }
+    for (size_t j = node->count; j > i; --j) {
+        transfer(node->slot(j), node->slot(j - 1));
+    }
+    try {
+        construct_value(node, i, std::move(value));
+    } catch (...) {
+        // close the gap, leaving any split in place
+        for (size_t j = i; j < node->count; ++j) {
+            transfer(node->slot(j), node->slot(j + 1));
+        }
+        if (!size_) {
+            free_node(root_);
+            reset();
+        }
+        throw;
+    }
+    ++node->count;
+    ++size_;
+    add_total(node, true);
+    return iterator(node, i);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert_value(T &&value)
+    -> std::pair<iterator, bool>
+{
+    auto position = insert_position(key(value));
+    if (!position.second) {
+        return position;
+    }
+    return std::make_pair(insert_at(position.first, std::move(value)), true);
+}
+
+
+/** \brief Insert `value` before `hint` if it sorts there, else anywhere.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert_hint(iterator hint,
+        T &&value)
+    -> iterator
+{
+    const Key &k = key(value);
+    bool after = hint == begin();
+    if (!after) {
+        iterator previous = std::prev(hint);
+        after = Multi ? !comp_(k, key(*previous)) : comp_(key(*previous), k);
+    }
+    bool before = hint == end();
+    if (!before) {
+        before = Multi ? !comp_(key(*hint), k) : comp_(k, key(*hint));
+    }
+    if (after && before) {
+        return insert_at(hint, std::move(value));
+    }
+    return insert_value(std::move(value)).first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::result(std::pair<iterator, bool> inserted,
+        std::true_type)
+    -> iterator
+{
+    return inserted.first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::result(std::pair<iterator, bool> inserted,
+        std::false_type)
+    -> std::pair<iterator, bool>
+{
+    return inserted;
+}
+
+
+/** \brief Move the last value of `left` through the parent into `node`.
+ *
+ *  `tracked` and `i` follow the value they point to as it moves.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::rotate_right(Node *left,
+    Node *node,
+    Node *&tracked,
+    size_t &i)
+{
+    Node *parent = node->parent;
+    size_t separator = left->position;
+    size_t last = left->count - 1;
+    if (tracked == node) {
+        ++i;
+    } else if (tracked == parent && i == separator) {
+        tracked = node;
+        i = 0;
+    } else if (tracked == left && i == last) {
+        tracked = parent;
+        i = separator;
+    } else if (tracked == left && i == left->count) {
+        tracked = node;
+        i = 0;
+    }
+
+    for (size_t j = node->count; j > 0; --j) {
+        transfer(node->slot(j), node->slot(j - 1));
+    }
+    transfer(node->slot(0), parent->slot(separator));
+    transfer(parent->slot(separator), left->slot(last));
+    if (!node->leaf) {
+        for (size_t j = node->count + 1; j > 0; --j) {
+            set_child(node, j, node->child(j - 1));
+        }
+        set_child(node, 0, left->child(last + 1));
+    }
+    --left->count;
+    ++node->count;
+    recount(left);
+    recount(node);
+}
+
+
+/** \brief Move the first value of `right` through the parent into `node`.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::rotate_left(Node *node,
+    Node *right,
+    Node *&tracked,
+    size_t &i)
+{
+    Node *parent = node->parent;
+    size_t separator = node->position;
+    size_t count = node->count;
+    if (tracked == parent && i == separator) {
+        tracked = node;
+        i = count;
+    } else if (tracked == right) {
+        if (i == 0) {
+            tracked = parent;
+            i = separator;
+        } else {
+            --i;
+        }
+    }
+
+    transfer(node->slot(count), parent->slot(separator));
+    transfer(parent->slot(separator), right->slot(0));
+    for (size_t j = 1; j < right->count; ++j) {
+        transfer(right->slot(j - 1), right->slot(j));
+    }
+    if (!node->leaf) {
+        set_child(node, count + 1, right->child(0));
+        for (size_t j = 1; j <= right->count; ++j) {
+            set_child(right, j - 1, right->child(j));
+        }
+    }
+    ++node->count;
+    --right->count;
+    recount(node);
+    recount(right);
+}
+
+
+/** \brief Merge `right` and the separating value of the parent into `left`.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::merge_nodes(Node *left,
+    Node *right,
+    Node *&tracked,
+    size_t &i)
+{
+    Node *parent = left->parent;
+    size_t separator = left->position;
+    size_t count = left->count;
+    if (tracked == parent && i == separator) {
+        tracked = left;
+        i = count;
+    } else if (tracked == parent && i > separator) {
+        --i;
+    } else if (tracked == right) {
+        tracked = left;
+        i += count + 1;
+    }
+
+    transfer(left->slot(count), parent->slot(separator));
+    for (size_t j = 0; j < right->count; ++j) {
+        transfer(left->slot(count + 1 + j), right->slot(j));
+    }
+    if (!left->leaf) {
+        for (size_t j = 0; j <= right->count; ++j) {
+            set_child(left, count + 1 + j, right->child(j));
+        }
+    }
+    left->count = static_cast<uint16_t>(count + 1 + right->count);
+    recount(left);
+
+    for (size_t j = separator + 1; j < parent->count; ++j) {
+        transfer(parent->slot(j - 1), parent->slot(j));
+        set_child(parent, j, parent->child(j + 1));
+    }
+    --parent->count;
+
+    if (right == rightmost_) {
+        rightmost_ = left;
+    }
+    free_node(right);
+}
+
+
+/** \brief Restore the minimum fill of `node` and its ancestors after an erase.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::rebalance(Node *node,
+    Node *&tracked,
+    size_t &i)
+{
+    while (node != root_ && node->count < min_slots) {
+        Node *parent = node->parent;
+        size_t position = node->position;
+        Node *left = position > 0 ? parent->child(position - 1) : nullptr;
+        Node *right = position < parent->count ? parent->child(position + 1) : nullptr;
+        if (left && left->count > min_slots) {
+            rotate_right(left, node, tracked, i);
+            return;
+        }
+        if (right && right->count > min_slots) {
+            rotate_left(node, right, tracked, i);
+            return;
+        }
+        if (left) {
+            merge_nodes(left, node, tracked, i);
+        } else {
+            merge_nodes(node, right, tracked, i);
+        }
+        node = parent;
+    }
+
+    if (root_->count == 0) {
+        Node *root = root_;
+        if (root->leaf) {
+            reset();
+        } else {
+            root_ = root->child(0);
+            root_->parent = nullptr;
+            root_->position = 0;
+        }
+        if (tracked == root) {
+            tracked = nullptr;
+        }
+        free_node(root);
+    }
+}
+
+
+/** \brief Iterator to the value at `i` in `node`, or the next one past its end.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::normalize(Node *node,
+        size_t i) const
+    -> iterator
+{
+    if (!node) {
+        return iterator(rightmost_, rightmost_ ? rightmost_->count : 0);
+    }
+    while (i == node->count && node->parent) {
+        i = node->position;
+        node = node->parent;
+    }
+    if (i == node->count) {
+        return iterator(rightmost_, rightmost_->count);
+    }
+    return iterator(node, i);
+}
+
+
+/** \brief Count an inserted or erased value in `node` and its ancestors.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::add_total(Node *node,
+    bool inserted) noexcept
+{
+    add_total(node, inserted, std::integral_constant<bool, Counted>());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::add_total(Node *node,
+    bool inserted,
+    std::true_type) noexcept
+{
+    for (; node; node = node->parent) {
+        node->total = inserted ? node->total + 1 : node->total - 1;
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::add_total(Node *,
+    bool,
+    std::false_type) noexcept
+{}
+
+
+/** \brief Recompute the subtree size of `node` from its children.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::recount(Node *node) noexcept
+{
+    recount(node, std::integral_constant<bool, Counted>());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::recount(Node *node,
+    std::true_type) noexcept
+{
+    size_t total = node->count;
+    if (!node->leaf) {
+        for (size_t i = 0; i <= node->count; ++i) {
+            total += node->child(i)->total;
+        }
+    }
+    node->total = total;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::recount(Node *,
+    std::false_type) noexcept
+{}
+
+
+/** \brief Iterator to the `k`-th value, descending by subtree sizes.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::select(size_t k) const
+    -> iterator
+{
+    if (k >= size_) {
+        return iterator(rightmost_, rightmost_ ? rightmost_->count : 0);
+    }
+    Node *node = root_;
+    while (!node->leaf) {
+        size_t i = 0;
+        for (; k >= node->child(i)->total; ++i) {
+            k -= node->child(i)->total;
+            if (k == 0) {
+                return iterator(node, i);
+            }
+            --k;
+        }
+        node = node->child(i);
+    }
+    return iterator(node, k);
+}
+
+
+/** \brief Number of values with keys less than `key`.
+ *
+ *  Values left of the lower bound in each node count along with the
+ *  subtrees between them, so one descent suffices.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K>
+size_t tree<Key, T, Compare, Alloc, Multi, Counted>::lower_rank(const K &key) const
+{
+    size_t rank = 0;
+    Node *node = root_;
+    while (node) {
+        size_t i = lower_index(node, key);
+        rank += i;
+        if (node->leaf) {
+            break;
+        }
+        for (size_t j = 0; j < i; ++j) {
+            rank += node->child(j)->total;
+        }
+        node = node->child(i);
+    }
+    return rank;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::value_compare::value_compare(key_compare comp):
+    comp(comp)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool tree<Key, T, Compare, Alloc, Multi, Counted>::value_compare::operator()(const value_type &left,
+    const value_type &right) const
+{
+    return comp(tree::key(left), tree::key(right));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree():
+    tree(key_compare())
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(const key_compare &comp,
+        const allocator_type &alloc):
+    comp_(comp),
+    alloc_(alloc)
+{
+    reset();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(const allocator_type &alloc):
+    tree(key_compare(), alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename Iter>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    tree(comp, alloc)
+{
+    insert(first, last);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename Iter>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(Iter first,
+        Iter last,
+        const allocator_type &alloc):
+    tree(first, last, key_compare(), alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(std::initializer_list<value_type> list,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    tree(list.begin(), list.end(), comp, alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(std::initializer_list<value_type> list,
+        const allocator_type &alloc):
+    tree(list.begin(), list.end(), key_compare(), alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(const This &other):
+    tree(other, AllocTraits::select_on_container_copy_construction(other.alloc_))
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(const This &other,
+        const allocator_type &alloc):
+    tree(other.comp_, alloc)
+{
+    // sorted appends fill each node
+    for (const auto &value: other) {
+        insert_at(end(), T(value));
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(This &&other) noexcept:
+    root_(other.root_),
+    leftmost_(other.leftmost_),
+    rightmost_(other.rightmost_),
+    size_(other.size_),
+    comp_(std::move(other.comp_)),
+    alloc_(std::move(other.alloc_))
+{
+    other.reset();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::tree(This &&other,
+        const allocator_type &alloc):
+    tree(other.comp_, alloc)
+{
+    if (alloc_ == other.alloc_) {
+        swap(other);
+        return;
+    }
+    for (auto &value: other) {
+        insert_at(end(), T(std::move(value)));
+    }
+    other.clear();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::operator=(const This &other)
+    -> This &
+{
+    if (this != &other) {
+        This copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::operator=(This &&other) noexcept
+    -> This &
+{
+    if (this != &other) {
+        clear();
+        swap(other);
+    }
+    return *this;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::operator=(std::initializer_list<value_type> list)
+    -> This &
+{
+    clear();
+    insert(list);
+    return *this;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+tree<Key, T, Compare, Alloc, Multi, Counted>::~tree()
+{
+    clear();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::begin() noexcept
+    -> iterator
+{
+    return iterator(leftmost_, 0);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(leftmost_, 0);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::end() noexcept
+    -> iterator
+{
+    return iterator(rightmost_, rightmost_ ? rightmost_->count : 0);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(rightmost_, rightmost_ ? rightmost_->count : 0);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::rbegin() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::rbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::rend() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(begin());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::rend() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(begin());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::crbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return rbegin();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::crend() const noexcept
+    -> const_reverse_iterator
+{
+    return rend();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool tree<Key, T, Compare, Alloc, Multi, Counted>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::max_size() const noexcept
+    -> size_type
+{
+    return AllocTraits::max_size(alloc_);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert(const value_type &value)
+    -> insert_result
+{
+    return emplace(value);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert(value_type &&value)
+    -> insert_result
+{
+    return result(insert_value(std::move(value)), std::integral_constant<bool, Multi>());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert(const_iterator hint,
+        const value_type &value)
+    -> iterator
+{
+    return emplace_hint(hint, value);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::insert(const_iterator hint,
+        value_type &&value)
+    -> iterator
+{
+    return emplace_hint(hint, std::move(value));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename Iter>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::insert(Iter first,
+    Iter last)
+{
+    // sorted input appends at the end hint
+    for (; first != last; ++first) {
+        emplace_hint(end(), *first);
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::insert(std::initializer_list<value_type> list)
+{
+    insert(list.begin(), list.end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename... Ts>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::emplace(Ts&&... ts)
+    -> insert_result
+{
+    return insert(T(std::forward<Ts>(ts)...));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename... Ts>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::emplace_hint(const_iterator hint,
+        Ts&&... ts)
+    -> iterator
+{
+    return insert_hint(iterator(hint.node(), hint.position()), T(std::forward<Ts>(ts)...));
+}
+
+
+/** \brief Erase the value at `position`, returning the following value.
+ *
+ *  Values of internal nodes are replaced by their successor, so only
+ *  leaves shrink, and underfull nodes then borrow from or merge with
+ *  a sibling.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::erase(const_iterator position)
+    -> iterator
+{
+    Node *node = position.node();
+    size_t i = position.position();
+    Node *tracked = node;
+    size_t next = i;
+
+    destroy_value(node, i);
+    if (!node->leaf) {
+        Node *leaf = node->child(i + 1);
+        while (!leaf->leaf) {
+            leaf = leaf->child(0);
+        }
+        transfer(node->slot(i), leaf->slot(0));
+        node = leaf;
+        i = 0;
+    }
+    for (size_t j = i + 1; j < node->count; ++j) {
+        transfer(node->slot(j - 1), node->slot(j));
+    }
+    --node->count;
+    --size_;
+    add_total(node, false);
+
+    rebalance(node, tracked, next);
+    return normalize(tracked, next);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::erase(const_iterator first,
+        const_iterator last)
+    -> iterator
+{
+    if (first == begin() && last == end()) {
+        clear();
+        return end();
+    }
+    // erasing invalidates `last`, so count the values first
+    size_t count = static_cast<size_t>(std::distance(first, last));
+    iterator it(first.node(), first.position());
+    for (; count; --count) {
+        it = erase(it);
+    }
+    return it;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::erase(const key_type &key)
+    -> size_type
+{
+    auto range = equal_range(key);
+    size_type count = static_cast<size_type>(std::distance(range.first, range.second));
+    erase(range.first, range.second);
+    return count;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::clear() noexcept
+{
+    if (root_) {
+        destroy(root_);
+        reset();
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::swap(This &other) noexcept
+{
+    using std::swap;
+    swap(root_, other.root_);
+    swap(leftmost_, other.leftmost_);
+    swap(rightmost_, other.rightmost_);
+    swap(size_, other.size_);
+    swap(comp_, other.comp_);
+    swap(alloc_, other.alloc_);
+}
+
+
+/** \brief Move the values of `other`, keeping those already present here.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+void tree<Key, T, Compare, Alloc, Multi, Counted>::merge(This &other)
+{
+    if (this == &other) {
+        return;
+    }
+    for (auto it = other.begin(); it != other.end();) {
+        auto position = insert_position(key(*it));
+        if (position.second) {
+            // moved last, so a throwing insert leaves `other` intact
+            insert_at(position.first, std::move(*it.node()->value(it.position())));
+            it = other.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::key_comp() const
+    -> key_compare
+{
+    return comp_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::value_comp() const
+    -> value_compare
+{
+    return value_compare(comp_);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::find(const key_type &key)
+    -> iterator
+{
+    return find_key(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::find(const key_type &key) const
+    -> const_iterator
+{
+    return find_key(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::count(const key_type &key) const
+    -> size_type
+{
+    if (!Multi) {
+        return find_key(key) != cend();
+    }
+    return static_cast<size_type>(std::distance(lower(key), upper(key)));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::lower_bound(const key_type &key)
+    -> iterator
+{
+    return lower(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::lower_bound(const key_type &key) const
+    -> const_iterator
+{
+    return lower(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::upper_bound(const key_type &key)
+    -> iterator
+{
+    return upper(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::upper_bound(const key_type &key) const
+    -> const_iterator
+{
+    return upper(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::equal_range(const key_type &key)
+    -> std::pair<iterator, iterator>
+{
+    return std::make_pair(lower(key), upper(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::equal_range(const key_type &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return std::make_pair(const_iterator(lower(key)), const_iterator(upper(key)));
+}
+
+
+/** \brief Heterogeneous lookup, for transparent comparators.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::find(const K &key)
+    -> iterator
+{
+    return find_key(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::find(const K &key) const
+    -> const_iterator
+{
+    return find_key(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::count(const K &key) const
+    -> size_type
+{
+    return static_cast<size_type>(std::distance(lower(key), upper(key)));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::lower_bound(const K &key)
+    -> iterator
+{
+    return lower(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::lower_bound(const K &key) const
+    -> const_iterator
+{
+    return lower(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::upper_bound(const K &key)
+    -> iterator
+{
+    return upper(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::upper_bound(const K &key) const
+    -> const_iterator
+{
+    return upper(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return std::make_pair(lower(key), upper(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return std::make_pair(const_iterator(lower(key)), const_iterator(upper(key)));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::nth(size_type k)
+    -> iterator
+{
+    return select(k);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::nth(size_type k) const
+    -> const_iterator
+{
+    return select(k);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::rank(const key_type &key) const
+    -> size_type
+{
+    return lower_rank(key);
+}
+
+
+/** \brief Number of values with keys in `[first, last)`.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::count_range(const key_type &first,
+        const key_type &last) const
+    -> size_type
+{
+    return comp_(first, last) ? lower_rank(last) - lower_rank(first) : 0;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::rank(const K &key) const
+    -> size_type
+{
+    return lower_rank(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+template <typename K, typename C, typename>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::count_range(const K &first,
+        const K &last) const
+    -> size_type
+{
+    return comp_(first, last) ? lower_rank(last) - lower_rank(first) : 0;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+auto tree<Key, T, Compare, Alloc, Multi, Counted>::get_allocator() const
+    -> allocator_type
+{
+    return alloc_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator==(const tree<Key, T, Compare, Alloc, Multi, Counted> &left,
+    const tree<Key, T, Compare, Alloc, Multi, Counted> &right)
+{
+    return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator!=(const tree<Key, T, Compare, Alloc, Multi, Counted> &left,
+    const tree<Key, T, Compare, Alloc, Multi, Counted> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator<(const tree<Key, T, Compare, Alloc, Multi, Counted> &left,
+    const tree<Key, T, Compare, Alloc, Multi, Counted> &right)
+{
+    return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator<=(const tree<Key, T, Compare, Alloc, Multi, Counted> &left,
+    const tree<Key, T, Compare, Alloc, Multi, Counted> &right)
+{
+    return !(right < left);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator>(const tree<Key, T, Compare, Alloc, Multi, Counted> &left,
+    const tree<Key, T, Compare, Alloc, Multi, Counted> &right)
+{
+    return right < left;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi, bool Counted>
+bool operator>=(const tree<Key, T, Compare, Alloc, Multi, Counted> &left,
+    const tree<Key, T, Compare, Alloc, Multi, Counted> &right)
+{
+    return !(left < right);
+}
+
+}   /* btree */
+}   /* itl */
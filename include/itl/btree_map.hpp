@@ -0,0 +1,831 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include "allocator.hpp"
+#include "btree.hpp"
+#include "destructor.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Inheritable B-tree map.
+ *
+ *  Exports the member surface of `itl::map`, without node handles.
+ *  Values are packed into nodes of a few cache lines, so lookups
+ *  chase far fewer pointers and elements carry no per-node overhead.
+ *  Unlike `itl::map`, inserts and erases invalidate all iterators
+ *  and references.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key,Value>>,
+    typename Destructor = virtual_destructor
+>
+class btree_map: protected btree::tree<Key, std::pair<const Key, Value>, Compare, Alloc, false>,
+    protected Destructor
+{
+protected:
+    typedef btree::tree<Key, std::pair<const Key, Value>, Compare, Alloc, false> Base;
+    typedef btree_map<Key, Value, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(btree_map<K, V, C, A, D> &left, btree_map<K, V, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const btree_map<K, V, C, A, D> &left, const btree_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const btree_map<K, V, C, A, D> &left, const btree_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>(const btree_map<K, V, C, A, D> &left, const btree_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>=(const btree_map<K, V, C, A, D> &left, const btree_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<(const btree_map<K, V, C, A, D> &left, const btree_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<=(const btree_map<K, V, C, A, D> &left, const btree_map<K, V, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    typedef Value mapped_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    btree_map();
+    btree_map(const This &other);
+    btree_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    btree_map(const This &other, const allocator_type &alloc);
+    btree_map(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~btree_map();
+
+     // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // ELEMENT ACCESS
+    mapped_type & operator[](const key_type &key);
+    mapped_type & operator[](key_type &&key);
+    mapped_type & at(const key_type &key);
+    const mapped_type & at(const key_type &key) const;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Ts&&... ts);
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Ts&&... ts);
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, const key_type &key, Ts&&... ts);
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, key_type &&key, Ts&&... ts);
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, V &&value);
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(key_type &&key, V &&value);
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, const key_type &key, V &&value);
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, key_type &&key, V &&value);
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+/** \brief Inheritable B-tree multimap.
+ *
+ *  Exports the member surface of `itl::multimap`, without node
+ *  handles. Inserts and erases invalidate all iterators.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class btree_multimap: protected btree::tree<Key, std::pair<const Key, Value>, Compare, Alloc, true>,
+    protected Destructor
+{
+protected:
+    typedef btree::tree<Key, std::pair<const Key, Value>, Compare, Alloc, true> Base;
+    typedef btree_multimap<Key, Value, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(btree_multimap<K, V, C, A, D> &left, btree_multimap<K, V, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const btree_multimap<K, V, C, A, D> &left, const btree_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const btree_multimap<K, V, C, A, D> &left, const btree_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>(const btree_multimap<K, V, C, A, D> &left, const btree_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>=(const btree_multimap<K, V, C, A, D> &left, const btree_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<(const btree_multimap<K, V, C, A, D> &left, const btree_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<=(const btree_multimap<K, V, C, A, D> &left, const btree_multimap<K, V, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    typedef Value mapped_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    btree_multimap();
+    btree_multimap(const This &other);
+    btree_multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    btree_multimap(const This &other, const allocator_type &alloc);
+    btree_multimap(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~btree_multimap();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(btree_map<Key, Value, Compare, Alloc, Destructor> &left,
+    btree_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const btree_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const btree_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const btree_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const btree_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const btree_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const btree_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_map<Key, Value, Compare, Alloc, Destructor>::btree_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_map<Key, Value, Compare, Alloc, Destructor>::btree_map(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_map<Key, Value, Compare, Alloc, Destructor>::btree_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_map<Key, Value, Compare, Alloc, Destructor>::btree_map(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_map<Key, Value, Compare, Alloc, Destructor>::btree_map(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_map<Key, Value, Compare, Alloc, Destructor>::~btree_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void btree_map<Key, Value, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::operator[](const key_type &key)
+    -> mapped_type &
+{
+    return try_emplace(key).first->second;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::operator[](key_type &&key)
+    -> mapped_type &
+{
+    return try_emplace(std::move(key)).first->second;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::at(const key_type &key)
+    -> mapped_type &
+{
+    iterator it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("itl::btree_map::at");
+    }
+    return it->second;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::at(const key_type &key) const
+    -> const mapped_type &
+{
+    const_iterator it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("itl::btree_map::at");
+    }
+    return it->second;
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void btree_map<Key, Value, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void btree_map<Key, Value, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+/** \brief Construct a value in place, unless `key` is already present.
+ *
+ *  Unlike `emplace`, nothing is constructed for an existing key.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::try_emplace(const key_type &key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, std::piecewise_construct,
+        std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(ts)...)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::try_emplace(key_type &&key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, std::piecewise_construct,
+        std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(ts)...)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::try_emplace(const_iterator,
+        const key_type &key,
+        Ts&&... ts)
+    -> iterator
+{
+    return try_emplace(key, std::forward<Ts>(ts)...).first;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::try_emplace(const_iterator,
+        key_type &&key,
+        Ts&&... ts)
+    -> iterator
+{
+    return try_emplace(std::move(key), std::forward<Ts>(ts)...).first;
+}
+
+
+/** \brief Assign to the value of `key`, or insert it if absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const key_type &key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        it->second = std::forward<V>(value);
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, key, std::forward<V>(value)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(key_type &&key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        it->second = std::forward<V>(value);
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, std::move(key), std::forward<V>(value)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const_iterator,
+        const key_type &key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(key, std::forward<V>(value)).first;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto btree_map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const_iterator,
+        key_type &&key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(std::move(key), std::forward<V>(value)).first;
+}
+
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_multimap<Key, Value, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_multimap<Key, Value, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_multimap<Key, Value, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_multimap<Key, Value, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(btree_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    btree_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const btree_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const btree_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const btree_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const btree_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const btree_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const btree_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const btree_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_multimap<Key, Value, Compare, Alloc, Destructor>::btree_multimap()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_multimap<Key, Value, Compare, Alloc, Destructor>::btree_multimap(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_multimap<Key, Value, Compare, Alloc, Destructor>::btree_multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_multimap<Key, Value, Compare, Alloc, Destructor>::btree_multimap(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_multimap<Key, Value, Compare, Alloc, Destructor>::btree_multimap(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_multimap<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto btree_multimap<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+btree_multimap<Key, Value, Compare, Alloc, Destructor>::~btree_multimap()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void btree_multimap<Key, Value, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void btree_multimap<Key, Value, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void btree_multimap<Key, Value, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key,Value>>
+>
+using btree_map = itl::btree_map<Key, Value, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using btree_multimap = itl::btree_multimap<Key, Value, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>
+>
+using btree_map = itl::btree_map<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>
+>
+using btree_multimap = itl::btree_multimap<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+}   /* pmr */
+
+#endif
+
+}   /* itl */
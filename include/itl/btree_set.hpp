@@ -0,0 +1,649 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include "allocator.hpp"
+#include "btree.hpp"
+#include "destructor.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Inheritable B-tree set.
+ *
+ *  Exports the member surface of `itl::set`, without node handles.
+ *  Values are packed into nodes of a few cache lines, so lookups
+ *  chase far fewer pointers and elements carry no per-node overhead.
+ *  Unlike `itl::set`, inserts and erases invalidate all iterators
+ *  and references.
+ */
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class btree_set: protected btree::tree<T, T, Compare, Alloc, false>,
+    protected Destructor
+{
+protected:
+    typedef btree::tree<T, T, Compare, Alloc, false> Base;
+    typedef btree_set<T, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(btree_set<K, C, A, D> &left, btree_set<K, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const btree_set<K, C, A, D> &left, const btree_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const btree_set<K, C, A, D> &left, const btree_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const btree_set<K, C, A, D> &left, const btree_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const btree_set<K, C, A, D> &left, const btree_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const btree_set<K, C, A, D> &left, const btree_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const btree_set<K, C, A, D> &left, const btree_set<K, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    btree_set();
+    btree_set(const This &other);
+    btree_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    btree_set(const This &other, const allocator_type &alloc);
+    btree_set(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~btree_set();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+/** \brief Inheritable B-tree multiset.
+ *
+ *  Exports the member surface of `itl::multiset`, without node
+ *  handles. Inserts and erases invalidate all iterators.
+ */
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class btree_multiset: protected btree::tree<T, T, Compare, Alloc, true>,
+    protected Destructor
+{
+protected:
+    typedef btree::tree<T, T, Compare, Alloc, true> Base;
+    typedef btree_multiset<T, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(btree_multiset<K, C, A, D> &left, btree_multiset<K, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const btree_multiset<K, C, A, D> &left, const btree_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const btree_multiset<K, C, A, D> &left, const btree_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const btree_multiset<K, C, A, D> &left, const btree_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const btree_multiset<K, C, A, D> &left, const btree_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const btree_multiset<K, C, A, D> &left, const btree_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const btree_multiset<K, C, A, D> &left, const btree_multiset<K, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    btree_multiset();
+    btree_multiset(const This &other);
+    btree_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    btree_multiset(const This &other, const allocator_type &alloc);
+    btree_multiset(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~btree_multiset();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_set<Key, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_set<Key, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_set<Key, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_set<Key, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(btree_set<Key, Compare, Alloc, Destructor> &left,
+    btree_set<Key, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const btree_set<Key, Compare, Alloc, Destructor> &left,
+    const btree_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const btree_set<Key, Compare, Alloc, Destructor> &left,
+    const btree_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const btree_set<Key, Compare, Alloc, Destructor> &left,
+    const btree_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const btree_set<Key, Compare, Alloc, Destructor> &left,
+    const btree_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const btree_set<Key, Compare, Alloc, Destructor> &left,
+    const btree_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const btree_set<Key, Compare, Alloc, Destructor> &left,
+    const btree_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_set<Key, Compare, Alloc, Destructor>::btree_set()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_set<Key, Compare, Alloc, Destructor>::btree_set(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_set<Key, Compare, Alloc, Destructor>::btree_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_set<Key, Compare, Alloc, Destructor>::btree_set(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_set<Key, Compare, Alloc, Destructor>::btree_set(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_set<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_set<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_set<Key, Compare, Alloc, Destructor>::~btree_set()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void btree_set<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void btree_set<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void btree_set<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_multiset<Key, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_multiset<Key, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_multiset<Key, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_multiset<Key, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(btree_multiset<Key, Compare, Alloc, Destructor> &left,
+    btree_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const btree_multiset<Key, Compare, Alloc, Destructor> &left,
+    const btree_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const btree_multiset<Key, Compare, Alloc, Destructor> &left,
+    const btree_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const btree_multiset<Key, Compare, Alloc, Destructor> &left,
+    const btree_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const btree_multiset<Key, Compare, Alloc, Destructor> &left,
+    const btree_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const btree_multiset<Key, Compare, Alloc, Destructor> &left,
+    const btree_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const btree_multiset<Key, Compare, Alloc, Destructor> &left,
+    const btree_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_multiset<Key, Compare, Alloc, Destructor>::btree_multiset()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_multiset<Key, Compare, Alloc, Destructor>::btree_multiset(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_multiset<Key, Compare, Alloc, Destructor>::btree_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_multiset<Key, Compare, Alloc, Destructor>::btree_multiset(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_multiset<Key, Compare, Alloc, Destructor>::btree_multiset(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_multiset<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto btree_multiset<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+btree_multiset<Key, Compare, Alloc, Destructor>::~btree_multiset()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void btree_multiset<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void btree_multiset<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void btree_multiset<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using btree_set = itl::btree_set<T, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using btree_multiset = itl::btree_multiset<T, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using btree_set = itl::btree_set<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using btree_multiset = itl::btree_multiset<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
+}   /* itl */
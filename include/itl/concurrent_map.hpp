@@ -0,0 +1,130 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include "destructor.hpp"
+#include "skiplist.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Ordered map that many threads read and write at once.
+ *
+ *  A lock-free skip list: `find`, `lower_bound`, `upper_bound` and
+ *  `insert` never block, and iterators stay valid while elements are
+ *  concurrently erased, since erased nodes are only freed once no
+ *  iterator or lookup can still reach them. Elements are immutable
+ *  once inserted, and iteration is weakly consistent. Iterators pin
+ *  memory, so long-lived iterators delay reclamation.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class concurrent_map: protected skiplist::list<Key, std::pair<const Key, Value>, Compare, Alloc>,
+    protected Destructor
+{
+protected:
+    typedef skiplist::list<Key, std::pair<const Key, Value>, Compare, Alloc> Base;
+    typedef concurrent_map<Key, Value, Compare, Alloc, Destructor> This;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    typedef Value mapped_type;
+    using typename Base::key_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    concurrent_map();
+    concurrent_map(const This &other) = delete;
+    This & operator=(const This &other) = delete;
+    ~concurrent_map();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::emplace;
+    using Base::erase;
+    using Base::clear;
+
+    // OBSERVERS
+    using Base::key_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+concurrent_map<Key, Value, Compare, Alloc, Destructor>::concurrent_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+concurrent_map<Key, Value, Compare, Alloc, Destructor>::~concurrent_map()
+{}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using concurrent_map = itl::concurrent_map<Key, Value, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
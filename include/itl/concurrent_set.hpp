@@ -0,0 +1,123 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include "destructor.hpp"
+#include "skiplist.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Ordered set that many threads read and write at once.
+ *
+ *  Shares the lock-free skip list of `itl::concurrent_map`, with the
+ *  same non-blocking lookups and inserts, and weakly consistent
+ *  iteration.
+ */
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class concurrent_set: protected skiplist::list<T, T, Compare, Alloc>,
+    protected Destructor
+{
+protected:
+    typedef skiplist::list<T, T, Compare, Alloc> Base;
+    typedef concurrent_set<T, Compare, Alloc, Destructor> This;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    concurrent_set();
+    concurrent_set(const This &other) = delete;
+    This & operator=(const This &other) = delete;
+    ~concurrent_set();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::emplace;
+    using Base::erase;
+    using Base::clear;
+
+    // OBSERVERS
+    using Base::key_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, typename Compare, typename Alloc, typename Destructor>
+concurrent_set<T, Compare, Alloc, Destructor>::concurrent_set()
+{}
+
+
+template <typename T, typename Compare, typename Alloc, typename Destructor>
+concurrent_set<T, Compare, Alloc, Destructor>::~concurrent_set()
+{}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using concurrent_set = itl::concurrent_set<T, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
@@ -0,0 +1,482 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "destructor.hpp"
+#include "unordered_map.hpp"
+
+#if __cplusplus >= 201402L
+#   include <shared_mutex>
+#endif
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Reader-writer lock guarding a shard.
+ *
+ *  `std::shared_mutex` from C++17, `std::shared_timed_mutex` in C++14,
+ *  otherwise readers also take the lock exclusively.
+ */
+#if __cplusplus >= 201703L
+typedef std::shared_mutex shard_mutex;
+typedef std::shared_lock<shard_mutex> shard_read_lock;
+#elif __cplusplus >= 201402L
+typedef std::shared_timed_mutex shard_mutex;
+typedef std::shared_lock<shard_mutex> shard_read_lock;
+#else
+typedef std::mutex shard_mutex;
+typedef std::unique_lock<shard_mutex> shard_read_lock;
+#endif
+
+typedef std::unique_lock<shard_mutex> shard_write_lock;
+
+
+/** \brief Hash map split across independently locked shards.
+ *
+ *  Each shard is an `itl::unordered_map` behind its own reader-writer
+ *  lock, aligned to keep shards on separate cache lines. Allocating
+ *  over-aligned types needs C++17, so before it, neighbouring shards
+ *  may still share a line at their boundary. Elements are only
+ *  reachable through callbacks run while the shard is locked, so no
+ *  iterator or reference outlives its lock. Callbacks must not call
+ *  back into the map.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class concurrent_unordered_map: protected Destructor
+{
+protected:
+    typedef concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> This;
+    typedef itl::unordered_map<Key, Value, Hash, Pred, Alloc> Map;
+
+    struct alignas(64) shard
+    {
+        mutable shard_mutex mutex;
+        Map map;
+    };
+
+    static size_t round_shards(size_t n);
+    size_t index(const Key &key) const;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef std::pair<const Key, Value> value_type;
+    typedef Value mapped_type;
+    typedef Hash hasher;
+    typedef Pred key_equal;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    explicit concurrent_unordered_map(size_type shards = 0, const hasher &hash = hasher(), const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type());
+    concurrent_unordered_map(const This &other) = delete;
+    This & operator=(const This &other) = delete;
+    ~concurrent_unordered_map();
+
+    // CAPACITY
+    bool empty() const;
+    size_type size() const;
+    size_type shard_count() const noexcept;
+
+    // LOOKUP
+    size_type count(const key_type &key) const;
+
+    template <typename Visitor>
+    bool find_and(const key_type &key, Visitor visit) const;
+
+    template <typename Visitor>
+    bool find_and_update(const key_type &key, Visitor visit);
+
+    template <typename Visitor>
+    void for_each(Visitor visit) const;
+
+    // MODIFIERS
+    bool insert(const value_type &value);
+    bool insert(value_type &&value);
+
+    template <typename... Ts>
+    bool emplace(Ts&&... ts);
+
+    template <typename Visitor>
+    bool insert_or_visit(const value_type &value, Visitor visit);
+
+    template <typename Visitor>
+    bool insert_or_visit(value_type &&value, Visitor visit);
+
+    bool insert_or_assign(const key_type &key, const mapped_type &value);
+    size_type erase(const key_type &key);
+
+    template <typename Predicate>
+    bool erase_if(const key_type &key, Predicate predicate);
+
+    template <typename Predicate>
+    size_type erase_if(Predicate predicate);
+
+    void clear();
+
+    // HASH POLICY
+    void reserve(size_type n);
+
+    // OBSERVERS
+    hasher hash_function() const;
+    key_equal key_eq() const;
+
+private:
+    std::vector<shard> shards_;
+    size_t mask_;
+    hasher hash_;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+size_t concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::round_shards(size_t n)
+{
+    if (n == 0) {
+        n = 4 * std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    size_t count = 1;
+    while (count < n) {
+        count *= 2;
+    }
+    return count;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+size_t concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::index(const Key &key) const
+{
+    // the inner map buckets by the low bits, so shard by the high bits
+    uint64_t hash = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash >> 32) & mask_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::concurrent_unordered_map(size_type shards,
+        const hasher &hash,
+        const key_equal &equal,
+        const allocator_type &alloc):
+    shards_(round_shards(shards)),
+    mask_(shards_.size() - 1),
+    hash_(hash)
+{
+    for (shard &s: shards_) {
+        s.map = Map(0, hash, equal, alloc);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::~concurrent_unordered_map()
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::empty() const
+{
+    for (const shard &s: shards_) {
+        shard_read_lock lock(s.mutex);
+        if (!s.map.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+/** \brief Sum of the shard sizes, which may be stale under concurrent writes.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::size() const
+    -> size_type
+{
+    size_type size = 0;
+    for (const shard &s: shards_) {
+        shard_read_lock lock(s.mutex);
+        size += s.map.size();
+    }
+    return size;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::shard_count() const noexcept
+    -> size_type
+{
+    return shards_.size();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::count(const key_type &key) const
+    -> size_type
+{
+    const shard &s = shards_[index(key)];
+    shard_read_lock lock(s.mutex);
+    return s.map.count(key);
+}
+
+
+/** \brief Call `visit(const value_type&)` on the element under a shared lock.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Visitor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_and(const key_type &key,
+    Visitor visit) const
+{
+    const shard &s = shards_[index(key)];
+    shard_read_lock lock(s.mutex);
+    auto it = s.map.find(key);
+    if (it == s.map.end()) {
+        return false;
+    }
+    visit(*it);
+    return true;
+}
+
+
+/** \brief Call `visit(value_type&)` on the element under an exclusive lock.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Visitor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_and_update(const key_type &key,
+    Visitor visit)
+{
+    shard &s = shards_[index(key)];
+    shard_write_lock lock(s.mutex);
+    auto it = s.map.find(key);
+    if (it == s.map.end()) {
+        return false;
+    }
+    visit(*it);
+    return true;
+}
+
+
+/** \brief Visit every element, locking one shard at a time.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Visitor>
+void concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::for_each(Visitor visit) const
+{
+    for (const shard &s: shards_) {
+        shard_read_lock lock(s.mutex);
+        for (const auto &value: s.map) {
+            visit(value);
+        }
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(const value_type &value)
+{
+    shard &s = shards_[index(value.first)];
+    shard_write_lock lock(s.mutex);
+    return s.map.insert(value).second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(value_type &&value)
+{
+    shard &s = shards_[index(value.first)];
+    shard_write_lock lock(s.mutex);
+    return s.map.insert(std::move(value)).second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace(Ts&&... ts)
+{
+    return insert(value_type(std::forward<Ts>(ts)...));
+}
+
+
+/** \brief Insert `value`, or call `visit(value_type&)` on the existing element.
+ *
+ *  Returns if the value was inserted.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Visitor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert_or_visit(const value_type &value,
+    Visitor visit)
+{
+    shard &s = shards_[index(value.first)];
+    shard_write_lock lock(s.mutex);
+    auto result = s.map.insert(value);
+    if (!result.second) {
+        visit(*result.first);
+    }
+    return result.second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Visitor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert_or_visit(value_type &&value,
+    Visitor visit)
+{
+    shard &s = shards_[index(value.first)];
+    shard_write_lock lock(s.mutex);
+    auto it = s.map.find(value.first);
+    if (it != s.map.end()) {
+        visit(*it);
+        return false;
+    }
+    s.map.insert(std::move(value));
+    return true;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert_or_assign(const key_type &key,
+    const mapped_type &value)
+{
+    shard &s = shards_[index(key)];
+    shard_write_lock lock(s.mutex);
+    auto result = s.map.insert(value_type(key, value));
+    if (!result.second) {
+        result.first->second = value;
+    }
+    return result.second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase(const key_type &key)
+    -> size_type
+{
+    shard &s = shards_[index(key)];
+    shard_write_lock lock(s.mutex);
+    return s.map.erase(key);
+}
+
+
+/** \brief Erase the element at `key` if `predicate(const value_type&)` holds.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Predicate>
+bool concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase_if(const key_type &key,
+    Predicate predicate)
+{
+    shard &s = shards_[index(key)];
+    shard_write_lock lock(s.mutex);
+    auto it = s.map.find(key);
+    if (it == s.map.end() || !predicate(static_cast<const value_type&>(*it))) {
+        return false;
+    }
+    s.map.erase(it);
+    return true;
+}
+
+
+/** \brief Erase every element satisfying `predicate(const value_type&)`.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Predicate>
+auto concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase_if(Predicate predicate)
+    -> size_type
+{
+    size_type erased = 0;
+    for (shard &s: shards_) {
+        shard_write_lock lock(s.mutex);
+        for (auto it = s.map.begin(); it != s.map.end();) {
+            if (predicate(static_cast<const value_type&>(*it))) {
+                it = s.map.erase(it);
+                ++erased;
+            } else {
+                ++it;
+            }
+        }
+    }
+    return erased;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::clear()
+{
+    for (shard &s: shards_) {
+        shard_write_lock lock(s.mutex);
+        s.map.clear();
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::reserve(size_type n)
+{
+    size_type per_shard = (n + shards_.size() - 1) / shards_.size();
+    for (shard &s: shards_) {
+        shard_write_lock lock(s.mutex);
+        s.map.reserve(per_shard);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::hash_function() const
+    -> hasher
+{
+    return hash_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::key_eq() const
+    -> key_equal
+{
+    return shards_.front().map.key_eq();
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using concurrent_unordered_map = itl::concurrent_unordered_map<Key, Value, Hash, Pred, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
@@ -9,6 +9,9 @@
 #pragma once
 
 #include <deque>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
 
 
 namespace itl
@@ -21,13 +24,15 @@ namespace itl
  */
 template <
     typename T,
-    typename Alloc = std::allocator<T>
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
 >
-class deque: protected std::deque<T, Alloc>
+class deque: protected std::deque<T, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::deque<T, Alloc> Base;
-    typedef deque<T, Alloc> This;
+    typedef deque<T, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -36,27 +41,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename V, typename A>
-    friend void swap(deque<V, A> &left, deque<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend void swap(deque<V, A, D> &left, deque<V, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename V, typename A>
-    friend bool operator==(const deque<V, A> &left, const deque<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator==(const deque<V, A, D> &left, const deque<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator!=(const deque<V, A> &left, const deque<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator!=(const deque<V, A, D> &left, const deque<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>(const deque<V, A> &left, const deque<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>(const deque<V, A, D> &left, const deque<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>=(const deque<V, A> &left, const deque<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>=(const deque<V, A, D> &left, const deque<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<(const deque<V, A> &left, const deque<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<(const deque<V, A, D> &left, const deque<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<=(const deque<V, A> &left, const deque<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<=(const deque<V, A, D> &left, const deque<V, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -77,7 +82,14 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~deque();
+    deque();
+    deque(const This &other);
+    deque(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    deque(const This &other, const allocator_type &alloc);
+    deque(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~deque();
 
     // ITERATORS
     using Base::begin;
@@ -125,103 +137,183 @@ public:
 // --------------
 
 
-template <typename T, typename Alloc>
-auto deque<T, Alloc>::ref() const
+template <typename T, typename Alloc, typename Destructor>
+auto deque<T, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto deque<T, Alloc>::ref()
+template <typename T, typename Alloc, typename Destructor>
+auto deque<T, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto deque<T, Alloc>::forward() const
+template <typename T, typename Alloc, typename Destructor>
+auto deque<T, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto deque<T, Alloc>::forward()
+template <typename T, typename Alloc, typename Destructor>
+auto deque<T, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-void swap(deque<T, Alloc> &left,
-    deque<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+void swap(deque<T, Alloc, Destructor> &left,
+    deque<T, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename T, typename Alloc>
-bool operator==(const deque<T, Alloc> &left,
-    const deque<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator==(const deque<T, Alloc, Destructor> &left,
+    const deque<T, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator!=(const deque<T, Alloc> &left,
-    const deque<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator!=(const deque<T, Alloc, Destructor> &left,
+    const deque<T, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>(const deque<T, Alloc> &left,
-    const deque<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>(const deque<T, Alloc, Destructor> &left,
+    const deque<T, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>=(const deque<T, Alloc> &left,
-    const deque<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>=(const deque<T, Alloc, Destructor> &left,
+    const deque<T, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<(const deque<T, Alloc> &left,
-    const deque<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<(const deque<T, Alloc, Destructor> &left,
+    const deque<T, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<=(const deque<T, Alloc> &left,
-    const deque<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<=(const deque<T, Alloc, Destructor> &left,
+    const deque<T, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-deque<T, Alloc>::~deque()
+template <typename T, typename Alloc, typename Destructor>
+deque<T, Alloc, Destructor>::deque()
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+deque<T, Alloc, Destructor>::deque(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+deque<T, Alloc, Destructor>::deque(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+deque<T, Alloc, Destructor>::deque(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+deque<T, Alloc, Destructor>::deque(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto deque<T, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto deque<T, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+deque<T, Alloc, Destructor>::~deque()
 {}
 
 
-template <typename T, typename Alloc>
-void deque<T, Alloc>::swap(This &other)
+template <typename T, typename Alloc, typename Destructor>
+void deque<T, Alloc, Destructor>::swap(This &other)
 {
-    ref().swap(other.ref());
+    allocator_aware_swap(ref(), other.ref());
 }
 
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Alloc = std::allocator<T>
+>
+using deque = itl::deque<T, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <typename T>
+using deque = itl::deque<T, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
@@ -0,0 +1,62 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Destructor policy making the wrapper polymorphic.
+ *
+ *  The default policy: adds a vtable pointer so derived objects
+ *  may be safely deleted through a pointer to the wrapper.
+ */
+struct virtual_destructor
+{
+    virtual ~virtual_destructor();
+};
+
+
+/** \brief Destructor policy without a vtable.
+ *
+ *  The wrapper has the same size as the STL container and a
+ *  non-virtual destructor. Since deleting a derived object through
+ *  a pointer to the wrapper would be undefined behavior, `new` and
+ *  `delete` expressions on the wrapper are ill-formed: store it by
+ *  value, or in another container.
+ *
+ *  Class-scope operators are inherited, so this also applies to
+ *  classes derived from the wrapper. A derived class that needs the
+ *  heap declares its own `operator new` and `operator delete`, which
+ *  hide these: deleting it through a pointer to the wrapper still
+ *  fails to compile. Allocators use the global operators, so none of
+ *  this affects `std::make_shared` or containers of wrappers.
+ */
+struct static_destructor
+{
+    static void * operator new(std::size_t size) = delete;
+    static void * operator new[](std::size_t size) = delete;
+    static void operator delete(void *ptr) = delete;
+    static void operator delete[](void *ptr) = delete;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline virtual_destructor::~virtual_destructor()
+{}
+
+}   /* itl */
@@ -0,0 +1,2614 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "destructor.hpp"
+#include "vector.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Tag for input sorted by key, without equivalent keys.
+ */
+struct sorted_unique_t
+{};
+
+
+/** \brief Tag for input sorted by key, possibly with equivalent keys.
+ */
+struct sorted_equivalent_t
+{};
+
+
+constexpr sorted_unique_t sorted_unique {};
+constexpr sorted_equivalent_t sorted_equivalent {};
+
+
+namespace flat
+{
+
+/** \brief First of the `n` keys at `first` not less than `key`.
+ *
+ *  Each step halves the range with a conditional move rather than a
+ *  branch, so lookups never mispredict, and the loop runs exactly
+ *  `log2(n)` times for any key.
+ */
+template <typename T, typename K, typename Compare>
+const T * lower_bound(const T *first, size_t n, const K &key, const Compare &comp);
+
+
+/** \brief First of the `n` keys at `first` greater than `key`.
+ */
+template <typename T, typename K, typename Compare>
+const T * upper_bound(const T *first, size_t n, const K &key, const Compare &comp);
+
+
+/** \brief Random-access iterator over parallel key and value arrays.
+ *
+ *  Dereferencing yields a pair of references, like `std::flat_map`,
+ *  since keys and values are not stored together.
+ */
+template <typename Key, typename T>
+class iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef std::pair<Key, typename std::remove_const<T>::type> value_type;
+    typedef ptrdiff_t difference_type;
+    typedef std::pair<const Key &, T &> reference;
+
+    class pointer
+    {
+    public:
+        explicit pointer(reference ref);
+        reference * operator->();
+
+    private:
+        reference ref_;
+    };
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    iterator() noexcept;
+    iterator(const Key *key, T *value) noexcept;
+
+    template <
+        typename U,
+        typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type
+    >
+    iterator(const iterator<Key, U> &other) noexcept;
+
+    reference operator*() const;
+    pointer operator->() const;
+    reference operator[](difference_type n) const;
+    iterator & operator++();
+    iterator operator++(int);
+    iterator & operator--();
+    iterator operator--(int);
+    iterator & operator+=(difference_type n);
+    iterator & operator-=(difference_type n);
+    iterator operator+(difference_type n) const;
+    iterator operator-(difference_type n) const;
+
+    template <typename U>
+    difference_type operator-(const iterator<Key, U> &other) const noexcept;
+
+    template <typename U>
+    bool operator==(const iterator<Key, U> &other) const noexcept;
+
+    template <typename U>
+    bool operator!=(const iterator<Key, U> &other) const noexcept;
+
+    template <typename U>
+    bool operator<(const iterator<Key, U> &other) const noexcept;
+
+    template <typename U>
+    bool operator<=(const iterator<Key, U> &other) const noexcept;
+
+    template <typename U>
+    bool operator>(const iterator<Key, U> &other) const noexcept;
+
+    template <typename U>
+    bool operator>=(const iterator<Key, U> &other) const noexcept;
+
+    const Key * key() const noexcept;
+    T * value() const noexcept;
+
+private:
+    const Key *key_;
+    T *value_;
+};
+
+
+template <typename Key, typename T>
+iterator<Key, T> operator+(typename iterator<Key, T>::difference_type n, const iterator<Key, T> &it);
+
+
+/** \brief Sorted array of keys, shared by the flat set containers.
+ *
+ *  Keys are stored contiguously in an `itl::vector`, so lookups are a
+ *  binary search over a single array, and iteration is a linear scan.
+ *  Inserts and erases shift the following keys, and invalidate all
+ *  iterators: build the set in bulk, then read it.
+ */
+template <
+    typename Key,
+    typename Compare,
+    typename Alloc,
+    bool Multi
+>
+class set_table
+{
+protected:
+    typedef set_table<Key, Compare, Alloc, Multi> This;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Key> KeyAlloc;
+    typedef itl::vector<Key, KeyAlloc, static_destructor> KeyContainer;
+    typedef typename std::conditional<Multi, sorted_equivalent_t, sorted_unique_t>::type sorted_type;
+
+    template <typename K>
+    size_t lower_index(const K &key) const;
+    template <typename K>
+    size_t upper_index(const K &key) const;
+    bool hint_fits(size_t i, const Key &key) const;
+    std::pair<size_t, bool> insert_position(const Key &key) const;
+    void merge_tail(size_t n, bool sorted);
+
+    typedef typename KeyContainer::const_iterator Iterator;
+    static Iterator result(std::pair<Iterator, bool> inserted, std::true_type);
+    static std::pair<Iterator, bool> result(std::pair<Iterator, bool> inserted, std::false_type);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef Key value_type;
+    typedef Compare key_compare;
+    typedef Compare value_compare;
+    typedef Alloc allocator_type;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef typename KeyContainer::pointer pointer;
+    typedef typename KeyContainer::const_pointer const_pointer;
+    typedef typename KeyContainer::const_iterator iterator;
+    typedef typename KeyContainer::const_iterator const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef typename std::conditional<Multi, iterator, std::pair<iterator, bool>>::type insert_result;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    set_table();
+    explicit set_table(const key_compare &comp, const allocator_type &alloc = allocator_type());
+    explicit set_table(const allocator_type &alloc);
+
+    template <typename Iter>
+    set_table(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    template <typename Iter>
+    set_table(Iter first, Iter last, const allocator_type &alloc);
+
+    template <typename Iter>
+    set_table(sorted_type, Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    set_table(std::initializer_list<value_type> list, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    set_table(std::initializer_list<value_type> list, const allocator_type &alloc);
+    set_table(sorted_type, std::initializer_list<value_type> list, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    set_table(const This &other);
+    set_table(const This &other, const allocator_type &alloc);
+    set_table(This &&other) noexcept;
+    set_table(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept;
+    This & operator=(std::initializer_list<value_type> list);
+    ~set_table();
+
+    // ITERATORS
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+    reverse_iterator rbegin() const noexcept;
+    reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void reserve(size_type n);
+    void shrink_to_fit();
+
+    // MODIFIERS
+    insert_result insert(const value_type &value);
+    insert_result insert(value_type &&value);
+    iterator insert(const_iterator hint, const value_type &value);
+    iterator insert(const_iterator hint, value_type &&value);
+
+    template <typename Iter>
+    void insert(Iter first, Iter last);
+
+    template <typename Iter>
+    void insert(sorted_type, Iter first, Iter last);
+
+    void insert(std::initializer_list<value_type> list);
+    void insert(sorted_type, std::initializer_list<value_type> list);
+
+    template <typename... Ts>
+    insert_result emplace(Ts&&... ts);
+
+    template <typename... Ts>
+    iterator emplace_hint(const_iterator hint, Ts&&... ts);
+
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type &key);
+    void clear() noexcept;
+    void swap(This &other);
+    void merge(This &other);
+
+    // OBSERVERS
+    key_compare key_comp() const;
+    value_compare value_comp() const;
+
+    // OPERATIONS
+    iterator find(const key_type &key) const;
+    size_type count(const key_type &key) const;
+    iterator lower_bound(const key_type &key) const;
+    iterator upper_bound(const key_type &key) const;
+    std::pair<iterator, iterator> equal_range(const key_type &key) const;
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key) const;
+
+    // ALLOCATOR
+    allocator_type get_allocator() const;
+
+private:
+    KeyContainer keys_;
+    key_compare comp_;
+
+    template <typename K, typename C, typename A, bool M>
+    friend bool operator==(const set_table<K, C, A, M> &left, const set_table<K, C, A, M> &right);
+
+    template <typename K, typename C, typename A, bool M>
+    friend bool operator<(const set_table<K, C, A, M> &left, const set_table<K, C, A, M> &right);
+};
+
+
+/** \brief Sorted parallel arrays of keys and values, shared by the flat
+ *  map containers.
+ *
+ *  Keys and values are stored in separate `itl::vector`s, so lookups
+ *  binary search a dense array of keys, touching no values until the
+ *  key is found. Inserts and erases shift the following elements, and
+ *  invalidate all iterators: build the map in bulk, then read it.
+ */
+template <
+    typename Key,
+    typename T,
+    typename Compare,
+    typename Alloc,
+    bool Multi
+>
+class map_table
+{
+protected:
+    typedef map_table<Key, T, Compare, Alloc, Multi> This;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<Key> KeyAlloc;
+    typedef typename AllocTraits::template rebind_alloc<T> ValueAlloc;
+    typedef itl::vector<Key, KeyAlloc, static_destructor> KeyContainer;
+    typedef itl::vector<T, ValueAlloc, static_destructor> ValueContainer;
+    typedef typename std::conditional<Multi, sorted_equivalent_t, sorted_unique_t>::type sorted_type;
+
+    template <typename K>
+    size_t lower_index(const K &key) const;
+    template <typename K>
+    size_t upper_index(const K &key) const;
+    bool hint_fits(size_t i, const Key &key) const;
+    std::pair<size_t, bool> insert_position(const Key &key) const;
+    size_t index(flat::iterator<Key, const T> position) const noexcept;
+    auto make_iterator(size_t i) noexcept -> flat::iterator<Key, T>;
+    auto make_iterator(size_t i) const noexcept -> flat::iterator<Key, const T>;
+
+    template <typename K, typename... Ts>
+    auto emplace_at(size_t i, K &&key, Ts&&... ts) -> flat::iterator<Key, T>;
+
+    template <typename Iter>
+    void insert_range(Iter first, Iter last, bool sorted);
+
+    static auto result(std::pair<flat::iterator<Key, T>, bool> inserted, std::true_type)
+        -> flat::iterator<Key, T>;
+    static auto result(std::pair<flat::iterator<Key, T>, bool> inserted, std::false_type)
+        -> std::pair<flat::iterator<Key, T>, bool>;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef std::pair<Key, T> value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef std::pair<const Key &, T &> reference;
+    typedef std::pair<const Key &, const T &> const_reference;
+    typedef flat::iterator<Key, T> iterator;
+    typedef flat::iterator<Key, const T> const_iterator;
+    typedef typename iterator::pointer pointer;
+    typedef typename const_iterator::pointer const_pointer;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef typename std::conditional<Multi, iterator, std::pair<iterator, bool>>::type insert_result;
+
+    class value_compare
+    {
+    public:
+        bool operator()(const_reference left, const_reference right) const;
+
+    protected:
+        friend class map_table;
+        value_compare(key_compare comp);
+
+        key_compare comp;
+    };
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    map_table();
+    explicit map_table(const key_compare &comp, const allocator_type &alloc = allocator_type());
+    explicit map_table(const allocator_type &alloc);
+
+    template <typename Iter>
+    map_table(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    template <typename Iter>
+    map_table(Iter first, Iter last, const allocator_type &alloc);
+
+    template <typename Iter>
+    map_table(sorted_type, Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    map_table(std::initializer_list<value_type> list, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    map_table(std::initializer_list<value_type> list, const allocator_type &alloc);
+    map_table(sorted_type, std::initializer_list<value_type> list, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    map_table(const This &other);
+    map_table(const This &other, const allocator_type &alloc);
+    map_table(This &&other) noexcept;
+    map_table(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept;
+    This & operator=(std::initializer_list<value_type> list);
+    ~map_table();
+
+    // ITERATORS
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void reserve(size_type n);
+    void shrink_to_fit();
+
+    // ELEMENT ACCESS
+    mapped_type & operator[](const key_type &key);
+    mapped_type & operator[](key_type &&key);
+    mapped_type & at(const key_type &key);
+    const mapped_type & at(const key_type &key) const;
+    const KeyContainer & keys() const noexcept;
+    const ValueContainer & values() const noexcept;
+
+    // MODIFIERS
+    insert_result insert(const value_type &value);
+    insert_result insert(value_type &&value);
+    iterator insert(const_iterator hint, const value_type &value);
+    iterator insert(const_iterator hint, value_type &&value);
+
+    template <typename Iter>
+    void insert(Iter first, Iter last);
+
+    template <typename Iter>
+    void insert(sorted_type, Iter first, Iter last);
+
+    void insert(std::initializer_list<value_type> list);
+    void insert(sorted_type, std::initializer_list<value_type> list);
+
+    template <typename... Ts>
+    insert_result emplace(Ts&&... ts);
+
+    template <typename... Ts>
+    iterator emplace_hint(const_iterator hint, Ts&&... ts);
+
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Ts&&... ts);
+
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Ts&&... ts);
+
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, const key_type &key, Ts&&... ts);
+
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, key_type &&key, Ts&&... ts);
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, V &&value);
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(key_type &&key, V &&value);
+
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, const key_type &key, V &&value);
+
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, key_type &&key, V &&value);
+
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type &key);
+    void clear() noexcept;
+    void swap(This &other);
+    void merge(This &other);
+
+    // OBSERVERS
+    key_compare key_comp() const;
+    value_compare value_comp() const;
+
+    // OPERATIONS
+    iterator find(const key_type &key);
+    const_iterator find(const key_type &key) const;
+    size_type count(const key_type &key) const;
+    iterator lower_bound(const key_type &key);
+    const_iterator lower_bound(const key_type &key) const;
+    iterator upper_bound(const key_type &key);
+    const_iterator upper_bound(const key_type &key) const;
+    std::pair<iterator, iterator> equal_range(const key_type &key);
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const;
+
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+
+    // ALLOCATOR
+    allocator_type get_allocator() const;
+
+private:
+    KeyContainer keys_;
+    ValueContainer values_;
+    key_compare comp_;
+
+    template <typename K, typename V, typename C, typename A, bool M>
+    friend bool operator==(const map_table<K, V, C, A, M> &left, const map_table<K, V, C, A, M> &right);
+};
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator==(const set_table<Key, Compare, Alloc, Multi> &left, const set_table<Key, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator!=(const set_table<Key, Compare, Alloc, Multi> &left, const set_table<Key, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator<(const set_table<Key, Compare, Alloc, Multi> &left, const set_table<Key, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator<=(const set_table<Key, Compare, Alloc, Multi> &left, const set_table<Key, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator>(const set_table<Key, Compare, Alloc, Multi> &left, const set_table<Key, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator>=(const set_table<Key, Compare, Alloc, Multi> &left, const set_table<Key, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator==(const map_table<Key, T, Compare, Alloc, Multi> &left, const map_table<Key, T, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator!=(const map_table<Key, T, Compare, Alloc, Multi> &left, const map_table<Key, T, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator<(const map_table<Key, T, Compare, Alloc, Multi> &left, const map_table<Key, T, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator<=(const map_table<Key, T, Compare, Alloc, Multi> &left, const map_table<Key, T, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator>(const map_table<Key, T, Compare, Alloc, Multi> &left, const map_table<Key, T, Compare, Alloc, Multi> &right);
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator>=(const map_table<Key, T, Compare, Alloc, Multi> &left, const map_table<Key, T, Compare, Alloc, Multi> &right);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, typename K, typename Compare>
+const T * lower_bound(const T *first,
+    size_t n,
+    const K &key,
+    const Compare &comp)
+{
+    if (n == 0) {
+        return first;
+    }
+    while (n > 1) {
+        size_t half = n / 2;
+        first = comp(first[half], key) ? first + half : first;
+        n -= half;
+    }
+    return first + comp(*first, key);
+}
+
+
+template <typename T, typename K, typename Compare>
+const T * upper_bound(const T *first,
+    size_t n,
+    const K &key,
+    const Compare &comp)
+{
+    if (n == 0) {
+        return first;
+    }
+    while (n > 1) {
+        size_t half = n / 2;
+        first = comp(key, first[half]) ? first : first + half;
+        n -= half;
+    }
+    return first + !comp(key, *first);
+}
+
+
+template <typename Key, typename T>
+iterator<Key, T>::pointer::pointer(reference ref):
+    ref_(ref)
+{}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::pointer::operator->()
+    -> reference *
+{
+    return &ref_;
+}
+
+
+template <typename Key, typename T>
+iterator<Key, T>::iterator() noexcept:
+    key_(nullptr),
+    value_(nullptr)
+{}
+
+
+template <typename Key, typename T>
+iterator<Key, T>::iterator(const Key *key,
+        T *value) noexcept:
+    key_(key),
+    value_(value)
+{}
+
+
+template <typename Key, typename T>
+template <typename U, typename>
+iterator<Key, T>::iterator(const iterator<Key, U> &other) noexcept:
+    key_(other.key()),
+    value_(other.value())
+{}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator*() const
+    -> reference
+{
+    return reference(*key_, *value_);
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator->() const
+    -> pointer
+{
+    return pointer(**this);
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator[](difference_type n) const
+    -> reference
+{
+    return reference(key_[n], value_[n]);
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator++()
+    -> iterator &
+{
+    ++key_;
+    ++value_;
+    return *this;
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator++(int)
+    -> iterator
+{
+    iterator copy(*this);
+    ++*this;
+    return copy;
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator--()
+    -> iterator &
+{
+    --key_;
+    --value_;
+    return *this;
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator--(int)
+    -> iterator
+{
+    iterator copy(*this);
+    --*this;
+    return copy;
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator+=(difference_type n)
+    -> iterator &
+{
+    key_ += n;
+    value_ += n;
+    return *this;
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator-=(difference_type n)
+    -> iterator &
+{
+    key_ -= n;
+    value_ -= n;
+    return *this;
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator+(difference_type n) const
+    -> iterator
+{
+    return iterator(key_ + n, value_ + n);
+}
+
+
+template <typename Key, typename T>
+auto iterator<Key, T>::operator-(difference_type n) const
+    -> iterator
+{
+    return iterator(key_ - n, value_ - n);
+}
+
+
+template <typename Key, typename T>
+template <typename U>
+auto iterator<Key, T>::operator-(const iterator<Key, U> &other) const noexcept
+    -> difference_type
+{
+    return key_ - other.key();
+}
+
+
+template <typename Key, typename T>
+template <typename U>
+bool iterator<Key, T>::operator==(const iterator<Key, U> &other) const noexcept
+{
+    return key_ == other.key();
+}
+
+
+template <typename Key, typename T>
+template <typename U>
+bool iterator<Key, T>::operator!=(const iterator<Key, U> &other) const noexcept
+{
+    return key_ != other.key();
+}
+
+
+template <typename Key, typename T>
+template <typename U>
+bool iterator<Key, T>::operator<(const iterator<Key, U> &other) const noexcept
+{
+    return key_ < other.key();
+}
+
+
+template <typename Key, typename T>
+template <typename U>
+bool iterator<Key, T>::operator<=(const iterator<Key, U> &other) const noexcept
+{
+    return key_ <= other.key();
+}
+
+
+template <typename Key, typename T>
+template <typename U>
+bool iterator<Key, T>::operator>(const iterator<Key, U> &other) const noexcept
+{
+    return key_ > other.key();
+}
+
+
+template <typename Key, typename T>
+template <typename U>
+bool iterator<Key, T>::operator>=(const iterator<Key, U> &other) const noexcept
+{
+    return key_ >= other.key();
+}
+
+
+template <typename Key, typename T>
+const Key * iterator<Key, T>::key() const noexcept
+{
+    return key_;
+}
+
+
+template <typename Key, typename T>
+T * iterator<Key, T>::value() const noexcept
+{
+    return value_;
+}
+
+
+template <typename Key, typename T>
+iterator<Key, T> operator+(typename iterator<Key, T>::difference_type n,
+    const iterator<Key, T> &it)
+{
+    return it + n;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename K>
+size_t set_table<Key, Compare, Alloc, Multi>::lower_index(const K &key) const
+{
+    return flat::lower_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename K>
+size_t set_table<Key, Compare, Alloc, Multi>::upper_index(const K &key) const
+{
+    return flat::upper_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data();
+}
+
+
+/** \brief Whether inserting `key` before index `i` keeps the keys sorted.
+ */
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool set_table<Key, Compare, Alloc, Multi>::hint_fits(size_t i,
+    const Key &key) const
+{
+    if (Multi) {
+        return (i == 0 || !comp_(key, keys_[i - 1])) && (i == keys_.size() || !comp_(keys_[i], key));
+    }
+    return (i == 0 || comp_(keys_[i - 1], key)) && (i == keys_.size() || comp_(key, keys_[i]));
+}
+
+
+/** \brief Index to insert `key` at, and whether it is absent.
+ *
+ *  Equivalent keys are inserted after those already present.
+ */
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::insert_position(const Key &key) const
+    -> std::pair<size_t, bool>
+{
+    if (Multi) {
+        return std::make_pair(upper_index(key), true);
+    }
+    size_t i = lower_index(key);
+    return std::make_pair(i, i == keys_.size() || comp_(key, keys_[i]));
+}
+
+
+/** \brief Merge the keys appended after index `n` into place.
+ *
+ *  Merging is stable, so of equivalent keys, those already present
+ *  come first, and are the ones kept by unique sets.
+ */
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::merge_tail(size_t n,
+    bool sorted)
+{
+    auto middle = keys_.begin() + n;
+    if (sorted) {
+        assert(std::is_sorted(middle, keys_.end(), comp_) && "itl::flat: unsorted input");
+    } else if (!std::is_sorted(middle, keys_.end(), comp_)) {
+        std::stable_sort(middle, keys_.end(), comp_);
+    }
+    if (n != 0 && middle != keys_.end() && comp_(*middle, *(middle - 1))) {
+        std::inplace_merge(keys_.begin(), middle, keys_.end(), comp_);
+    }
+    if (!Multi) {
+        auto &comp = comp_;
+        auto last = std::unique(keys_.begin(), keys_.end(), [&comp](const Key &left, const Key &right) {
+            return !comp(left, right);
+        });
+        keys_.erase(last, keys_.end());
+    }
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::result(std::pair<Iterator, bool> inserted,
+        std::true_type)
+    -> Iterator
+{
+    return inserted.first;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::result(std::pair<Iterator, bool> inserted,
+        std::false_type)
+    -> std::pair<Iterator, bool>
+{
+    return inserted;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table():
+    set_table(key_compare())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(const key_compare &comp,
+        const allocator_type &alloc):
+    keys_(KeyAlloc(alloc)),
+    comp_(comp)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(const allocator_type &alloc):
+    set_table(key_compare(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+set_table<Key, Compare, Alloc, Multi>::set_table(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    set_table(comp, alloc)
+{
+    insert(first, last);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+set_table<Key, Compare, Alloc, Multi>::set_table(Iter first,
+        Iter last,
+        const allocator_type &alloc):
+    set_table(first, last, key_compare(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+set_table<Key, Compare, Alloc, Multi>::set_table(sorted_type tag,
+        Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    set_table(comp, alloc)
+{
+    insert(tag, first, last);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(std::initializer_list<value_type> list,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    set_table(list.begin(), list.end(), comp, alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(std::initializer_list<value_type> list,
+        const allocator_type &alloc):
+    set_table(list.begin(), list.end(), key_compare(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(sorted_type tag,
+        std::initializer_list<value_type> list,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    set_table(tag, list.begin(), list.end(), comp, alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(const This &other):
+    keys_(other.keys_),
+    comp_(other.comp_)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(const This &other,
+        const allocator_type &alloc):
+    keys_(other.keys_, KeyAlloc(alloc)),
+    comp_(other.comp_)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(This &&other) noexcept:
+    keys_(std::move(other.keys_)),
+    comp_(std::move(other.comp_))
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::set_table(This &&other,
+        const allocator_type &alloc):
+    keys_(std::move(other.keys_), KeyAlloc(alloc)),
+    comp_(other.comp_)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::operator=(const This &other)
+    -> This &
+{
+    keys_ = other.keys_;
+    comp_ = other.comp_;
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::operator=(This &&other) noexcept
+    -> This &
+{
+    keys_ = std::move(other.keys_);
+    comp_ = std::move(other.comp_);
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::operator=(std::initializer_list<value_type> list)
+    -> This &
+{
+    clear();
+    insert(list);
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+set_table<Key, Compare, Alloc, Multi>::~set_table()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::begin() const noexcept
+    -> iterator
+{
+    return keys_.begin();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::end() const noexcept
+    -> iterator
+{
+    return keys_.end();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::rbegin() const noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(end());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::rend() const noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(begin());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::crbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return rbegin();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::crend() const noexcept
+    -> const_reverse_iterator
+{
+    return rend();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool set_table<Key, Compare, Alloc, Multi>::empty() const noexcept
+{
+    return keys_.empty();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::size() const noexcept
+    -> size_type
+{
+    return keys_.size();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::max_size() const noexcept
+    -> size_type
+{
+    return keys_.max_size();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::reserve(size_type n)
+{
+    keys_.reserve(n);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::shrink_to_fit()
+{
+    keys_.shrink_to_fit();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::insert(const value_type &value)
+    -> insert_result
+{
+    return emplace(value);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::insert(value_type &&value)
+    -> insert_result
+{
+    return emplace(std::move(value));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::insert(const_iterator hint,
+        const value_type &value)
+    -> iterator
+{
+    return emplace_hint(hint, value);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::insert(const_iterator hint,
+        value_type &&value)
+    -> iterator
+{
+    return emplace_hint(hint, std::move(value));
+}
+
+
+/** \brief Insert a range of keys in any order.
+ *
+ *  The keys are appended, sorted and merged into place, so inserting
+ *  `m` keys costs `O(m log m + n)`, rather than `O(m n)` one by one.
+ */
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+void set_table<Key, Compare, Alloc, Multi>::insert(Iter first,
+    Iter last)
+{
+    size_t n = keys_.size();
+    keys_.insert(keys_.end(), first, last);
+    merge_tail(n, false);
+}
+
+
+/** \brief Insert a range of keys already sorted by `key_comp()`.
+ *
+ *  The keys are appended and merged into place in linear time. Debug
+ *  builds assert that the input is sorted.
+ */
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+void set_table<Key, Compare, Alloc, Multi>::insert(sorted_type,
+    Iter first,
+    Iter last)
+{
+    size_t n = keys_.size();
+    keys_.insert(keys_.end(), first, last);
+    merge_tail(n, true);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::insert(std::initializer_list<value_type> list)
+{
+    insert(list.begin(), list.end());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::insert(sorted_type tag,
+    std::initializer_list<value_type> list)
+{
+    insert(tag, list.begin(), list.end());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto set_table<Key, Compare, Alloc, Multi>::emplace(Ts&&... ts)
+    -> insert_result
+{
+    value_type value(std::forward<Ts>(ts)...);
+    std::pair<size_t, bool> position = insert_position(value);
+    if (position.second) {
+        keys_.insert(keys_.begin() + position.first, std::move(value));
+    }
+    std::pair<iterator, bool> inserted(keys_.begin() + position.first, position.second);
+    return result(inserted, std::integral_constant<bool, Multi>());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto set_table<Key, Compare, Alloc, Multi>::emplace_hint(const_iterator hint,
+        Ts&&... ts)
+    -> iterator
+{
+    value_type value(std::forward<Ts>(ts)...);
+    size_t i = hint - keys_.begin();
+    if (!hint_fits(i, value)) {
+        std::pair<size_t, bool> position = insert_position(value);
+        if (!position.second) {
+            return keys_.begin() + position.first;
+        }
+        i = position.first;
+    }
+    return keys_.insert(keys_.begin() + i, std::move(value));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::erase(const_iterator position)
+    -> iterator
+{
+    return keys_.erase(position);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::erase(const_iterator first,
+        const_iterator last)
+    -> iterator
+{
+    return keys_.erase(first, last);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::erase(const key_type &key)
+    -> size_type
+{
+    auto range = equal_range(key);
+    size_type erased = range.second - range.first;
+    keys_.erase(range.first, range.second);
+    return erased;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::clear() noexcept
+{
+    keys_.clear();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::swap(This &other)
+{
+    using std::swap;
+    keys_.swap(other.keys_);
+    swap(comp_, other.comp_);
+}
+
+
+/** \brief Move the keys of `other`, keeping those already present here.
+ *
+ *  Both arrays are sorted, so this is a single linear merge.
+ */
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+void set_table<Key, Compare, Alloc, Multi>::merge(This &other)
+{
+    if (this == &other) {
+        return;
+    }
+    KeyContainer merged(keys_.get_allocator());
+    KeyContainer rest(other.keys_.get_allocator());
+    merged.reserve(keys_.size() + other.keys_.size());
+    auto it = keys_.begin();
+    for (auto &key: other.keys_) {
+        while (it != keys_.end() && !comp_(key, *it)) {
+            merged.push_back(std::move(*it++));
+        }
+        if (Multi || merged.empty() || comp_(merged.back(), key)) {
+            merged.push_back(std::move(key));
+        } else {
+            rest.push_back(std::move(key));
+        }
+    }
+    std::move(it, keys_.end(), std::back_inserter(merged));
+    keys_.swap(merged);
+    other.keys_.swap(rest);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::key_comp() const
+    -> key_compare
+{
+    return comp_;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::value_comp() const
+    -> value_compare
+{
+    return comp_;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::find(const key_type &key) const
+    -> iterator
+{
+    size_t i = lower_index(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+        return keys_.begin() + i;
+    }
+    return keys_.end();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::count(const key_type &key) const
+    -> size_type
+{
+    if (Multi) {
+        return upper_index(key) - lower_index(key);
+    }
+    return find(key) != end();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::lower_bound(const key_type &key) const
+    -> iterator
+{
+    return keys_.begin() + lower_index(key);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::upper_bound(const key_type &key) const
+    -> iterator
+{
+    return keys_.begin() + upper_index(key);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::equal_range(const key_type &key) const
+    -> std::pair<iterator, iterator>
+{
+    return std::make_pair(lower_bound(key), upper_bound(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto set_table<Key, Compare, Alloc, Multi>::find(const K &key) const
+    -> iterator
+{
+    size_t i = lower_index(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+        return keys_.begin() + i;
+    }
+    return keys_.end();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto set_table<Key, Compare, Alloc, Multi>::count(const K &key) const
+    -> size_type
+{
+    return upper_index(key) - lower_index(key);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto set_table<Key, Compare, Alloc, Multi>::lower_bound(const K &key) const
+    -> iterator
+{
+    return keys_.begin() + lower_index(key);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto set_table<Key, Compare, Alloc, Multi>::upper_bound(const K &key) const
+    -> iterator
+{
+    return keys_.begin() + upper_index(key);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto set_table<Key, Compare, Alloc, Multi>::equal_range(const K &key) const
+    -> std::pair<iterator, iterator>
+{
+    return std::make_pair(lower_bound(key), upper_bound(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+auto set_table<Key, Compare, Alloc, Multi>::get_allocator() const
+    -> allocator_type
+{
+    return allocator_type(keys_.get_allocator());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator==(const set_table<Key, Compare, Alloc, Multi> &left,
+    const set_table<Key, Compare, Alloc, Multi> &right)
+{
+    return left.keys_ == right.keys_;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator!=(const set_table<Key, Compare, Alloc, Multi> &left,
+    const set_table<Key, Compare, Alloc, Multi> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator<(const set_table<Key, Compare, Alloc, Multi> &left,
+    const set_table<Key, Compare, Alloc, Multi> &right)
+{
+    return left.keys_ < right.keys_;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator<=(const set_table<Key, Compare, Alloc, Multi> &left,
+    const set_table<Key, Compare, Alloc, Multi> &right)
+{
+    return !(right < left);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator>(const set_table<Key, Compare, Alloc, Multi> &left,
+    const set_table<Key, Compare, Alloc, Multi> &right)
+{
+    return right < left;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, bool Multi>
+bool operator>=(const set_table<Key, Compare, Alloc, Multi> &left,
+    const set_table<Key, Compare, Alloc, Multi> &right)
+{
+    return !(left < right);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K>
+size_t map_table<Key, T, Compare, Alloc, Multi>::lower_index(const K &key) const
+{
+    return flat::lower_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K>
+size_t map_table<Key, T, Compare, Alloc, Multi>::upper_index(const K &key) const
+{
+    return flat::upper_bound(keys_.data(), keys_.size(), key, comp_) - keys_.data();
+}
+
+
+/** \brief Whether inserting `key` before index `i` keeps the keys sorted.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool map_table<Key, T, Compare, Alloc, Multi>::hint_fits(size_t i,
+    const Key &key) const
+{
+    if (Multi) {
+        return (i == 0 || !comp_(key, keys_[i - 1])) && (i == keys_.size() || !comp_(keys_[i], key));
+    }
+    return (i == 0 || comp_(keys_[i - 1], key)) && (i == keys_.size() || comp_(key, keys_[i]));
+}
+
+
+/** \brief Index to insert `key` at, and whether it is absent.
+ *
+ *  Equivalent keys are inserted after those already present.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert_position(const Key &key) const
+    -> std::pair<size_t, bool>
+{
+    if (Multi) {
+        return std::make_pair(upper_index(key), true);
+    }
+    size_t i = lower_index(key);
+    return std::make_pair(i, i == keys_.size() || comp_(key, keys_[i]));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+size_t map_table<Key, T, Compare, Alloc, Multi>::index(const_iterator position) const noexcept
+{
+    return position.key() - keys_.data();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::make_iterator(size_t i) noexcept
+    -> iterator
+{
+    return iterator(keys_.data() + i, values_.data() + i);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::make_iterator(size_t i) const noexcept
+    -> const_iterator
+{
+    return const_iterator(keys_.data() + i, values_.data() + i);
+}
+
+
+/** \brief Insert `key` and a value constructed from `ts` at index `i`.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename... Ts>
+auto map_table<Key, T, Compare, Alloc, Multi>::emplace_at(size_t i,
+        K &&key,
+        Ts&&... ts)
+    -> iterator
+{
+    keys_.emplace(keys_.begin() + i, std::forward<K>(key));
+    try {
+        values_.emplace(values_.begin() + i, std::forward<Ts>(ts)...);
+    } catch (...) {
+        keys_.erase(keys_.begin() + i);
+        throw;
+    }
+    return make_iterator(i);
+}
+
+
+/** \brief Merge a range of values into place.
+ *
+ *  The values are buffered and, unless already sorted, stably sorted
+ *  by key, then merged with the existing elements in a single linear pass.
+ *  Of equivalent keys, those already present come first, and are the
+ *  ones kept by unique maps.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+void map_table<Key, T, Compare, Alloc, Multi>::insert_range(Iter first,
+    Iter last,
+    bool sorted)
+{
+    typedef typename AllocTraits::template rebind_alloc<value_type> BufferAlloc;
+    std::vector<value_type, BufferAlloc> buffer(first, last, BufferAlloc(keys_.get_allocator()));
+    if (buffer.empty()) {
+        return;
+    }
+    auto &comp = comp_;
+    auto less = [&comp](const value_type &left, const value_type &right) {
+        return comp(left.first, right.first);
+    };
+    if (sorted) {
+        assert(std::is_sorted(buffer.begin(), buffer.end(), less) && "itl::flat: unsorted input");
+    } else if (!std::is_sorted(buffer.begin(), buffer.end(), less)) {
+        std::stable_sort(buffer.begin(), buffer.end(), less);
+    }
+
+    KeyContainer keys(keys_.get_allocator());
+    ValueContainer values(values_.get_allocator());
+    keys.reserve(keys_.size() + buffer.size());
+    values.reserve(values_.size() + buffer.size());
+    size_t i = 0;
+    for (auto &value: buffer) {
+        while (i < keys_.size() && !comp_(value.first, keys_[i])) {
+            keys.push_back(std::move(keys_[i]));
+            values.push_back(std::move(values_[i]));
+            ++i;
+        }
+        if (Multi || keys.empty() || comp_(keys.back(), value.first)) {
+            keys.push_back(std::move(value.first));
+            values.push_back(std::move(value.second));
+        }
+    }
+    std::move(keys_.begin() + i, keys_.end(), std::back_inserter(keys));
+    std::move(values_.begin() + i, values_.end(), std::back_inserter(values));
+    keys_.swap(keys);
+    values_.swap(values);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::result(std::pair<iterator, bool> inserted,
+        std::true_type)
+    -> iterator
+{
+    return inserted.first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::result(std::pair<iterator, bool> inserted,
+        std::false_type)
+    -> std::pair<iterator, bool>
+{
+    return inserted;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::value_compare::value_compare(key_compare comp):
+    comp(comp)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool map_table<Key, T, Compare, Alloc, Multi>::value_compare::operator()(const_reference left,
+    const_reference right) const
+{
+    return comp(left.first, right.first);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table():
+    map_table(key_compare())
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(const key_compare &comp,
+        const allocator_type &alloc):
+    keys_(KeyAlloc(alloc)),
+    values_(ValueAlloc(alloc)),
+    comp_(comp)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(const allocator_type &alloc):
+    map_table(key_compare(), alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    map_table(comp, alloc)
+{
+    insert(first, last);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(Iter first,
+        Iter last,
+        const allocator_type &alloc):
+    map_table(first, last, key_compare(), alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(sorted_type tag,
+        Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    map_table(comp, alloc)
+{
+    insert(tag, first, last);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(std::initializer_list<value_type> list,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    map_table(list.begin(), list.end(), comp, alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(std::initializer_list<value_type> list,
+        const allocator_type &alloc):
+    map_table(list.begin(), list.end(), key_compare(), alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(sorted_type tag,
+        std::initializer_list<value_type> list,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    map_table(tag, list.begin(), list.end(), comp, alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(const This &other):
+    keys_(other.keys_),
+    values_(other.values_),
+    comp_(other.comp_)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(const This &other,
+        const allocator_type &alloc):
+    keys_(other.keys_, KeyAlloc(alloc)),
+    values_(other.values_, ValueAlloc(alloc)),
+    comp_(other.comp_)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(This &&other) noexcept:
+    keys_(std::move(other.keys_)),
+    values_(std::move(other.values_)),
+    comp_(std::move(other.comp_))
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::map_table(This &&other,
+        const allocator_type &alloc):
+    keys_(std::move(other.keys_), KeyAlloc(alloc)),
+    values_(std::move(other.values_), ValueAlloc(alloc)),
+    comp_(other.comp_)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::operator=(const This &other)
+    -> This &
+{
+    keys_ = other.keys_;
+    values_ = other.values_;
+    comp_ = other.comp_;
+    return *this;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::operator=(This &&other) noexcept
+    -> This &
+{
+    keys_ = std::move(other.keys_);
+    values_ = std::move(other.values_);
+    comp_ = std::move(other.comp_);
+    return *this;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::operator=(std::initializer_list<value_type> list)
+    -> This &
+{
+    clear();
+    insert(list);
+    return *this;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+map_table<Key, T, Compare, Alloc, Multi>::~map_table()
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::begin() noexcept
+    -> iterator
+{
+    return make_iterator(0);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::begin() const noexcept
+    -> const_iterator
+{
+    return make_iterator(0);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::end() noexcept
+    -> iterator
+{
+    return make_iterator(keys_.size());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::end() const noexcept
+    -> const_iterator
+{
+    return make_iterator(keys_.size());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::rbegin() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::rbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::rend() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(begin());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::rend() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(begin());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::crbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return rbegin();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::crend() const noexcept
+    -> const_reverse_iterator
+{
+    return rend();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool map_table<Key, T, Compare, Alloc, Multi>::empty() const noexcept
+{
+    return keys_.empty();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::size() const noexcept
+    -> size_type
+{
+    return keys_.size();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::max_size() const noexcept
+    -> size_type
+{
+    return std::min<size_type>(keys_.max_size(), values_.max_size());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+void map_table<Key, T, Compare, Alloc, Multi>::reserve(size_type n)
+{
+    keys_.reserve(n);
+    values_.reserve(n);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+void map_table<Key, T, Compare, Alloc, Multi>::shrink_to_fit()
+{
+    keys_.shrink_to_fit();
+    values_.shrink_to_fit();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::operator[](const key_type &key)
+    -> mapped_type &
+{
+    return *try_emplace(key).first.value();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::operator[](key_type &&key)
+    -> mapped_type &
+{
+    return *try_emplace(std::move(key)).first.value();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::at(const key_type &key)
+    -> mapped_type &
+{
+    iterator it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("itl::flat_map::at");
+    }
+    return *it.value();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::at(const key_type &key) const
+    -> const mapped_type &
+{
+    const_iterator it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("itl::flat_map::at");
+    }
+    return *it.value();
+}
+
+
+/** \brief Sorted array of keys.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::keys() const noexcept
+    -> const KeyContainer &
+{
+    return keys_;
+}
+
+
+/** \brief Values, in the order of their keys.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::values() const noexcept
+    -> const ValueContainer &
+{
+    return values_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert(const value_type &value)
+    -> insert_result
+{
+    return emplace(value);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert(value_type &&value)
+    -> insert_result
+{
+    return emplace(std::move(value));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert(const_iterator hint,
+        const value_type &value)
+    -> iterator
+{
+    return emplace_hint(hint, value);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert(const_iterator hint,
+        value_type &&value)
+    -> iterator
+{
+    return emplace_hint(hint, std::move(value));
+}
+
+
+/** \brief Insert a range of values in any order.
+ *
+ *  Inserting `m` values costs `O(m log m + n)`, rather than `O(m n)`
+ *  one by one.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+void map_table<Key, T, Compare, Alloc, Multi>::insert(Iter first,
+    Iter last)
+{
+    insert_range(first, last, false);
+}
+
+
+/** \brief Insert a range of values already sorted by key.
+ *
+ *  The values are merged into place in linear time. Debug builds
+ *  assert that the input is sorted.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename Iter>
+void map_table<Key, T, Compare, Alloc, Multi>::insert(sorted_type,
+    Iter first,
+    Iter last)
+{
+    insert_range(first, last, true);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+void map_table<Key, T, Compare, Alloc, Multi>::insert(std::initializer_list<value_type> list)
+{
+    insert(list.begin(), list.end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+void map_table<Key, T, Compare, Alloc, Multi>::insert(sorted_type tag,
+    std::initializer_list<value_type> list)
+{
+    insert(tag, list.begin(), list.end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto map_table<Key, T, Compare, Alloc, Multi>::emplace(Ts&&... ts)
+    -> insert_result
+{
+    value_type value(std::forward<Ts>(ts)...);
+    std::pair<size_t, bool> position = insert_position(value.first);
+    if (position.second) {
+        emplace_at(position.first, std::move(value.first), std::move(value.second));
+    }
+    std::pair<iterator, bool> inserted(make_iterator(position.first), position.second);
+    return result(inserted, std::integral_constant<bool, Multi>());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto map_table<Key, T, Compare, Alloc, Multi>::emplace_hint(const_iterator hint,
+        Ts&&... ts)
+    -> iterator
+{
+    value_type value(std::forward<Ts>(ts)...);
+    size_t i = index(hint);
+    if (!hint_fits(i, value.first)) {
+        std::pair<size_t, bool> position = insert_position(value.first);
+        if (!position.second) {
+            return make_iterator(position.first);
+        }
+        i = position.first;
+    }
+    return emplace_at(i, std::move(value.first), std::move(value.second));
+}
+
+
+/** \brief Construct a value in place, unless `key` is already present.
+ *
+ *  Unlike `emplace`, nothing is constructed for an existing key.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto map_table<Key, T, Compare, Alloc, Multi>::try_emplace(const key_type &key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    std::pair<size_t, bool> position = insert_position(key);
+    if (!position.second) {
+        return std::make_pair(make_iterator(position.first), false);
+    }
+    return std::make_pair(emplace_at(position.first, key, std::forward<Ts>(ts)...), true);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto map_table<Key, T, Compare, Alloc, Multi>::try_emplace(key_type &&key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    std::pair<size_t, bool> position = insert_position(key);
+    if (!position.second) {
+        return std::make_pair(make_iterator(position.first), false);
+    }
+    return std::make_pair(emplace_at(position.first, std::move(key), std::forward<Ts>(ts)...), true);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto map_table<Key, T, Compare, Alloc, Multi>::try_emplace(const_iterator hint,
+        const key_type &key,
+        Ts&&... ts)
+    -> iterator
+{
+    size_t i = index(hint);
+    if (hint_fits(i, key)) {
+        return emplace_at(i, key, std::forward<Ts>(ts)...);
+    }
+    return try_emplace(key, std::forward<Ts>(ts)...).first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename... Ts>
+auto map_table<Key, T, Compare, Alloc, Multi>::try_emplace(const_iterator hint,
+        key_type &&key,
+        Ts&&... ts)
+    -> iterator
+{
+    size_t i = index(hint);
+    if (hint_fits(i, key)) {
+        return emplace_at(i, std::move(key), std::forward<Ts>(ts)...);
+    }
+    return try_emplace(std::move(key), std::forward<Ts>(ts)...).first;
+}
+
+
+/** \brief Assign to the value of `key`, or insert it if absent.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename V>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert_or_assign(const key_type &key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    std::pair<size_t, bool> position = insert_position(key);
+    if (!position.second) {
+        values_[position.first] = std::forward<V>(value);
+        return std::make_pair(make_iterator(position.first), false);
+    }
+    return std::make_pair(emplace_at(position.first, key, std::forward<V>(value)), true);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename V>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert_or_assign(key_type &&key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    std::pair<size_t, bool> position = insert_position(key);
+    if (!position.second) {
+        values_[position.first] = std::forward<V>(value);
+        return std::make_pair(make_iterator(position.first), false);
+    }
+    return std::make_pair(emplace_at(position.first, std::move(key), std::forward<V>(value)), true);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename V>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert_or_assign(const_iterator,
+        const key_type &key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(key, std::forward<V>(value)).first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename V>
+auto map_table<Key, T, Compare, Alloc, Multi>::insert_or_assign(const_iterator,
+        key_type &&key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(std::move(key), std::forward<V>(value)).first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::erase(const_iterator position)
+    -> iterator
+{
+    size_t i = index(position);
+    keys_.erase(keys_.begin() + i);
+    values_.erase(values_.begin() + i);
+    return make_iterator(i);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::erase(const_iterator first,
+        const_iterator last)
+    -> iterator
+{
+    size_t i = index(first);
+    size_t j = index(last);
+    keys_.erase(keys_.begin() + i, keys_.begin() + j);
+    values_.erase(values_.begin() + i, values_.begin() + j);
+    return make_iterator(i);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::erase(const key_type &key)
+    -> size_type
+{
+    auto range = equal_range(key);
+    size_type erased = range.second - range.first;
+    erase(range.first, range.second);
+    return erased;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+void map_table<Key, T, Compare, Alloc, Multi>::clear() noexcept
+{
+    keys_.clear();
+    values_.clear();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+void map_table<Key, T, Compare, Alloc, Multi>::swap(This &other)
+{
+    using std::swap;
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+    swap(comp_, other.comp_);
+}
+
+
+/** \brief Move the values of `other`, keeping those already present here.
+ *
+ *  Both arrays are sorted, so this is a single linear merge.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+void map_table<Key, T, Compare, Alloc, Multi>::merge(This &other)
+{
+    if (this == &other) {
+        return;
+    }
+    KeyContainer keys(keys_.get_allocator());
+    ValueContainer values(values_.get_allocator());
+    KeyContainer rest_keys(other.keys_.get_allocator());
+    ValueContainer rest_values(other.values_.get_allocator());
+    keys.reserve(keys_.size() + other.keys_.size());
+    values.reserve(values_.size() + other.values_.size());
+    size_t i = 0;
+    for (size_t j = 0; j < other.keys_.size(); ++j) {
+        Key &key = other.keys_[j];
+        while (i < keys_.size() && !comp_(key, keys_[i])) {
+            keys.push_back(std::move(keys_[i]));
+            values.push_back(std::move(values_[i]));
+            ++i;
+        }
+        if (Multi || keys.empty() || comp_(keys.back(), key)) {
+            keys.push_back(std::move(key));
+            values.push_back(std::move(other.values_[j]));
+        } else {
+            rest_keys.push_back(std::move(key));
+            rest_values.push_back(std::move(other.values_[j]));
+        }
+    }
+    std::move(keys_.begin() + i, keys_.end(), std::back_inserter(keys));
+    std::move(values_.begin() + i, values_.end(), std::back_inserter(values));
+    keys_.swap(keys);
+    values_.swap(values);
+    other.keys_.swap(rest_keys);
+    other.values_.swap(rest_values);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::key_comp() const
+    -> key_compare
+{
+    return comp_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::value_comp() const
+    -> value_compare
+{
+    return value_compare(comp_);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::find(const key_type &key)
+    -> iterator
+{
+    size_t i = lower_index(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+        return make_iterator(i);
+    }
+    return end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::find(const key_type &key) const
+    -> const_iterator
+{
+    size_t i = lower_index(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+        return make_iterator(i);
+    }
+    return end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::count(const key_type &key) const
+    -> size_type
+{
+    if (Multi) {
+        return upper_index(key) - lower_index(key);
+    }
+    return find(key) != end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::lower_bound(const key_type &key)
+    -> iterator
+{
+    return make_iterator(lower_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::lower_bound(const key_type &key) const
+    -> const_iterator
+{
+    return make_iterator(lower_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::upper_bound(const key_type &key)
+    -> iterator
+{
+    return make_iterator(upper_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::upper_bound(const key_type &key) const
+    -> const_iterator
+{
+    return make_iterator(upper_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::equal_range(const key_type &key)
+    -> std::pair<iterator, iterator>
+{
+    return std::make_pair(lower_bound(key), upper_bound(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::equal_range(const key_type &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return std::make_pair(lower_bound(key), upper_bound(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::find(const K &key)
+    -> iterator
+{
+    size_t i = lower_index(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+        return make_iterator(i);
+    }
+    return end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::find(const K &key) const
+    -> const_iterator
+{
+    size_t i = lower_index(key);
+    if (i != keys_.size() && !comp_(key, keys_[i])) {
+        return make_iterator(i);
+    }
+    return end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::count(const K &key) const
+    -> size_type
+{
+    return upper_index(key) - lower_index(key);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::lower_bound(const K &key)
+    -> iterator
+{
+    return make_iterator(lower_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::lower_bound(const K &key) const
+    -> const_iterator
+{
+    return make_iterator(lower_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::upper_bound(const K &key)
+    -> iterator
+{
+    return make_iterator(upper_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::upper_bound(const K &key) const
+    -> const_iterator
+{
+    return make_iterator(upper_index(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return std::make_pair(lower_bound(key), upper_bound(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+template <typename K, typename C, typename>
+auto map_table<Key, T, Compare, Alloc, Multi>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return std::make_pair(lower_bound(key), upper_bound(key));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+auto map_table<Key, T, Compare, Alloc, Multi>::get_allocator() const
+    -> allocator_type
+{
+    return allocator_type(keys_.get_allocator());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator==(const map_table<Key, T, Compare, Alloc, Multi> &left,
+    const map_table<Key, T, Compare, Alloc, Multi> &right)
+{
+    return left.keys_ == right.keys_ && left.values_ == right.values_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator!=(const map_table<Key, T, Compare, Alloc, Multi> &left,
+    const map_table<Key, T, Compare, Alloc, Multi> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator<(const map_table<Key, T, Compare, Alloc, Multi> &left,
+    const map_table<Key, T, Compare, Alloc, Multi> &right)
+{
+    return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator<=(const map_table<Key, T, Compare, Alloc, Multi> &left,
+    const map_table<Key, T, Compare, Alloc, Multi> &right)
+{
+    return !(right < left);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator>(const map_table<Key, T, Compare, Alloc, Multi> &left,
+    const map_table<Key, T, Compare, Alloc, Multi> &right)
+{
+    return right < left;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc, bool Multi>
+bool operator>=(const map_table<Key, T, Compare, Alloc, Multi> &left,
+    const map_table<Key, T, Compare, Alloc, Multi> &right)
+{
+    return !(left < right);
+}
+
+}   /* flat */
+}   /* itl */
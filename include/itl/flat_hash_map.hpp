@@ -0,0 +1,1728 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "destructor.hpp"
+#include "hashed.hpp"
+#include "relocate.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   include <emmintrin.h>
+#   define ITL_HAS_SSE2 1
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+
+namespace itl
+{
+namespace swiss
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Control byte values. Full slots store the 7-bit hash H2.
+ */
+constexpr int8_t empty = -128;
+constexpr int8_t deleted = -2;
+constexpr int8_t sentinel = -1;
+
+
+bool is_full(int8_t ctrl) noexcept;
+bool is_empty_or_deleted(int8_t ctrl) noexcept;
+unsigned trailing_zeros(uint64_t value) noexcept;
+
+
+/** \brief Set of matching positions within a group.
+ *
+ *  Each position is `1 << Shift` bits wide.
+ */
+template <unsigned Shift>
+class bitmask
+{
+public:
+    explicit bitmask(uint64_t mask) noexcept;
+
+    explicit operator bool() const noexcept;
+    unsigned lowest() const noexcept;
+    void pop() noexcept;
+
+private:
+    uint64_t mask_;
+};
+
+
+#if defined(ITL_HAS_SSE2)
+
+/** \brief 16 control bytes compared with SSE2.
+ */
+class group
+{
+public:
+    static constexpr size_t width = 16;
+    typedef bitmask<0> mask;
+
+    explicit group(const int8_t *ctrl) noexcept;
+
+    mask match(int8_t h2) const noexcept;
+    mask match_empty() const noexcept;
+    mask match_empty_or_deleted() const noexcept;
+    unsigned count_leading_empty_or_deleted() const noexcept;
+
+private:
+    __m128i ctrl_;
+};
+
+#else
+
+/** \brief 8 control bytes compared within a 64-bit word.
+ *
+ *  `match` may report false positives, which the key comparison
+ *  rejects.
+ */
+class group
+{
+public:
+    static constexpr size_t width = 8;
+    typedef bitmask<3> mask;
+
+    explicit group(const int8_t *ctrl) noexcept;
+
+    mask match(int8_t h2) const noexcept;
+    mask match_empty() const noexcept;
+    mask match_empty_or_deleted() const noexcept;
+    unsigned count_leading_empty_or_deleted() const noexcept;
+
+private:
+    static constexpr uint64_t lsbs = 0x0101010101010101ULL;
+    static constexpr uint64_t msbs = 0x8080808080808080ULL;
+
+    uint64_t ctrl_;
+};
+
+#endif
+
+
+/** \brief Triangular probe sequence over groups, visiting every group once.
+ */
+class probe_sequence
+{
+public:
+    probe_sequence(size_t hash, size_t mask) noexcept;
+
+    size_t offset() const noexcept;
+    size_t offset(unsigned i) const noexcept;
+    void next() noexcept;
+
+private:
+    size_t mask_;
+    size_t offset_;
+    size_t index_;
+};
+
+
+/** \brief Control bytes of a table without slots.
+ */
+int8_t * empty_group() noexcept;
+
+size_t mix(size_t hash) noexcept;
+size_t normalize_capacity(size_t n) noexcept;
+size_t capacity_to_growth(size_t capacity) noexcept;
+size_t growth_to_capacity(size_t growth) noexcept;
+
+
+/** \brief Forward iterator over the full slots of a table.
+ */
+template <typename T>
+class iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef T * pointer;
+    typedef T & reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    iterator() noexcept;
+    iterator(const int8_t *ctrl, T *slot) noexcept;
+
+    template <
+        typename U,
+        typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type
+    >
+    iterator(const iterator<U> &other) noexcept;
+
+    reference operator*() const;
+    pointer operator->() const;
+    iterator & operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+
+    const int8_t * ctrl() const noexcept;
+    T * slot() const noexcept;
+
+private:
+    void skip() noexcept;
+
+    const int8_t *ctrl_;
+    T *slot_;
+};
+
+}   /* swiss */
+
+
+/** \brief Open-addressing hash map with Swiss-table control bytes.
+ *
+ *  Exports the member surface of `itl::unordered_map`. Elements live
+ *  in a single flat array, probed one group of control bytes at a
+ *  time with SIMD compares, so inserts do not allocate per element
+ *  and misses rarely touch the slots. Unlike `std::unordered_map`,
+ *  rehashing invalidates references to elements, and the maximum
+ *  load factor is fixed at 7/8.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class flat_hash_map: protected Destructor
+{
+protected:
+    typedef flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor> This;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<int8_t> CtrlAlloc;
+    typedef std::allocator_traits<CtrlAlloc> CtrlTraits;
+    typedef typename slot_type<std::pair<const Key, Value>>::type Slot;
+    typedef std::integral_constant<bool, std::is_nothrow_move_constructible<Slot>::value> RelocatesSlots;
+
+    size_t hash(const Key &key) const;
+    size_t find_index(const Key &key, size_t hash) const;
+    size_t find_first_non_full(size_t hash) const noexcept;
+
+    template <typename Iter, typename Function>
+    void find_batch_index(Iter first, Iter last, Function function) const;
+    size_t prepare_insert(size_t hash);
+    void set_ctrl(size_t i, int8_t h) noexcept;
+    void erase_index(size_t i);
+    void resize(size_t capacity);
+    void resize(size_t capacity, std::true_type);
+    void resize(size_t capacity, std::false_type);
+    void allocate_table(size_t capacity);
+    void deallocate_table(int8_t *ctrl, std::pair<const Key, Value> *slots, size_t capacity) noexcept;
+    void destroy() noexcept;
+    void reset() noexcept;
+    void adopt(This &other) noexcept;
+    void move_assign(This &other, std::true_type) noexcept;
+    void move_assign(This &other, std::false_type);
+    void copy_assign(const This &other, std::true_type);
+    void copy_assign(const This &other, std::false_type);
+    void swap_tables(This &other) noexcept;
+    void swap(This &other, std::true_type) noexcept;
+    void swap(This &other, std::false_type);
+
+    template <typename... Ts>
+    std::pair<typename AllocTraits::value_type*, bool> emplace_key(const Key &key, Ts&&... ts);
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend void swap(flat_hash_map<K, V, H, P, A, D> &left, flat_hash_map<K, V, H, P, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    // --------------------
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator==(const flat_hash_map<K, V, H, P, A, D> &left, const flat_hash_map<K, V, H, P, A, D> &right);
+
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator!=(const flat_hash_map<K, V, H, P, A, D> &left, const flat_hash_map<K, V, H, P, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef std::pair<const Key, Value> value_type;
+    typedef Value mapped_type;
+    typedef Hash hasher;
+    typedef Pred key_equal;
+    typedef Alloc allocator_type;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef typename AllocTraits::pointer pointer;
+    typedef typename AllocTraits::const_pointer const_pointer;
+    typedef swiss::iterator<value_type> iterator;
+    typedef swiss::iterator<const value_type> const_iterator;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    flat_hash_map();
+    explicit flat_hash_map(size_type n, const hasher &hash = hasher(), const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type());
+    explicit flat_hash_map(const allocator_type &alloc);
+    flat_hash_map(std::initializer_list<value_type> list, size_type n = 0, const hasher &hash = hasher(), const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type());
+
+    template <typename Iter>
+    flat_hash_map(Iter first, Iter last, size_type n = 0, const hasher &hash = hasher(), const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type());
+
+    flat_hash_map(const This &other);
+    flat_hash_map(const This &other, const allocator_type &alloc);
+    flat_hash_map(This &&other) noexcept;
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(AllocTraits::propagate_on_container_move_assignment::value);
+    This & operator=(std::initializer_list<value_type> list);
+    ~flat_hash_map();
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+
+    // ITERATORS
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // ELEMENT ACCESS
+    mapped_type & operator[](const key_type &key);
+    mapped_type & operator[](key_type &&key);
+    mapped_type & at(const key_type &key);
+    const mapped_type & at(const key_type &key) const;
+
+    // LOOKUP
+    iterator find(const key_type &key);
+    const_iterator find(const key_type &key) const;
+    size_type count(const key_type &key) const;
+    std::pair<iterator, iterator> equal_range(const key_type &key);
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const;
+
+    template <typename Iter, typename OutIter>
+    OutIter find_batch(Iter first, Iter last, OutIter out);
+
+    template <typename Iter, typename OutIter>
+    OutIter find_batch(Iter first, Iter last, OutIter out) const;
+
+    // MODIFIERS
+    template <typename... Ts>
+    std::pair<iterator, bool> emplace(Ts&&... ts);
+
+    template <typename... Ts>
+    iterator emplace_hint(const_iterator hint, Ts&&... ts);
+
+    std::pair<iterator, bool> insert(const value_type &value);
+    std::pair<iterator, bool> insert(value_type &&value);
+    iterator insert(const_iterator hint, const value_type &value);
+    iterator insert(const_iterator hint, value_type &&value);
+
+    template <typename Iter>
+    void insert(Iter first, Iter last);
+
+    void insert(std::initializer_list<value_type> list);
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type &key);
+    void clear() noexcept;
+    void swap(This &other) noexcept(AllocTraits::propagate_on_container_swap::value || AllocTraits::is_always_equal::value);
+
+    // BUCKETS
+    size_type bucket_count() const noexcept;
+    size_type max_bucket_count() const noexcept;
+
+    // HASH POLICY
+    float load_factor() const noexcept;
+    float max_load_factor() const noexcept;
+    void max_load_factor(float ml) noexcept;
+    void rehash(size_type n);
+    void reserve(size_type n);
+
+    // OBSERVERS
+    hasher hash_function() const;
+    key_equal key_eq() const;
+    allocator_type get_allocator() const;
+
+private:
+    int8_t *ctrl_;
+    value_type *slots_;
+    size_t size_;
+    size_t capacity_;
+    size_t growth_left_;
+    hasher hash_;
+    key_equal equal_;
+    allocator_type alloc_;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace swiss
+{
+
+inline bool is_full(int8_t ctrl) noexcept
+{
+    return ctrl >= 0;
+}
+
+
+inline bool is_empty_or_deleted(int8_t ctrl) noexcept
+{
+    return ctrl < sentinel;
+}
+
+
+inline unsigned trailing_zeros(uint64_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<unsigned>(index);
+#else
+    unsigned count = 0;
+    for (; !(value & 1); value >>= 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+
+template <unsigned Shift>
+bitmask<Shift>::bitmask(uint64_t mask) noexcept:
+    mask_(mask)
+{}
+
+
+template <unsigned Shift>
+bitmask<Shift>::operator bool() const noexcept
+{
+    return mask_ != 0;
+}
+
+
+template <unsigned Shift>
+unsigned bitmask<Shift>::lowest() const noexcept
+{
+    return trailing_zeros(mask_) >> Shift;
+}
+
+
+template <unsigned Shift>
+void bitmask<Shift>::pop() noexcept
+{
+    mask_ &= mask_ - 1;
+}
+
+
+#if defined(ITL_HAS_SSE2)
+
+inline group::group(const int8_t *ctrl) noexcept:
+    ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+{}
+
+
+inline auto group::match(int8_t h2) const noexcept
+    -> mask
+{
+    __m128i match = _mm_set1_epi8(static_cast<char>(h2));
+    return mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(match, ctrl_))));
+}
+
+
+inline auto group::match_empty() const noexcept
+    -> mask
+{
+    return match(empty);
+}
+
+
+inline auto group::match_empty_or_deleted() const noexcept
+    -> mask
+{
+    __m128i special = _mm_set1_epi8(static_cast<char>(sentinel));
+    return mask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(special, ctrl_))));
+}
+
+
+inline unsigned group::count_leading_empty_or_deleted() const noexcept
+{
+    __m128i special = _mm_set1_epi8(static_cast<char>(sentinel));
+    uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(special, ctrl_)));
+    return trailing_zeros(bits + 1);
+}
+
+#else
+
+inline group::group(const int8_t *ctrl) noexcept
+{
+    std::memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ctrl_ = __builtin_bswap64(ctrl_);
+#endif
+}
+
+
+inline auto group::match(int8_t h2) const noexcept
+    -> mask
+{
+    uint64_t x = ctrl_ ^ (lsbs * static_cast<uint8_t>(h2));
+    return mask((x - lsbs) & ~x & msbs);
+}
+
+
+inline auto group::match_empty() const noexcept
+    -> mask
+{
+    return mask((ctrl_ & (~ctrl_ << 6)) & msbs);
+}
+
+
+inline auto group::match_empty_or_deleted() const noexcept
+    -> mask
+{
+    return mask((ctrl_ & (~ctrl_ << 7)) & msbs);
+}
+
+
+inline unsigned group::count_leading_empty_or_deleted() const noexcept
+{
+    const uint64_t gaps = 0x00FEFEFEFEFEFEFEULL;
+    return (trailing_zeros(((~ctrl_ & (ctrl_ >> 7)) | gaps) + 1) + 7) >> 3;
+}
+
+#endif
+
+
+inline probe_sequence::probe_sequence(size_t hash,
+        size_t mask) noexcept:
+    mask_(mask),
+    offset_(hash & mask),
+    index_(0)
+{}
+
+
+inline size_t probe_sequence::offset() const noexcept
+{
+    return offset_;
+}
+
+
+inline size_t probe_sequence::offset(unsigned i) const noexcept
+{
+    return (offset_ + i) & mask_;
+}
+
+
+inline void probe_sequence::next() noexcept
+{
+    index_ += group::width;
+    offset_ += index_;
+    offset_ &= mask_;
+}
+
+
+inline int8_t * empty_group() noexcept
+{
+    alignas(16) static int8_t ctrl[group::width] = {
+        sentinel, empty, empty, empty, empty, empty, empty, empty,
+#if defined(ITL_HAS_SSE2)
+        empty, empty, empty, empty, empty, empty, empty, empty,
+#endif
+    };
+    return ctrl;
+}
+
+
+inline size_t mix(size_t hash) noexcept
+{
+    // identity hashes, such as std::hash<int>, leave H1 and H2 correlated
+    uint64_t x = static_cast<uint64_t>(hash);
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+}
+
+
+inline size_t normalize_capacity(size_t n) noexcept
+{
+    // capacities are one less than a power of two, and act as the mask
+    size_t capacity = 1;
+    while (capacity < n) {
+        capacity = 2 * capacity + 1;
+    }
+    return capacity;
+}
+
+
+inline size_t capacity_to_growth(size_t capacity) noexcept
+{
+    if (group::width == 8 && capacity == 7) {
+        return 6;
+    }
+    return capacity - capacity / 8;
+}
+
+
+inline size_t growth_to_capacity(size_t growth) noexcept
+{
+    if (group::width == 8 && growth == 7) {
+        return 8;
+    }
+    return growth + (growth ? (growth - 1) / 7 : 0);
+}
+
+
+template <typename T>
+iterator<T>::iterator() noexcept:
+    ctrl_(nullptr),
+    slot_(nullptr)
+{}
+
+
+template <typename T>
+iterator<T>::iterator(const int8_t *ctrl,
+        T *slot) noexcept:
+    ctrl_(ctrl),
+    slot_(slot)
+{
+    skip();
+}
+
+
+template <typename T>
+template <typename U, typename>
+iterator<T>::iterator(const iterator<U> &other) noexcept:
+    ctrl_(other.ctrl()),
+    slot_(other.slot())
+{}
+
+
+template <typename T>
+auto iterator<T>::operator*() const
+    -> reference
+{
+    return *slot_;
+}
+
+
+template <typename T>
+auto iterator<T>::operator->() const
+    -> pointer
+{
+    return slot_;
+}
+
+
+template <typename T>
+auto iterator<T>::operator++()
+    -> iterator &
+{
+    ++ctrl_;
+    ++slot_;
+    skip();
+    return *this;
+}
+
+
+template <typename T>
+auto iterator<T>::operator++(int)
+    -> iterator
+{
+    iterator copy(*this);
+    ++*this;
+    return copy;
+}
+
+
+template <typename T>
+bool iterator<T>::operator==(const iterator &other) const noexcept
+{
+    return ctrl_ == other.ctrl_;
+}
+
+
+template <typename T>
+bool iterator<T>::operator!=(const iterator &other) const noexcept
+{
+    return ctrl_ != other.ctrl_;
+}
+
+
+template <typename T>
+const int8_t * iterator<T>::ctrl() const noexcept
+{
+    return ctrl_;
+}
+
+
+template <typename T>
+T * iterator<T>::slot() const noexcept
+{
+    return slot_;
+}
+
+
+template <typename T>
+void iterator<T>::skip() noexcept
+{
+    while (ctrl_ && is_empty_or_deleted(*ctrl_)) {
+        unsigned shift = group(ctrl_).count_leading_empty_or_deleted();
+        ctrl_ += shift;
+        slot_ += shift;
+    }
+}
+
+}   /* swiss */
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+size_t flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::hash(const Key &key) const
+{
+    return swiss::mix(hash_(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+size_t flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_index(const Key &key,
+    size_t hash) const
+{
+    int8_t h2 = static_cast<int8_t>(hash & 0x7F);
+    swiss::probe_sequence sequence(hash >> 7, capacity_);
+    while (true) {
+        swiss::group group(ctrl_ + sequence.offset());
+        for (auto match = group.match(h2); match; match.pop()) {
+            size_t i = sequence.offset(match.lowest());
+            if (equal_(slots_[i].first, key)) {
+                return i;
+            }
+        }
+        if (group.match_empty()) {
+            return capacity_;
+        }
+        sequence.next();
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+size_t flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_first_non_full(size_t hash) const noexcept
+{
+    swiss::probe_sequence sequence(hash >> 7, capacity_);
+    while (true) {
+        auto match = swiss::group(ctrl_ + sequence.offset()).match_empty_or_deleted();
+        if (match) {
+            return sequence.offset(match.lowest());
+        }
+        sequence.next();
+    }
+}
+
+
+/** \brief Call `function` with the slot of each key in `[first, last)`.
+ *
+ *  Keys are resolved in groups of 16: each key is hashed and its
+ *  first probed group of control bytes and slots is prefetched
+ *  before any group is probed, overlapping the cache misses.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter, typename Function>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_batch_index(Iter first,
+    Iter last,
+    Function function) const
+{
+    const size_t width = 16;
+    const Key *keys[width];
+    size_t hashes[width];
+
+    while (first != last) {
+        size_t count = 0;
+        for (; count < width && first != last; ++count, ++first) {
+            keys[count] = std::addressof(*first);
+            hashes[count] = hash(*keys[count]);
+            if (capacity_) {
+                size_t offset = swiss::probe_sequence(hashes[count] >> 7, capacity_).offset();
+                hashed::prefetch(ctrl_ + offset);
+                hashed::prefetch(slots_ + offset);
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            function(find_index(*keys[i], hashes[i]));
+        }
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+size_t flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::prepare_insert(size_t hash)
+{
+    size_t i = find_first_non_full(hash);
+    if (growth_left_ == 0 && ctrl_[i] != swiss::deleted) {
+        // drop tombstones in place of growing when they fill the table
+        if (capacity_ > swiss::group::width && size_ * 32 <= capacity_ * 25) {
+            resize(capacity_);
+        } else {
+            resize(2 * capacity_ + 1);
+        }
+        i = find_first_non_full(hash);
+    }
+    return i;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::set_ctrl(size_t i,
+    int8_t h) noexcept
+{
+    // mirror the first bytes past the sentinel, so groups never wrap
+    const size_t cloned = swiss::group::width - 1;
+    ctrl_[i] = h;
+    ctrl_[((i - cloned) & capacity_) + (cloned & capacity_)] = h;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase_index(size_t i)
+{
+    AllocTraits::destroy(alloc_, slots_ + i);
+    --size_;
+
+    // a slot may become empty if no probe sequence ever passed it
+    size_t before = (i - swiss::group::width) & capacity_;
+    auto empty_after = swiss::group(ctrl_ + i).match_empty();
+    auto empty_before = swiss::group(ctrl_ + before).match_empty();
+    bool never_full = false;
+    if (empty_before && empty_after) {
+        unsigned highest = 0;
+        for (auto match = empty_before; match; match.pop()) {
+            highest = match.lowest();
+        }
+        unsigned leading = swiss::group::width - 1 - highest;
+        never_full = empty_after.lowest() + leading < swiss::group::width;
+    }
+
+    set_ctrl(i, never_full ? swiss::empty : swiss::deleted);
+    growth_left_ += never_full;
+}
+
+
+/** \brief Rehash every element into a new table of `capacity` slots.
+ *
+ *  Elements relocate through their mutable `slot_type`, so keys are
+ *  moved rather than copied, unless that move may throw.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::resize(size_t capacity)
+{
+    resize(capacity, RelocatesSlots());
+}
+
+
+/** \brief Rehash by relocating each element, which cannot throw.
+ *
+ *  Only the hash may throw. The elements already relocated then stay
+ *  in the new table, and the rest are destroyed, so the map is valid
+ *  but smaller.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::resize(size_t capacity,
+    std::true_type)
+{
+    int8_t *old_ctrl = ctrl_;
+    value_type *old_slots = slots_;
+    size_t old_capacity = capacity_;
+    allocate_table(capacity);
+
+    size_t i = 0;
+    try {
+        for (; i < old_capacity; ++i) {
+            if (swiss::is_full(old_ctrl[i])) {
+                size_t h = hash(old_slots[i].first);
+                size_t j = find_first_non_full(h);
+                relocate_at(reinterpret_cast<Slot*>(old_slots + i), reinterpret_cast<Slot*>(slots_ + j));
+                set_ctrl(j, static_cast<int8_t>(h & 0x7F));
+            }
+        }
+    } catch (...) {
+        for (; i < old_capacity; ++i) {
+            if (swiss::is_full(old_ctrl[i])) {
+                AllocTraits::destroy(alloc_, old_slots + i);
+                --size_;
+            }
+        }
+        growth_left_ = swiss::capacity_to_growth(capacity_) - size_;
+        deallocate_table(old_ctrl, old_slots, old_capacity);
+        throw;
+    }
+    deallocate_table(old_ctrl, old_slots, old_capacity);
+}
+
+
+/** \brief Rehash by copying each element, keeping the old table on a throw.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::resize(size_t capacity,
+    std::false_type)
+{
+    int8_t *old_ctrl = ctrl_;
+    value_type *old_slots = slots_;
+    size_t old_capacity = capacity_;
+    size_t old_growth = growth_left_;
+    allocate_table(capacity);
+
+    try {
+        for (size_t i = 0; i < old_capacity; ++i) {
+            if (swiss::is_full(old_ctrl[i])) {
+                size_t h = hash(old_slots[i].first);
+                size_t j = find_first_non_full(h);
+                AllocTraits::construct(alloc_, slots_ + j, std::move_if_noexcept(old_slots[i]));
+                set_ctrl(j, static_cast<int8_t>(h & 0x7F));
+            }
+        }
+    } catch (...) {
+        for (size_t j = 0; j < capacity_; ++j) {
+            if (swiss::is_full(ctrl_[j])) {
+                AllocTraits::destroy(alloc_, slots_ + j);
+            }
+        }
+        deallocate_table(ctrl_, slots_, capacity_);
+        ctrl_ = old_ctrl;
+        slots_ = old_slots;
+        capacity_ = old_capacity;
+        growth_left_ = old_growth;
+        throw;
+    }
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+        if (swiss::is_full(old_ctrl[i])) {
+            AllocTraits::destroy(alloc_, old_slots + i);
+        }
+    }
+    deallocate_table(old_ctrl, old_slots, old_capacity);
+}
+
+
+/** \brief Replace the arrays with an empty table of `capacity` slots.
+ *
+ *  The old arrays are neither destroyed nor freed. On a throw, the
+ *  map is unchanged.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::allocate_table(size_t capacity)
+{
+    CtrlAlloc ctrl_alloc(alloc_);
+    size_t bytes = capacity + swiss::group::width;
+    int8_t *ctrl = CtrlTraits::allocate(ctrl_alloc, bytes);
+    value_type *slots;
+    try {
+        slots = AllocTraits::allocate(alloc_, capacity);
+    } catch (...) {
+        CtrlTraits::deallocate(ctrl_alloc, ctrl, bytes);
+        throw;
+    }
+    std::memset(ctrl, swiss::empty, bytes);
+    ctrl[capacity] = swiss::sentinel;
+
+    ctrl_ = ctrl;
+    slots_ = slots;
+    capacity_ = capacity;
+    growth_left_ = swiss::capacity_to_growth(capacity) - size_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::deallocate_table(int8_t *ctrl,
+    std::pair<const Key, Value> *slots,
+    size_t capacity) noexcept
+{
+    if (capacity) {
+        CtrlAlloc ctrl_alloc(alloc_);
+        CtrlTraits::deallocate(ctrl_alloc, ctrl, capacity + swiss::group::width);
+        AllocTraits::deallocate(alloc_, slots, capacity);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::destroy() noexcept
+{
+    if (!capacity_) {
+        return;
+    }
+    for (size_t i = 0; i < capacity_; ++i) {
+        if (swiss::is_full(ctrl_[i])) {
+            AllocTraits::destroy(alloc_, slots_ + i);
+        }
+    }
+    deallocate_table(ctrl_, slots_, capacity_);
+    reset();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::reset() noexcept
+{
+    ctrl_ = swiss::empty_group();
+    slots_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+    growth_left_ = 0;
+}
+
+
+/** \brief Free this table and take that of `other`, leaving it empty.
+ *
+ *  The allocators must be equal, or propagated by the caller.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::adopt(This &other) noexcept
+{
+    destroy();
+    ctrl_ = other.ctrl_;
+    slots_ = other.slots_;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+    growth_left_ = other.growth_left_;
+    hash_ = std::move(other.hash_);
+    equal_ = std::move(other.equal_);
+    other.reset();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::move_assign(This &other,
+    std::true_type) noexcept
+{
+    adopt(other);
+    alloc_ = std::move(other.alloc_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::move_assign(This &other,
+    std::false_type)
+{
+    if (alloc_ == other.alloc_) {
+        adopt(other);
+        return;
+    }
+    clear();
+    hash_ = std::move(other.hash_);
+    equal_ = std::move(other.equal_);
+    reserve(other.size());
+    for (auto &value: other) {
+        emplace_key(value.first, std::move(value));
+    }
+    other.clear();
+}
+
+
+/** \brief Copy-assign, taking the allocator of `other`.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::copy_assign(const This &other,
+    std::true_type)
+{
+    This copy(other, other.alloc_);
+    swap(copy, std::true_type());
+}
+
+
+/** \brief Copy-assign into a table using this map's allocator.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::copy_assign(const This &other,
+    std::false_type)
+{
+    This copy(other, alloc_);
+    swap_tables(copy);
+}
+
+
+/** \brief Exchange everything but the allocators.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::swap_tables(This &other) noexcept
+{
+    using std::swap;
+    swap(ctrl_, other.ctrl_);
+    swap(slots_, other.slots_);
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+    swap(growth_left_, other.growth_left_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::swap(This &other,
+    std::true_type) noexcept
+{
+    using std::swap;
+    swap_tables(other);
+    swap(alloc_, other.alloc_);
+}
+
+
+/** \brief Swap with allocators that do not propagate.
+ *
+ *  Equal allocators exchange tables. Unequal ones exchange elements,
+ *  each map keeping its own allocator, as `allocator_aware_swap` does.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::swap(This &other,
+    std::false_type)
+{
+    if (alloc_ == other.alloc_) {
+        swap_tables(other);
+    } else {
+        This temp(std::move(*this));
+        *this = std::move(other);
+        other = std::move(temp);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_key(const Key &key,
+        Ts&&... ts)
+    -> std::pair<typename AllocTraits::value_type*, bool>
+{
+    size_t h = hash(key);
+    size_t i = find_index(key, h);
+    if (i != capacity_) {
+        return std::make_pair(slots_ + i, false);
+    }
+
+    i = prepare_insert(h);
+    AllocTraits::construct(alloc_, slots_ + i, std::forward<Ts>(ts)...);
+    growth_left_ -= ctrl_[i] == swiss::empty;
+    set_ctrl(i, static_cast<int8_t>(h & 0x7F));
+    ++size_;
+    return std::make_pair(slots_ + i, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void swap(flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator==(const flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
+{
+    if (left.size() != right.size()) {
+        return false;
+    }
+    for (const auto &value: left) {
+        auto it = right.find(value.first);
+        if (it == right.end() || !(it->second == value.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator!=(const flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map():
+    flat_hash_map(0)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map(size_type n,
+        const hasher &hash,
+        const key_equal &equal,
+        const allocator_type &alloc):
+    hash_(hash),
+    equal_(equal),
+    alloc_(alloc)
+{
+    reset();
+    if (n) {
+        resize(swiss::normalize_capacity(n));
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map(const allocator_type &alloc):
+    flat_hash_map(0, hasher(), key_equal(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map(std::initializer_list<value_type> list,
+        size_type n,
+        const hasher &hash,
+        const key_equal &equal,
+        const allocator_type &alloc):
+    flat_hash_map(list.begin(), list.end(), n, hash, equal, alloc)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map(Iter first,
+        Iter last,
+        size_type n,
+        const hasher &hash,
+        const key_equal &equal,
+        const allocator_type &alloc):
+    flat_hash_map(n, hash, equal, alloc)
+{
+    insert(first, last);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map(const This &other):
+    flat_hash_map(other, AllocTraits::select_on_container_copy_construction(other.alloc_))
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map(const This &other,
+        const allocator_type &alloc):
+    flat_hash_map(0, other.hash_, other.equal_, alloc)
+{
+    reserve(other.size());
+    for (const auto &value: other) {
+        emplace_key(value.first, value);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::flat_hash_map(This &&other) noexcept:
+    ctrl_(other.ctrl_),
+    slots_(other.slots_),
+    size_(other.size_),
+    capacity_(other.capacity_),
+    growth_left_(other.growth_left_),
+    hash_(std::move(other.hash_)),
+    equal_(std::move(other.equal_)),
+    alloc_(std::move(other.alloc_))
+{
+    other.reset();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    if (this != &other) {
+        copy_assign(other, typename AllocTraits::propagate_on_container_copy_assignment());
+    }
+    return *this;
+}
+
+
+/** \brief Move-assign, following the allocator's propagation rules.
+ *
+ *  The table of `other` is adopted when its allocator propagates or
+ *  compares equal. Otherwise this map keeps its allocator, and the
+ *  elements are moved one by one into its own table.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(This &&other) noexcept(AllocTraits::propagate_on_container_move_assignment::value)
+    -> This &
+{
+    if (this != &other) {
+        move_assign(other, typename AllocTraits::propagate_on_container_move_assignment());
+    }
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(std::initializer_list<value_type> list)
+    -> This &
+{
+    clear();
+    insert(list);
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::~flat_hash_map()
+{
+    destroy();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_size() const noexcept
+    -> size_type
+{
+    return AllocTraits::max_size(alloc_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::begin() noexcept
+    -> iterator
+{
+    return iterator(ctrl_, slots_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(ctrl_, slots_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::end() noexcept
+    -> iterator
+{
+    return iterator(ctrl_ + capacity_, slots_ + capacity_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(ctrl_ + capacity_, slots_ + capacity_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator[](const key_type &key)
+    -> mapped_type &
+{
+    return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>()).first->second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator[](key_type &&key)
+    -> mapped_type &
+{
+    return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::tuple<>()).first->second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::at(const key_type &key)
+    -> mapped_type &
+{
+    size_t i = find_index(key, hash(key));
+    if (i == capacity_) {
+        throw std::out_of_range("flat_hash_map::at");
+    }
+    return slots_[i].second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::at(const key_type &key) const
+    -> const mapped_type &
+{
+    size_t i = find_index(key, hash(key));
+    if (i == capacity_) {
+        throw std::out_of_range("flat_hash_map::at");
+    }
+    return slots_[i].second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::find(const key_type &key)
+    -> iterator
+{
+    size_t i = find_index(key, hash(key));
+    return iterator(ctrl_ + i, slots_ + i);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::find(const key_type &key) const
+    -> const_iterator
+{
+    size_t i = find_index(key, hash(key));
+    return const_iterator(ctrl_ + i, slots_ + i);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter, typename OutIter>
+OutIter flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_batch(Iter first,
+    Iter last,
+    OutIter out)
+{
+    find_batch_index(first, last, [this, &out](size_t i) {
+        *out++ = iterator(ctrl_ + i, slots_ + i);
+    });
+    return out;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter, typename OutIter>
+OutIter flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_batch(Iter first,
+    Iter last,
+    OutIter out) const
+{
+    find_batch_index(first, last, [this, &out](size_t i) {
+        *out++ = const_iterator(ctrl_ + i, slots_ + i);
+    });
+    return out;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::count(const key_type &key) const
+    -> size_type
+{
+    return find_index(key, hash(key)) != capacity_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const key_type &key)
+    -> std::pair<iterator, iterator>
+{
+    iterator first = find(key);
+    iterator last = first;
+    return std::make_pair(first, first == end() ? last : ++last);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const key_type &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    const_iterator first = find(key);
+    const_iterator last = first;
+    return std::make_pair(first, first == end() ? last : ++last);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace(Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    // construct first to find the key, as with std::unordered_map,
+    // in a mutable slot so the key is moved into the table
+    Slot value(std::forward<Ts>(ts)...);
+    auto result = emplace_key(value.first, std::move(value));
+    size_t i = static_cast<size_t>(result.first - slots_);
+    return std::make_pair(iterator(ctrl_ + i, result.first), result.second);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_hint(const_iterator,
+        Ts&&... ts)
+    -> iterator
+{
+    return emplace(std::forward<Ts>(ts)...).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(const value_type &value)
+    -> std::pair<iterator, bool>
+{
+    auto result = emplace_key(value.first, value);
+    size_t i = static_cast<size_t>(result.first - slots_);
+    return std::make_pair(iterator(ctrl_ + i, result.first), result.second);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(value_type &&value)
+    -> std::pair<iterator, bool>
+{
+    auto result = emplace_key(value.first, std::move(value));
+    size_t i = static_cast<size_t>(result.first - slots_);
+    return std::make_pair(iterator(ctrl_ + i, result.first), result.second);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(const_iterator,
+        const value_type &value)
+    -> iterator
+{
+    return insert(value).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(const_iterator,
+        value_type &&value)
+    -> iterator
+{
+    return insert(std::move(value)).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(Iter first,
+    Iter last)
+{
+    for (; first != last; ++first) {
+        emplace(*first);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(std::initializer_list<value_type> list)
+{
+    insert(list.begin(), list.end());
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase(const_iterator position)
+    -> iterator
+{
+    size_t i = static_cast<size_t>(position.ctrl() - ctrl_);
+    erase_index(i);
+    return iterator(ctrl_ + i + 1, slots_ + i + 1);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase(const_iterator first,
+        const_iterator last)
+    -> iterator
+{
+    while (first != last) {
+        first = erase(first);
+    }
+    size_t i = static_cast<size_t>(last.ctrl() - ctrl_);
+    return iterator(ctrl_ + i, slots_ + i);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase(const key_type &key)
+    -> size_type
+{
+    size_t i = find_index(key, hash(key));
+    if (i == capacity_) {
+        return 0;
+    }
+    erase_index(i);
+    return 1;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::clear() noexcept
+{
+    if (!capacity_) {
+        return;
+    }
+    for (size_t i = 0; i < capacity_; ++i) {
+        if (swiss::is_full(ctrl_[i])) {
+            AllocTraits::destroy(alloc_, slots_ + i);
+        }
+    }
+    std::memset(ctrl_, swiss::empty, capacity_ + swiss::group::width);
+    ctrl_[capacity_] = swiss::sentinel;
+    size_ = 0;
+    growth_left_ = swiss::capacity_to_growth(capacity_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::swap(This &other) noexcept(AllocTraits::propagate_on_container_swap::value || AllocTraits::is_always_equal::value)
+{
+    swap(other, typename AllocTraits::propagate_on_container_swap());
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::bucket_count() const noexcept
+    -> size_type
+{
+    return capacity_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_bucket_count() const noexcept
+    -> size_type
+{
+    return max_size();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+float flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::load_factor() const noexcept
+{
+    return capacity_ ? static_cast<float>(size_) / capacity_ : 0.0f;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+float flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_load_factor() const noexcept
+{
+    return 0.875f;
+}
+
+
+/** \brief Accepted for compatibility, the maximum load factor is fixed.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_load_factor(float) noexcept
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::rehash(size_type n)
+{
+    if (n == 0 && size_ == 0) {
+        destroy();
+        return;
+    }
+    size_t capacity = swiss::normalize_capacity(std::max(n, swiss::growth_to_capacity(size_)));
+    if (capacity != capacity_ && (n == 0 || capacity > capacity_)) {
+        resize(capacity);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::reserve(size_type n)
+{
+    if (n > size_ + growth_left_) {
+        resize(swiss::normalize_capacity(swiss::growth_to_capacity(n)));
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::hash_function() const
+    -> hasher
+{
+    return hash_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::key_eq() const
+    -> key_equal
+{
+    return equal_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto flat_hash_map<Key, Value, Hash, Pred, Alloc, Destructor>::get_allocator() const
+    -> allocator_type
+{
+    return alloc_;
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using flat_hash_map = itl::flat_hash_map<Key, Value, Hash, Pred, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
@@ -0,0 +1,687 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
+#include "flat.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Inheritable sorted-vector map.
+ *
+ *  Exports the member surface of `itl::map`, without node handles,
+ *  plus `reserve`, `shrink_to_fit`, and bulk inserts of sorted input.
+ *  Keys and values are stored in separate sorted `itl::vector`s, so
+ *  lookups binary search a dense array of keys, and iteration is a
+ *  linear scan. Inserts and erases shift the following elements, and
+ *  invalidate all iterators: best for maps built once and read often.
+ *
+ *  Like `std::flat_map`, iterators dereference to a pair of references
+ *  rather than to a stored `value_type`.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class flat_map: protected flat::map_table<Key, Value, Compare, Alloc, false>,
+    protected Destructor
+{
+protected:
+    typedef flat::map_table<Key, Value, Compare, Alloc, false> Base;
+    typedef flat_map<Key, Value, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(flat_map<K, V, C, A, D> &left, flat_map<K, V, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const flat_map<K, V, C, A, D> &left, const flat_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const flat_map<K, V, C, A, D> &left, const flat_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>(const flat_map<K, V, C, A, D> &left, const flat_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>=(const flat_map<K, V, C, A, D> &left, const flat_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<(const flat_map<K, V, C, A, D> &left, const flat_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<=(const flat_map<K, V, C, A, D> &left, const flat_map<K, V, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::mapped_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    flat_map();
+    flat_map(const This &other);
+    flat_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    flat_map(const This &other, const allocator_type &alloc);
+    flat_map(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~flat_map();
+
+     // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+    using Base::reserve;
+    using Base::shrink_to_fit;
+
+    // ELEMENT ACCESS
+    using Base::operator[];
+    using Base::at;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    using Base::try_emplace;
+    using Base::insert_or_assign;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+    using Base::keys;
+    using Base::values;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+/** \brief Inheritable sorted-vector multimap.
+ *
+ *  Exports the member surface of `itl::multimap`, without node
+ *  handles. Inserts and erases invalidate all iterators.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class flat_multimap: protected flat::map_table<Key, Value, Compare, Alloc, true>,
+    protected Destructor
+{
+protected:
+    typedef flat::map_table<Key, Value, Compare, Alloc, true> Base;
+    typedef flat_multimap<Key, Value, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(flat_multimap<K, V, C, A, D> &left, flat_multimap<K, V, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const flat_multimap<K, V, C, A, D> &left, const flat_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const flat_multimap<K, V, C, A, D> &left, const flat_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>(const flat_multimap<K, V, C, A, D> &left, const flat_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>=(const flat_multimap<K, V, C, A, D> &left, const flat_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<(const flat_multimap<K, V, C, A, D> &left, const flat_multimap<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<=(const flat_multimap<K, V, C, A, D> &left, const flat_multimap<K, V, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::mapped_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    flat_multimap();
+    flat_multimap(const This &other);
+    flat_multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    flat_multimap(const This &other, const allocator_type &alloc);
+    flat_multimap(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~flat_multimap();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+    using Base::reserve;
+    using Base::shrink_to_fit;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+    using Base::keys;
+    using Base::values;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_map<Key, Value, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_map<Key, Value, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_map<Key, Value, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_map<Key, Value, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(flat_map<Key, Value, Compare, Alloc, Destructor> &left,
+    flat_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const flat_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const flat_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const flat_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const flat_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const flat_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const flat_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_map<Key, Value, Compare, Alloc, Destructor>::flat_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_map<Key, Value, Compare, Alloc, Destructor>::flat_map(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_map<Key, Value, Compare, Alloc, Destructor>::flat_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_map<Key, Value, Compare, Alloc, Destructor>::flat_map(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_map<Key, Value, Compare, Alloc, Destructor>::flat_map(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_map<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_map<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_map<Key, Value, Compare, Alloc, Destructor>::~flat_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void flat_map<Key, Value, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+
+
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void flat_map<Key, Value, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void flat_map<Key, Value, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+
+
+
+
+
+
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_multimap<Key, Value, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_multimap<Key, Value, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_multimap<Key, Value, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_multimap<Key, Value, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(flat_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    flat_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const flat_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const flat_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const flat_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const flat_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const flat_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const flat_multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const flat_multimap<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_multimap<Key, Value, Compare, Alloc, Destructor>::flat_multimap()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_multimap<Key, Value, Compare, Alloc, Destructor>::flat_multimap(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_multimap<Key, Value, Compare, Alloc, Destructor>::flat_multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_multimap<Key, Value, Compare, Alloc, Destructor>::flat_multimap(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_multimap<Key, Value, Compare, Alloc, Destructor>::flat_multimap(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_multimap<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto flat_multimap<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+flat_multimap<Key, Value, Compare, Alloc, Destructor>::~flat_multimap()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void flat_multimap<Key, Value, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void flat_multimap<Key, Value, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void flat_multimap<Key, Value, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<Key, Value>>
+>
+using flat_map = itl::flat_map<Key, Value, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<Key, Value>>
+>
+using flat_multimap = itl::flat_multimap<Key, Value, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>
+>
+using flat_map = itl::flat_map<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<Key, Value>>>;
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>
+>
+using flat_multimap = itl::flat_multimap<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<Key, Value>>>;
+
+}   /* pmr */
+
+#endif
+
+}   /* itl */
@@ -0,0 +1,654 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
+#include "flat.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Inheritable sorted-vector set.
+ *
+ *  Exports the member surface of `itl::set`, without node handles,
+ *  plus `reserve`, `shrink_to_fit`, and bulk inserts of sorted input.
+ *  Keys are stored in a sorted `itl::vector`, so lookups are a binary
+ *  search over a single array, and iteration is a linear scan.
+ *  Inserts and erases shift the following keys, and invalidate all
+ *  iterators: best for sets built once and read often.
+ */
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class flat_set: protected flat::set_table<T, Compare, Alloc, false>,
+    protected Destructor
+{
+protected:
+    typedef flat::set_table<T, Compare, Alloc, false> Base;
+    typedef flat_set<T, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(flat_set<K, C, A, D> &left, flat_set<K, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const flat_set<K, C, A, D> &left, const flat_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const flat_set<K, C, A, D> &left, const flat_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const flat_set<K, C, A, D> &left, const flat_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const flat_set<K, C, A, D> &left, const flat_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const flat_set<K, C, A, D> &left, const flat_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const flat_set<K, C, A, D> &left, const flat_set<K, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    flat_set();
+    flat_set(const This &other);
+    flat_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    flat_set(const This &other, const allocator_type &alloc);
+    flat_set(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~flat_set();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+    using Base::reserve;
+    using Base::shrink_to_fit;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+/** \brief Inheritable sorted-vector multiset.
+ *
+ *  Exports the member surface of `itl::multiset`, without node
+ *  handles. Inserts and erases invalidate all iterators.
+ */
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class flat_multiset: protected flat::set_table<T, Compare, Alloc, true>,
+    protected Destructor
+{
+protected:
+    typedef flat::set_table<T, Compare, Alloc, true> Base;
+    typedef flat_multiset<T, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(flat_multiset<K, C, A, D> &left, flat_multiset<K, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const flat_multiset<K, C, A, D> &left, const flat_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const flat_multiset<K, C, A, D> &left, const flat_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const flat_multiset<K, C, A, D> &left, const flat_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const flat_multiset<K, C, A, D> &left, const flat_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const flat_multiset<K, C, A, D> &left, const flat_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const flat_multiset<K, C, A, D> &left, const flat_multiset<K, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    flat_multiset();
+    flat_multiset(const This &other);
+    flat_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    flat_multiset(const This &other, const allocator_type &alloc);
+    flat_multiset(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~flat_multiset();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+    using Base::reserve;
+    using Base::shrink_to_fit;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_set<Key, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_set<Key, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_set<Key, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_set<Key, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(flat_set<Key, Compare, Alloc, Destructor> &left,
+    flat_set<Key, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const flat_set<Key, Compare, Alloc, Destructor> &left,
+    const flat_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const flat_set<Key, Compare, Alloc, Destructor> &left,
+    const flat_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const flat_set<Key, Compare, Alloc, Destructor> &left,
+    const flat_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const flat_set<Key, Compare, Alloc, Destructor> &left,
+    const flat_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const flat_set<Key, Compare, Alloc, Destructor> &left,
+    const flat_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const flat_set<Key, Compare, Alloc, Destructor> &left,
+    const flat_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_set<Key, Compare, Alloc, Destructor>::flat_set()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_set<Key, Compare, Alloc, Destructor>::flat_set(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_set<Key, Compare, Alloc, Destructor>::flat_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_set<Key, Compare, Alloc, Destructor>::flat_set(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_set<Key, Compare, Alloc, Destructor>::flat_set(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_set<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_set<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_set<Key, Compare, Alloc, Destructor>::~flat_set()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void flat_set<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void flat_set<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void flat_set<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_multiset<Key, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_multiset<Key, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_multiset<Key, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_multiset<Key, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(flat_multiset<Key, Compare, Alloc, Destructor> &left,
+    flat_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const flat_multiset<Key, Compare, Alloc, Destructor> &left,
+    const flat_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const flat_multiset<Key, Compare, Alloc, Destructor> &left,
+    const flat_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const flat_multiset<Key, Compare, Alloc, Destructor> &left,
+    const flat_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const flat_multiset<Key, Compare, Alloc, Destructor> &left,
+    const flat_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const flat_multiset<Key, Compare, Alloc, Destructor> &left,
+    const flat_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const flat_multiset<Key, Compare, Alloc, Destructor> &left,
+    const flat_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_multiset<Key, Compare, Alloc, Destructor>::flat_multiset()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_multiset<Key, Compare, Alloc, Destructor>::flat_multiset(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_multiset<Key, Compare, Alloc, Destructor>::flat_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_multiset<Key, Compare, Alloc, Destructor>::flat_multiset(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_multiset<Key, Compare, Alloc, Destructor>::flat_multiset(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_multiset<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto flat_multiset<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+flat_multiset<Key, Compare, Alloc, Destructor>::~flat_multiset()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void flat_multiset<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void flat_multiset<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void flat_multiset<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using flat_set = itl::flat_set<T, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using flat_multiset = itl::flat_multiset<T, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using flat_set = itl::flat_set<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using flat_multiset = itl::flat_multiset<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
+}   /* itl */
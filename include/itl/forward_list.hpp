@@ -9,6 +9,9 @@
 #pragma once
 
 #include <forward_list>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
 
 
 namespace itl
@@ -21,13 +24,15 @@ namespace itl
  */
 template <
     typename T,
-    typename Alloc = std::allocator<T>
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
 >
-class forward_list: protected std::forward_list<T, Alloc>
+class forward_list: protected std::forward_list<T, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::forward_list<T, Alloc> Base;
-    typedef forward_list<T, Alloc> This;
+    typedef forward_list<T, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -36,27 +41,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename V, typename A>
-    friend void swap(forward_list<V, A> &left, forward_list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend void swap(forward_list<V, A, D> &left, forward_list<V, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename V, typename A>
-    friend bool operator==(const forward_list<V, A> &left, const forward_list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator==(const forward_list<V, A, D> &left, const forward_list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator!=(const forward_list<V, A> &left, const forward_list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator!=(const forward_list<V, A, D> &left, const forward_list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>(const forward_list<V, A> &left, const forward_list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>(const forward_list<V, A, D> &left, const forward_list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>=(const forward_list<V, A> &left, const forward_list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>=(const forward_list<V, A, D> &left, const forward_list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<(const forward_list<V, A> &left, const forward_list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<(const forward_list<V, A, D> &left, const forward_list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<=(const forward_list<V, A> &left, const forward_list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<=(const forward_list<V, A, D> &left, const forward_list<V, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -75,7 +80,14 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~forward_list();
+    forward_list();
+    forward_list(const This &other);
+    forward_list(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    forward_list(const This &other, const allocator_type &alloc);
+    forward_list(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~forward_list();
 
     // ITERATORS
     using Base::before_begin;
@@ -134,173 +146,253 @@ public:
 // --------------
 
 
-template <typename T, typename Alloc>
-auto forward_list<T, Alloc>::ref() const
+template <typename T, typename Alloc, typename Destructor>
+auto forward_list<T, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto forward_list<T, Alloc>::ref()
+template <typename T, typename Alloc, typename Destructor>
+auto forward_list<T, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto forward_list<T, Alloc>::forward() const
+template <typename T, typename Alloc, typename Destructor>
+auto forward_list<T, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto forward_list<T, Alloc>::forward()
+template <typename T, typename Alloc, typename Destructor>
+auto forward_list<T, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-void swap(forward_list<T, Alloc> &left,
-    forward_list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+void swap(forward_list<T, Alloc, Destructor> &left,
+    forward_list<T, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename T, typename Alloc>
-bool operator==(const forward_list<T, Alloc> &left,
-    const forward_list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator==(const forward_list<T, Alloc, Destructor> &left,
+    const forward_list<T, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator!=(const forward_list<T, Alloc> &left,
-    const forward_list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator!=(const forward_list<T, Alloc, Destructor> &left,
+    const forward_list<T, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>(const forward_list<T, Alloc> &left,
-    const forward_list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>(const forward_list<T, Alloc, Destructor> &left,
+    const forward_list<T, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>=(const forward_list<T, Alloc> &left,
-    const forward_list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>=(const forward_list<T, Alloc, Destructor> &left,
+    const forward_list<T, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<(const forward_list<T, Alloc> &left,
-    const forward_list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<(const forward_list<T, Alloc, Destructor> &left,
+    const forward_list<T, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<=(const forward_list<T, Alloc> &left,
-    const forward_list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<=(const forward_list<T, Alloc, Destructor> &left,
+    const forward_list<T, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-forward_list<T, Alloc>::~forward_list()
+template <typename T, typename Alloc, typename Destructor>
+forward_list<T, Alloc, Destructor>::forward_list()
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+forward_list<T, Alloc, Destructor>::forward_list(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+forward_list<T, Alloc, Destructor>::forward_list(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+forward_list<T, Alloc, Destructor>::forward_list(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+forward_list<T, Alloc, Destructor>::forward_list(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto forward_list<T, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto forward_list<T, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+forward_list<T, Alloc, Destructor>::~forward_list()
 {}
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::splice_after(const_iterator position, This &x)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::splice_after(const_iterator position, This &x)
 {
     ref().splice_after(position, x.ref());
 }
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::splice_after(const_iterator position, This &&x)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::splice_after(const_iterator position, This &&x)
 {
     ref().splice_after(position, x.forward());
 }
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::splice_after(const_iterator position, This &x, const_iterator i)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::splice_after(const_iterator position, This &x, const_iterator i)
 {
     ref().splice_after(position, x.ref(), i);
 }
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::splice_after(const_iterator position, This &&x, const_iterator i)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::splice_after(const_iterator position, This &&x, const_iterator i)
 {
     ref().splice_after(position, x.forward(), i);
 }
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::splice_after(const_iterator position, This &x, const_iterator first, const_iterator last)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::splice_after(const_iterator position, This &x, const_iterator first, const_iterator last)
 {
     ref().splice_after(position, x.ref(), first, last);
 }
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::splice_after(const_iterator position, This &&x, const_iterator first, const_iterator last)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::splice_after(const_iterator position, This &&x, const_iterator first, const_iterator last)
 {
     ref().splice_after(position, x.forward(), first, last);
 }
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::merge(This &x)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::merge(This &x)
 {
     ref().merge(x.ref());
 }
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::merge(This &&x)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::merge(This &&x)
 {
     ref().merge(x.forward());
 }
 
 
-template <typename T, typename Alloc>
+template <typename T, typename Alloc, typename Destructor>
 template <typename Compare>
-void forward_list<T, Alloc>::merge(This &x, Compare comp)
+void forward_list<T, Alloc, Destructor>::merge(This &x, Compare comp)
 {
     ref().merge(x.ref(), comp);
 }
 
-template <typename T, typename Alloc>
+template <typename T, typename Alloc, typename Destructor>
 template <typename Compare>
-void forward_list<T, Alloc>::merge(This &&x, Compare comp)
+void forward_list<T, Alloc, Destructor>::merge(This &&x, Compare comp)
 {
     ref().merge(x.forward(), comp);
 }
 
 
-template <typename T, typename Alloc>
-void forward_list<T, Alloc>::swap(This &other)
+template <typename T, typename Alloc, typename Destructor>
+void forward_list<T, Alloc, Destructor>::swap(This &other)
 {
-    ref().swap(other.ref());
+    allocator_aware_swap(ref(), other.ref());
 }
 
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Alloc = std::allocator<T>
+>
+using forward_list = itl::forward_list<T, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <typename T>
+using forward_list = itl::forward_list<T, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
@@ -0,0 +1,219 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER)
+#   include <xmmintrin.h>
+#endif
+
+
+namespace itl
+{
+namespace hashed
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Key of an element of a std unordered container.
+ */
+template <typename Container>
+auto key(const typename Container::value_type &value)
+    -> const typename Container::key_type &;
+
+
+/** \brief Find the first element equal to `key`, whose hash is `hash`.
+ *
+ *  The standard unordered containers expose no lookup by hash, but
+ *  libstdc++, libc++ and MSVC all map hashes to buckets modulo the
+ *  bucket count, so the bucket is scanned directly, comparing keys
+ *  without hashing `key`. With libstdc++, hits are converted from
+ *  local iterators in place; other libraries look up hits again.
+ */
+template <typename Iterator, typename Container, typename K>
+Iterator find(Container &container, const K &key, size_t hash);
+
+
+/** \brief Count the elements equal to `key`, whose hash is `hash`.
+ */
+template <typename Container, typename K>
+auto count(const Container &container, const K &key, size_t hash)
+    -> typename Container::size_type;
+
+
+/** \brief Range of the elements equal to `key`, whose hash is `hash`.
+ */
+template <typename Iterator, typename Container, typename K>
+std::pair<Iterator, Iterator> equal_range(Container &container, const K &key, size_t hash);
+
+
+/** \brief Erase the elements equal to `key`, whose hash is `hash`.
+ */
+template <typename Container>
+auto erase(Container &container, const typename Container::key_type &key, size_t hash)
+    -> typename Container::size_type;
+
+
+/** \brief Hint that `address` will be read soon.
+ */
+void prefetch(const void *address) noexcept;
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline void prefetch(const void *address) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#elif defined(_MSC_VER)
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+    (void) address;
+#endif
+}
+
+
+template <typename Container>
+auto key(const typename Container::value_type &value,
+        std::true_type)
+    -> const typename Container::key_type &
+{
+    return value;
+}
+
+
+template <typename Container>
+auto key(const typename Container::value_type &value,
+        std::false_type)
+    -> const typename Container::key_type &
+{
+    return value.first;
+}
+
+
+template <typename Container>
+auto key(const typename Container::value_type &value)
+    -> const typename Container::key_type &
+{
+    typedef typename Container::key_type key_type;
+    typedef typename Container::value_type value_type;
+    return key<Container>(value, std::is_same<key_type, value_type>());
+}
+
+
+/** \brief Iterator to the element at a local iterator.
+ *
+ *  No standard library converts local iterators publicly. libstdc++
+ *  local and global iterators wrap the same node pointer, so it is
+ *  rewrapped, as vector.hpp reaches the storage of `std::vector`.
+ *  Elsewhere, the element's own key is looked up again.
+ */
+template <typename Iterator, typename Container, typename Local>
+Iterator convert(Container &container,
+    const Local &local)
+{
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)
+    (void) container;
+    return Iterator(local._M_cur);
+#else
+    return container.find(key<typename std::remove_const<Container>::type>(*local));
+#endif
+}
+
+
+template <typename Iterator, typename Container, typename K>
+Iterator find(Container &container,
+    const K &key,
+    size_t hash)
+{
+    typedef typename std::remove_const<Container>::type Base;
+    assert(hash == container.hash_function()(key));
+
+    size_t buckets = container.bucket_count();
+    if (!buckets) {
+        return container.end();
+    }
+    size_t n = hash % buckets;
+    auto equal = container.key_eq();
+    auto last = container.cend(n);
+    for (auto it = container.cbegin(n); it != last; ++it) {
+        if (equal(hashed::key<Base>(*it), key)) {
+            return convert<Iterator>(container, it);
+        }
+    }
+    return container.end();
+}
+
+
+template <typename Container, typename K>
+auto count(const Container &container,
+        const K &key,
+        size_t hash)
+    -> typename Container::size_type
+{
+    assert(hash == container.hash_function()(key));
+
+    size_t buckets = container.bucket_count();
+    if (!buckets) {
+        return 0;
+    }
+    size_t n = hash % buckets;
+    typename Container::size_type matches = 0;
+    auto equal = container.key_eq();
+    auto last = container.cend(n);
+    for (auto it = container.cbegin(n); it != last; ++it) {
+        matches += equal(hashed::key<Container>(*it), key);
+    }
+    return matches;
+}
+
+
+template <typename Iterator, typename Container, typename K>
+std::pair<Iterator, Iterator> equal_range(Container &container,
+    const K &key,
+    size_t hash)
+{
+    typedef typename std::remove_const<Container>::type Base;
+    Iterator first = find<Iterator>(container, key, hash);
+    Iterator last = first;
+    auto equal = container.key_eq();
+    // equivalent keys are adjacent in iteration order
+    while (last != container.end() && equal(hashed::key<Base>(*last), key)) {
+        ++last;
+    }
+    return std::make_pair(first, last);
+}
+
+
+template <typename Container>
+auto erase(Container &container,
+        const typename Container::key_type &key,
+        size_t hash)
+    -> typename Container::size_type
+{
+    auto it = find<typename Container::iterator>(container, key, hash);
+    typename Container::size_type erased = 0;
+    auto equal = container.key_eq();
+    // equivalent keys are adjacent in iteration order
+    while (it != container.end() && equal(hashed::key<Container>(*it), key)) {
+        it = container.erase(it);
+        ++erased;
+    }
+    return erased;
+}
+
+}   /* hashed */
+}   /* itl */
@@ -0,0 +1,1312 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "destructor.hpp"
+#include "hashed.hpp"
+
+
+namespace itl
+{
+namespace incremental
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Chained node storing the element and its mixed hash.
+ */
+template <typename T>
+struct node
+{
+    node *next;
+    size_t hash;
+    T value;
+};
+
+
+/** \brief Bucket arrays of a table, possibly mid-migration.
+ *
+ *  While migrating, old buckets at or past `migrated` still hold
+ *  their chains, and each old bucket `i` splits into the new buckets
+ *  `i` and `i + old_count` once moved. New buckets whose old bucket
+ *  has not been moved are uninitialized.
+ */
+template <typename Node>
+struct table
+{
+    Node **buckets;
+    size_t count;
+    Node **old_buckets;
+    size_t old_count;
+    size_t migrated;
+
+    Node ** head(size_t hash) const noexcept;
+    size_t positions() const noexcept;
+    bool valid(size_t position) const noexcept;
+    Node * at(size_t position) const noexcept;
+};
+
+
+/** \brief Forward iterator over the chains of both bucket arrays.
+ */
+template <typename Node, typename T>
+class iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef T * pointer;
+    typedef T & reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    iterator() noexcept;
+    iterator(const table<Node> *tables, size_t position, Node *node) noexcept;
+
+    template <
+        typename U,
+        typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type
+    >
+    iterator(const iterator<Node, U> &other) noexcept;
+
+    reference operator*() const;
+    pointer operator->() const;
+    iterator & operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+
+    const table<Node> * owner() const noexcept;
+    size_t position() const noexcept;
+    Node * get() const noexcept;
+
+private:
+    void skip() noexcept;
+
+    const table<Node> *table_;
+    size_t position_;
+    Node *node_;
+};
+
+}   /* incremental */
+
+
+/** \brief Chained hash map rehashing a few buckets per insertion.
+ *
+ *  Exports the member surface of `itl::unordered_map`. Crossing the
+ *  maximum load factor allocates a bucket array twice the size, but
+ *  chains are moved into it a bounded number of buckets per insert,
+ *  rather than all at once, so no single insertion stalls on the
+ *  whole table. Every element has exactly one home during the
+ *  migration, so lookups still probe a single chain. As with
+ *  `std::unordered_map`, references remain valid on rehashing, and
+ *  insertion invalidates iterators. Swapping also invalidates
+ *  iterators. `rehash` and `reserve` complete synchronously.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class incremental_unordered_map: protected Destructor
+{
+protected:
+    typedef incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> This;
+    typedef incremental::node<std::pair<const Key, Value>> Node;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<Node> NodeAlloc;
+    typedef std::allocator_traits<NodeAlloc> NodeTraits;
+    typedef typename AllocTraits::template rebind_alloc<Node*> BucketAlloc;
+    typedef std::allocator_traits<BucketAlloc> BucketTraits;
+
+    static const size_t min_buckets = 8;
+    static const size_t migrate_steps = 8;
+
+    size_t hash(const Key &key) const;
+    Node * find_node(const Key &key, size_t hash) const;
+
+    template <typename Iter, typename Function>
+    void find_batch_node(Iter first, Iter last, Function function) const;
+    Node ** allocate_buckets(size_t count);
+    void deallocate_buckets(Node **buckets, size_t count) noexcept;
+    void grow();
+    void migrate(size_t steps) noexcept;
+    void rebuild(size_t count);
+    void unlink(Node *node) noexcept;
+    void destroy() noexcept;
+    void reset() noexcept;
+
+    template <typename... Ts>
+    std::pair<Node*, bool> emplace_key(const Key &key, Ts&&... ts);
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend void swap(incremental_unordered_map<K, V, H, P, A, D> &left, incremental_unordered_map<K, V, H, P, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    // --------------------
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator==(const incremental_unordered_map<K, V, H, P, A, D> &left, const incremental_unordered_map<K, V, H, P, A, D> &right);
+
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator!=(const incremental_unordered_map<K, V, H, P, A, D> &left, const incremental_unordered_map<K, V, H, P, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef std::pair<const Key, Value> value_type;
+    typedef Value mapped_type;
+    typedef Hash hasher;
+    typedef Pred key_equal;
+    typedef Alloc allocator_type;
+    typedef value_type & reference;
+    typedef const value_type & const_reference;
+    typedef typename AllocTraits::pointer pointer;
+    typedef typename AllocTraits::const_pointer const_pointer;
+    typedef incremental::iterator<Node, value_type> iterator;
+    typedef incremental::iterator<Node, const value_type> const_iterator;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    incremental_unordered_map();
+    explicit incremental_unordered_map(size_type n, const hasher &hash = hasher(), const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type());
+    explicit incremental_unordered_map(const allocator_type &alloc);
+    incremental_unordered_map(std::initializer_list<value_type> list, size_type n = 0, const hasher &hash = hasher(), const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type());
+
+    template <typename Iter>
+    incremental_unordered_map(Iter first, Iter last, size_type n = 0, const hasher &hash = hasher(), const key_equal &equal = key_equal(), const allocator_type &alloc = allocator_type());
+
+    incremental_unordered_map(const This &other);
+    incremental_unordered_map(This &&other) noexcept;
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept;
+    This & operator=(std::initializer_list<value_type> list);
+    ~incremental_unordered_map();
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+
+    // ITERATORS
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // ELEMENT ACCESS
+    mapped_type & operator[](const key_type &key);
+    mapped_type & operator[](key_type &&key);
+    mapped_type & at(const key_type &key);
+    const mapped_type & at(const key_type &key) const;
+
+    // LOOKUP
+    iterator find(const key_type &key);
+    const_iterator find(const key_type &key) const;
+    size_type count(const key_type &key) const;
+    std::pair<iterator, iterator> equal_range(const key_type &key);
+    std::pair<const_iterator, const_iterator> equal_range(const key_type &key) const;
+
+    template <typename Iter, typename OutIter>
+    OutIter find_batch(Iter first, Iter last, OutIter out);
+
+    template <typename Iter, typename OutIter>
+    OutIter find_batch(Iter first, Iter last, OutIter out) const;
+
+    // MODIFIERS
+    template <typename... Ts>
+    std::pair<iterator, bool> emplace(Ts&&... ts);
+
+    template <typename... Ts>
+    iterator emplace_hint(const_iterator hint, Ts&&... ts);
+
+    std::pair<iterator, bool> insert(const value_type &value);
+    std::pair<iterator, bool> insert(value_type &&value);
+    iterator insert(const_iterator hint, const value_type &value);
+    iterator insert(const_iterator hint, value_type &&value);
+
+    template <typename Iter>
+    void insert(Iter first, Iter last);
+
+    void insert(std::initializer_list<value_type> list);
+    iterator erase(const_iterator position);
+    iterator erase(const_iterator first, const_iterator last);
+    size_type erase(const key_type &key);
+    void clear() noexcept;
+    void swap(This &other) noexcept;
+
+    // BUCKETS
+    size_type bucket_count() const noexcept;
+    size_type max_bucket_count() const noexcept;
+    bool rehashing() const noexcept;
+
+    // HASH POLICY
+    float load_factor() const noexcept;
+    float max_load_factor() const noexcept;
+    void max_load_factor(float ml) noexcept;
+    void rehash(size_type n);
+    void reserve(size_type n);
+
+    // OBSERVERS
+    hasher hash_function() const;
+    key_equal key_eq() const;
+    allocator_type get_allocator() const;
+
+private:
+    iterator make_iterator(Node *node) const noexcept;
+
+    incremental::table<Node> table_;
+    size_t size_;
+    float max_load_;
+    hasher hash_;
+    key_equal equal_;
+    NodeAlloc alloc_;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+namespace incremental
+{
+
+template <typename Node>
+Node ** table<Node>::head(size_t hash) const noexcept
+{
+    if (old_count) {
+        size_t i = hash & (old_count - 1);
+        if (i >= migrated) {
+            return old_buckets + i;
+        }
+    }
+    return buckets + (hash & (count - 1));
+}
+
+
+template <typename Node>
+size_t table<Node>::positions() const noexcept
+{
+    return old_count + count;
+}
+
+
+template <typename Node>
+bool table<Node>::valid(size_t position) const noexcept
+{
+    if (position < old_count) {
+        return position >= migrated;
+    }
+    return !old_count || ((position - old_count) & (old_count - 1)) < migrated;
+}
+
+
+template <typename Node>
+Node * table<Node>::at(size_t position) const noexcept
+{
+    if (!valid(position)) {
+        return nullptr;
+    }
+    return position < old_count ? old_buckets[position] : buckets[position - old_count];
+}
+
+
+template <typename Node, typename T>
+iterator<Node, T>::iterator() noexcept:
+    table_(nullptr),
+    position_(0),
+    node_(nullptr)
+{}
+
+
+template <typename Node, typename T>
+iterator<Node, T>::iterator(const table<Node> *tables,
+        size_t position,
+        Node *node) noexcept:
+    table_(tables),
+    position_(position),
+    node_(node)
+{
+    skip();
+}
+
+
+template <typename Node, typename T>
+template <typename U, typename>
+iterator<Node, T>::iterator(const iterator<Node, U> &other) noexcept:
+    table_(other.owner()),
+    position_(other.position()),
+    node_(other.get())
+{}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator*() const
+    -> reference
+{
+    return node_->value;
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator->() const
+    -> pointer
+{
+    return std::addressof(node_->value);
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator++()
+    -> iterator &
+{
+    node_ = node_->next;
+    skip();
+    return *this;
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator++(int)
+    -> iterator
+{
+    iterator copy(*this);
+    ++*this;
+    return copy;
+}
+
+
+template <typename Node, typename T>
+bool iterator<Node, T>::operator==(const iterator &other) const noexcept
+{
+    return node_ == other.node_;
+}
+
+
+template <typename Node, typename T>
+bool iterator<Node, T>::operator!=(const iterator &other) const noexcept
+{
+    return node_ != other.node_;
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::owner() const noexcept
+    -> const table<Node> *
+{
+    return table_;
+}
+
+
+template <typename Node, typename T>
+size_t iterator<Node, T>::position() const noexcept
+{
+    return position_;
+}
+
+
+template <typename Node, typename T>
+Node * iterator<Node, T>::get() const noexcept
+{
+    return node_;
+}
+
+
+template <typename Node, typename T>
+void iterator<Node, T>::skip() noexcept
+{
+    if (!table_) {
+        return;
+    }
+    size_t positions = table_->positions();
+    while (!node_ && ++position_ < positions) {
+        node_ = table_->at(position_);
+    }
+}
+
+}   /* incremental */
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+size_t incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::hash(const Key &key) const
+{
+    // spread identity hashes into the low bits used for indexing
+    uint64_t h = static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_node(const Key &key,
+        size_t hash) const
+    -> Node *
+{
+    if (!size_) {
+        return nullptr;
+    }
+    for (Node *node = *table_.head(hash); node; node = node->next) {
+        if (node->hash == hash && equal_(node->value.first, key)) {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+
+/** \brief Call `function` with the node of each key in `[first, last)`.
+ *
+ *  Keys are resolved in groups of 16, in three passes: hash each key
+ *  and prefetch its bucket, prefetch the head node of each bucket,
+ *  then scan the chains, so the cache misses of a group overlap.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter, typename Function>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_batch_node(Iter first,
+    Iter last,
+    Function function) const
+{
+    const size_t width = 16;
+    const Key *keys[width];
+    size_t hashes[width];
+
+    while (first != last) {
+        size_t count = 0;
+        for (; count < width && first != last; ++count, ++first) {
+            keys[count] = std::addressof(*first);
+            hashes[count] = hash(*keys[count]);
+            if (size_) {
+                hashed::prefetch(table_.head(hashes[count]));
+            }
+        }
+        for (size_t i = 0; size_ && i < count; ++i) {
+            Node *node = *table_.head(hashes[i]);
+            if (node) {
+                hashed::prefetch(node);
+            }
+        }
+        for (size_t i = 0; i < count; ++i) {
+            function(find_node(*keys[i], hashes[i]));
+        }
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::allocate_buckets(size_t count)
+    -> Node **
+{
+    BucketAlloc alloc(alloc_);
+    return BucketTraits::allocate(alloc, count);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::deallocate_buckets(Node **buckets,
+    size_t count) noexcept
+{
+    BucketAlloc alloc(alloc_);
+    BucketTraits::deallocate(alloc, buckets, count);
+}
+
+
+/** \brief Start migrating to twice the buckets, if over the load factor.
+ *
+ *  The new array is left uninitialized, each bucket being written
+ *  when its old bucket is moved, so growing costs only an allocation.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::grow()
+{
+    if (!table_.count) {
+        rebuild(min_buckets);
+        return;
+    }
+    if (static_cast<float>(size_ + 1) <= max_load_ * table_.count) {
+        return;
+    }
+
+    if (table_.old_count) {
+        migrate(table_.old_count);
+    }
+    Node **buckets = allocate_buckets(2 * table_.count);
+    table_.old_buckets = table_.buckets;
+    table_.old_count = table_.count;
+    table_.migrated = 0;
+    table_.buckets = buckets;
+    table_.count = 2 * table_.count;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::migrate(size_t steps) noexcept
+{
+    size_t mask = table_.count - 1;
+    for (; steps && table_.migrated < table_.old_count; --steps) {
+        size_t i = table_.migrated++;
+        Node *node = table_.old_buckets[i];
+        table_.buckets[i] = nullptr;
+        table_.buckets[i + table_.old_count] = nullptr;
+        while (node) {
+            Node *next = node->next;
+            Node **head = table_.buckets + (node->hash & mask);
+            node->next = *head;
+            *head = node;
+            node = next;
+        }
+    }
+
+    if (table_.old_count && table_.migrated == table_.old_count) {
+        deallocate_buckets(table_.old_buckets, table_.old_count);
+        table_.old_buckets = nullptr;
+        table_.old_count = 0;
+        table_.migrated = 0;
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::rebuild(size_t count)
+{
+    Node **buckets = allocate_buckets(count);
+    std::fill(buckets, buckets + count, nullptr);
+    migrate(table_.old_count);
+
+    for (size_t i = 0; i < table_.count; ++i) {
+        Node *node = table_.buckets[i];
+        while (node) {
+            Node *next = node->next;
+            Node **head = buckets + (node->hash & (count - 1));
+            node->next = *head;
+            *head = node;
+            node = next;
+        }
+    }
+
+    if (table_.count) {
+        deallocate_buckets(table_.buckets, table_.count);
+    }
+    table_.buckets = buckets;
+    table_.count = count;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::unlink(Node *node) noexcept
+{
+    Node **link = table_.head(node->hash);
+    while (*link != node) {
+        link = &(*link)->next;
+    }
+    *link = node->next;
+    NodeTraits::destroy(alloc_, std::addressof(node->value));
+    NodeTraits::deallocate(alloc_, node, 1);
+    --size_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::destroy() noexcept
+{
+    clear();
+    if (table_.count) {
+        deallocate_buckets(table_.buckets, table_.count);
+    }
+    reset();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::reset() noexcept
+{
+    table_.buckets = nullptr;
+    table_.count = 0;
+    table_.old_buckets = nullptr;
+    table_.old_count = 0;
+    table_.migrated = 0;
+    size_ = 0;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_key(const Key &key,
+        Ts&&... ts)
+    -> std::pair<Node*, bool>
+{
+    size_t h = hash(key);
+    Node *node = find_node(key, h);
+    if (node) {
+        return std::make_pair(node, false);
+    }
+
+    node = NodeTraits::allocate(alloc_, 1);
+    try {
+        NodeTraits::construct(alloc_, std::addressof(node->value), std::forward<Ts>(ts)...);
+    } catch (...) {
+        NodeTraits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    try {
+        grow();
+    } catch (...) {
+        NodeTraits::destroy(alloc_, std::addressof(node->value));
+        NodeTraits::deallocate(alloc_, node, 1);
+        throw;
+    }
+    migrate(migrate_steps);
+
+    Node **head = table_.head(h);
+    node->hash = h;
+    node->next = *head;
+    *head = node;
+    ++size_;
+    return std::make_pair(node, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::make_iterator(Node *node) const noexcept
+    -> iterator
+{
+    if (!node) {
+        return iterator(&table_, table_.positions(), nullptr);
+    }
+    Node **head = table_.head(node->hash);
+    size_t position;
+    if (table_.old_count && head >= table_.old_buckets && head < table_.old_buckets + table_.old_count) {
+        position = static_cast<size_t>(head - table_.old_buckets);
+    } else {
+        position = table_.old_count + static_cast<size_t>(head - table_.buckets);
+    }
+    return iterator(&table_, position, node);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void swap(incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator==(const incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
+{
+    if (left.size() != right.size()) {
+        return false;
+    }
+    for (const auto &value: left) {
+        auto it = right.find(value.first);
+        if (it == right.end() || !(it->second == value.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator!=(const incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::incremental_unordered_map():
+    incremental_unordered_map(0)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::incremental_unordered_map(size_type n,
+        const hasher &hash,
+        const key_equal &equal,
+        const allocator_type &alloc):
+    max_load_(1.0f),
+    hash_(hash),
+    equal_(equal),
+    alloc_(alloc)
+{
+    reset();
+    if (n) {
+        rehash(n);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::incremental_unordered_map(const allocator_type &alloc):
+    incremental_unordered_map(0, hasher(), key_equal(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::incremental_unordered_map(std::initializer_list<value_type> list,
+        size_type n,
+        const hasher &hash,
+        const key_equal &equal,
+        const allocator_type &alloc):
+    incremental_unordered_map(list.begin(), list.end(), n, hash, equal, alloc)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::incremental_unordered_map(Iter first,
+        Iter last,
+        size_type n,
+        const hasher &hash,
+        const key_equal &equal,
+        const allocator_type &alloc):
+    incremental_unordered_map(n, hash, equal, alloc)
+{
+    insert(first, last);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::incremental_unordered_map(const This &other):
+    incremental_unordered_map(0, other.hash_, other.equal_, AllocTraits::select_on_container_copy_construction(allocator_type(other.alloc_)))
+{
+    max_load_ = other.max_load_;
+    reserve(other.size());
+    for (const auto &value: other) {
+        emplace_key(value.first, value);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::incremental_unordered_map(This &&other) noexcept:
+    table_(other.table_),
+    size_(other.size_),
+    max_load_(other.max_load_),
+    hash_(std::move(other.hash_)),
+    equal_(std::move(other.equal_)),
+    alloc_(std::move(other.alloc_))
+{
+    other.reset();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    if (this != &other) {
+        This copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    if (this != &other) {
+        destroy();
+        swap(other);
+    }
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(std::initializer_list<value_type> list)
+    -> This &
+{
+    clear();
+    insert(list);
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::~incremental_unordered_map()
+{
+    destroy();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_size() const noexcept
+    -> size_type
+{
+    return NodeTraits::max_size(alloc_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::begin() noexcept
+    -> iterator
+{
+    return iterator(&table_, 0, table_.positions() ? table_.at(0) : nullptr);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(&table_, 0, table_.positions() ? table_.at(0) : nullptr);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::end() noexcept
+    -> iterator
+{
+    return iterator(&table_, table_.positions(), nullptr);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(&table_, table_.positions(), nullptr);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator[](const key_type &key)
+    -> mapped_type &
+{
+    return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key), std::tuple<>()).first->value.second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator[](key_type &&key)
+    -> mapped_type &
+{
+    return emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)), std::tuple<>()).first->value.second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::at(const key_type &key)
+    -> mapped_type &
+{
+    Node *node = find_node(key, hash(key));
+    if (!node) {
+        throw std::out_of_range("incremental_unordered_map::at");
+    }
+    return node->value.second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::at(const key_type &key) const
+    -> const mapped_type &
+{
+    Node *node = find_node(key, hash(key));
+    if (!node) {
+        throw std::out_of_range("incremental_unordered_map::at");
+    }
+    return node->value.second;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find(const key_type &key)
+    -> iterator
+{
+    return make_iterator(find_node(key, hash(key)));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find(const key_type &key) const
+    -> const_iterator
+{
+    return make_iterator(find_node(key, hash(key)));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter, typename OutIter>
+OutIter incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_batch(Iter first,
+    Iter last,
+    OutIter out)
+{
+    find_batch_node(first, last, [this, &out](Node *node) {
+        *out++ = make_iterator(node);
+    });
+    return out;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter, typename OutIter>
+OutIter incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_batch(Iter first,
+    Iter last,
+    OutIter out) const
+{
+    find_batch_node(first, last, [this, &out](Node *node) {
+        *out++ = const_iterator(make_iterator(node));
+    });
+    return out;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::count(const key_type &key) const
+    -> size_type
+{
+    return find_node(key, hash(key)) != nullptr;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const key_type &key)
+    -> std::pair<iterator, iterator>
+{
+    iterator first = find(key);
+    iterator last = first;
+    return std::make_pair(first, first == end() ? last : ++last);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const key_type &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    const_iterator first = find(key);
+    const_iterator last = first;
+    return std::make_pair(first, first == end() ? last : ++last);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace(Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    // construct first to find the key, as with std::unordered_map
+    value_type value(std::forward<Ts>(ts)...);
+    auto result = emplace_key(value.first, std::move(value));
+    return std::make_pair(make_iterator(result.first), result.second);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_hint(const_iterator,
+        Ts&&... ts)
+    -> iterator
+{
+    return emplace(std::forward<Ts>(ts)...).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(const value_type &value)
+    -> std::pair<iterator, bool>
+{
+    auto result = emplace_key(value.first, value);
+    return std::make_pair(make_iterator(result.first), result.second);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(value_type &&value)
+    -> std::pair<iterator, bool>
+{
+    auto result = emplace_key(value.first, std::move(value));
+    return std::make_pair(make_iterator(result.first), result.second);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(const_iterator,
+        const value_type &value)
+    -> iterator
+{
+    return insert(value).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(const_iterator,
+        value_type &&value)
+    -> iterator
+{
+    return insert(std::move(value)).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename Iter>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(Iter first,
+    Iter last)
+{
+    for (; first != last; ++first) {
+        emplace(*first);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert(std::initializer_list<value_type> list)
+{
+    insert(list.begin(), list.end());
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase(const_iterator position)
+    -> iterator
+{
+    // erasing never migrates, so other iterators stay valid
+    Node *node = position.get();
+    ++position;
+    unlink(node);
+    return iterator(&table_, position.position(), position.get());
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase(const_iterator first,
+        const_iterator last)
+    -> iterator
+{
+    while (first != last) {
+        first = erase(first);
+    }
+    return iterator(&table_, last.position(), last.get());
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase(const key_type &key)
+    -> size_type
+{
+    Node *node = find_node(key, hash(key));
+    if (!node) {
+        return 0;
+    }
+    unlink(node);
+    return 1;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::clear() noexcept
+{
+    size_t positions = table_.positions();
+    for (size_t i = 0; i < positions; ++i) {
+        Node *node = table_.at(i);
+        while (node) {
+            Node *next = node->next;
+            NodeTraits::destroy(alloc_, std::addressof(node->value));
+            NodeTraits::deallocate(alloc_, node, 1);
+            node = next;
+        }
+    }
+
+    if (table_.old_count) {
+        deallocate_buckets(table_.old_buckets, table_.old_count);
+        table_.old_buckets = nullptr;
+        table_.old_count = 0;
+        table_.migrated = 0;
+    }
+    std::fill(table_.buckets, table_.buckets + table_.count, nullptr);
+    size_ = 0;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::swap(This &other) noexcept
+{
+    using std::swap;
+    swap(table_, other.table_);
+    swap(size_, other.size_);
+    swap(max_load_, other.max_load_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+    swap(alloc_, other.alloc_);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::bucket_count() const noexcept
+    -> size_type
+{
+    return table_.count;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_bucket_count() const noexcept
+    -> size_type
+{
+    BucketAlloc alloc(alloc_);
+    return BucketTraits::max_size(alloc);
+}
+
+
+/** \brief If buckets are still being moved to the larger array.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::rehashing() const noexcept
+{
+    return table_.old_count != 0;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+float incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::load_factor() const noexcept
+{
+    return table_.count ? static_cast<float>(size_) / table_.count : 0.0f;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+float incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_load_factor() const noexcept
+{
+    return max_load_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::max_load_factor(float ml) noexcept
+{
+    max_load_ = ml;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::rehash(size_type n)
+{
+    size_t needed = static_cast<size_t>(std::ceil(size_ / max_load_));
+    n = std::max(std::max(n, needed), static_cast<size_t>(min_buckets));
+    size_t count = min_buckets;
+    while (count < n) {
+        count *= 2;
+    }
+    if (count != table_.count || table_.old_count) {
+        rebuild(count);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::reserve(size_type n)
+{
+    size_t count = static_cast<size_t>(std::ceil(n / max_load_));
+    if (count > table_.count) {
+        rehash(count);
+    }
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::hash_function() const
+    -> hasher
+{
+    return hash_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::key_eq() const
+    -> key_equal
+{
+    return equal_;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto incremental_unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::get_allocator() const
+    -> allocator_type
+{
+    return allocator_type(alloc_);
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using incremental_unordered_map = itl::incremental_unordered_map<Key, Value, Hash, Pred, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
@@ -0,0 +1,85 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Half-open range of keys, `[lower, upper)`.
+ */
+template <typename Key>
+struct interval
+{
+    Key lower;
+    Key upper;
+};
+
+
+template <typename Key>
+bool operator==(const interval<Key> &left, const interval<Key> &right);
+
+template <typename Key>
+bool operator!=(const interval<Key> &left, const interval<Key> &right);
+
+
+/** \brief Orders disjoint intervals by their lower bound.
+ */
+template <
+    typename Key,
+    typename Compare = std::less<Key>
+>
+struct interval_less
+{
+    Compare comp;
+
+    interval_less(const Compare &comp = Compare());
+    bool operator()(const interval<Key> &left, const interval<Key> &right) const;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key>
+bool operator==(const interval<Key> &left,
+    const interval<Key> &right)
+{
+    return left.lower == right.lower && left.upper == right.upper;
+}
+
+
+template <typename Key>
+bool operator!=(const interval<Key> &left,
+    const interval<Key> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename Key, typename Compare>
+interval_less<Key, Compare>::interval_less(const Compare &comp):
+    comp(comp)
+{}
+
+
+template <typename Key, typename Compare>
+bool interval_less<Key, Compare>::operator()(const interval<Key> &left,
+    const interval<Key> &right) const
+{
+    return comp(left.lower, right.lower);
+}
+
+}   /* itl */
@@ -0,0 +1,559 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "interval.hpp"
+#include "map.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Map from disjoint half-open ranges of keys to values.
+ *
+ *  Assigning a range overwrites whatever it overlaps, splitting the
+ *  ranges at its ends, and ranges that touch or overlap with equal
+ *  values are coalesced into one. Values must be equality comparable.
+ *  Point lookups take `O(log n)`, and overlap queries `O(log n + k)`
+ *  for `k` ranges found. Iterators visit ranges in order, and their
+ *  values are read-only, since editing them could break coalescing.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const interval<Key>, Value>>,
+    typename Destructor = virtual_destructor
+>
+class interval_map: protected map<interval<Key>, Value, interval_less<Key, Compare>, Alloc, Destructor>
+{
+protected:
+    typedef map<interval<Key>, Value, interval_less<Key, Compare>, Alloc, Destructor> Base;
+    typedef interval_map<Key, Value, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(interval_map<K, V, C, A, D> &left, interval_map<K, V, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const interval_map<K, V, C, A, D> &left, const interval_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const interval_map<K, V, C, A, D> &left, const interval_map<K, V, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef interval<Key> interval_type;
+    using typename Base::value_type;
+    typedef Compare key_compare;
+    using typename Base::allocator_type;
+    using typename Base::const_reference;
+    typedef const_reference reference;
+    using typename Base::const_iterator;
+    typedef const_iterator iterator;
+    using typename Base::const_reverse_iterator;
+    typedef const_reverse_iterator reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    interval_map();
+    explicit interval_map(const key_compare &comp, const allocator_type &alloc = allocator_type());
+    explicit interval_map(const allocator_type &alloc);
+    interval_map(std::initializer_list<value_type> values, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    interval_map(const This &other);
+    interval_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~interval_map();
+
+    template <typename Iter>
+    static This from_sorted(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    // ITERATORS
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // ELEMENT ACCESS
+    const mapped_type & at(const key_type &key) const;
+
+    // MODIFIERS
+    const_iterator assign(const interval_type &range, const mapped_type &value);
+    void erase(const interval_type &range);
+    using Base::clear;
+    void swap(This &other);
+
+    // OBSERVERS
+    key_compare key_comp() const;
+
+    // OPERATIONS
+    const_iterator find(const key_type &key) const;
+    bool contains(const key_type &key) const;
+    std::pair<const_iterator, const_iterator> overlap(const interval_type &range) const;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+interval_map<Key, Value, Compare, Alloc, Destructor>::interval_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+interval_map<Key, Value, Compare, Alloc, Destructor>::interval_map(const key_compare &comp,
+        const allocator_type &alloc):
+    Base(interval_less<Key, Compare>(comp), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+interval_map<Key, Value, Compare, Alloc, Destructor>::interval_map(const allocator_type &alloc):
+    Base(alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+interval_map<Key, Value, Compare, Alloc, Destructor>::interval_map(std::initializer_list<value_type> values,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    Base(interval_less<Key, Compare>(comp), alloc)
+{
+    for (const value_type &value: values) {
+        assign(value.first, value.second);
+    }
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+interval_map<Key, Value, Compare, Alloc, Destructor>::interval_map(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+interval_map<Key, Value, Compare, Alloc, Destructor>::interval_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+interval_map<Key, Value, Compare, Alloc, Destructor>::~interval_map()
+{}
+
+
+/** \brief Build from ranges sorted by lower bound, in linear time.
+ *
+ *  Disjoint ranges are appended at the end. Ranges that overlap or
+ *  extend the last one fall back to `assign`, so later ranges win.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename Iter>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::from_sorted(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc)
+    -> This
+{
+    This result(comp, alloc);
+    Base &base = result.ref();
+    for (; first != last; ++first) {
+        const interval_type &range = first->first;
+        if (!comp(range.lower, range.upper)) {
+            continue;
+        }
+        if (!base.empty()) {
+            auto back = std::prev(base.end());
+            bool touches = !comp(back->first.upper, range.lower);
+            if (touches && (comp(range.lower, back->first.upper) || back->second == first->second)) {
+                result.assign(range, first->second);
+                continue;
+            }
+        }
+        base.emplace_hint(base.end(), *first);
+    }
+    return result;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::begin() const noexcept
+    -> const_iterator
+{
+    return ref().begin();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::end() const noexcept
+    -> const_iterator
+{
+    return ref().end();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::rbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return ref().rbegin();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::rend() const noexcept
+    -> const_reverse_iterator
+{
+    return ref().rend();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::crbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return rbegin();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::crend() const noexcept
+    -> const_reverse_iterator
+{
+    return rend();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::at(const key_type &key) const
+    -> const mapped_type &
+{
+    const_iterator it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("itl::interval_map::at");
+    }
+    return it->second;
+}
+
+
+/** \brief Map every key in `range` to `value`, returning the range that now holds it.
+ *
+ *  Ranges partly covered keep their uncovered ends, and neighbours
+ *  with an equal value are merged into the result.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::assign(const interval_type &range,
+        const mapped_type &value)
+    -> const_iterator
+{
+    key_compare comp = key_comp();
+    Key lower = range.lower;
+    Key upper = range.upper;
+    if (!comp(lower, upper)) {
+        return end();
+    }
+
+    // every range that overlaps or touches [lower, upper)
+    Base &base = ref();
+    auto first = base.lower_bound(interval_type {lower, lower});
+    if (first != base.begin() && !comp(std::prev(first)->first.upper, lower)) {
+        --first;
+    }
+    auto last = base.upper_bound(interval_type {upper, upper});
+    if (first != last && !comp(lower, first->first.upper) && !(first->second == value)) {
+        ++first;
+    }
+    if (first != last && !comp(std::prev(last)->first.lower, upper) && !(std::prev(last)->second == value)) {
+        --last;
+    }
+    if (first == last) {
+        return base.emplace_hint(last, interval_type {lower, upper}, value);
+    }
+
+    // split off the uncovered ends, or absorb them if their values match
+    auto back = std::prev(last);
+    if (comp(upper, back->first.upper)) {
+        if (back->second == value) {
+            upper = back->first.upper;
+        } else {
+            last = base.emplace_hint(last, interval_type {upper, back->first.upper}, back->second);
+        }
+    }
+    if (comp(first->first.lower, lower)) {
+        if (first->second == value) {
+            lower = first->first.lower;
+        } else {
+            value_type piece(interval_type {first->first.lower, lower}, first->second);
+            value_type entry(interval_type {lower, upper}, value);
+            auto hint = base.erase(first, last);
+            base.emplace_hint(hint, std::move(piece));
+            return base.emplace_hint(hint, std::move(entry));
+        }
+    }
+    // copied first, since `value` may live in a range about to be erased
+    value_type entry(interval_type {lower, upper}, value);
+    auto hint = base.erase(first, last);
+    return base.emplace_hint(hint, std::move(entry));
+}
+
+
+/** \brief Remove every key in `range`, keeping the uncovered ends of partly covered ranges.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void interval_map<Key, Value, Compare, Alloc, Destructor>::erase(const interval_type &range)
+{
+    key_compare comp = key_comp();
+    Key lower = range.lower;
+    Key upper = range.upper;
+    if (!comp(lower, upper)) {
+        return;
+    }
+
+    Base &base = ref();
+    auto first = base.upper_bound(interval_type {lower, lower});
+    if (first != base.begin() && comp(lower, std::prev(first)->first.upper)) {
+        --first;
+    }
+    auto last = base.lower_bound(interval_type {upper, upper});
+    if (first == last) {
+        return;
+    }
+
+    auto back = std::prev(last);
+    if (comp(upper, back->first.upper)) {
+        last = base.emplace_hint(last, interval_type {upper, back->first.upper}, back->second);
+    }
+    if (comp(first->first.lower, lower)) {
+        value_type piece(interval_type {first->first.lower, lower}, first->second);
+        auto hint = base.erase(first, last);
+        base.emplace_hint(hint, std::move(piece));
+        return;
+    }
+    base.erase(first, last);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void interval_map<Key, Value, Compare, Alloc, Destructor>::swap(This &other)
+{
+    Base::swap(other);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::key_comp() const
+    -> key_compare
+{
+    return Base::key_comp().comp;
+}
+
+
+/** \brief Range containing `key`, or `end()`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::find(const key_type &key) const
+    -> const_iterator
+{
+    const_iterator it = ref().upper_bound(interval_type {key, key});
+    if (it == begin() || !key_comp()(key, (--it)->first.upper)) {
+        return end();
+    }
+    return it;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool interval_map<Key, Value, Compare, Alloc, Destructor>::contains(const key_type &key) const
+{
+    return find(key) != end();
+}
+
+
+/** \brief Ranges sharing at least one key with `range`, in order.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto interval_map<Key, Value, Compare, Alloc, Destructor>::overlap(const interval_type &range) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    key_compare comp = key_comp();
+    if (!comp(range.lower, range.upper)) {
+        return std::make_pair(end(), end());
+    }
+    const_iterator first = ref().upper_bound(interval_type {range.lower, range.lower});
+    if (first != begin() && comp(range.lower, std::prev(first)->first.upper)) {
+        --first;
+    }
+    return std::make_pair(first, ref().lower_bound(interval_type {range.upper, range.upper}));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(interval_map<Key, Value, Compare, Alloc, Destructor> &left,
+    interval_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const interval_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const interval_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const interval_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const interval_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const interval<Key>, Value>>
+>
+using interval_map = itl::interval_map<Key, Value, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>
+>
+using interval_map = itl::interval_map<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<const interval<Key>, Value>>>;
+
+}   /* pmr */
+
+#endif
+
+}   /* itl */
@@ -0,0 +1,439 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "interval.hpp"
+#include "set.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Set of keys stored as disjoint half-open ranges.
+ *
+ *  Inserted ranges are coalesced with every range they overlap or
+ *  touch, so the set holds the fewest ranges covering its keys.
+ *  Point lookups take `O(log n)`, and overlap queries `O(log n + k)`
+ *  for `k` ranges found.
+ */
+template <
+    typename Key,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<interval<Key>>,
+    typename Destructor = virtual_destructor
+>
+class interval_set: protected set<interval<Key>, interval_less<Key, Compare>, Alloc, Destructor>
+{
+protected:
+    typedef set<interval<Key>, interval_less<Key, Compare>, Alloc, Destructor> Base;
+    typedef interval_set<Key, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(interval_set<K, C, A, D> &left, interval_set<K, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const interval_set<K, C, A, D> &left, const interval_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const interval_set<K, C, A, D> &left, const interval_set<K, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef interval<Key> interval_type;
+    using typename Base::value_type;
+    typedef Compare key_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    interval_set();
+    explicit interval_set(const key_compare &comp, const allocator_type &alloc = allocator_type());
+    explicit interval_set(const allocator_type &alloc);
+    interval_set(std::initializer_list<value_type> values, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    interval_set(const This &other);
+    interval_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~interval_set();
+
+    template <typename Iter>
+    static This from_sorted(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // MODIFIERS
+    const_iterator insert(const interval_type &range);
+    void erase(const interval_type &range);
+    using Base::clear;
+    void swap(This &other);
+
+    // OBSERVERS
+    key_compare key_comp() const;
+
+    // OPERATIONS
+    const_iterator find(const key_type &key) const;
+    bool contains(const key_type &key) const;
+    std::pair<const_iterator, const_iterator> overlap(const interval_type &range) const;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+interval_set<Key, Compare, Alloc, Destructor>::interval_set()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+interval_set<Key, Compare, Alloc, Destructor>::interval_set(const key_compare &comp,
+        const allocator_type &alloc):
+    Base(interval_less<Key, Compare>(comp), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+interval_set<Key, Compare, Alloc, Destructor>::interval_set(const allocator_type &alloc):
+    Base(alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+interval_set<Key, Compare, Alloc, Destructor>::interval_set(std::initializer_list<value_type> values,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    Base(interval_less<Key, Compare>(comp), alloc)
+{
+    for (const value_type &value: values) {
+        insert(value);
+    }
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+interval_set<Key, Compare, Alloc, Destructor>::interval_set(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+interval_set<Key, Compare, Alloc, Destructor>::interval_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+interval_set<Key, Compare, Alloc, Destructor>::~interval_set()
+{}
+
+
+/** \brief Build from ranges sorted by lower bound, in linear time.
+ *
+ *  Disjoint ranges are appended at the end, and ranges that overlap
+ *  or touch the last one fall back to `insert`.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename Iter>
+auto interval_set<Key, Compare, Alloc, Destructor>::from_sorted(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc)
+    -> This
+{
+    This result(comp, alloc);
+    Base &base = result.ref();
+    for (; first != last; ++first) {
+        const interval_type &range = *first;
+        if (!comp(range.lower, range.upper)) {
+            continue;
+        }
+        if (!base.empty() && !comp(std::prev(base.end())->upper, range.lower)) {
+            result.insert(range);
+            continue;
+        }
+        base.emplace_hint(base.end(), range);
+    }
+    return result;
+}
+
+
+/** \brief Add every key in `range`, returning the range that now holds them.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::insert(const interval_type &range)
+    -> const_iterator
+{
+    key_compare comp = key_comp();
+    interval_type merged = range;
+    if (!comp(merged.lower, merged.upper)) {
+        return end();
+    }
+
+    // every range that overlaps or touches the new one
+    Base &base = ref();
+    auto first = base.lower_bound(interval_type {merged.lower, merged.lower});
+    if (first != base.begin() && !comp(std::prev(first)->upper, merged.lower)) {
+        --first;
+    }
+    auto last = base.upper_bound(interval_type {merged.upper, merged.upper});
+    if (first != last) {
+        if (comp(first->lower, merged.lower)) {
+            merged.lower = first->lower;
+        }
+        if (comp(merged.upper, std::prev(last)->upper)) {
+            merged.upper = std::prev(last)->upper;
+        }
+    }
+    auto hint = base.erase(first, last);
+    return base.emplace_hint(hint, merged);
+}
+
+
+/** \brief Remove every key in `range`, keeping the uncovered ends of partly covered ranges.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void interval_set<Key, Compare, Alloc, Destructor>::erase(const interval_type &range)
+{
+    key_compare comp = key_comp();
+    interval_type removed = range;
+    if (!comp(removed.lower, removed.upper)) {
+        return;
+    }
+
+    Base &base = ref();
+    auto first = base.upper_bound(interval_type {removed.lower, removed.lower});
+    if (first != base.begin() && comp(removed.lower, std::prev(first)->upper)) {
+        --first;
+    }
+    auto last = base.lower_bound(interval_type {removed.upper, removed.upper});
+    if (first == last) {
+        return;
+    }
+
+    auto back = std::prev(last);
+    if (comp(removed.upper, back->upper)) {
+        last = base.emplace_hint(last, interval_type {removed.upper, back->upper});
+    }
+    if (comp(first->lower, removed.lower)) {
+        interval_type piece = {first->lower, removed.lower};
+        auto hint = base.erase(first, last);
+        base.emplace_hint(hint, piece);
+        return;
+    }
+    base.erase(first, last);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void interval_set<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    Base::swap(other);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::key_comp() const
+    -> key_compare
+{
+    return Base::key_comp().comp;
+}
+
+
+/** \brief Range containing `key`, or `end()`.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::find(const key_type &key) const
+    -> const_iterator
+{
+    const_iterator it = ref().upper_bound(interval_type {key, key});
+    if (it == begin() || !key_comp()(key, (--it)->upper)) {
+        return end();
+    }
+    return it;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool interval_set<Key, Compare, Alloc, Destructor>::contains(const key_type &key) const
+{
+    return find(key) != end();
+}
+
+
+/** \brief Ranges sharing at least one key with `range`, in order.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto interval_set<Key, Compare, Alloc, Destructor>::overlap(const interval_type &range) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    key_compare comp = key_comp();
+    if (!comp(range.lower, range.upper)) {
+        return std::make_pair(end(), end());
+    }
+    const_iterator first = ref().upper_bound(interval_type {range.lower, range.lower});
+    if (first != begin() && comp(range.lower, std::prev(first)->upper)) {
+        --first;
+    }
+    return std::make_pair(first, ref().lower_bound(interval_type {range.upper, range.upper}));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(interval_set<Key, Compare, Alloc, Destructor> &left,
+    interval_set<Key, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const interval_set<Key, Compare, Alloc, Destructor> &left,
+    const interval_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const interval_set<Key, Compare, Alloc, Destructor> &left,
+    const interval_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<interval<Key>>
+>
+using interval_set = itl::interval_set<Key, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Key,
+    typename Compare = std::less<Key>
+>
+using interval_set = itl::interval_set<Key, Compare, std::pmr::polymorphic_allocator<interval<Key>>>;
+
+}   /* pmr */
+
+#endif
+
+}   /* itl */
@@ -0,0 +1,160 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+
+namespace itl
+{
+namespace intrusive
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Links of a doubly-linked node, also the sentinel of a list.
+ */
+struct list_node
+{
+    list_node *next;
+    list_node *prev;
+};
+
+
+/** \brief Link of a singly-linked node, also the head of a list.
+ */
+struct forward_list_node
+{
+    forward_list_node *next;
+};
+
+
+template <typename T, typename Hook, Hook T::*Member>
+T * owner(typename Hook::node_type *node) noexcept;
+
+}   /* intrusive */
+
+
+/** \brief Member hook linking an element into an `itl::intrusive_list`.
+ *
+ *  Unlinked hooks hold null links, so `linked()` tells whether the
+ *  element is in a list. Debug builds assert that an element is never
+ *  inserted twice, nor destroyed while linked. Copies start unlinked.
+ */
+class list_hook: public intrusive::list_node
+{
+public:
+    typedef intrusive::list_node node_type;
+
+    list_hook() noexcept;
+    list_hook(const list_hook &other) noexcept;
+    list_hook & operator=(const list_hook &other) noexcept;
+    ~list_hook();
+
+    bool linked() const noexcept;
+};
+
+
+/** \brief Member hook linking an element into an `itl::intrusive_forward_list`.
+ *
+ *  Unlinked hooks point to themselves, since the last element of a
+ *  list holds a null link. Otherwise checked like `itl::list_hook`.
+ */
+class forward_list_hook: public intrusive::forward_list_node
+{
+public:
+    typedef intrusive::forward_list_node node_type;
+
+    forward_list_hook() noexcept;
+    forward_list_hook(const forward_list_hook &other) noexcept;
+    forward_list_hook & operator=(const forward_list_hook &other) noexcept;
+    ~forward_list_hook();
+
+    bool linked() const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+/** \brief Find the element embedding a hook.
+ *
+ *  The member offset is measured on static storage rather than a null
+ *  pointer, which sanitizers reject, and folds to a constant.
+ */
+template <typename T, typename Hook, Hook T::*Member>
+T * intrusive::owner(typename Hook::node_type *node) noexcept
+{
+    static const typename std::aligned_storage<sizeof(T), alignof(T)>::type probe = {};
+    const T *object = reinterpret_cast<const T*>(&probe);
+    ptrdiff_t offset = reinterpret_cast<const char*>(&(object->*Member)) - reinterpret_cast<const char*>(object);
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(static_cast<Hook*>(node)) - offset);
+}
+
+
+inline list_hook::list_hook() noexcept:
+    intrusive::list_node {nullptr, nullptr}
+{}
+
+
+inline list_hook::list_hook(const list_hook &) noexcept:
+    intrusive::list_node {nullptr, nullptr}
+{}
+
+
+inline list_hook & list_hook::operator=(const list_hook &) noexcept
+{
+    return *this;
+}
+
+
+inline list_hook::~list_hook()
+{
+    assert(!linked() && "itl::list_hook: destroyed while linked");
+}
+
+
+inline bool list_hook::linked() const noexcept
+{
+    return next != nullptr;
+}
+
+
+inline forward_list_hook::forward_list_hook() noexcept:
+    intrusive::forward_list_node {this}
+{}
+
+
+inline forward_list_hook::forward_list_hook(const forward_list_hook &) noexcept:
+    intrusive::forward_list_node {this}
+{}
+
+
+inline forward_list_hook & forward_list_hook::operator=(const forward_list_hook &) noexcept
+{
+    return *this;
+}
+
+
+inline forward_list_hook::~forward_list_hook()
+{
+    assert(!linked() && "itl::forward_list_hook: destroyed while linked");
+}
+
+
+inline bool forward_list_hook::linked() const noexcept
+{
+    return next != this;
+}
+
+}   /* itl */
@@ -0,0 +1,930 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include "destructor.hpp"
+#include "intrusive.hpp"
+
+
+namespace itl
+{
+namespace intrusive
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Forward iterator over an intrusive forward list.
+ */
+template <typename T, forward_list_hook T::*Hook, bool Const>
+class forward_list_iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const T *, T *>::type pointer;
+    typedef typename std::conditional<Const, const T &, T &>::type reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    forward_list_iterator() noexcept;
+    explicit forward_list_iterator(forward_list_node *node) noexcept;
+
+    template <bool C, typename = typename std::enable_if<Const && !C>::type>
+    forward_list_iterator(const forward_list_iterator<T, Hook, C> &other) noexcept;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    forward_list_iterator & operator++() noexcept;
+    forward_list_iterator operator++(int) noexcept;
+
+    forward_list_node * node() const noexcept;
+
+private:
+    forward_list_node *node_;
+};
+
+
+template <typename T, forward_list_hook T::*Hook, bool L, bool R>
+bool operator==(const forward_list_iterator<T, Hook, L> &left, const forward_list_iterator<T, Hook, R> &right) noexcept;
+
+template <typename T, forward_list_hook T::*Hook, bool L, bool R>
+bool operator!=(const forward_list_iterator<T, Hook, L> &left, const forward_list_iterator<T, Hook, R> &right) noexcept;
+
+}   /* intrusive */
+
+
+/** \brief Singly-linked list threading elements through a member hook.
+ *
+ *  The singly-linked counterpart of `itl::intrusive_list`, one pointer
+ *  per element, with the `itl::forward_list` interface. Like
+ *  `std::forward_list`, it keeps no size, and an element is erased
+ *  through its predecessor.
+ */
+template <
+    typename T,
+    forward_list_hook T::*Hook,
+    typename Destructor = virtual_destructor
+>
+class intrusive_forward_list: protected Destructor
+{
+protected:
+    typedef intrusive_forward_list<T, Hook, Destructor> This;
+    typedef intrusive::forward_list_node Node;
+
+    static Node * node(T &value) noexcept;
+    static T & value(Node *node) noexcept;
+    static void link_after(Node *position, Node *node) noexcept;
+    static void unlink_after(Node *position) noexcept;
+    Node * tail() noexcept;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef intrusive::forward_list_iterator<T, Hook, false> iterator;
+    typedef intrusive::forward_list_iterator<T, Hook, true> const_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    intrusive_forward_list() noexcept;
+    intrusive_forward_list(const This &other) = delete;
+    intrusive_forward_list(This &&other) noexcept;
+    This & operator=(const This &other) = delete;
+    This & operator=(This &&other) noexcept;
+    ~intrusive_forward_list();
+
+    template <typename Iter>
+    intrusive_forward_list(Iter first, Iter last);
+
+    // ITERATORS
+    iterator before_begin() noexcept;
+    const_iterator before_begin() const noexcept;
+    const_iterator cbefore_begin() const noexcept;
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+    iterator iterator_to(reference value) noexcept;
+    const_iterator iterator_to(const_reference value) const noexcept;
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type max_size() const noexcept;
+
+    // ELEMENT ACCESS
+    reference front() noexcept;
+    const_reference front() const noexcept;
+
+    // MODIFIERS
+    void push_front(reference value) noexcept;
+    void pop_front() noexcept;
+    iterator insert_after(const_iterator position, reference value) noexcept;
+
+    template <typename Iter>
+    iterator insert_after(const_iterator position, Iter first, Iter last);
+
+    iterator erase_after(const_iterator position) noexcept;
+    iterator erase_after(const_iterator first, const_iterator last) noexcept;
+    void clear() noexcept;
+    void swap(This &other) noexcept;
+
+    // OPERATIONS
+    size_type remove(const_reference value);
+
+    template <typename Predicate>
+    size_type remove_if(Predicate pred);
+
+    size_type unique();
+
+    template <typename BinaryPredicate>
+    size_type unique(BinaryPredicate pred);
+
+    void sort();
+
+    template <typename Compare>
+    void sort(Compare comp);
+
+    void reverse() noexcept;
+    void splice_after(const_iterator position, This &x) noexcept;
+    void splice_after(const_iterator position, This &&x) noexcept;
+    void splice_after(const_iterator position, This &x, const_iterator i) noexcept;
+    void splice_after(const_iterator position, This &&x, const_iterator i) noexcept;
+    void splice_after(const_iterator position, This &x, const_iterator first, const_iterator last) noexcept;
+    void splice_after(const_iterator position, This &&x, const_iterator first, const_iterator last) noexcept;
+    void merge(This &x);
+    void merge(This &&x);
+
+    template <typename Compare>
+    void merge(This &x, Compare comp);
+
+    template <typename Compare>
+    void merge(This &&x, Compare comp);
+
+private:
+    Node head_;
+};
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void swap(intrusive_forward_list<T, Hook, Destructor> &left, intrusive_forward_list<T, Hook, Destructor> &right) noexcept;
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator==(const intrusive_forward_list<T, Hook, Destructor> &left, const intrusive_forward_list<T, Hook, Destructor> &right);
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator!=(const intrusive_forward_list<T, Hook, Destructor> &left, const intrusive_forward_list<T, Hook, Destructor> &right);
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator<(const intrusive_forward_list<T, Hook, Destructor> &left, const intrusive_forward_list<T, Hook, Destructor> &right);
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator<=(const intrusive_forward_list<T, Hook, Destructor> &left, const intrusive_forward_list<T, Hook, Destructor> &right);
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator>(const intrusive_forward_list<T, Hook, Destructor> &left, const intrusive_forward_list<T, Hook, Destructor> &right);
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator>=(const intrusive_forward_list<T, Hook, Destructor> &left, const intrusive_forward_list<T, Hook, Destructor> &right);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+intrusive::forward_list_iterator<T, Hook, Const>::forward_list_iterator() noexcept:
+    node_(nullptr)
+{}
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+intrusive::forward_list_iterator<T, Hook, Const>::forward_list_iterator(forward_list_node *node) noexcept:
+    node_(node)
+{}
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+template <bool C, typename>
+intrusive::forward_list_iterator<T, Hook, Const>::forward_list_iterator(const forward_list_iterator<T, Hook, C> &other) noexcept:
+    node_(other.node())
+{}
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+auto intrusive::forward_list_iterator<T, Hook, Const>::operator*() const noexcept
+    -> reference
+{
+    return *owner<T, forward_list_hook, Hook>(node_);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+auto intrusive::forward_list_iterator<T, Hook, Const>::operator->() const noexcept
+    -> pointer
+{
+    return owner<T, forward_list_hook, Hook>(node_);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+auto intrusive::forward_list_iterator<T, Hook, Const>::operator++() noexcept
+    -> forward_list_iterator &
+{
+    node_ = node_->next;
+    return *this;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+auto intrusive::forward_list_iterator<T, Hook, Const>::operator++(int) noexcept
+    -> forward_list_iterator
+{
+    forward_list_iterator copy(*this);
+    node_ = node_->next;
+    return copy;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, bool Const>
+auto intrusive::forward_list_iterator<T, Hook, Const>::node() const noexcept
+    -> forward_list_node *
+{
+    return node_;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, bool L, bool R>
+bool intrusive::operator==(const forward_list_iterator<T, Hook, L> &left,
+    const forward_list_iterator<T, Hook, R> &right) noexcept
+{
+    return left.node() == right.node();
+}
+
+
+template <typename T, forward_list_hook T::*Hook, bool L, bool R>
+bool intrusive::operator!=(const forward_list_iterator<T, Hook, L> &left,
+    const forward_list_iterator<T, Hook, R> &right) noexcept
+{
+    return left.node() != right.node();
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::node(T &value) noexcept
+    -> Node *
+{
+    return &(value.*Hook);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::value(Node *node) noexcept
+    -> T &
+{
+    return *intrusive::owner<T, forward_list_hook, Hook>(node);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::link_after(Node *position,
+    Node *node) noexcept
+{
+    assert(node->next == node && "itl::intrusive_forward_list: element already linked");
+    node->next = position->next;
+    position->next = node;
+}
+
+
+/** \brief Unlink the node after `position`, leaving its hook unlinked.
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::unlink_after(Node *position) noexcept
+{
+    Node *node = position->next;
+    position->next = node->next;
+    node->next = node;
+}
+
+
+/** \brief Find the last node, or the head if empty, in O(n).
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::tail() noexcept
+    -> Node *
+{
+    Node *node = &head_;
+    while (node->next) {
+        node = node->next;
+    }
+    return node;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void swap(intrusive_forward_list<T, Hook, Destructor> &left,
+    intrusive_forward_list<T, Hook, Destructor> &right) noexcept
+{
+    left.swap(right);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator==(const intrusive_forward_list<T, Hook, Destructor> &left,
+    const intrusive_forward_list<T, Hook, Destructor> &right)
+{
+    auto l = left.begin();
+    auto r = right.begin();
+    for (; l != left.end() && r != right.end(); ++l, ++r) {
+        if (!(*l == *r)) {
+            return false;
+        }
+    }
+    return l == left.end() && r == right.end();
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator!=(const intrusive_forward_list<T, Hook, Destructor> &left,
+    const intrusive_forward_list<T, Hook, Destructor> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator<(const intrusive_forward_list<T, Hook, Destructor> &left,
+    const intrusive_forward_list<T, Hook, Destructor> &right)
+{
+    return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator<=(const intrusive_forward_list<T, Hook, Destructor> &left,
+    const intrusive_forward_list<T, Hook, Destructor> &right)
+{
+    return !(right < left);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator>(const intrusive_forward_list<T, Hook, Destructor> &left,
+    const intrusive_forward_list<T, Hook, Destructor> &right)
+{
+    return right < left;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool operator>=(const intrusive_forward_list<T, Hook, Destructor> &left,
+    const intrusive_forward_list<T, Hook, Destructor> &right)
+{
+    return !(left < right);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+intrusive_forward_list<T, Hook, Destructor>::intrusive_forward_list() noexcept:
+    head_ {nullptr}
+{}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+intrusive_forward_list<T, Hook, Destructor>::intrusive_forward_list(This &&other) noexcept:
+    head_ {other.head_.next}
+{
+    other.head_.next = nullptr;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    if (this != &other) {
+        clear();
+        head_.next = other.head_.next;
+        other.head_.next = nullptr;
+    }
+    return *this;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+intrusive_forward_list<T, Hook, Destructor>::~intrusive_forward_list()
+{
+    clear();
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+template <typename Iter>
+intrusive_forward_list<T, Hook, Destructor>::intrusive_forward_list(Iter first,
+        Iter last):
+    intrusive_forward_list()
+{
+    insert_after(before_begin(), first, last);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::before_begin() noexcept
+    -> iterator
+{
+    return iterator(&head_);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::before_begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(const_cast<Node*>(&head_));
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::cbefore_begin() const noexcept
+    -> const_iterator
+{
+    return before_begin();
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::begin() noexcept
+    -> iterator
+{
+    return iterator(head_.next);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(head_.next);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::end() noexcept
+    -> iterator
+{
+    return iterator(nullptr);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(nullptr);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+/** \brief Get the position of an element linked into this list.
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::iterator_to(reference value) noexcept
+    -> iterator
+{
+    return iterator(node(value));
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::iterator_to(const_reference value) const noexcept
+    -> const_iterator
+{
+    return const_iterator(node(const_cast<T&>(value)));
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+bool intrusive_forward_list<T, Hook, Destructor>::empty() const noexcept
+{
+    return head_.next == nullptr;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::max_size() const noexcept
+    -> size_type
+{
+    return std::numeric_limits<difference_type>::max() / sizeof(T);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::front() noexcept
+    -> reference
+{
+    return value(head_.next);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::front() const noexcept
+    -> const_reference
+{
+    return value(head_.next);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::push_front(reference value) noexcept
+{
+    link_after(&head_, node(value));
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::pop_front() noexcept
+{
+    unlink_after(&head_);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::insert_after(const_iterator position,
+    reference value) noexcept
+    -> iterator
+{
+    Node *inserted = node(value);
+    link_after(position.node(), inserted);
+    return iterator(inserted);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+template <typename Iter>
+auto intrusive_forward_list<T, Hook, Destructor>::insert_after(const_iterator position,
+    Iter first,
+    Iter last)
+    -> iterator
+{
+    iterator result(position.node());
+    for (; first != last; ++first) {
+        result = insert_after(result, *first);
+    }
+    return result;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::erase_after(const_iterator position) noexcept
+    -> iterator
+{
+    unlink_after(position.node());
+    return iterator(position.node()->next);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::erase_after(const_iterator first,
+    const_iterator last) noexcept
+    -> iterator
+{
+    Node *node = first.node();
+    while (node->next != last.node()) {
+        unlink_after(node);
+    }
+    return iterator(last.node());
+}
+
+
+/** \brief Unlink every element, leaving the elements themselves alone.
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::clear() noexcept
+{
+    Node *node = head_.next;
+    while (node) {
+        Node *next = node->next;
+        node->next = node;
+        node = next;
+    }
+    head_.next = nullptr;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::swap(This &other) noexcept
+{
+    std::swap(head_.next, other.head_.next);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::remove(const_reference value)
+    -> size_type
+{
+    // `value` may be an element: unlinking it leaves it intact
+    return remove_if([&value](const_reference item) {
+        return item == value;
+    });
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+template <typename Predicate>
+auto intrusive_forward_list<T, Hook, Destructor>::remove_if(Predicate pred)
+    -> size_type
+{
+    size_type removed = 0;
+    Node *node = &head_;
+    while (node->next) {
+        if (pred(static_cast<const_reference>(value(node->next)))) {
+            unlink_after(node);
+            ++removed;
+        } else {
+            node = node->next;
+        }
+    }
+    return removed;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+auto intrusive_forward_list<T, Hook, Destructor>::unique()
+    -> size_type
+{
+    return unique(std::equal_to<T>());
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+template <typename BinaryPredicate>
+auto intrusive_forward_list<T, Hook, Destructor>::unique(BinaryPredicate pred)
+    -> size_type
+{
+    size_type removed = 0;
+    Node *kept = head_.next;
+    if (!kept) {
+        return removed;
+    }
+    while (kept->next) {
+        if (pred(static_cast<const_reference>(value(kept)), static_cast<const_reference>(value(kept->next)))) {
+            unlink_after(kept);
+            ++removed;
+        } else {
+            kept = kept->next;
+        }
+    }
+    return removed;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::sort()
+{
+    sort(std::less<T>());
+}
+
+
+/** \brief Stable merge sort, relinking elements in place.
+ *
+ *  If `comp` throws, every element stays linked, in unspecified order.
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+template <typename Compare>
+void intrusive_forward_list<T, Hook, Destructor>::sort(Compare comp)
+{
+    size_type count = 0;
+    for (Node *node = head_.next; node && count < 2; node = node->next) {
+        ++count;
+    }
+    if (count < 2) {
+        return;
+    }
+
+    // split at the middle with a slow and a fast cursor
+    Node *middle = head_.next;
+    for (Node *fast = middle->next; fast && fast->next; fast = fast->next->next) {
+        middle = middle->next;
+    }
+    This right;
+    right.head_.next = middle->next;
+    middle->next = nullptr;
+
+    try {
+        sort(comp);
+        right.sort(comp);
+        merge(right, comp);
+    } catch (...) {
+        tail()->next = right.head_.next;
+        right.head_.next = nullptr;
+        throw;
+    }
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::reverse() noexcept
+{
+    Node *reversed = nullptr;
+    Node *node = head_.next;
+    while (node) {
+        Node *next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+    head_.next = reversed;
+}
+
+
+/** \brief Move every element of `x` after `position`, in O(size of x).
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::splice_after(const_iterator position,
+    This &x) noexcept
+{
+    if (&x == this || x.empty()) {
+        return;
+    }
+    Node *last = x.tail();
+    last->next = position.node()->next;
+    position.node()->next = x.head_.next;
+    x.head_.next = nullptr;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::splice_after(const_iterator position,
+    This &&x) noexcept
+{
+    splice_after(position, x);
+}
+
+
+/** \brief Move the element after `i` in `x` after `position`.
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::splice_after(const_iterator position,
+    This &,
+    const_iterator i) noexcept
+{
+    Node *previous = i.node();
+    Node *node = previous->next;
+    if (position.node() == previous || position.node() == node) {
+        return;
+    }
+    previous->next = node->next;
+    node->next = position.node()->next;
+    position.node()->next = node;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::splice_after(const_iterator position,
+    This &&x,
+    const_iterator i) noexcept
+{
+    splice_after(position, x, i);
+}
+
+
+/** \brief Move the elements of `x` in `(first, last)` after `position`.
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::splice_after(const_iterator position,
+    This &,
+    const_iterator first,
+    const_iterator last) noexcept
+{
+    Node *before = first.node();
+    if (before->next == last.node()) {
+        return;
+    }
+    Node *moved = before->next;
+    Node *end = moved;
+    while (end->next != last.node()) {
+        end = end->next;
+    }
+    before->next = last.node();
+    end->next = position.node()->next;
+    position.node()->next = moved;
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::splice_after(const_iterator position,
+    This &&x,
+    const_iterator first,
+    const_iterator last) noexcept
+{
+    splice_after(position, x, first, last);
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::merge(This &x)
+{
+    merge(x, std::less<T>());
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+void intrusive_forward_list<T, Hook, Destructor>::merge(This &&x)
+{
+    merge(x, std::less<T>());
+}
+
+
+/** \brief Merge sorted `x` into this sorted list, keeping equal elements of this list first.
+ *
+ *  If `comp` throws, elements already moved stay in this list.
+ */
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+template <typename Compare>
+void intrusive_forward_list<T, Hook, Destructor>::merge(This &x,
+    Compare comp)
+{
+    if (&x == this) {
+        return;
+    }
+
+    Node *previous = &head_;
+    while (x.head_.next) {
+        Node *node = previous->next;
+        if (!node) {
+            previous->next = x.head_.next;
+            x.head_.next = nullptr;
+            break;
+        }
+        Node *other = x.head_.next;
+        if (comp(static_cast<const_reference>(value(other)), static_cast<const_reference>(value(node)))) {
+            x.head_.next = other->next;
+            other->next = node;
+            previous->next = other;
+        }
+        previous = previous->next;
+    }
+}
+
+
+template <typename T, forward_list_hook T::*Hook, typename Destructor>
+template <typename Compare>
+void intrusive_forward_list<T, Hook, Destructor>::merge(This &&x,
+    Compare comp)
+{
+    merge(x, comp);
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <typename T, forward_list_hook T::*Hook>
+using intrusive_forward_list = itl::intrusive_forward_list<T, Hook, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
@@ -0,0 +1,1021 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include "destructor.hpp"
+#include "intrusive.hpp"
+
+
+namespace itl
+{
+namespace intrusive
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Bidirectional iterator over an intrusive list.
+ */
+template <typename T, list_hook T::*Hook, bool Const>
+class list_iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const T *, T *>::type pointer;
+    typedef typename std::conditional<Const, const T &, T &>::type reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    list_iterator() noexcept;
+    explicit list_iterator(list_node *node) noexcept;
+
+    template <bool C, typename = typename std::enable_if<Const && !C>::type>
+    list_iterator(const list_iterator<T, Hook, C> &other) noexcept;
+
+    reference operator*() const noexcept;
+    pointer operator->() const noexcept;
+    list_iterator & operator++() noexcept;
+    list_iterator operator++(int) noexcept;
+    list_iterator & operator--() noexcept;
+    list_iterator operator--(int) noexcept;
+
+    list_node * node() const noexcept;
+
+private:
+    list_node *node_;
+};
+
+
+template <typename T, list_hook T::*Hook, bool L, bool R>
+bool operator==(const list_iterator<T, Hook, L> &left, const list_iterator<T, Hook, R> &right) noexcept;
+
+template <typename T, list_hook T::*Hook, bool L, bool R>
+bool operator!=(const list_iterator<T, Hook, L> &left, const list_iterator<T, Hook, R> &right) noexcept;
+
+}   /* intrusive */
+
+
+/** \brief Doubly-linked list threading elements through a member hook.
+ *
+ *  The list never owns, copies or allocates: it links elements the
+ *  caller keeps alive, through the `list_hook` at `Hook`, so insertion
+ *  and removal are O(1) and cannot throw. `iterator_to` finds an
+ *  element's position from the element itself, so it may be erased or
+ *  spliced to another list without a search. Elements are unlinked,
+ *  not destroyed, by erasure and by the list's destructor.
+ *
+ *  The list may be moved but not copied, since an element links into
+ *  one list at a time.
+ */
+template <
+    typename T,
+    list_hook T::*Hook,
+    typename Destructor = virtual_destructor
+>
+class intrusive_list: protected Destructor
+{
+protected:
+    typedef intrusive_list<T, Hook, Destructor> This;
+    typedef intrusive::list_node Node;
+
+    static Node * node(T &value) noexcept;
+    static T & value(Node *node) noexcept;
+    static void link(Node *position, Node *node) noexcept;
+    static void unlink(Node *node) noexcept;
+    static void transfer(Node *position, Node *first, Node *last) noexcept;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef intrusive::list_iterator<T, Hook, false> iterator;
+    typedef intrusive::list_iterator<T, Hook, true> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    intrusive_list() noexcept;
+    intrusive_list(const This &other) = delete;
+    intrusive_list(This &&other) noexcept;
+    This & operator=(const This &other) = delete;
+    This & operator=(This &&other) noexcept;
+    ~intrusive_list();
+
+    template <typename Iter>
+    intrusive_list(Iter first, Iter last);
+
+    // ITERATORS
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+    iterator iterator_to(reference value) noexcept;
+    const_iterator iterator_to(const_reference value) const noexcept;
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+
+    // ELEMENT ACCESS
+    reference front() noexcept;
+    const_reference front() const noexcept;
+    reference back() noexcept;
+    const_reference back() const noexcept;
+
+    // MODIFIERS
+    void push_front(reference value) noexcept;
+    void push_back(reference value) noexcept;
+    void pop_front() noexcept;
+    void pop_back() noexcept;
+    iterator insert(const_iterator position, reference value) noexcept;
+
+    template <typename Iter>
+    iterator insert(const_iterator position, Iter first, Iter last);
+
+    iterator erase(const_iterator position) noexcept;
+    iterator erase(const_iterator first, const_iterator last) noexcept;
+    void clear() noexcept;
+    void swap(This &other) noexcept;
+
+    // OPERATIONS
+    size_type remove(const_reference value);
+
+    template <typename Predicate>
+    size_type remove_if(Predicate pred);
+
+    size_type unique();
+
+    template <typename BinaryPredicate>
+    size_type unique(BinaryPredicate pred);
+
+    void sort();
+
+    template <typename Compare>
+    void sort(Compare comp);
+
+    void reverse() noexcept;
+    void splice(const_iterator position, This &x) noexcept;
+    void splice(const_iterator position, This &&x) noexcept;
+    void splice(const_iterator position, This &x, const_iterator i) noexcept;
+    void splice(const_iterator position, This &&x, const_iterator i) noexcept;
+    void splice(const_iterator position, This &x, const_iterator first, const_iterator last) noexcept;
+    void splice(const_iterator position, This &&x, const_iterator first, const_iterator last) noexcept;
+    void merge(This &x);
+    void merge(This &&x);
+
+    template <typename Compare>
+    void merge(This &x, Compare comp);
+
+    template <typename Compare>
+    void merge(This &&x, Compare comp);
+
+private:
+    Node head_;
+    size_type size_;
+};
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void swap(intrusive_list<T, Hook, Destructor> &left, intrusive_list<T, Hook, Destructor> &right) noexcept;
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator==(const intrusive_list<T, Hook, Destructor> &left, const intrusive_list<T, Hook, Destructor> &right);
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator!=(const intrusive_list<T, Hook, Destructor> &left, const intrusive_list<T, Hook, Destructor> &right);
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator<(const intrusive_list<T, Hook, Destructor> &left, const intrusive_list<T, Hook, Destructor> &right);
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator<=(const intrusive_list<T, Hook, Destructor> &left, const intrusive_list<T, Hook, Destructor> &right);
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator>(const intrusive_list<T, Hook, Destructor> &left, const intrusive_list<T, Hook, Destructor> &right);
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator>=(const intrusive_list<T, Hook, Destructor> &left, const intrusive_list<T, Hook, Destructor> &right);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+intrusive::list_iterator<T, Hook, Const>::list_iterator() noexcept:
+    node_(nullptr)
+{}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+intrusive::list_iterator<T, Hook, Const>::list_iterator(list_node *node) noexcept:
+    node_(node)
+{}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+template <bool C, typename>
+intrusive::list_iterator<T, Hook, Const>::list_iterator(const list_iterator<T, Hook, C> &other) noexcept:
+    node_(other.node())
+{}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+auto intrusive::list_iterator<T, Hook, Const>::operator*() const noexcept
+    -> reference
+{
+    return *owner<T, list_hook, Hook>(node_);
+}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+auto intrusive::list_iterator<T, Hook, Const>::operator->() const noexcept
+    -> pointer
+{
+    return owner<T, list_hook, Hook>(node_);
+}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+auto intrusive::list_iterator<T, Hook, Const>::operator++() noexcept
+    -> list_iterator &
+{
+    node_ = node_->next;
+    return *this;
+}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+auto intrusive::list_iterator<T, Hook, Const>::operator++(int) noexcept
+    -> list_iterator
+{
+    list_iterator copy(*this);
+    node_ = node_->next;
+    return copy;
+}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+auto intrusive::list_iterator<T, Hook, Const>::operator--() noexcept
+    -> list_iterator &
+{
+    node_ = node_->prev;
+    return *this;
+}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+auto intrusive::list_iterator<T, Hook, Const>::operator--(int) noexcept
+    -> list_iterator
+{
+    list_iterator copy(*this);
+    node_ = node_->prev;
+    return copy;
+}
+
+
+template <typename T, list_hook T::*Hook, bool Const>
+auto intrusive::list_iterator<T, Hook, Const>::node() const noexcept
+    -> list_node *
+{
+    return node_;
+}
+
+
+template <typename T, list_hook T::*Hook, bool L, bool R>
+bool intrusive::operator==(const list_iterator<T, Hook, L> &left,
+    const list_iterator<T, Hook, R> &right) noexcept
+{
+    return left.node() == right.node();
+}
+
+
+template <typename T, list_hook T::*Hook, bool L, bool R>
+bool intrusive::operator!=(const list_iterator<T, Hook, L> &left,
+    const list_iterator<T, Hook, R> &right) noexcept
+{
+    return left.node() != right.node();
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::node(T &value) noexcept
+    -> Node *
+{
+    return &(value.*Hook);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::value(Node *node) noexcept
+    -> T &
+{
+    return *intrusive::owner<T, list_hook, Hook>(node);
+}
+
+
+/** \brief Link `node` before `position`.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::link(Node *position,
+    Node *node) noexcept
+{
+    assert(!node->next && "itl::intrusive_list: element already linked");
+    node->next = position;
+    node->prev = position->prev;
+    position->prev->next = node;
+    position->prev = node;
+}
+
+
+/** \brief Unlink `node`, leaving its hook unlinked.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::unlink(Node *node) noexcept
+{
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = nullptr;
+    node->prev = nullptr;
+}
+
+
+/** \brief Move `[first, last)` before `position`, which must lie outside it.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::transfer(Node *position,
+    Node *first,
+    Node *last) noexcept
+{
+    Node *tail = last->prev;
+    first->prev->next = last;
+    last->prev = first->prev;
+
+    tail->next = position;
+    first->prev = position->prev;
+    position->prev->next = first;
+    position->prev = tail;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void swap(intrusive_list<T, Hook, Destructor> &left,
+    intrusive_list<T, Hook, Destructor> &right) noexcept
+{
+    left.swap(right);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator==(const intrusive_list<T, Hook, Destructor> &left,
+    const intrusive_list<T, Hook, Destructor> &right)
+{
+    return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator!=(const intrusive_list<T, Hook, Destructor> &left,
+    const intrusive_list<T, Hook, Destructor> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator<(const intrusive_list<T, Hook, Destructor> &left,
+    const intrusive_list<T, Hook, Destructor> &right)
+{
+    return std::lexicographical_compare(left.begin(), left.end(), right.begin(), right.end());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator<=(const intrusive_list<T, Hook, Destructor> &left,
+    const intrusive_list<T, Hook, Destructor> &right)
+{
+    return !(right < left);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator>(const intrusive_list<T, Hook, Destructor> &left,
+    const intrusive_list<T, Hook, Destructor> &right)
+{
+    return right < left;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool operator>=(const intrusive_list<T, Hook, Destructor> &left,
+    const intrusive_list<T, Hook, Destructor> &right)
+{
+    return !(left < right);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+intrusive_list<T, Hook, Destructor>::intrusive_list() noexcept:
+    head_ {&head_, &head_},
+    size_(0)
+{}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+intrusive_list<T, Hook, Destructor>::intrusive_list(This &&other) noexcept:
+    intrusive_list()
+{
+    splice(end(), other);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    if (this != &other) {
+        clear();
+        splice(end(), other);
+    }
+    return *this;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+intrusive_list<T, Hook, Destructor>::~intrusive_list()
+{
+    clear();
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+template <typename Iter>
+intrusive_list<T, Hook, Destructor>::intrusive_list(Iter first,
+        Iter last):
+    intrusive_list()
+{
+    insert(end(), first, last);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::begin() noexcept
+    -> iterator
+{
+    return iterator(head_.next);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(head_.next);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::end() noexcept
+    -> iterator
+{
+    return iterator(&head_);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(const_cast<Node*>(&head_));
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::rbegin() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(end());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::rbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(end());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::crbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return rbegin();
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::rend() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(begin());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::rend() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(begin());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::crend() const noexcept
+    -> const_reverse_iterator
+{
+    return rend();
+}
+
+
+/** \brief Get the position of an element linked into this list.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::iterator_to(reference value) noexcept
+    -> iterator
+{
+    return iterator(node(value));
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::iterator_to(const_reference value) const noexcept
+    -> const_iterator
+{
+    return const_iterator(node(const_cast<T&>(value)));
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+bool intrusive_list<T, Hook, Destructor>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::max_size() const noexcept
+    -> size_type
+{
+    return std::numeric_limits<difference_type>::max() / sizeof(T);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::front() noexcept
+    -> reference
+{
+    return value(head_.next);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::front() const noexcept
+    -> const_reference
+{
+    return value(head_.next);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::back() noexcept
+    -> reference
+{
+    return value(head_.prev);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::back() const noexcept
+    -> const_reference
+{
+    return value(head_.prev);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::push_front(reference value) noexcept
+{
+    link(head_.next, node(value));
+    ++size_;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::push_back(reference value) noexcept
+{
+    link(&head_, node(value));
+    ++size_;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::pop_front() noexcept
+{
+    unlink(head_.next);
+    --size_;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::pop_back() noexcept
+{
+    unlink(head_.prev);
+    --size_;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::insert(const_iterator position,
+    reference value) noexcept
+    -> iterator
+{
+    Node *inserted = node(value);
+    link(position.node(), inserted);
+    ++size_;
+    return iterator(inserted);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+template <typename Iter>
+auto intrusive_list<T, Hook, Destructor>::insert(const_iterator position,
+    Iter first,
+    Iter last)
+    -> iterator
+{
+    iterator result(position.node());
+    if (first != last) {
+        result = insert(position, *first);
+        for (++first; first != last; ++first) {
+            insert(position, *first);
+        }
+    }
+    return result;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::erase(const_iterator position) noexcept
+    -> iterator
+{
+    Node *next = position.node()->next;
+    unlink(position.node());
+    --size_;
+    return iterator(next);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::erase(const_iterator first,
+    const_iterator last) noexcept
+    -> iterator
+{
+    while (first != last) {
+        first = erase(first);
+    }
+    return iterator(last.node());
+}
+
+
+/** \brief Unlink every element, leaving the elements themselves alone.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::clear() noexcept
+{
+    Node *node = head_.next;
+    while (node != &head_) {
+        Node *next = node->next;
+        node->next = nullptr;
+        node->prev = nullptr;
+        node = next;
+    }
+    head_.next = &head_;
+    head_.prev = &head_;
+    size_ = 0;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::swap(This &other) noexcept
+{
+    This temp;
+    temp.splice(temp.end(), other);
+    other.splice(other.end(), *this);
+    splice(end(), temp);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::remove(const_reference value)
+    -> size_type
+{
+    // `value` may be an element: unlinking it leaves it intact
+    return remove_if([&value](const_reference item) {
+        return item == value;
+    });
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+template <typename Predicate>
+auto intrusive_list<T, Hook, Destructor>::remove_if(Predicate pred)
+    -> size_type
+{
+    size_type removed = 0;
+    Node *node = head_.next;
+    while (node != &head_) {
+        Node *next = node->next;
+        if (pred(static_cast<const_reference>(value(node)))) {
+            unlink(node);
+            --size_;
+            ++removed;
+        }
+        node = next;
+    }
+    return removed;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+auto intrusive_list<T, Hook, Destructor>::unique()
+    -> size_type
+{
+    return unique(std::equal_to<T>());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+template <typename BinaryPredicate>
+auto intrusive_list<T, Hook, Destructor>::unique(BinaryPredicate pred)
+    -> size_type
+{
+    size_type removed = 0;
+    if (size_ < 2) {
+        return removed;
+    }
+    Node *kept = head_.next;
+    Node *node = kept->next;
+    while (node != &head_) {
+        Node *next = node->next;
+        if (pred(static_cast<const_reference>(value(kept)), static_cast<const_reference>(value(node)))) {
+            unlink(node);
+            --size_;
+            ++removed;
+        } else {
+            kept = node;
+        }
+        node = next;
+    }
+    return removed;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::sort()
+{
+    sort(std::less<T>());
+}
+
+
+/** \brief Stable merge sort, relinking elements in place.
+ *
+ *  If `comp` throws, every element stays linked, in unspecified order.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+template <typename Compare>
+void intrusive_list<T, Hook, Destructor>::sort(Compare comp)
+{
+    if (size_ < 2) {
+        return;
+    }
+
+    This right;
+    const_iterator middle = std::next(cbegin(), static_cast<difference_type>(size_ / 2));
+    right.splice(right.end(), *this, middle, cend());
+    try {
+        sort(comp);
+        right.sort(comp);
+        merge(right, comp);
+    } catch (...) {
+        splice(end(), right);
+        throw;
+    }
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::reverse() noexcept
+{
+    Node *node = &head_;
+    do {
+        std::swap(node->next, node->prev);
+        node = node->prev;
+    } while (node != &head_);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::splice(const_iterator position,
+    This &x) noexcept
+{
+    if (&x != this && !x.empty()) {
+        transfer(position.node(), x.head_.next, &x.head_);
+        size_ += x.size_;
+        x.size_ = 0;
+    }
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::splice(const_iterator position,
+    This &&x) noexcept
+{
+    splice(position, x);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::splice(const_iterator position,
+    This &x,
+    const_iterator i) noexcept
+{
+    Node *node = i.node();
+    if (position.node() == node || position.node() == node->next) {
+        return;
+    }
+    transfer(position.node(), node, node->next);
+    --x.size_;
+    ++size_;
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::splice(const_iterator position,
+    This &&x,
+    const_iterator i) noexcept
+{
+    splice(position, x, i);
+}
+
+
+/** \brief Move `[first, last)` from `x` before `position`, in O(distance) unless `x` is this list.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::splice(const_iterator position,
+    This &x,
+    const_iterator first,
+    const_iterator last) noexcept
+{
+    if (first == last) {
+        return;
+    }
+    if (&x != this) {
+        size_type count = static_cast<size_type>(std::distance(first, last));
+        x.size_ -= count;
+        size_ += count;
+    }
+    transfer(position.node(), first.node(), last.node());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::splice(const_iterator position,
+    This &&x,
+    const_iterator first,
+    const_iterator last) noexcept
+{
+    splice(position, x, first, last);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::merge(This &x)
+{
+    merge(x, std::less<T>());
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+void intrusive_list<T, Hook, Destructor>::merge(This &&x)
+{
+    merge(x, std::less<T>());
+}
+
+
+/** \brief Merge sorted `x` into this sorted list, keeping equal elements of this list first.
+ *
+ *  If `comp` throws, elements already moved stay in this list.
+ */
+template <typename T, list_hook T::*Hook, typename Destructor>
+template <typename Compare>
+void intrusive_list<T, Hook, Destructor>::merge(This &x,
+    Compare comp)
+{
+    if (&x == this) {
+        return;
+    }
+
+    Node *node = head_.next;
+    while (node != &head_ && !x.empty()) {
+        Node *other = x.head_.next;
+        if (comp(static_cast<const_reference>(value(other)), static_cast<const_reference>(value(node)))) {
+            transfer(node, other, other->next);
+            --x.size_;
+            ++size_;
+        } else {
+            node = node->next;
+        }
+    }
+    splice(end(), x);
+}
+
+
+template <typename T, list_hook T::*Hook, typename Destructor>
+template <typename Compare>
+void intrusive_list<T, Hook, Destructor>::merge(This &&x,
+    Compare comp)
+{
+    merge(x, comp);
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <typename T, list_hook T::*Hook>
+using intrusive_list = itl::intrusive_list<T, Hook, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
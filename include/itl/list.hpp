@@ -9,6 +9,9 @@
 #pragma once
 
 #include <list>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
 
 
 namespace itl
@@ -21,13 +24,15 @@ namespace itl
  */
 template <
     typename T,
-    typename Alloc = std::allocator<T>
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
 >
-class list: protected std::list<T, Alloc>
+class list: protected std::list<T, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::list<T, Alloc> Base;
-    typedef list<T, Alloc> This;
+    typedef list<T, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -36,27 +41,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename V, typename A>
-    friend void swap(list<V, A> &left, list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend void swap(list<V, A, D> &left, list<V, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename V, typename A>
-    friend bool operator==(const list<V, A> &left, const list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator==(const list<V, A, D> &left, const list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator!=(const list<V, A> &left, const list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator!=(const list<V, A, D> &left, const list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>(const list<V, A> &left, const list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>(const list<V, A, D> &left, const list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>=(const list<V, A> &left, const list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>=(const list<V, A, D> &left, const list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<(const list<V, A> &left, const list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<(const list<V, A, D> &left, const list<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<=(const list<V, A> &left, const list<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<=(const list<V, A, D> &left, const list<V, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -77,7 +82,14 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~list();
+    list();
+    list(const This &other);
+    list(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    list(const This &other, const allocator_type &alloc);
+    list(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~list();
 
     // ITERATORS
     using Base::begin;
@@ -143,173 +155,253 @@ public:
 // --------------
 
 
-template <typename T, typename Alloc>
-auto list<T, Alloc>::ref() const
+template <typename T, typename Alloc, typename Destructor>
+auto list<T, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto list<T, Alloc>::ref()
+template <typename T, typename Alloc, typename Destructor>
+auto list<T, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto list<T, Alloc>::forward() const
+template <typename T, typename Alloc, typename Destructor>
+auto list<T, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto list<T, Alloc>::forward()
+template <typename T, typename Alloc, typename Destructor>
+auto list<T, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-void swap(list<T, Alloc> &left,
-    list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+void swap(list<T, Alloc, Destructor> &left,
+    list<T, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename T, typename Alloc>
-bool operator==(const list<T, Alloc> &left,
-    const list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator==(const list<T, Alloc, Destructor> &left,
+    const list<T, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator!=(const list<T, Alloc> &left,
-    const list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator!=(const list<T, Alloc, Destructor> &left,
+    const list<T, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>(const list<T, Alloc> &left,
-    const list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>(const list<T, Alloc, Destructor> &left,
+    const list<T, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>=(const list<T, Alloc> &left,
-    const list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>=(const list<T, Alloc, Destructor> &left,
+    const list<T, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<(const list<T, Alloc> &left,
-    const list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<(const list<T, Alloc, Destructor> &left,
+    const list<T, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<=(const list<T, Alloc> &left,
-    const list<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<=(const list<T, Alloc, Destructor> &left,
+    const list<T, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-list<T, Alloc>::~list()
+template <typename T, typename Alloc, typename Destructor>
+list<T, Alloc, Destructor>::list()
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+list<T, Alloc, Destructor>::list(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+list<T, Alloc, Destructor>::list(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+list<T, Alloc, Destructor>::list(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+list<T, Alloc, Destructor>::list(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto list<T, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto list<T, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+list<T, Alloc, Destructor>::~list()
 {}
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::splice(const_iterator position, This &x)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::splice(const_iterator position, This &x)
 {
     ref().splice(position, x.ref());
 }
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::splice(const_iterator position, This &&x)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::splice(const_iterator position, This &&x)
 {
     ref().splice(position, x.forward());
 }
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::splice(const_iterator position, This &x, const_iterator i)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::splice(const_iterator position, This &x, const_iterator i)
 {
     ref().splice(position, x.ref(), i);
 }
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::splice(const_iterator position, This &&x, const_iterator i)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::splice(const_iterator position, This &&x, const_iterator i)
 {
     ref().splice(position, x.forward(), i);
 }
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::splice(const_iterator position, This &x, const_iterator first, const_iterator last)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::splice(const_iterator position, This &x, const_iterator first, const_iterator last)
 {
     ref().splice(position, x.ref(), first, last);
 }
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::splice(const_iterator position, This &&x, const_iterator first, const_iterator last)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::splice(const_iterator position, This &&x, const_iterator first, const_iterator last)
 {
     ref().splice(position, x.forward(), first, last);
 }
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::merge(This &x)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::merge(This &x)
 {
     ref().merge(x.ref());
 }
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::merge(This &&x)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::merge(This &&x)
 {
     ref().merge(x.forward());
 }
 
 
-template <typename T, typename Alloc>
+template <typename T, typename Alloc, typename Destructor>
 template <typename Compare>
-void list<T, Alloc>::merge(This &x, Compare comp)
+void list<T, Alloc, Destructor>::merge(This &x, Compare comp)
 {
     ref().merge(x.ref(), comp);
 }
 
-template <typename T, typename Alloc>
+template <typename T, typename Alloc, typename Destructor>
 template <typename Compare>
-void list<T, Alloc>::merge(This &&x, Compare comp)
+void list<T, Alloc, Destructor>::merge(This &&x, Compare comp)
 {
     ref().merge(x.forward(), comp);
 }
 
 
-template <typename T, typename Alloc>
-void list<T, Alloc>::swap(This &other)
+template <typename T, typename Alloc, typename Destructor>
+void list<T, Alloc, Destructor>::swap(This &other)
 {
-    ref().swap(other.ref());
+    allocator_aware_swap(ref(), other.ref());
 }
 
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Alloc = std::allocator<T>
+>
+using list = itl::list<T, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <typename T>
+using list = itl::list<T, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
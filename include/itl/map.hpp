@@ -8,7 +8,13 @@
 
 #pragma once
 
+#include <cassert>
+#include <iterator>
 #include <map>
+#include <tuple>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
 
 
 namespace itl
@@ -23,13 +29,15 @@ template <
     typename Key,
     typename Value,
     typename Compare = std::less<Key>,
-    typename Alloc = std::allocator<std::pair<const Key,Value>>
+    typename Alloc = std::allocator<std::pair<const Key,Value>>,
+    typename Destructor = virtual_destructor
 >
-class map: protected std::map<Key, Value, Compare, Alloc>
+class map: protected std::map<Key, Value, Compare, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::map<Key, Value, Compare, Alloc> Base;
-    typedef map<Key, Value, Compare, Alloc> This;
+    typedef map<Key, Value, Compare, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -38,27 +46,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename V, typename C, typename A>
-    friend void swap(map<K, V, C, A> &left, map<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(map<K, V, C, A, D> &left, map<K, V, C, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator==(const map<K, V, C, A> &left, const map<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const map<K, V, C, A, D> &left, const map<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator!=(const map<K, V, C, A> &left, const map<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const map<K, V, C, A, D> &left, const map<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator>(const map<K, V, C, A> &left, const map<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>(const map<K, V, C, A, D> &left, const map<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator>=(const map<K, V, C, A> &left, const map<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>=(const map<K, V, C, A, D> &left, const map<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator<(const map<K, V, C, A> &left, const map<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<(const map<K, V, C, A, D> &left, const map<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator<=(const map<K, V, C, A> &left, const map<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<=(const map<K, V, C, A, D> &left, const map<K, V, C, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -79,11 +87,25 @@ public:
     using typename Base::const_reverse_iterator;
     using typename Base::difference_type;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+    using typename Base::insert_return_type;
+#endif
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~map();
+    map();
+    map(const This &other);
+    map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    map(const This &other, const allocator_type &alloc);
+    map(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~map();
+
+    template <typename Iter>
+    static This from_sorted(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
 
      // ITERATORS
     using Base::begin;
@@ -110,6 +132,32 @@ public:
     using Base::clear;
     using Base::emplace;
     using Base::emplace_hint;
+#if __cplusplus >= 201703L
+    using Base::try_emplace;
+    using Base::insert_or_assign;
+#else
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Ts&&... ts);
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Ts&&... ts);
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, const key_type &key, Ts&&... ts);
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, key_type &&key, Ts&&... ts);
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, V &&value);
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(key_type &&key, V &&value);
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, const key_type &key, V &&value);
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, key_type &&key, V &&value);
+#endif
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
     // OBSERVERS
@@ -122,6 +170,26 @@ public:
     using Base::lower_bound;
     using Base::upper_bound;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_associative_lookup)
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
 
     // ALLOCATOR
     using Base::get_allocator;
@@ -134,13 +202,15 @@ template <
     typename Key,
     typename Value,
     typename Compare = std::less<Key>,
-    typename Alloc = std::allocator<std::pair<const Key, Value>>
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
 >
-class multimap: protected std::multimap<Key, Value, Compare, Alloc>
+class multimap: protected std::multimap<Key, Value, Compare, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::multimap<Key, Value, Compare, Alloc> Base;
-    typedef multimap<Key, Value, Compare, Alloc> This;
+    typedef multimap<Key, Value, Compare, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -149,27 +219,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename V, typename C, typename A>
-    friend void swap(multimap<K, V, C, A> &left, multimap<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(multimap<K, V, C, A, D> &left, multimap<K, V, C, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator==(const multimap<K, V, C, A> &left, const multimap<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const multimap<K, V, C, A, D> &left, const multimap<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator!=(const multimap<K, V, C, A> &left, const multimap<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const multimap<K, V, C, A, D> &left, const multimap<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator>(const multimap<K, V, C, A> &left, const multimap<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>(const multimap<K, V, C, A, D> &left, const multimap<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator>=(const multimap<K, V, C, A> &left, const multimap<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator>=(const multimap<K, V, C, A, D> &left, const multimap<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator<(const multimap<K, V, C, A> &left, const multimap<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<(const multimap<K, V, C, A, D> &left, const multimap<K, V, C, A, D> &right);
 
-    template <typename K, typename V, typename C, typename A>
-    friend bool operator<=(const multimap<K, V, C, A> &left, const multimap<K, V, C, A> &right);
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator<=(const multimap<K, V, C, A, D> &left, const multimap<K, V, C, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -190,11 +260,24 @@ public:
     using typename Base::const_reverse_iterator;
     using typename Base::difference_type;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+#endif
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~multimap();
+    multimap();
+    multimap(const This &other);
+    multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    multimap(const This &other, const allocator_type &alloc);
+    multimap(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~multimap();
+
+    template <typename Iter>
+    static This from_sorted(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
 
     // ITERATORS
     using Base::begin;
@@ -217,6 +300,11 @@ public:
     using Base::clear;
     using Base::emplace;
     using Base::emplace_hint;
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
     // OBSERVERS
@@ -229,6 +317,26 @@ public:
     using Base::lower_bound;
     using Base::upper_bound;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_associative_lookup)
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
 
     // ALLOCATOR
     using Base::get_allocator;
@@ -239,203 +347,771 @@ public:
 // --------------
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto map<Key, Value, Compare, Alloc>::ref() const
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto map<Key, Value, Compare, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto map<Key, Value, Compare, Alloc>::ref()
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto map<Key, Value, Compare, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto map<Key, Value, Compare, Alloc>::forward() const
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto map<Key, Value, Compare, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto map<Key, Value, Compare, Alloc>::forward()
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto map<Key, Value, Compare, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-void swap(map<Key, Value, Compare, Alloc> &left,
-    map<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(map<Key, Value, Compare, Alloc, Destructor> &left,
+    map<Key, Value, Compare, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator==(const map<Key, Value, Compare, Alloc> &left,
-    const map<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const map<Key, Value, Compare, Alloc, Destructor> &left,
+    const map<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator!=(const map<Key, Value, Compare, Alloc> &left,
-    const map<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const map<Key, Value, Compare, Alloc, Destructor> &left,
+    const map<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator>(const map<Key, Value, Compare, Alloc> &left,
-    const map<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const map<Key, Value, Compare, Alloc, Destructor> &left,
+    const map<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator>=(const map<Key, Value, Compare, Alloc> &left,
-    const map<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const map<Key, Value, Compare, Alloc, Destructor> &left,
+    const map<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator<(const map<Key, Value, Compare, Alloc> &left,
-    const map<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const map<Key, Value, Compare, Alloc, Destructor> &left,
+    const map<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator<=(const map<Key, Value, Compare, Alloc> &left,
-    const map<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const map<Key, Value, Compare, Alloc, Destructor> &left,
+    const map<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-map<Key, Value, Compare, Alloc>::~map()
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+map<Key, Value, Compare, Alloc, Destructor>::map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+map<Key, Value, Compare, Alloc, Destructor>::map(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+map<Key, Value, Compare, Alloc, Destructor>::map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+map<Key, Value, Compare, Alloc, Destructor>::map(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+map<Key, Value, Compare, Alloc, Destructor>::map(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto map<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto map<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+map<Key, Value, Compare, Alloc, Destructor>::~map()
 {}
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-void map<Key, Value, Compare, Alloc>::swap(This &other)
+/** \brief Build a map from values sorted by key, in linear time.
+ *
+ *  Each value is appended at the end, with one comparison and
+ *  amortized constant rebalancing, and nodes are allocated in key
+ *  order: with `itl::arena::map`, they are contiguous. Values with
+ *  duplicate keys are skipped, as by `insert`. Debug builds assert
+ *  that the input is sorted.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename Iter>
+auto map<Key, Value, Compare, Alloc, Destructor>::from_sorted(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc)
+    -> This
+{
+    This result(comp, alloc);
+    for (; first != last; ++first) {
+        auto it = result.emplace_hint(result.end(), *first);
+        // unsorted input silently falls back to a full search
+        assert(std::next(it) == result.end() && "itl::map::from_sorted: unsorted input");
+        (void) it;
+    }
+    return result;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void map<Key, Value, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and erase it from `other`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void map<Key, Value, Compare, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    for (auto it = other.begin(); it != other.end();) {
+        if (Base::insert(*it).second) {
+            it = other.erase(it);
+        } else {
+            ++it;
+        }
+    }
+#endif
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void map<Key, Value, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if __cplusplus < 201703L
+
+/** \brief Construct a value in place, unless `key` is already present.
+ *
+ *  Unlike `emplace`, nothing is constructed for an existing key. This
+ *  is the standard C++17 member, provided for older libraries.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto map<Key, Value, Compare, Alloc, Destructor>::try_emplace(const key_type &key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, std::piecewise_construct,
+        std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(ts)...)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto map<Key, Value, Compare, Alloc, Destructor>::try_emplace(key_type &&key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, std::piecewise_construct,
+        std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(ts)...)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto map<Key, Value, Compare, Alloc, Destructor>::try_emplace(const_iterator,
+        const key_type &key,
+        Ts&&... ts)
+    -> iterator
+{
+    return try_emplace(key, std::forward<Ts>(ts)...).first;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto map<Key, Value, Compare, Alloc, Destructor>::try_emplace(const_iterator,
+        key_type &&key,
+        Ts&&... ts)
+    -> iterator
+{
+    return try_emplace(std::move(key), std::forward<Ts>(ts)...).first;
+}
+
+
+/** \brief Assign to the value of `key`, or insert it if absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const key_type &key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        it->second = std::forward<V>(value);
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, key, std::forward<V>(value)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(key_type &&key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::lower_bound(key);
+    if (it != end() && !key_comp()(key, it->first)) {
+        it->second = std::forward<V>(value);
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace_hint(it, std::move(key), std::forward<V>(value)), true);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const_iterator,
+        const key_type &key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(key, std::forward<V>(value)).first;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename V>
+auto map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const_iterator,
+        key_type &&key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(std::move(key), std::forward<V>(value)).first;
+}
+
+#endif
+
+
+#if !defined(__cpp_lib_generic_associative_lookup)
+
+/** \brief Heterogeneous lookup, for transparent comparators.
+ *
+ *  Before C++14, std ordered containers only search by `key_type`,
+ *  so these convert `key` to a temporary `key_type`, which allocates
+ *  for string keys, and search for that. A `key` equivalent to a
+ *  range of keys, rather than to one, is narrowed to the converted
+ *  key. From C++14, the std overloads compare `key` directly, without
+ *  either cost, and these are not declared.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::count(const K &key) const
+    -> size_type
+{
+    return Base::count(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::lower_bound(const K &key)
+    -> iterator
+{
+    return Base::lower_bound(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::lower_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::lower_bound(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::upper_bound(const K &key)
+    -> iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::upper_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return Base::equal_range(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto map<Key, Value, Compare, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
 {
-    ref().swap(other.ref());
+    return Base::equal_range(key_type(key));
 }
 
+#endif
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto multimap<Key, Value, Compare, Alloc>::ref() const
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto multimap<Key, Value, Compare, Alloc>::ref()
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto multimap<Key, Value, Compare, Alloc>::forward() const
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-auto multimap<Key, Value, Compare, Alloc>::forward()
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-void swap(multimap<Key, Value, Compare, Alloc> &left,
-    multimap<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    multimap<Key, Value, Compare, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator==(const multimap<Key, Value, Compare, Alloc> &left,
-    const multimap<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const multimap<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator!=(const multimap<Key, Value, Compare, Alloc> &left,
-    const multimap<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const multimap<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator>(const multimap<Key, Value, Compare, Alloc> &left,
-    const multimap<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const multimap<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator>=(const multimap<Key, Value, Compare, Alloc> &left,
-    const multimap<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const multimap<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator<(const multimap<Key, Value, Compare, Alloc> &left,
-    const multimap<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const multimap<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-bool operator<=(const multimap<Key, Value, Compare, Alloc> &left,
-    const multimap<Key, Value, Compare, Alloc> &right)
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const multimap<Key, Value, Compare, Alloc, Destructor> &left,
+    const multimap<Key, Value, Compare, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-multimap<Key, Value, Compare, Alloc>::~multimap()
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+multimap<Key, Value, Compare, Alloc, Destructor>::multimap()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+multimap<Key, Value, Compare, Alloc, Destructor>::multimap(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+multimap<Key, Value, Compare, Alloc, Destructor>::multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+multimap<Key, Value, Compare, Alloc, Destructor>::multimap(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+multimap<Key, Value, Compare, Alloc, Destructor>::multimap(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+multimap<Key, Value, Compare, Alloc, Destructor>::~multimap()
 {}
 
 
-template <typename Key, typename Value, typename Compare, typename Alloc>
-void multimap<Key, Value, Compare, Alloc>::swap(This &other)
+/** \brief Build a multimap from values sorted by key, in linear time.
+ *
+ *  Each value is appended at the end, with one comparison and
+ *  amortized constant rebalancing, and nodes are allocated in key
+ *  order: with `itl::arena::multimap`, they are contiguous. Debug
+ *  builds assert that the input is sorted.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename Iter>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::from_sorted(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc)
+    -> This
+{
+    This result(comp, alloc);
+    for (; first != last; ++first) {
+        auto it = result.emplace_hint(result.end(), *first);
+        // unsorted input silently falls back to a full search
+        assert(std::next(it) == result.end() && "itl::multimap::from_sorted: unsorted input");
+        (void) it;
+    }
+    return result;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void multimap<Key, Value, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and clear `other`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void multimap<Key, Value, Compare, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    Base::insert(other.begin(), other.end());
+    other.clear();
+#endif
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void multimap<Key, Value, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if !defined(__cpp_lib_generic_associative_lookup)
+
+/** \brief Heterogeneous lookup, for transparent comparators.
+ *
+ *  Before C++14, std ordered containers only search by `key_type`,
+ *  so these convert `key` to a temporary `key_type`, which allocates
+ *  for string keys, and search for that. A `key` equivalent to a
+ *  range of keys, rather than to one, is narrowed to the converted
+ *  key. From C++14, the std overloads compare `key` directly, without
+ *  either cost, and these are not declared.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::count(const K &key) const
+    -> size_type
+{
+    return Base::count(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::lower_bound(const K &key)
+    -> iterator
 {
-    ref().swap(other.ref());
+    return Base::lower_bound(key_type(key));
 }
 
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::lower_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::lower_bound(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::upper_bound(const K &key)
+    -> iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::upper_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return Base::equal_range(key_type(key));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multimap<Key, Value, Compare, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return Base::equal_range(key_type(key));
+}
+
+#endif
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key,Value>>
+>
+using map = itl::map<Key, Value, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using multimap = itl::multimap<Key, Value, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>
+>
+using map = itl::map<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>
+>
+using multimap = itl::multimap<Key, Value, Compare, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
@@ -0,0 +1,731 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "destructor.hpp"
+#include "span.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Access mode for a memory-mapped file.
+ *
+ *  read_only       map the file read-only, for `mapped_vector<const T>`
+ *  read_write      share writes with the file, which grows on demand
+ *  copy_on_write   writes are private and never reach the file
+ */
+enum class map_mode
+{
+    read_only,
+    read_write,
+    copy_on_write,
+};
+
+
+/** \brief Expected access pattern, forwarded to `madvise`.
+ */
+enum class map_advice
+{
+    normal,
+    sequential,
+    random,
+    willneed,
+    dontneed,
+};
+
+
+/** \brief Vector of trivially copyable elements backed by a mapped file.
+ *
+ *  Exports the read and iterate API of `itl::vector`. Opening the
+ *  file only maps it, so elements are paged in on first access.
+ *  Only read_write mappings may grow past the file size: growth
+ *  extends the file with `ftruncate` and remaps it, and the file is
+ *  truncated back to `size()` on close. Requires POSIX.
+ *
+ *  Writability is part of the type. `mapped_vector<const T>` maps
+ *  the file read_only and hands out const elements, so members that
+ *  write fail to compile. `mapped_vector<T>` maps it read_write or
+ *  copy_on_write.
+ */
+template <
+    typename T,
+    typename Destructor = virtual_destructor
+>
+class mapped_vector: protected Destructor
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "mapped_vector requires a trivially copyable type.");
+
+protected:
+    typedef mapped_vector<T, Destructor> This;
+    static constexpr map_mode default_mode = std::is_const<T>::value ? map_mode::read_only : map_mode::read_write;
+
+    void map(size_t n);
+    void remap(size_t n);
+    void unmap() noexcept;
+    void check(int result, const char *function) const;
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename V, typename D>
+    friend void swap(mapped_vector<V, D> &left, mapped_vector<V, D> &right) noexcept;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef typename std::remove_const<T>::type value_type;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef T * iterator;
+    typedef const T * const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    mapped_vector() noexcept;
+    explicit mapped_vector(const std::string &path, map_mode mode = default_mode);
+    mapped_vector(const This &other) = delete;
+    mapped_vector(This &&other) noexcept;
+    This & operator=(const This &other) = delete;
+    This & operator=(This &&other) noexcept;
+    ~mapped_vector();
+
+    // FILE
+    void open(const std::string &path, map_mode mode = default_mode);
+    void close() noexcept;
+    bool is_open() const noexcept;
+    map_mode mode() const noexcept;
+    void flush();
+    void advise(map_advice advice);
+
+    // ITERATORS
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // CAPACITY
+    size_type size() const noexcept;
+    size_type max_size() const noexcept;
+    void resize(size_type n);
+    void resize(size_type n, const value_type &value);
+    void resize_default_init(size_type n);
+    size_type capacity() const noexcept;
+    bool empty() const noexcept;
+    void reserve(size_type n);
+    void shrink_to_fit();
+
+    // ELEMENT ACCESS
+    reference operator[](size_type n);
+    const_reference operator[](size_type n) const;
+    reference at(size_type n);
+    const_reference at(size_type n) const;
+    reference front();
+    const_reference front() const;
+    reference back();
+    const_reference back() const;
+    pointer data() noexcept;
+    const_pointer data() const noexcept;
+
+    // MODIFIERS
+    void push_back(const value_type &value);
+    void pop_back();
+    void clear() noexcept;
+    span<T> append_uninitialized(size_type n);
+    void swap(This &other) noexcept;
+
+private:
+    int fd_;
+    map_mode mode_;
+    value_type *data_;
+    size_type size_;
+    size_type capacity_;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::map(size_t n)
+{
+    data_ = nullptr;
+    if (n) {
+        int prot = mode_ == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        int flags = mode_ == map_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+        void *address = ::mmap(nullptr, n * sizeof(T), prot, flags, fd_, 0);
+        if (address == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        data_ = static_cast<value_type*>(address);
+    }
+    capacity_ = n;
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::remap(size_t n)
+{
+    if (mode_ != map_mode::read_write && n > capacity_) {
+        throw std::logic_error("mapped_vector: only read_write mappings may grow.");
+    }
+    if (mode_ == map_mode::read_write) {
+        check(::ftruncate(fd_, static_cast<off_t>(n * sizeof(T))), "ftruncate");
+    }
+
+#if defined(MREMAP_MAYMOVE)
+    if (data_ && n) {
+        void *address = ::mremap(data_, capacity_ * sizeof(T), n * sizeof(T), MREMAP_MAYMOVE);
+        if (address == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mremap");
+        }
+        data_ = static_cast<value_type*>(address);
+        capacity_ = n;
+        return;
+    }
+#endif
+
+    unmap();
+    map(n);
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::unmap() noexcept
+{
+    if (data_) {
+        ::munmap(data_, capacity_ * sizeof(T));
+    }
+    data_ = nullptr;
+    capacity_ = 0;
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::check(int result,
+    const char *function) const
+{
+    if (result != 0) {
+        throw std::system_error(errno, std::generic_category(), function);
+    }
+}
+
+
+template <typename T, typename Destructor>
+void swap(mapped_vector<T, Destructor> &left,
+    mapped_vector<T, Destructor> &right) noexcept
+{
+    left.swap(right);
+}
+
+
+template <typename T, typename Destructor>
+mapped_vector<T, Destructor>::mapped_vector() noexcept:
+    fd_(-1),
+    mode_(map_mode::read_only),
+    data_(nullptr),
+    size_(0),
+    capacity_(0)
+{}
+
+
+template <typename T, typename Destructor>
+mapped_vector<T, Destructor>::mapped_vector(const std::string &path,
+        map_mode mode):
+    mapped_vector()
+{
+    open(path, mode);
+}
+
+
+template <typename T, typename Destructor>
+mapped_vector<T, Destructor>::mapped_vector(This &&other) noexcept:
+    mapped_vector()
+{
+    swap(other);
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    close();
+    swap(other);
+    return *this;
+}
+
+
+template <typename T, typename Destructor>
+mapped_vector<T, Destructor>::~mapped_vector()
+{
+    close();
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::open(const std::string &path,
+    map_mode mode)
+{
+    if ((mode == map_mode::read_only) != std::is_const<T>::value) {
+        throw std::invalid_argument("mapped_vector: read_only mappings require a const element type.");
+    }
+    close();
+    int flags = mode == map_mode::read_write ? O_RDWR | O_CREAT : O_RDONLY;
+    fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw std::system_error(errno, std::generic_category(), path);
+    }
+    mode_ = mode;
+
+    struct stat status;
+    try {
+        check(::fstat(fd_, &status), "fstat");
+        size_ = static_cast<size_type>(status.st_size) / sizeof(T);
+        map(size_);
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::close() noexcept
+{
+    bool truncate = mode_ == map_mode::read_write && size_ != capacity_;
+    unmap();
+    if (fd_ >= 0) {
+        if (truncate) {
+            static_cast<void>(::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T))));
+        }
+        ::close(fd_);
+    }
+    fd_ = -1;
+    size_ = 0;
+}
+
+
+template <typename T, typename Destructor>
+bool mapped_vector<T, Destructor>::is_open() const noexcept
+{
+    return fd_ >= 0;
+}
+
+
+template <typename T, typename Destructor>
+map_mode mapped_vector<T, Destructor>::mode() const noexcept
+{
+    return mode_;
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::flush()
+{
+    if (data_ && mode_ == map_mode::read_write) {
+        check(::msync(data_, capacity_ * sizeof(T), MS_SYNC), "msync");
+    }
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::advise(map_advice advice)
+{
+    if (!data_) {
+        return;
+    }
+
+    int value = MADV_NORMAL;
+    switch (advice) {
+        case map_advice::normal:
+            value = MADV_NORMAL;
+            break;
+        case map_advice::sequential:
+            value = MADV_SEQUENTIAL;
+            break;
+        case map_advice::random:
+            value = MADV_RANDOM;
+            break;
+        case map_advice::willneed:
+            value = MADV_WILLNEED;
+            break;
+        case map_advice::dontneed:
+            value = MADV_DONTNEED;
+            break;
+    }
+    check(::madvise(data_, capacity_ * sizeof(T), value), "madvise");
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::begin() noexcept
+    -> iterator
+{
+    return data_;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::begin() const noexcept
+    -> const_iterator
+{
+    return data_;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::end() noexcept
+    -> iterator
+{
+    return data_ + size_;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::end() const noexcept
+    -> const_iterator
+{
+    return data_ + size_;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::rbegin() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(end());
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::rbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(end());
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::rend() noexcept
+    -> reverse_iterator
+{
+    return reverse_iterator(begin());
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::rend() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(begin());
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::crbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return rbegin();
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::crend() const noexcept
+    -> const_reverse_iterator
+{
+    return rend();
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::max_size() const noexcept
+    -> size_type
+{
+    return static_cast<size_type>(std::numeric_limits<off_t>::max()) / sizeof(T);
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::resize(size_type n)
+{
+    resize(n, value_type());
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::resize(size_type n,
+    const value_type &value)
+{
+    size_type offset = size_;
+    if (n > offset) {
+        }
+    resize_default_init(n);
+    if (n > offset) {
+        std::fill(data_ + offset, data_ + n, value);
+    }
+}
+
+
+/** \brief Resize without initializing new elements.
+ *
+ *  Pages added by growing the file are zero-filled by the kernel.
+ */
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::resize_default_init(size_type n)
+{
+    if (n > capacity_) {
+        remap(n);
+    }
+    size_ = n;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::capacity() const noexcept
+    -> size_type
+{
+    return capacity_;
+}
+
+
+template <typename T, typename Destructor>
+bool mapped_vector<T, Destructor>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::reserve(size_type n)
+{
+    if (n > max_size()) {
+        throw std::length_error("mapped_vector::reserve");
+    } else if (n > capacity_) {
+        remap(n);
+    }
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::shrink_to_fit()
+{
+    if (mode_ == map_mode::read_write && size_ != capacity_) {
+        remap(size_);
+    }
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::operator[](size_type n)
+    -> reference
+{
+    return data_[n];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::operator[](size_type n) const
+    -> const_reference
+{
+    return data_[n];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::at(size_type n)
+    -> reference
+{
+    if (n >= size_) {
+        throw std::out_of_range("mapped_vector::at");
+    }
+    return data_[n];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::at(size_type n) const
+    -> const_reference
+{
+    if (n >= size_) {
+        throw std::out_of_range("mapped_vector::at");
+    }
+    return data_[n];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::front()
+    -> reference
+{
+    return data_[0];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::front() const
+    -> const_reference
+{
+    return data_[0];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::back()
+    -> reference
+{
+    return data_[size_ - 1];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::back() const
+    -> const_reference
+{
+    return data_[size_ - 1];
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::data() noexcept
+    -> pointer
+{
+    return data_;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::data() const noexcept
+    -> const_pointer
+{
+    return data_;
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::push_back(const value_type &value)
+{
+    static_assert(!std::is_const<T>::value, "mapped_vector<const T> is not writable.");
+    if (size_ == capacity_) {
+        // copy first, `value` may refer into the mapping
+        value_type copy = value;
+        reserve(std::max<size_type>(2 * capacity_, 1));
+        data_[size_++] = copy;
+    } else {
+        data_[size_++] = value;
+    }
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::pop_back()
+{
+    --size_;
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::clear() noexcept
+{
+    size_ = 0;
+}
+
+
+template <typename T, typename Destructor>
+auto mapped_vector<T, Destructor>::append_uninitialized(size_type n)
+    -> span<T>
+{
+    static_assert(!std::is_const<T>::value, "mapped_vector<const T> is not writable.");
+    size_type offset = size_;
+    if (size_ + n > capacity_) {
+        reserve(std::max(size_ + n, 2 * capacity_));
+    }
+    resize_default_init(offset + n);
+    return span<T>(data_ + offset, n);
+}
+
+
+template <typename T, typename Destructor>
+void mapped_vector<T, Destructor>::swap(This &other) noexcept
+{
+    std::swap(fd_, other.fd_);
+    std::swap(mode_, other.mode_);
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <typename T>
+using mapped_vector = itl::mapped_vector<T, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
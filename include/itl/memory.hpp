@@ -9,6 +9,7 @@
 #pragma once
 
 #include <memory>
+#include "relocate.hpp"
 
 
 namespace itl
@@ -159,9 +160,9 @@ public:
     virtual ~shared_ptr();
 
     shared_ptr(const Base &other);
-    shared_ptr(Base &&other);
+    shared_ptr(Base &&other) noexcept;
     shared_ptr(const This &other);
-    shared_ptr(This &&other);
+    shared_ptr(This &&other) noexcept;
 
     template <typename U>
     shared_ptr(U *u);
@@ -197,9 +198,9 @@ public:
     shared_ptr(std::unique_ptr<U, Deleter> &&other);
 
     This & operator=(const Base &other);
-    This & operator=(Base &&other);
+    This & operator=(Base &&other) noexcept;
     This & operator=(const This &other);
-    This & operator=(This &&other);
+    This & operator=(This &&other) noexcept;
 
     // MODIFIERS
     using Base::reset;
@@ -246,7 +247,7 @@ public:
     ~weak_ptr();
 
     weak_ptr(const This &other);
-    weak_ptr(This &&other);
+    weak_ptr(This &&other) noexcept;
 
     template <typename U>
     weak_ptr(const shared_ptr<U> &other) noexcept;
@@ -258,7 +259,7 @@ public:
     weak_ptr(weak_ptr<U> &&other);
 
     This & operator=(const This &other);
-    This & operator=(This &&other);
+    This & operator=(This &&other) noexcept;
 
     template <typename U>
     This & operator=(const shared_ptr<U> &other) noexcept;
@@ -665,13 +666,13 @@ shared_ptr<T>::shared_ptr(const This &other):
 
 
 template <typename T>
-shared_ptr<T>::shared_ptr(Base &&other):
+shared_ptr<T>::shared_ptr(Base &&other) noexcept:
     Base(std::move(other))
 {}
 
 
 template <typename T>
-shared_ptr<T>::shared_ptr(This &&other):
+shared_ptr<T>::shared_ptr(This &&other) noexcept:
     Base(other.forward())
 {}
 
@@ -686,7 +687,7 @@ auto shared_ptr<T>::operator=(const Base &other)
 
 
 template <typename T>
-auto shared_ptr<T>::operator=(Base &&other)
+auto shared_ptr<T>::operator=(Base &&other) noexcept
     -> This &
 {
     Base::operator=(std::move(other));
@@ -704,7 +705,7 @@ auto shared_ptr<T>::operator=(const This &other)
 
 
 template <typename T>
-auto shared_ptr<T>::operator=(This &&other)
+auto shared_ptr<T>::operator=(This &&other) noexcept
     -> This &
 {
     Base::operator=(other.forward());
@@ -787,7 +788,7 @@ weak_ptr<T>::weak_ptr(const shared_ptr<U> &other) noexcept :
 
 
 template <typename T>
-weak_ptr<T>::weak_ptr(This &&other):
+weak_ptr<T>::weak_ptr(This &&other) noexcept:
     Base(other.forward())
 {}
 
@@ -816,7 +817,7 @@ auto weak_ptr<T>::operator=(const This &other)
 
 
 template <typename T>
-auto weak_ptr<T>::operator=(This &&other)
+auto weak_ptr<T>::operator=(This &&other) noexcept
     -> This &
 {
     Base::operator=(other.forward());
@@ -880,6 +881,19 @@ shared_ptr<T> allocate_shared(const Alloc& alloc,
 }
 
 
+// TRAITS
+// ------
+
+
+template <typename T>
+struct is_trivially_relocatable<shared_ptr<T>>: std::true_type
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<weak_ptr<T>>: std::true_type
+{};
+
 }   /* itl */
 
 
@@ -0,0 +1,410 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "forward_list.hpp"
+#include "list.hpp"
+#include "map.hpp"
+#include "relocate.hpp"
+#include "set.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Process-wide pool of fixed-size blocks, with a cache per thread.
+ *
+ *  Each thread allocates from its own free list, then carves fresh
+ *  blocks in address order from 64 KiB slabs, so nodes allocated
+ *  together sit together. Threads exchange surplus blocks in batches
+ *  through a shared depot, taking its lock once per batch rather than
+ *  once per block. A thread's cached blocks return to the depot when
+ *  it exits. Slabs are never returned to the system.
+ */
+template <size_t Size, size_t Align>
+class node_pool
+{
+public:
+    static void * allocate();
+    static void deallocate(void *ptr) noexcept;
+
+private:
+    struct block
+    {
+        block *next;
+        block *next_batch;
+    };
+
+    struct slab
+    {
+        slab *next;
+    };
+
+    struct depot
+    {
+        std::mutex mutex;
+        block *batches = nullptr;
+        slab *slabs = nullptr;
+    };
+
+    // trivial, so blocks freed during static destruction still find it
+    struct cache
+    {
+        block *head;
+        size_t count;
+        char *cursor;
+        char *end;
+        bool registered;
+        bool exited;
+    };
+
+    struct reaper
+    {
+        ~reaper();
+    };
+
+    static constexpr size_t batch_size = 64;
+    static constexpr size_t header = (sizeof(slab) + Align - 1) / Align * Align;
+    static constexpr size_t slab_size = 65536 > header + 8 * Size ? 65536 : header + 8 * Size;
+
+    static_assert(Size >= sizeof(block) && Size % Align == 0, "itl::node_pool: invalid block size");
+
+    static depot & shared() noexcept;
+    static cache & local() noexcept;
+    static void enroll(cache &local);
+    static void * refill(cache &local);
+    static void flush(cache &local, size_t count) noexcept;
+};
+
+
+/** \brief Allocator drawing single nodes from a shared `itl::node_pool`.
+ *
+ *  Node-based containers rebind it to their node type, and every
+ *  node type of the same size and alignment shares one pool. Arrays,
+ *  such as hash buckets, and over-aligned types use `operator new`.
+ *  Stateless, so all instances compare equal and nodes may be freed
+ *  by any thread.
+ */
+template <typename T>
+class node_pool_allocator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type is_always_equal;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef node_pool_allocator<U> other;
+    };
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    node_pool_allocator() noexcept;
+
+    template <typename U>
+    node_pool_allocator(const node_pool_allocator<U> &other) noexcept;
+
+    T * allocate(size_type n);
+    void deallocate(T *p, size_type n) noexcept;
+
+private:
+    static constexpr size_t align = alignof(T) > alignof(void*) ? alignof(T) : alignof(void*);
+    static constexpr size_t size = ((sizeof(T) > 2 * sizeof(void*) ? sizeof(T) : 2 * sizeof(void*)) + align - 1) / align * align;
+    static constexpr bool pooled = alignof(T) <= alignof(std::max_align_t);
+
+    typedef node_pool<size, align> pool;
+};
+
+
+template <typename T, typename U>
+bool operator==(const node_pool_allocator<T> &left, const node_pool_allocator<U> &right) noexcept;
+
+template <typename T, typename U>
+bool operator!=(const node_pool_allocator<T> &left, const node_pool_allocator<U> &right) noexcept;
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <size_t Size, size_t Align>
+constexpr size_t node_pool<Size, Align>::batch_size;
+
+
+template <size_t Size, size_t Align>
+constexpr size_t node_pool<Size, Align>::header;
+
+
+template <size_t Size, size_t Align>
+constexpr size_t node_pool<Size, Align>::slab_size;
+
+
+template <size_t Size, size_t Align>
+node_pool<Size, Align>::reaper::~reaper()
+{
+    // hand back the uncarved rest of the slab too
+    cache &cached = local();
+    for (; cached.cursor != cached.end; cached.cursor += Size) {
+        block *node = reinterpret_cast<block*>(cached.cursor);
+        node->next = cached.head;
+        cached.head = node;
+        ++cached.count;
+    }
+    flush(cached, cached.count);
+    cached.exited = true;
+}
+
+
+/** \brief Depot shared by every thread, never destroyed, so it outlives all thread caches.
+ */
+template <size_t Size, size_t Align>
+auto node_pool<Size, Align>::shared() noexcept
+    -> depot &
+{
+    static depot *instance = new depot();
+    return *instance;
+}
+
+
+template <size_t Size, size_t Align>
+auto node_pool<Size, Align>::local() noexcept
+    -> cache &
+{
+    static thread_local cache instance = {nullptr, 0, nullptr, nullptr, false, false};
+    return instance;
+}
+
+
+/** \brief Flush the cache when the thread exits.
+ */
+template <size_t Size, size_t Align>
+void node_pool<Size, Align>::enroll(cache &local)
+{
+    static thread_local reaper instance;
+    (void) instance;
+    local.registered = true;
+}
+
+
+template <size_t Size, size_t Align>
+void * node_pool<Size, Align>::allocate()
+{
+    cache &cached = local();
+    block *head = cached.head;
+    if (head) {
+        cached.head = head->next;
+        --cached.count;
+        return head;
+    }
+    return refill(cached);
+}
+
+
+template <size_t Size, size_t Align>
+void node_pool<Size, Align>::deallocate(void *ptr) noexcept
+{
+    cache &cached = local();
+    block *node = static_cast<block*>(ptr);
+    node->next = cached.head;
+    cached.head = node;
+    ++cached.count;
+    if (cached.count >= 2 * batch_size || cached.exited) {
+        flush(cached, cached.exited ? cached.count : batch_size);
+    } else if (!cached.registered) {
+        try {
+            enroll(cached);
+        } catch (...) {
+            // without the exit hook, cached blocks leak when the thread exits
+        }
+    }
+}
+
+
+/** \brief Allocate once the free list is empty, from a depot batch, the current slab, or a new slab.
+ */
+template <size_t Size, size_t Align>
+void * node_pool<Size, Align>::refill(cache &cached)
+{
+    if (!cached.registered && !cached.exited) {
+        enroll(cached);
+    }
+
+    depot &pool = shared();
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        block *batch = pool.batches;
+        if (batch) {
+            pool.batches = batch->next_batch;
+            cached.head = batch->next;
+            for (block *node = cached.head; node; node = node->next) {
+                ++cached.count;
+            }
+            return batch;
+        }
+    }
+
+    if (cached.cursor == cached.end) {
+        slab *fresh = static_cast<slab*>(::operator new(slab_size));
+        {
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            fresh->next = pool.slabs;
+            pool.slabs = fresh;
+        }
+        cached.cursor = reinterpret_cast<char*>(fresh) + header;
+        cached.end = cached.cursor + (slab_size - header) / Size * Size;
+    }
+    void *ptr = cached.cursor;
+    cached.cursor += Size;
+    return ptr;
+}
+
+
+/** \brief Move `count` cached blocks to the depot as one batch.
+ */
+template <size_t Size, size_t Align>
+void node_pool<Size, Align>::flush(cache &cached,
+    size_t count) noexcept
+{
+    if (count == 0) {
+        return;
+    }
+    block *first = cached.head;
+    block *last = first;
+    for (size_t i = 1; i < count; ++i) {
+        last = last->next;
+    }
+    cached.head = last->next;
+    cached.count -= count;
+    last->next = nullptr;
+
+    depot &pool = shared();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    first->next_batch = pool.batches;
+    pool.batches = first;
+}
+
+
+template <typename T>
+constexpr size_t node_pool_allocator<T>::align;
+
+
+template <typename T>
+constexpr size_t node_pool_allocator<T>::size;
+
+
+template <typename T>
+constexpr bool node_pool_allocator<T>::pooled;
+
+
+template <typename T>
+node_pool_allocator<T>::node_pool_allocator() noexcept
+{}
+
+
+template <typename T>
+template <typename U>
+node_pool_allocator<T>::node_pool_allocator(const node_pool_allocator<U> &) noexcept
+{}
+
+
+template <typename T>
+T * node_pool_allocator<T>::allocate(size_type n)
+{
+    if (n == 1 && pooled) {
+        return static_cast<T*>(pool::allocate());
+    }
+    if (n > SIZE_MAX / sizeof(T)) {
+        throw std::bad_alloc();
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+}
+
+
+template <typename T>
+void node_pool_allocator<T>::deallocate(T *p,
+    size_type n) noexcept
+{
+    if (n == 1 && pooled) {
+        pool::deallocate(p);
+    } else {
+        ::operator delete(p);
+    }
+}
+
+
+template <typename T, typename U>
+bool operator==(const node_pool_allocator<T> &,
+    const node_pool_allocator<U> &) noexcept
+{
+    return true;
+}
+
+
+template <typename T, typename U>
+bool operator!=(const node_pool_allocator<T> &,
+    const node_pool_allocator<U> &) noexcept
+{
+    return false;
+}
+
+
+// TRAITS
+// ------
+
+
+template <typename T>
+struct is_trivially_relocatable<node_pool_allocator<T>>: std::true_type
+{};
+
+
+// POOLED
+// ------
+
+namespace pooled
+{
+
+template <typename T>
+using list = itl::list<T, node_pool_allocator<T>>;
+
+template <typename T>
+using forward_list = itl::forward_list<T, node_pool_allocator<T>>;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using map = itl::map<Key, Value, Compare, node_pool_allocator<std::pair<const Key, Value>>>;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using multimap = itl::multimap<Key, Value, Compare, node_pool_allocator<std::pair<const Key, Value>>>;
+
+template <typename T, typename Compare = std::less<T>>
+using set = itl::set<T, Compare, node_pool_allocator<T>>;
+
+template <typename T, typename Compare = std::less<T>>
+using multiset = itl::multiset<T, Compare, node_pool_allocator<T>>;
+
+}   /* pooled */
+
+}   /* itl */
@@ -0,0 +1,655 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+#include "allocator.hpp"
+#include "btree.hpp"
+#include "destructor.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Inheritable set with rank and select in logarithmic time.
+ *
+ *  Exports the member surface of `itl::btree_set`, plus `nth`, the
+ *  element at an index, `rank`, the index of a key, and `count_range`,
+ *  the number of keys in a half-open range. Like `itl::btree_set`,
+ *  inserts and erases invalidate all iterators and references.
+ */
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class order_statistic_set: protected btree::tree<T, T, Compare, Alloc, false, true>,
+    protected Destructor
+{
+protected:
+    typedef btree::tree<T, T, Compare, Alloc, false, true> Base;
+    typedef order_statistic_set<T, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(order_statistic_set<K, C, A, D> &left, order_statistic_set<K, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const order_statistic_set<K, C, A, D> &left, const order_statistic_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const order_statistic_set<K, C, A, D> &left, const order_statistic_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const order_statistic_set<K, C, A, D> &left, const order_statistic_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const order_statistic_set<K, C, A, D> &left, const order_statistic_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const order_statistic_set<K, C, A, D> &left, const order_statistic_set<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const order_statistic_set<K, C, A, D> &left, const order_statistic_set<K, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    order_statistic_set();
+    order_statistic_set(const This &other);
+    order_statistic_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    order_statistic_set(const This &other, const allocator_type &alloc);
+    order_statistic_set(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~order_statistic_set();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+    using Base::nth;
+    using Base::rank;
+    using Base::count_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+/** \brief Inheritable multiset with rank and select in logarithmic time.
+ *
+ *  Exports the member surface of `itl::btree_multiset`, plus `nth`,
+ *  `rank` and `count_range`. Inserts and erases invalidate all
+ *  iterators.
+ */
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class order_statistic_multiset: protected btree::tree<T, T, Compare, Alloc, true, true>,
+    protected Destructor
+{
+protected:
+    typedef btree::tree<T, T, Compare, Alloc, true, true> Base;
+    typedef order_statistic_multiset<T, Compare, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(order_statistic_multiset<K, C, A, D> &left, order_statistic_multiset<K, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const order_statistic_multiset<K, C, A, D> &left, const order_statistic_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const order_statistic_multiset<K, C, A, D> &left, const order_statistic_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const order_statistic_multiset<K, C, A, D> &left, const order_statistic_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const order_statistic_multiset<K, C, A, D> &left, const order_statistic_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const order_statistic_multiset<K, C, A, D> &left, const order_statistic_multiset<K, C, A, D> &right);
+
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const order_statistic_multiset<K, C, A, D> &left, const order_statistic_multiset<K, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::value_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    order_statistic_multiset();
+    order_statistic_multiset(const This &other);
+    order_statistic_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    order_statistic_multiset(const This &other, const allocator_type &alloc);
+    order_statistic_multiset(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~order_statistic_multiset();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+    using Base::max_size;
+
+    // MODIFIERS
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_hint;
+    void merge(This &other);
+    void merge(This &&other);
+    void swap(This &other);
+
+    // OBSERVERS
+    using Base::key_comp;
+    using Base::value_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+    using Base::equal_range;
+    using Base::nth;
+    using Base::rank;
+    using Base::count_range;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_set<Key, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_set<Key, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_set<Key, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_set<Key, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(order_statistic_set<Key, Compare, Alloc, Destructor> &left,
+    order_statistic_set<Key, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const order_statistic_set<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const order_statistic_set<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const order_statistic_set<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const order_statistic_set<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const order_statistic_set<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const order_statistic_set<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_set<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_set<Key, Compare, Alloc, Destructor>::order_statistic_set()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_set<Key, Compare, Alloc, Destructor>::order_statistic_set(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_set<Key, Compare, Alloc, Destructor>::order_statistic_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_set<Key, Compare, Alloc, Destructor>::order_statistic_set(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_set<Key, Compare, Alloc, Destructor>::order_statistic_set(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_set<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_set<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_set<Key, Compare, Alloc, Destructor>::~order_statistic_set()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void order_statistic_set<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void order_statistic_set<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void order_statistic_set<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_multiset<Key, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_multiset<Key, Compare, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_multiset<Key, Compare, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_multiset<Key, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(order_statistic_multiset<Key, Compare, Alloc, Destructor> &left,
+    order_statistic_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const order_statistic_multiset<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const order_statistic_multiset<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const order_statistic_multiset<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const order_statistic_multiset<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const order_statistic_multiset<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const order_statistic_multiset<Key, Compare, Alloc, Destructor> &left,
+    const order_statistic_multiset<Key, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_multiset<Key, Compare, Alloc, Destructor>::order_statistic_multiset()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_multiset<Key, Compare, Alloc, Destructor>::order_statistic_multiset(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_multiset<Key, Compare, Alloc, Destructor>::order_statistic_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_multiset<Key, Compare, Alloc, Destructor>::order_statistic_multiset(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_multiset<Key, Compare, Alloc, Destructor>::order_statistic_multiset(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_multiset<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto order_statistic_multiset<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+order_statistic_multiset<Key, Compare, Alloc, Destructor>::~order_statistic_multiset()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void order_statistic_multiset<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void order_statistic_multiset<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    Base::merge(other.ref());
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void order_statistic_multiset<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using order_statistic_set = itl::order_statistic_set<T, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using order_statistic_multiset = itl::order_statistic_multiset<T, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using order_statistic_set = itl::order_statistic_set<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using order_statistic_multiset = itl::order_statistic_multiset<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
+}   /* itl */
@@ -0,0 +1,1849 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace itl
+{
+namespace persistent
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Deepest path an iterator tracks, enough for 2^44 AVL nodes.
+ */
+constexpr size_t max_depth = 64;
+
+
+/** \brief Bits of the index consumed per trie level.
+ */
+constexpr size_t trie_bits = 5;
+constexpr size_t trie_width = size_t(1) << trie_bits;
+constexpr size_t trie_mask = trie_width - 1;
+
+
+/** \brief Reference-counted node of a persistent AVL tree.
+ */
+template <typename T>
+struct tree_node
+{
+    std::atomic<size_t> refs;
+    tree_node *left;
+    tree_node *right;
+    int height;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+    T * value() noexcept;
+};
+
+
+/** \brief Forward iterator over a tree, keeping the path of pending ancestors.
+ *
+ *  Valid while the version it came from is alive, since versions
+ *  never change.
+ */
+template <typename Node, typename T>
+class tree_iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T * pointer;
+    typedef const T & reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    tree_iterator() noexcept;
+
+    reference operator*() const;
+    pointer operator->() const;
+    tree_iterator & operator++();
+    tree_iterator operator++(int);
+    bool operator==(const tree_iterator &other) const noexcept;
+    bool operator!=(const tree_iterator &other) const noexcept;
+
+    void push(Node *node) noexcept;
+    void push_left(Node *node) noexcept;
+
+private:
+    Node *stack_[max_depth];
+    size_t depth_;
+};
+
+
+/** \brief AVL tree of key-value pairs, shared by the persistent maps.
+ *
+ *  Nodes are reference counted and shared between versions. Edits
+ *  copy the path from the root to the change, except for nodes only
+ *  this tree references, which are edited in place: copying a tree
+ *  shares its root, so the next edit of either copy copies its path
+ *  once, and further edits of that copy are in place.
+ *
+ *  If an edit throws, the tree is left empty. Other trees sharing
+ *  its nodes are never affected.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare,
+    typename Alloc
+>
+class tree
+{
+protected:
+    typedef tree<Key, Value, Compare, Alloc> This;
+    typedef std::pair<const Key, Value> T;
+    typedef tree_node<T> Node;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<Node> NodeAlloc;
+    typedef std::allocator_traits<NodeAlloc> NodeTraits;
+
+    /** \brief Owned reference released on scope exit, unless taken.
+     */
+    struct hold
+    {
+        const This *owner;
+        Node *node;
+
+        ~hold();
+        Node * get() noexcept;
+    };
+
+    static int height(Node *node) noexcept;
+    static bool unique(Node *node) noexcept;
+    static Node * retain(Node *node) noexcept;
+    void release(Node *node) const noexcept;
+
+    template <typename... Ts>
+    Node * make_node(Node *left, Node *right, Ts&&... ts);
+    Node * take_left(Node *node);
+    Node * take_right(Node *node);
+    Node * join(Node *node, Node *left, Node *right);
+    Node * balance(Node *node, Node *left, Node *right);
+
+    template <typename V>
+    Node * assign(Node *node, const Key &key, V &&value, bool &inserted);
+    Node * remove(Node *node, const Key &key);
+    Node * remove_min(Node *node, Node *&min);
+
+    template <typename V>
+    bool insert_or_assign(const Key &key, V &&value);
+    bool insert(const T &value);
+    size_t erase(const Key &key);
+    void clear() noexcept;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef T value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef const value_type & reference;
+    typedef const value_type & const_reference;
+    typedef tree_iterator<Node, T> iterator;
+    typedef tree_iterator<Node, T> const_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    tree();
+    explicit tree(const key_compare &comp, const allocator_type &alloc = allocator_type());
+    explicit tree(const allocator_type &alloc);
+    tree(const This &other) noexcept;
+    tree(This &&other) noexcept;
+    This & operator=(const This &other) noexcept;
+    This & operator=(This &&other) noexcept;
+    ~tree();
+
+    // ITERATORS
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+
+    // ELEMENT ACCESS
+    const mapped_type & at(const key_type &key) const;
+
+    // MODIFIERS
+    void swap(This &other) noexcept;
+
+    // OBSERVERS
+    key_compare key_comp() const;
+
+    // OPERATIONS
+    const_iterator find(const key_type &key) const;
+    size_type count(const key_type &key) const;
+    const_iterator lower_bound(const key_type &key) const;
+    const_iterator upper_bound(const key_type &key) const;
+
+    // ALLOCATOR
+    allocator_type get_allocator() const;
+
+private:
+    Node *root_;
+    size_t size_;
+    key_compare comp_;
+    allocator_type alloc_;
+};
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+bool operator==(const tree<Key, Value, Compare, Alloc> &left, const tree<Key, Value, Compare, Alloc> &right);
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+bool operator!=(const tree<Key, Value, Compare, Alloc> &left, const tree<Key, Value, Compare, Alloc> &right);
+
+
+/** \brief Reference-counted node of a persistent trie.
+ *
+ *  Leaves hold up to `trie_width` values, branches as many children.
+ */
+template <typename T>
+struct trie_node
+{
+    std::atomic<size_t> refs;
+    uint32_t count;
+    bool leaf;
+};
+
+
+template <typename T>
+struct trie_branch: trie_node<T>
+{
+    trie_node<T> *children[trie_width];
+};
+
+
+template <typename T>
+struct trie_leaf: trie_node<T>
+{
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[trie_width];
+
+    T * value(size_t i) noexcept;
+};
+
+
+/** \brief Random-access iterator over a trie, caching the current leaf.
+ */
+template <typename Trie, typename T>
+class trie_iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T * pointer;
+    typedef const T & reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    trie_iterator() noexcept;
+    trie_iterator(const Trie *trie, size_t index) noexcept;
+
+    reference operator*() const;
+    pointer operator->() const;
+    reference operator[](difference_type n) const;
+    trie_iterator & operator++() noexcept;
+    trie_iterator operator++(int) noexcept;
+    trie_iterator & operator--() noexcept;
+    trie_iterator operator--(int) noexcept;
+    trie_iterator & operator+=(difference_type n) noexcept;
+    trie_iterator operator+(difference_type n) const noexcept;
+    trie_iterator & operator-=(difference_type n) noexcept;
+    trie_iterator operator-(difference_type n) const noexcept;
+    difference_type operator-(const trie_iterator &other) const noexcept;
+
+    bool operator==(const trie_iterator &other) const noexcept;
+    bool operator!=(const trie_iterator &other) const noexcept;
+    bool operator<(const trie_iterator &other) const noexcept;
+    bool operator<=(const trie_iterator &other) const noexcept;
+    bool operator>(const trie_iterator &other) const noexcept;
+    bool operator>=(const trie_iterator &other) const noexcept;
+
+private:
+    const Trie *trie_;
+    size_t index_;
+    mutable const T *leaf_;
+    mutable size_t base_;
+};
+
+
+/** \brief Trie of 32-value leaves with a separate tail, shared by the persistent vectors.
+ *
+ *  Indexes are split into 5-bit digits, one per level, so a lookup
+ *  or edit touches `log32(n)` nodes. Appends fill the tail leaf,
+ *  which only moves into the trie once full. Nodes are shared and
+ *  edited in place exactly as in `persistent::tree`.
+ */
+template <typename T, typename Alloc>
+class trie
+{
+protected:
+    typedef trie<T, Alloc> This;
+    typedef trie_node<T> Node;
+    typedef trie_branch<T> Branch;
+    typedef trie_leaf<T> Leaf;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<Branch> BranchAlloc;
+    typedef typename AllocTraits::template rebind_alloc<Leaf> LeafAlloc;
+    typedef std::allocator_traits<BranchAlloc> BranchTraits;
+    typedef std::allocator_traits<LeafAlloc> LeafTraits;
+
+    template <typename Trie, typename U>
+    friend class trie_iterator;
+
+    struct hold
+    {
+        const This *owner;
+        Node *node;
+
+        ~hold();
+        Node * get() noexcept;
+    };
+
+    static bool unique(Node *node) noexcept;
+    static Node * retain(Node *node) noexcept;
+    void release(Node *node) const noexcept;
+
+    Branch * make_branch();
+    Leaf * make_leaf();
+    Node * editable(Node *node);
+    size_t tail_offset() const noexcept;
+    Leaf * leaf_for(size_t i) const noexcept;
+
+    Node * push_tail(size_t size, size_t level, Node *parent, Node *tail);
+    Node * new_path(size_t level, Node *node);
+    Node * pop_tail(size_t size, size_t level, Node *node);
+    template <typename V>
+    Node * assign(size_t level, Node *node, size_t i, V &&value);
+
+    template <typename... Ts>
+    void emplace_back(Ts&&... ts);
+    void pop_back();
+    template <typename V>
+    void assign(size_t i, V &&value);
+    void clear() noexcept;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef const value_type & reference;
+    typedef const value_type & const_reference;
+    typedef trie_iterator<This, T> iterator;
+    typedef trie_iterator<This, T> const_iterator;
+    typedef std::reverse_iterator<const_iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    trie();
+    explicit trie(const allocator_type &alloc);
+    trie(const This &other) noexcept;
+    trie(This &&other) noexcept;
+    This & operator=(const This &other) noexcept;
+    This & operator=(This &&other) noexcept;
+    ~trie();
+
+    // ITERATORS
+    const_iterator begin() const noexcept;
+    const_iterator end() const noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_iterator cbegin() const noexcept;
+    const_iterator cend() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // CAPACITY
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+
+    // ELEMENT ACCESS
+    const_reference operator[](size_type i) const;
+    const_reference at(size_type i) const;
+    const_reference front() const;
+    const_reference back() const;
+
+    // MODIFIERS
+    void swap(This &other) noexcept;
+
+    // ALLOCATOR
+    allocator_type get_allocator() const;
+
+private:
+    Node *root_;
+    Node *tail_;
+    size_t size_;
+    size_t shift_;
+    allocator_type alloc_;
+};
+
+
+template <typename T, typename Alloc>
+bool operator==(const trie<T, Alloc> &left, const trie<T, Alloc> &right);
+
+template <typename T, typename Alloc>
+bool operator!=(const trie<T, Alloc> &left, const trie<T, Alloc> &right);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T>
+T * tree_node<T>::value() noexcept
+{
+    return reinterpret_cast<T*>(&storage);
+}
+
+
+template <typename Node, typename T>
+tree_iterator<Node, T>::tree_iterator() noexcept:
+    depth_(0)
+{}
+
+
+template <typename Node, typename T>
+auto tree_iterator<Node, T>::operator*() const
+    -> reference
+{
+    return *stack_[depth_ - 1]->value();
+}
+
+
+template <typename Node, typename T>
+auto tree_iterator<Node, T>::operator->() const
+    -> pointer
+{
+    return stack_[depth_ - 1]->value();
+}
+
+
+template <typename Node, typename T>
+auto tree_iterator<Node, T>::operator++()
+    -> tree_iterator &
+{
+    Node *node = stack_[--depth_];
+    push_left(node->right);
+    return *this;
+}
+
+
+template <typename Node, typename T>
+auto tree_iterator<Node, T>::operator++(int)
+    -> tree_iterator
+{
+    tree_iterator copy(*this);
+    operator++();
+    return copy;
+}
+
+
+template <typename Node, typename T>
+bool tree_iterator<Node, T>::operator==(const tree_iterator &other) const noexcept
+{
+    return depth_ == other.depth_ && (depth_ == 0 || stack_[depth_ - 1] == other.stack_[depth_ - 1]);
+}
+
+
+template <typename Node, typename T>
+bool tree_iterator<Node, T>::operator!=(const tree_iterator &other) const noexcept
+{
+    return !operator==(other);
+}
+
+
+/** \brief Visit `node` after the values already on the stack.
+ */
+template <typename Node, typename T>
+void tree_iterator<Node, T>::push(Node *node) noexcept
+{
+    assert(depth_ < max_depth && "itl::persistent: tree too deep");
+    stack_[depth_++] = node;
+}
+
+
+/** \brief Visit the subtree of `node` before the values on the stack.
+ */
+template <typename Node, typename T>
+void tree_iterator<Node, T>::push_left(Node *node) noexcept
+{
+    for (; node; node = node->left) {
+        push(node);
+    }
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+tree<Key, Value, Compare, Alloc>::hold::~hold()
+{
+    owner->release(node);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::hold::get() noexcept
+    -> Node *
+{
+    Node *taken = node;
+    node = nullptr;
+    return taken;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+int tree<Key, Value, Compare, Alloc>::height(Node *node) noexcept
+{
+    return node ? node->height : 0;
+}
+
+
+/** \brief If only the caller references `node`, so it may be edited in place.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+bool tree<Key, Value, Compare, Alloc>::unique(Node *node) noexcept
+{
+    return node->refs.load(std::memory_order_acquire) == 1;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::retain(Node *node) noexcept
+    -> Node *
+{
+    if (node) {
+        node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+void tree<Key, Value, Compare, Alloc>::release(Node *node) const noexcept
+{
+    if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        release(node->left);
+        release(node->right);
+        NodeAlloc alloc(alloc_);
+        AllocTraits::destroy(const_cast<allocator_type&>(alloc_), node->value());
+        NodeTraits::deallocate(alloc, node, 1);
+    }
+}
+
+
+/** \brief New node owning `left` and `right`, which are released if it throws.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+template <typename... Ts>
+auto tree<Key, Value, Compare, Alloc>::make_node(Node *left,
+        Node *right,
+        Ts&&... ts)
+    -> Node *
+{
+    hold l = {this, left};
+    hold r = {this, right};
+    NodeAlloc alloc(alloc_);
+    Node *node = NodeTraits::allocate(alloc, 1);
+    try {
+        AllocTraits::construct(alloc_, node->value(), std::forward<Ts>(ts)...);
+    } catch (...) {
+        NodeTraits::deallocate(alloc, node, 1);
+        throw;
+    }
+    ::new (static_cast<void*>(&node->refs)) std::atomic<size_t>(1);
+    node->left = l.get();
+    node->right = r.get();
+    node->height = 1 + std::max(height(node->left), height(node->right));
+    return node;
+}
+
+
+/** \brief Owned reference to the left child, moved out if `node` is unique.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::take_left(Node *node)
+    -> Node *
+{
+    if (unique(node)) {
+        Node *left = node->left;
+        node->left = nullptr;
+        return left;
+    }
+    return retain(node->left);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::take_right(Node *node)
+    -> Node *
+{
+    if (unique(node)) {
+        Node *right = node->right;
+        node->right = nullptr;
+        return right;
+    }
+    return retain(node->right);
+}
+
+
+/** \brief The value of `node` over new children, consuming all three.
+ *
+ *  Reuses `node` if unique, and copies its value otherwise.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::join(Node *node,
+        Node *left,
+        Node *right)
+    -> Node *
+{
+    if (unique(node)) {
+        // children still set were shared when taken, so drop our references
+        release(node->left);
+        release(node->right);
+        node->left = left;
+        node->right = right;
+        node->height = 1 + std::max(height(left), height(right));
+        return node;
+    }
+    hold shared = {this, node};
+    return make_node(left, right, *node->value());
+}
+
+
+/** \brief Join, rotating once or twice if the heights differ by two.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::balance(Node *node,
+        Node *left,
+        Node *right)
+    -> Node *
+{
+    int lh = height(left);
+    int rh = height(right);
+    if (lh > rh + 1) {
+        Node *ll = take_left(left);
+        Node *lr = take_right(left);
+        if (height(ll) >= height(lr)) {
+            hold a = {this, left};
+            hold b = {this, ll};
+            Node *inner = join(node, lr, right);
+            return join(a.get(), b.get(), inner);
+        }
+        Node *lrl = take_left(lr);
+        Node *lrr = take_right(lr);
+        hold a = {this, left};
+        hold b = {this, ll};
+        hold c = {this, lr};
+        hold d = {this, lrl};
+        hold e = {this, join(node, lrr, right)};
+        hold f = {this, join(a.get(), b.get(), d.get())};
+        return join(c.get(), f.get(), e.get());
+    }
+    if (rh > lh + 1) {
+        Node *rl = take_left(right);
+        Node *rr = take_right(right);
+        if (height(rr) >= height(rl)) {
+            hold a = {this, right};
+            hold b = {this, rr};
+            Node *inner = join(node, left, rl);
+            return join(a.get(), inner, b.get());
+        }
+        Node *rll = take_left(rl);
+        Node *rlr = take_right(rl);
+        hold a = {this, right};
+        hold b = {this, rr};
+        hold c = {this, rl};
+        hold d = {this, rlr};
+        hold e = {this, join(node, left, rll)};
+        hold f = {this, join(a.get(), d.get(), b.get())};
+        return join(c.get(), e.get(), f.get());
+    }
+    return join(node, left, right);
+}
+
+
+/** \brief Subtree of `node` with `key` set to `value`, consuming `node`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+template <typename V>
+auto tree<Key, Value, Compare, Alloc>::assign(Node *node,
+        const Key &key,
+        V &&value,
+        bool &inserted)
+    -> Node *
+{
+    if (!node) {
+        inserted = true;
+        return make_node(nullptr, nullptr, key, std::forward<V>(value));
+    }
+    hold self = {this, node};
+    if (comp_(key, node->value()->first)) {
+        Node *left = assign(take_left(node), key, std::forward<V>(value), inserted);
+        self.get();
+        return balance(node, left, take_right(node));
+    }
+    if (comp_(node->value()->first, key)) {
+        Node *right = assign(take_right(node), key, std::forward<V>(value), inserted);
+        self.get();
+        return balance(node, take_left(node), right);
+    }
+    inserted = false;
+    if (unique(node)) {
+        node->value()->second = std::forward<V>(value);
+        return self.get();
+    }
+    return make_node(retain(node->left), retain(node->right), node->value()->first, std::forward<V>(value));
+}
+
+
+/** \brief Subtree of `node` without `key`, which must be present.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::remove(Node *node,
+        const Key &key)
+    -> Node *
+{
+    hold self = {this, node};
+    if (comp_(key, node->value()->first)) {
+        Node *left = remove(take_left(node), key);
+        self.get();
+        return balance(node, left, take_right(node));
+    }
+    if (comp_(node->value()->first, key)) {
+        Node *right = remove(take_right(node), key);
+        self.get();
+        return balance(node, take_left(node), right);
+    }
+
+    hold left = {this, take_left(node)};
+    Node *right = take_right(node);
+    release(self.get());
+    if (!right) {
+        return left.get();
+    }
+    if (!left.node) {
+        return right;
+    }
+    // the successor replaces the erased node
+    hold min = {this, nullptr};
+    Node *rest = remove_min(right, min.node);
+    return balance(min.get(), left.get(), rest);
+}
+
+
+/** \brief Subtree of `node` without its leftmost node, which is handed out in `min`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::remove_min(Node *node,
+        Node *&min)
+    -> Node *
+{
+    if (!node->left) {
+        Node *right = take_right(node);
+        min = node;
+        return right;
+    }
+    hold self = {this, node};
+    Node *left = remove_min(take_left(node), min);
+    self.get();
+    return balance(node, left, take_right(node));
+}
+
+
+/** \brief Set `key` to `value`, returning if it was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+template <typename V>
+bool tree<Key, Value, Compare, Alloc>::insert_or_assign(const Key &key,
+    V &&value)
+{
+    // empty until the edit completes, which leaves it valid if it throws
+    Node *root = root_;
+    size_t size = size_;
+    root_ = nullptr;
+    size_ = 0;
+    bool inserted = false;
+    root_ = assign(root, key, std::forward<V>(value), inserted);
+    size_ = size + (inserted ? 1 : 0);
+    return inserted;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+bool tree<Key, Value, Compare, Alloc>::insert(const T &value)
+{
+    if (count(value.first)) {
+        return false;
+    }
+    return insert_or_assign(value.first, value.second);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+size_t tree<Key, Value, Compare, Alloc>::erase(const Key &key)
+{
+    if (!count(key)) {
+        return 0;
+    }
+    Node *root = root_;
+    size_t size = size_;
+    root_ = nullptr;
+    size_ = 0;
+    root_ = remove(root, key);
+    size_ = size - 1;
+    return 1;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+void tree<Key, Value, Compare, Alloc>::clear() noexcept
+{
+    release(root_);
+    root_ = nullptr;
+    size_ = 0;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+tree<Key, Value, Compare, Alloc>::tree():
+    tree(key_compare())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+tree<Key, Value, Compare, Alloc>::tree(const key_compare &comp,
+        const allocator_type &alloc):
+    root_(nullptr),
+    size_(0),
+    comp_(comp),
+    alloc_(alloc)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+tree<Key, Value, Compare, Alloc>::tree(const allocator_type &alloc):
+    tree(key_compare(), alloc)
+{}
+
+
+/** \brief Share the nodes of `other`, in constant time.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc>
+tree<Key, Value, Compare, Alloc>::tree(const This &other) noexcept:
+    root_(retain(other.root_)),
+    size_(other.size_),
+    comp_(other.comp_),
+    alloc_(other.alloc_)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+tree<Key, Value, Compare, Alloc>::tree(This &&other) noexcept:
+    root_(other.root_),
+    size_(other.size_),
+    comp_(other.comp_),
+    alloc_(other.alloc_)
+{
+    other.root_ = nullptr;
+    other.size_ = 0;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::operator=(const This &other) noexcept
+    -> This &
+{
+    Node *root = retain(other.root_);
+    release(root_);
+    root_ = root;
+    size_ = other.size_;
+    comp_ = other.comp_;
+    alloc_ = other.alloc_;
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::operator=(This &&other) noexcept
+    -> This &
+{
+    swap(other);
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+tree<Key, Value, Compare, Alloc>::~tree()
+{
+    release(root_);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::begin() const noexcept
+    -> const_iterator
+{
+    const_iterator it;
+    it.push_left(root_);
+    return it;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+bool tree<Key, Value, Compare, Alloc>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::at(const key_type &key) const
+    -> const mapped_type &
+{
+    const_iterator it = find(key);
+    if (it == end()) {
+        throw std::out_of_range("itl::persistent_map::at");
+    }
+    return it->second;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+void tree<Key, Value, Compare, Alloc>::swap(This &other) noexcept
+{
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(comp_, other.comp_);
+    std::swap(alloc_, other.alloc_);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::key_comp() const
+    -> key_compare
+{
+    return comp_;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::find(const key_type &key) const
+    -> const_iterator
+{
+    const_iterator it = lower_bound(key);
+    if (it == end() || comp_(key, it->first)) {
+        return end();
+    }
+    return it;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::count(const key_type &key) const
+    -> size_type
+{
+    Node *node = root_;
+    while (node) {
+        if (comp_(key, node->value()->first)) {
+            node = node->left;
+        } else if (comp_(node->value()->first, key)) {
+            node = node->right;
+        } else {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::lower_bound(const key_type &key) const
+    -> const_iterator
+{
+    // ancestors where the search turned left are visited after the bound
+    const_iterator it;
+    Node *node = root_;
+    while (node) {
+        if (comp_(node->value()->first, key)) {
+            node = node->right;
+        } else {
+            it.push(node);
+            node = node->left;
+        }
+    }
+    return it;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::upper_bound(const key_type &key) const
+    -> const_iterator
+{
+    const_iterator it;
+    Node *node = root_;
+    while (node) {
+        if (comp_(key, node->value()->first)) {
+            it.push(node);
+            node = node->left;
+        } else {
+            node = node->right;
+        }
+    }
+    return it;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+auto tree<Key, Value, Compare, Alloc>::get_allocator() const
+    -> allocator_type
+{
+    return alloc_;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+bool operator==(const tree<Key, Value, Compare, Alloc> &left,
+    const tree<Key, Value, Compare, Alloc> &right)
+{
+    return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc>
+bool operator!=(const tree<Key, Value, Compare, Alloc> &left,
+    const tree<Key, Value, Compare, Alloc> &right)
+{
+    return !(left == right);
+}
+
+
+template <typename T>
+T * trie_leaf<T>::value(size_t i) noexcept
+{
+    return reinterpret_cast<T*>(&slots[i]);
+}
+
+
+template <typename Trie, typename T>
+trie_iterator<Trie, T>::trie_iterator() noexcept:
+    trie_(nullptr),
+    index_(0),
+    leaf_(nullptr),
+    base_(0)
+{}
+
+
+template <typename Trie, typename T>
+trie_iterator<Trie, T>::trie_iterator(const Trie *trie,
+        size_t index) noexcept:
+    trie_(trie),
+    index_(index),
+    leaf_(nullptr),
+    base_(0)
+{}
+
+
+/** \brief Value at the index, looking up its leaf only on crossing into a new one.
+ */
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator*() const
+    -> reference
+{
+    if (!leaf_ || index_ - base_ >= trie_width) {
+        base_ = index_ & ~trie_mask;
+        leaf_ = trie_->leaf_for(index_)->value(0);
+    }
+    return leaf_[index_ - base_];
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator->() const
+    -> pointer
+{
+    return &operator*();
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator[](difference_type n) const
+    -> reference
+{
+    return *(*this + n);
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator++() noexcept
+    -> trie_iterator &
+{
+    ++index_;
+    return *this;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator++(int) noexcept
+    -> trie_iterator
+{
+    trie_iterator copy(*this);
+    ++index_;
+    return copy;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator--() noexcept
+    -> trie_iterator &
+{
+    --index_;
+    return *this;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator--(int) noexcept
+    -> trie_iterator
+{
+    trie_iterator copy(*this);
+    --index_;
+    return copy;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator+=(difference_type n) noexcept
+    -> trie_iterator &
+{
+    index_ += static_cast<size_t>(n);
+    return *this;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator+(difference_type n) const noexcept
+    -> trie_iterator
+{
+    trie_iterator copy(*this);
+    return copy += n;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator-=(difference_type n) noexcept
+    -> trie_iterator &
+{
+    index_ -= static_cast<size_t>(n);
+    return *this;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator-(difference_type n) const noexcept
+    -> trie_iterator
+{
+    trie_iterator copy(*this);
+    return copy -= n;
+}
+
+
+template <typename Trie, typename T>
+auto trie_iterator<Trie, T>::operator-(const trie_iterator &other) const noexcept
+    -> difference_type
+{
+    return static_cast<difference_type>(index_ - other.index_);
+}
+
+
+template <typename Trie, typename T>
+bool trie_iterator<Trie, T>::operator==(const trie_iterator &other) const noexcept
+{
+    return index_ == other.index_;
+}
+
+
+template <typename Trie, typename T>
+bool trie_iterator<Trie, T>::operator!=(const trie_iterator &other) const noexcept
+{
+    return index_ != other.index_;
+}
+
+
+template <typename Trie, typename T>
+bool trie_iterator<Trie, T>::operator<(const trie_iterator &other) const noexcept
+{
+    return index_ < other.index_;
+}
+
+
+template <typename Trie, typename T>
+bool trie_iterator<Trie, T>::operator<=(const trie_iterator &other) const noexcept
+{
+    return index_ <= other.index_;
+}
+
+
+template <typename Trie, typename T>
+bool trie_iterator<Trie, T>::operator>(const trie_iterator &other) const noexcept
+{
+    return index_ > other.index_;
+}
+
+
+template <typename Trie, typename T>
+bool trie_iterator<Trie, T>::operator>=(const trie_iterator &other) const noexcept
+{
+    return index_ >= other.index_;
+}
+
+
+template <typename T, typename Alloc>
+trie<T, Alloc>::hold::~hold()
+{
+    owner->release(node);
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::hold::get() noexcept
+    -> Node *
+{
+    Node *taken = node;
+    node = nullptr;
+    return taken;
+}
+
+
+template <typename T, typename Alloc>
+bool trie<T, Alloc>::unique(Node *node) noexcept
+{
+    return node->refs.load(std::memory_order_acquire) == 1;
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::retain(Node *node) noexcept
+    -> Node *
+{
+    if (node) {
+        node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+
+template <typename T, typename Alloc>
+void trie<T, Alloc>::release(Node *node) const noexcept
+{
+    if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    if (node->leaf) {
+        Leaf *leaf = static_cast<Leaf*>(node);
+        for (size_t i = 0; i < leaf->count; ++i) {
+            AllocTraits::destroy(const_cast<allocator_type&>(alloc_), leaf->value(i));
+        }
+        LeafAlloc alloc(alloc_);
+        LeafTraits::deallocate(alloc, leaf, 1);
+    } else {
+        Branch *branch = static_cast<Branch*>(node);
+        for (size_t i = 0; i < trie_width; ++i) {
+            release(branch->children[i]);
+        }
+        BranchAlloc alloc(alloc_);
+        BranchTraits::deallocate(alloc, branch, 1);
+    }
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::make_branch()
+    -> Branch *
+{
+    BranchAlloc alloc(alloc_);
+    Branch *branch = BranchTraits::allocate(alloc, 1);
+    ::new (static_cast<void*>(&branch->refs)) std::atomic<size_t>(1);
+    branch->count = 0;
+    branch->leaf = false;
+    std::fill_n(branch->children, trie_width, nullptr);
+    return branch;
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::make_leaf()
+    -> Leaf *
+{
+    LeafAlloc alloc(alloc_);
+    Leaf *leaf = LeafTraits::allocate(alloc, 1);
+    ::new (static_cast<void*>(&leaf->refs)) std::atomic<size_t>(1);
+    leaf->count = 0;
+    leaf->leaf = true;
+    return leaf;
+}
+
+
+/** \brief `node` if unique, else a copy, releasing `node` only on success.
+ */
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::editable(Node *node)
+    -> Node *
+{
+    if (unique(node)) {
+        return node;
+    }
+    if (node->leaf) {
+        Leaf *leaf = static_cast<Leaf*>(node);
+        hold copy = {this, make_leaf()};
+        Leaf *result = static_cast<Leaf*>(copy.node);
+        for (; result->count < leaf->count; ++result->count) {
+            AllocTraits::construct(alloc_, result->value(result->count), *leaf->value(result->count));
+        }
+        release(node);
+        return copy.get();
+    }
+    Branch *branch = static_cast<Branch*>(node);
+    Branch *result = make_branch();
+    for (size_t i = 0; i < trie_width; ++i) {
+        result->children[i] = retain(branch->children[i]);
+    }
+    release(node);
+    return result;
+}
+
+
+/** \brief Index of the first value in the tail.
+ */
+template <typename T, typename Alloc>
+size_t trie<T, Alloc>::tail_offset() const noexcept
+{
+    return size_ < trie_width ? 0 : ((size_ - 1) >> trie_bits) << trie_bits;
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::leaf_for(size_t i) const noexcept
+    -> Leaf *
+{
+    if (i >= tail_offset()) {
+        return static_cast<Leaf*>(tail_);
+    }
+    Node *node = root_;
+    for (size_t level = shift_; level > 0; level -= trie_bits) {
+        node = static_cast<Branch*>(node)->children[(i >> level) & trie_mask];
+    }
+    return static_cast<Leaf*>(node);
+}
+
+
+/** \brief Subtree of `parent` with the full `tail` appended, consuming both.
+ */
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::push_tail(size_t size,
+        size_t level,
+        Node *parent,
+        Node *tail)
+    -> Node *
+{
+    hold self = {this, parent};
+    hold leaf = {this, tail};
+    self.node = parent ? editable(parent) : make_branch();
+    Branch *branch = static_cast<Branch*>(self.node);
+    size_t i = ((size - 1) >> level) & trie_mask;
+    if (level == trie_bits) {
+        branch->children[i] = leaf.get();
+    } else {
+        Node *child = branch->children[i];
+        branch->children[i] = nullptr;
+        branch->children[i] = child ? push_tail(size, level - trie_bits, child, leaf.get()) : new_path(level - trie_bits, leaf.get());
+    }
+    return self.get();
+}
+
+
+/** \brief Chain of branches from `level` down to `node`, consuming it.
+ */
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::new_path(size_t level,
+        Node *node)
+    -> Node *
+{
+    if (level == 0) {
+        return node;
+    }
+    hold child = {this, new_path(level - trie_bits, node)};
+    Branch *branch = make_branch();
+    branch->children[0] = child.get();
+    return branch;
+}
+
+
+/** \brief Subtree of `node` without its last leaf, or null if that empties it.
+ */
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::pop_tail(size_t size,
+        size_t level,
+        Node *node)
+    -> Node *
+{
+    hold self = {this, node};
+    size_t i = ((size - 2) >> level) & trie_mask;
+    if (level > trie_bits) {
+        self.node = editable(node);
+        Branch *branch = static_cast<Branch*>(self.node);
+        Node *child = branch->children[i];
+        branch->children[i] = nullptr;
+        Node *result = pop_tail(size, level - trie_bits, child);
+        if (!result && i == 0) {
+            return nullptr;
+        }
+        branch->children[i] = result;
+        return self.get();
+    }
+    if (i == 0) {
+        return nullptr;
+    }
+    self.node = editable(node);
+    Branch *branch = static_cast<Branch*>(self.node);
+    release(branch->children[i]);
+    branch->children[i] = nullptr;
+    return self.get();
+}
+
+
+/** \brief Subtree of `node` with the value at `i` replaced, consuming `node`.
+ */
+template <typename T, typename Alloc>
+template <typename V>
+auto trie<T, Alloc>::assign(size_t level,
+        Node *node,
+        size_t i,
+        V &&value)
+    -> Node *
+{
+    hold self = {this, node};
+    self.node = editable(node);
+    if (level == 0) {
+        *static_cast<Leaf*>(self.node)->value(i & trie_mask) = std::forward<V>(value);
+        return self.get();
+    }
+    Branch *branch = static_cast<Branch*>(self.node);
+    size_t j = (i >> level) & trie_mask;
+    Node *child = branch->children[j];
+    branch->children[j] = nullptr;
+    branch->children[j] = assign(level - trie_bits, child, i, std::forward<V>(value));
+    return self.get();
+}
+
+
+/** \brief Append a value, moving the tail into the trie once it is full.
+ */
+template <typename T, typename Alloc>
+template <typename... Ts>
+void trie<T, Alloc>::emplace_back(Ts&&... ts)
+{
+    if (size_ - tail_offset() < trie_width) {
+        tail_ = tail_ ? editable(tail_) : make_leaf();
+        Leaf *tail = static_cast<Leaf*>(tail_);
+        AllocTraits::construct(alloc_, tail->value(tail->count), std::forward<Ts>(ts)...);
+        ++tail->count;
+        ++size_;
+        return;
+    }
+
+    hold leaf = {this, make_leaf()};
+    Leaf *next = static_cast<Leaf*>(leaf.node);
+    AllocTraits::construct(alloc_, next->value(0), std::forward<Ts>(ts)...);
+    next->count = 1;
+
+    // empty until the edit completes, which leaves it valid if it throws
+    Node *root = root_;
+    Node *tail = tail_;
+    size_t size = size_;
+    size_t shift = shift_;
+    root_ = tail_ = nullptr;
+    size_ = 0;
+    shift_ = trie_bits;
+    if ((size >> trie_bits) > (size_t(1) << shift)) {
+        // the root is full, so grow a level
+        hold old = {this, root};
+        hold path = {this, new_path(shift, tail)};
+        Branch *branch = make_branch();
+        branch->children[0] = old.get();
+        branch->children[1] = path.get();
+        root = branch;
+        shift += trie_bits;
+    } else {
+        root = push_tail(size, shift, root, tail);
+    }
+    root_ = root;
+    tail_ = leaf.get();
+    size_ = size + 1;
+    shift_ = shift;
+}
+
+
+/** \brief Remove the last value, moving the last trie leaf into the tail once it empties.
+ */
+template <typename T, typename Alloc>
+void trie<T, Alloc>::pop_back()
+{
+    assert(size_ > 0 && "itl::persistent_vector::pop_back: empty vector");
+    if (size_ - tail_offset() > 1) {
+        tail_ = editable(tail_);
+        Leaf *tail = static_cast<Leaf*>(tail_);
+        AllocTraits::destroy(alloc_, tail->value(--tail->count));
+        --size_;
+        return;
+    }
+    if (size_ == 1) {
+        clear();
+        return;
+    }
+
+    hold tail = {this, retain(leaf_for(size_ - 2))};
+    Node *root = root_;
+    size_t size = size_;
+    size_t shift = shift_;
+    release(tail_);
+    root_ = tail_ = nullptr;
+    size_ = 0;
+    shift_ = trie_bits;
+    root = pop_tail(size, shift, root);
+    if (root && shift > trie_bits && !static_cast<Branch*>(root)->children[1]) {
+        Node *child = retain(static_cast<Branch*>(root)->children[0]);
+        release(root);
+        root = child;
+        shift -= trie_bits;
+    }
+    root_ = root;
+    tail_ = tail.get();
+    size_ = size - 1;
+    shift_ = shift;
+}
+
+
+template <typename T, typename Alloc>
+template <typename V>
+void trie<T, Alloc>::assign(size_t i,
+    V &&value)
+{
+    assert(i < size_ && "itl::persistent_vector::set: index out of range");
+    if (i >= tail_offset()) {
+        tail_ = editable(tail_);
+        *static_cast<Leaf*>(tail_)->value(i & trie_mask) = std::forward<V>(value);
+        return;
+    }
+    Node *root = root_;
+    Node *tail = tail_;
+    size_t size = size_;
+    size_t shift = shift_;
+    hold leaf = {this, tail};
+    root_ = tail_ = nullptr;
+    size_ = 0;
+    shift_ = trie_bits;
+    root = assign(shift, root, i, std::forward<V>(value));
+    root_ = root;
+    tail_ = leaf.get();
+    size_ = size;
+    shift_ = shift;
+}
+
+
+template <typename T, typename Alloc>
+void trie<T, Alloc>::clear() noexcept
+{
+    release(root_);
+    release(tail_);
+    root_ = tail_ = nullptr;
+    size_ = 0;
+    shift_ = trie_bits;
+}
+
+
+template <typename T, typename Alloc>
+trie<T, Alloc>::trie():
+    trie(allocator_type())
+{}
+
+
+template <typename T, typename Alloc>
+trie<T, Alloc>::trie(const allocator_type &alloc):
+    root_(nullptr),
+    tail_(nullptr),
+    size_(0),
+    shift_(trie_bits),
+    alloc_(alloc)
+{}
+
+
+/** \brief Share the nodes of `other`, in constant time.
+ */
+template <typename T, typename Alloc>
+trie<T, Alloc>::trie(const This &other) noexcept:
+    root_(retain(other.root_)),
+    tail_(retain(other.tail_)),
+    size_(other.size_),
+    shift_(other.shift_),
+    alloc_(other.alloc_)
+{}
+
+
+template <typename T, typename Alloc>
+trie<T, Alloc>::trie(This &&other) noexcept:
+    root_(other.root_),
+    tail_(other.tail_),
+    size_(other.size_),
+    shift_(other.shift_),
+    alloc_(other.alloc_)
+{
+    other.root_ = other.tail_ = nullptr;
+    other.size_ = 0;
+    other.shift_ = trie_bits;
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::operator=(const This &other) noexcept
+    -> This &
+{
+    This copy(other);
+    swap(copy);
+    return *this;
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::operator=(This &&other) noexcept
+    -> This &
+{
+    swap(other);
+    return *this;
+}
+
+
+template <typename T, typename Alloc>
+trie<T, Alloc>::~trie()
+{
+    clear();
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::begin() const noexcept
+    -> const_iterator
+{
+    return const_iterator(this, 0);
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator(this, size_);
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::rbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(end());
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::rend() const noexcept
+    -> const_reverse_iterator
+{
+    return const_reverse_iterator(begin());
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::cbegin() const noexcept
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::crbegin() const noexcept
+    -> const_reverse_iterator
+{
+    return rbegin();
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::crend() const noexcept
+    -> const_reverse_iterator
+{
+    return rend();
+}
+
+
+template <typename T, typename Alloc>
+bool trie<T, Alloc>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::operator[](size_type i) const
+    -> const_reference
+{
+    return *leaf_for(i)->value(i & trie_mask);
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::at(size_type i) const
+    -> const_reference
+{
+    if (i >= size_) {
+        throw std::out_of_range("itl::persistent_vector::at");
+    }
+    return operator[](i);
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::front() const
+    -> const_reference
+{
+    return operator[](0);
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::back() const
+    -> const_reference
+{
+    return operator[](size_ - 1);
+}
+
+
+template <typename T, typename Alloc>
+void trie<T, Alloc>::swap(This &other) noexcept
+{
+    std::swap(root_, other.root_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+    std::swap(shift_, other.shift_);
+    std::swap(alloc_, other.alloc_);
+}
+
+
+template <typename T, typename Alloc>
+auto trie<T, Alloc>::get_allocator() const
+    -> allocator_type
+{
+    return alloc_;
+}
+
+
+template <typename T, typename Alloc>
+bool operator==(const trie<T, Alloc> &left,
+    const trie<T, Alloc> &right)
+{
+    return left.size() == right.size() && std::equal(left.begin(), left.end(), right.begin());
+}
+
+
+template <typename T, typename Alloc>
+bool operator!=(const trie<T, Alloc> &left,
+    const trie<T, Alloc> &right)
+{
+    return !(left == right);
+}
+
+}   /* persistent */
+}   /* itl */
@@ -0,0 +1,490 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include "destructor.hpp"
+#include "persistent.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+class transient_map;
+
+
+/** \brief Immutable ordered map whose versions share structure.
+ *
+ *  `set`, `insert` and `erase` leave the map unchanged and return a
+ *  new version in `O(log n)`, sharing all but the edited path with
+ *  this one. Copies take constant time, so readers can keep a
+ *  snapshot while writers derive new versions. Versions may be read
+ *  and released from any thread.
+ *
+ *  For bulk updates, edit a `transient()` and convert it back with
+ *  `persistent()`: nodes the transient already copied are edited in
+ *  place instead of being copied again.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class persistent_map: protected persistent::tree<Key, Value, Compare, Alloc>,
+    protected Destructor
+{
+protected:
+    typedef persistent::tree<Key, Value, Compare, Alloc> Base;
+    typedef persistent_map<Key, Value, Compare, Alloc, Destructor> This;
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend class transient_map;
+
+    explicit persistent_map(const Base &base) noexcept;
+    const Base & ref() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend void swap(persistent_map<K, V, C, A, D> &left, persistent_map<K, V, C, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator==(const persistent_map<K, V, C, A, D> &left, const persistent_map<K, V, C, A, D> &right);
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend bool operator!=(const persistent_map<K, V, C, A, D> &left, const persistent_map<K, V, C, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::mapped_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+    typedef transient_map<Key, Value, Compare, Alloc, Destructor> transient_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    persistent_map();
+    persistent_map(std::initializer_list<value_type> values, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    persistent_map(const This &other) noexcept;
+    persistent_map(This &&other) noexcept;
+    This & operator=(const This &other) noexcept;
+    This & operator=(This &&other) noexcept;
+    ~persistent_map();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+
+    // ELEMENT ACCESS
+    using Base::at;
+
+    // MODIFIERS
+    This set(const key_type &key, const mapped_type &value) const;
+    This insert(const value_type &value) const;
+    This erase(const key_type &key) const;
+    transient_type transient() const noexcept;
+    void swap(This &other) noexcept;
+
+    // OBSERVERS
+    using Base::key_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+/** \brief Batch-edit view of a `persistent_map`, edited in place.
+ *
+ *  Starts out sharing every node with the map it came from, copies
+ *  each node at most once when first edited, then edits it in place.
+ *  `persistent()` snapshots the current contents in constant time;
+ *  later edits copy whatever the snapshot shares. If an edit throws,
+ *  the transient is left empty.
+ */
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
+>
+class transient_map: protected persistent::tree<Key, Value, Compare, Alloc>,
+    protected Destructor
+{
+protected:
+    typedef persistent::tree<Key, Value, Compare, Alloc> Base;
+    typedef transient_map<Key, Value, Compare, Alloc, Destructor> This;
+
+    template <typename K, typename V, typename C, typename A, typename D>
+    friend class persistent_map;
+
+    explicit transient_map(const Base &base) noexcept;
+    const Base & ref() const;
+    Base && forward();
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::key_type;
+    using typename Base::mapped_type;
+    using typename Base::value_type;
+    using typename Base::key_compare;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+    typedef persistent_map<Key, Value, Compare, Alloc, Destructor> persistent_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    transient_map();
+    transient_map(const This &other) noexcept;
+    transient_map(This &&other) noexcept;
+    This & operator=(const This &other) noexcept;
+    This & operator=(This &&other) noexcept;
+    ~transient_map();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::cbegin;
+    using Base::cend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+
+    // ELEMENT ACCESS
+    using Base::at;
+
+    // MODIFIERS
+    bool insert_or_assign(const key_type &key, const mapped_type &value);
+    bool insert_or_assign(const key_type &key, mapped_type &&value);
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    persistent_type persistent() const noexcept;
+    using Base::swap;
+
+    // OBSERVERS
+    using Base::key_comp;
+
+    // OPERATIONS
+    using Base::find;
+    using Base::count;
+    using Base::lower_bound;
+    using Base::upper_bound;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+persistent_map<Key, Value, Compare, Alloc, Destructor>::persistent_map(const Base &base) noexcept:
+    Base(base)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+persistent_map<Key, Value, Compare, Alloc, Destructor>::persistent_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+persistent_map<Key, Value, Compare, Alloc, Destructor>::persistent_map(std::initializer_list<value_type> values,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    Base(comp, alloc)
+{
+    for (const value_type &value: values) {
+        Base::insert(value);
+    }
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+persistent_map<Key, Value, Compare, Alloc, Destructor>::persistent_map(const This &other) noexcept:
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+persistent_map<Key, Value, Compare, Alloc, Destructor>::persistent_map(This &&other) noexcept:
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other) noexcept
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+persistent_map<Key, Value, Compare, Alloc, Destructor>::~persistent_map()
+{}
+
+
+/** \brief New version with `key` mapped to `value`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::set(const key_type &key,
+        const mapped_type &value) const
+    -> This
+{
+    This copy(*this);
+    copy.Base::insert_or_assign(key, value);
+    return copy;
+}
+
+
+/** \brief New version with `value` inserted, or this version if its key is present.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::insert(const value_type &value) const
+    -> This
+{
+    This copy(*this);
+    copy.Base::insert(value);
+    return copy;
+}
+
+
+/** \brief New version without `key`.
+ */
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::erase(const key_type &key) const
+    -> This
+{
+    This copy(*this);
+    copy.Base::erase(key);
+    return copy;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto persistent_map<Key, Value, Compare, Alloc, Destructor>::transient() const noexcept
+    -> transient_type
+{
+    return transient_type(ref());
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void persistent_map<Key, Value, Compare, Alloc, Destructor>::swap(This &other) noexcept
+{
+    Base::swap(other);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+void swap(persistent_map<Key, Value, Compare, Alloc, Destructor> &left,
+    persistent_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const persistent_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const persistent_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const persistent_map<Key, Value, Compare, Alloc, Destructor> &left,
+    const persistent_map<Key, Value, Compare, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+transient_map<Key, Value, Compare, Alloc, Destructor>::transient_map(const Base &base) noexcept:
+    Base(base)
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto transient_map<Key, Value, Compare, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto transient_map<Key, Value, Compare, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+transient_map<Key, Value, Compare, Alloc, Destructor>::transient_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+transient_map<Key, Value, Compare, Alloc, Destructor>::transient_map(const This &other) noexcept:
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+transient_map<Key, Value, Compare, Alloc, Destructor>::transient_map(This &&other) noexcept:
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto transient_map<Key, Value, Compare, Alloc, Destructor>::operator=(const This &other) noexcept
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto transient_map<Key, Value, Compare, Alloc, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+transient_map<Key, Value, Compare, Alloc, Destructor>::~transient_map()
+{}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool transient_map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const key_type &key,
+    const mapped_type &value)
+{
+    return Base::insert_or_assign(key, value);
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+bool transient_map<Key, Value, Compare, Alloc, Destructor>::insert_or_assign(const key_type &key,
+    mapped_type &&value)
+{
+    return Base::insert_or_assign(key, std::move(value));
+}
+
+
+template <typename Key, typename Value, typename Compare, typename Alloc, typename Destructor>
+auto transient_map<Key, Value, Compare, Alloc, Destructor>::persistent() const noexcept
+    -> persistent_type
+{
+    return persistent_type(ref());
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using persistent_map = itl::persistent_map<Key, Value, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename Key,
+    typename Value,
+    typename Compare = std::less<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using transient_map = itl::transient_map<Key, Value, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
@@ -0,0 +1,489 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include "destructor.hpp"
+#include "persistent.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+template <typename T, typename Alloc, typename Destructor>
+class transient_vector;
+
+
+/** \brief Immutable vector whose versions share structure.
+ *
+ *  `push_back`, `pop_back` and `set` leave the vector unchanged and
+ *  return a new version, sharing all but the edited path with this
+ *  one. Values live in a 32-way trie, so indexing and edits take
+ *  `O(log32 n)`, and appends amortize to a copy of the tail leaf.
+ *  Copies take constant time, and versions may be read and
+ *  released from any thread.
+ *
+ *  For bulk updates, edit a `transient()` and convert it back with
+ *  `persistent()`.
+ */
+template <
+    typename T,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class persistent_vector: protected persistent::trie<T, Alloc>,
+    protected Destructor
+{
+protected:
+    typedef persistent::trie<T, Alloc> Base;
+    typedef persistent_vector<T, Alloc, Destructor> This;
+
+    template <typename U, typename A, typename D>
+    friend class transient_vector;
+
+    explicit persistent_vector(const Base &base) noexcept;
+    const Base & ref() const;
+    Base && forward();
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename U, typename A, typename D>
+    friend void swap(persistent_vector<U, A, D> &left, persistent_vector<U, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename U, typename A, typename D>
+    friend bool operator==(const persistent_vector<U, A, D> &left, const persistent_vector<U, A, D> &right);
+
+    template <typename U, typename A, typename D>
+    friend bool operator!=(const persistent_vector<U, A, D> &left, const persistent_vector<U, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::value_type;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+    typedef transient_vector<T, Alloc, Destructor> transient_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    persistent_vector();
+    persistent_vector(std::initializer_list<value_type> values, const allocator_type &alloc = allocator_type());
+    persistent_vector(const This &other) noexcept;
+    persistent_vector(This &&other) noexcept;
+    This & operator=(const This &other) noexcept;
+    This & operator=(This &&other) noexcept;
+    ~persistent_vector();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+
+    // ELEMENT ACCESS
+    using Base::operator[];
+    using Base::at;
+    using Base::front;
+    using Base::back;
+
+    // MODIFIERS
+    This push_back(const value_type &value) const;
+    This pop_back() const;
+    This set(size_type i, const value_type &value) const;
+    transient_type transient() const noexcept;
+    void swap(This &other) noexcept;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+/** \brief Batch-edit view of a `persistent_vector`, edited in place.
+ *
+ *  Starts out sharing every node with the vector it came from,
+ *  copies each node at most once when first edited, then edits it
+ *  in place. `persistent()` snapshots the current contents in
+ *  constant time. If an edit throws, the transient is left empty.
+ */
+template <
+    typename T,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class transient_vector: protected persistent::trie<T, Alloc>,
+    protected Destructor
+{
+protected:
+    typedef persistent::trie<T, Alloc> Base;
+    typedef transient_vector<T, Alloc, Destructor> This;
+
+    template <typename U, typename A, typename D>
+    friend class persistent_vector;
+
+    explicit transient_vector(const Base &base) noexcept;
+    const Base & ref() const;
+    Base && forward();
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::value_type;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+    typedef persistent_vector<T, Alloc, Destructor> persistent_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    using Base::Base;
+    transient_vector();
+    transient_vector(const This &other) noexcept;
+    transient_vector(This &&other) noexcept;
+    This & operator=(const This &other) noexcept;
+    This & operator=(This &&other) noexcept;
+    ~transient_vector();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::empty;
+    using Base::size;
+
+    // ELEMENT ACCESS
+    using Base::operator[];
+    using Base::at;
+    using Base::front;
+    using Base::back;
+
+    // MODIFIERS
+    void push_back(const value_type &value);
+    void push_back(value_type &&value);
+    using Base::emplace_back;
+    using Base::pop_back;
+    void set(size_type i, const value_type &value);
+    void set(size_type i, value_type &&value);
+    using Base::clear;
+    persistent_type persistent() const noexcept;
+    using Base::swap;
+
+    // ALLOCATOR
+    using Base::get_allocator;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, typename Alloc, typename Destructor>
+persistent_vector<T, Alloc, Destructor>::persistent_vector(const Base &base) noexcept:
+    Base(base)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+persistent_vector<T, Alloc, Destructor>::persistent_vector()
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+persistent_vector<T, Alloc, Destructor>::persistent_vector(std::initializer_list<value_type> values,
+        const allocator_type &alloc):
+    Base(alloc)
+{
+    for (const value_type &value: values) {
+        Base::emplace_back(value);
+    }
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+persistent_vector<T, Alloc, Destructor>::persistent_vector(const This &other) noexcept:
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+persistent_vector<T, Alloc, Destructor>::persistent_vector(This &&other) noexcept:
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::operator=(const This &other) noexcept
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+persistent_vector<T, Alloc, Destructor>::~persistent_vector()
+{}
+
+
+/** \brief New version with `value` appended.
+ */
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::push_back(const value_type &value) const
+    -> This
+{
+    This copy(*this);
+    copy.Base::emplace_back(value);
+    return copy;
+}
+
+
+/** \brief New version without the last value.
+ */
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::pop_back() const
+    -> This
+{
+    This copy(*this);
+    copy.Base::pop_back();
+    return copy;
+}
+
+
+/** \brief New version with the value at `i` replaced.
+ */
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::set(size_type i,
+        const value_type &value) const
+    -> This
+{
+    This copy(*this);
+    copy.Base::assign(i, value);
+    return copy;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto persistent_vector<T, Alloc, Destructor>::transient() const noexcept
+    -> transient_type
+{
+    return transient_type(ref());
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void persistent_vector<T, Alloc, Destructor>::swap(This &other) noexcept
+{
+    Base::swap(other);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void swap(persistent_vector<T, Alloc, Destructor> &left,
+    persistent_vector<T, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+bool operator==(const persistent_vector<T, Alloc, Destructor> &left,
+    const persistent_vector<T, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+bool operator!=(const persistent_vector<T, Alloc, Destructor> &left,
+    const persistent_vector<T, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+transient_vector<T, Alloc, Destructor>::transient_vector(const Base &base) noexcept:
+    Base(base)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto transient_vector<T, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto transient_vector<T, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+transient_vector<T, Alloc, Destructor>::transient_vector()
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+transient_vector<T, Alloc, Destructor>::transient_vector(const This &other) noexcept:
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+transient_vector<T, Alloc, Destructor>::transient_vector(This &&other) noexcept:
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto transient_vector<T, Alloc, Destructor>::operator=(const This &other) noexcept
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto transient_vector<T, Alloc, Destructor>::operator=(This &&other) noexcept
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+transient_vector<T, Alloc, Destructor>::~transient_vector()
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void transient_vector<T, Alloc, Destructor>::push_back(const value_type &value)
+{
+    Base::emplace_back(value);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void transient_vector<T, Alloc, Destructor>::push_back(value_type &&value)
+{
+    Base::emplace_back(std::move(value));
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void transient_vector<T, Alloc, Destructor>::set(size_type i,
+    const value_type &value)
+{
+    Base::assign(i, value);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void transient_vector<T, Alloc, Destructor>::set(size_type i,
+    value_type &&value)
+{
+    Base::assign(i, std::move(value));
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto transient_vector<T, Alloc, Destructor>::persistent() const noexcept
+    -> persistent_type
+{
+    return persistent_type(ref());
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Alloc = std::allocator<T>
+>
+using persistent_vector = itl::persistent_vector<T, Alloc, static_destructor>;
+
+
+template <
+    typename T,
+    typename Alloc = std::allocator<T>
+>
+using transient_vector = itl::transient_vector<T, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
@@ -9,6 +9,9 @@
 #pragma once
 
 #include <queue>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
 
 
 namespace itl
@@ -21,13 +24,15 @@ namespace itl
  */
 template <
     typename T,
-    typename Container = std::deque<T>
+    typename Container = std::deque<T>,
+    typename Destructor = virtual_destructor
 >
-class queue: protected std::queue<T, Container>
+class queue: protected std::queue<T, Container>,
+    protected Destructor
 {
 protected:
     typedef std::queue<T, Container> Base;
-    typedef queue<T, Container> This;
+    typedef queue<T, Container, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -36,27 +41,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename V, typename C>
-    friend void swap(queue<V, C> &left, queue<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend void swap(queue<V, C, D> &left, queue<V, C, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename V, typename C>
-    friend bool operator==(const queue<V, C> &left, const queue<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator==(const queue<V, C, D> &left, const queue<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator!=(const queue<V, C> &left, const queue<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator!=(const queue<V, C, D> &left, const queue<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator>(const queue<V, C> &left, const queue<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator>(const queue<V, C, D> &left, const queue<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator>=(const queue<V, C> &left, const queue<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator>=(const queue<V, C, D> &left, const queue<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator<(const queue<V, C> &left, const queue<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator<(const queue<V, C, D> &left, const queue<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator<=(const queue<V, C> &left, const queue<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator<=(const queue<V, C, D> &left, const queue<V, C, D> &right);
 
 public:
     // MEMBER TYPES
@@ -70,7 +75,12 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~queue();
+    queue();
+    queue(const This &other);
+    queue(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~queue();
 
     using Base::empty;
     using Base::size;
@@ -87,103 +97,169 @@ public:
 // --------------
 
 
-template <typename T, typename Container>
-auto queue<T, Container>::ref() const
+template <typename T, typename Container, typename Destructor>
+auto queue<T, Container, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename T, typename Container>
-auto queue<T, Container>::ref()
+template <typename T, typename Container, typename Destructor>
+auto queue<T, Container, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename T, typename Container>
-auto queue<T, Container>::forward() const
+template <typename T, typename Container, typename Destructor>
+auto queue<T, Container, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename T, typename Container>
-auto queue<T, Container>::forward()
+template <typename T, typename Container, typename Destructor>
+auto queue<T, Container, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename T, typename Container>
-void swap(queue<T, Container> &left,
-    queue<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+void swap(queue<T, Container, Destructor> &left,
+    queue<T, Container, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename T, typename Container>
-bool operator==(const queue<T, Container> &left,
-    const queue<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator==(const queue<T, Container, Destructor> &left,
+    const queue<T, Container, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator!=(const queue<T, Container> &left,
-    const queue<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator!=(const queue<T, Container, Destructor> &left,
+    const queue<T, Container, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator>(const queue<T, Container> &left,
-    const queue<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator>(const queue<T, Container, Destructor> &left,
+    const queue<T, Container, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator>=(const queue<T, Container> &left,
-    const queue<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator>=(const queue<T, Container, Destructor> &left,
+    const queue<T, Container, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator<(const queue<T, Container> &left,
-    const queue<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator<(const queue<T, Container, Destructor> &left,
+    const queue<T, Container, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator<=(const queue<T, Container> &left,
-    const queue<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator<=(const queue<T, Container, Destructor> &left,
+    const queue<T, Container, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename T, typename Container>
-queue<T, Container>::~queue()
+template <typename T, typename Container, typename Destructor>
+queue<T, Container, Destructor>::queue()
+{}
+
+
+template <typename T, typename Container, typename Destructor>
+queue<T, Container, Destructor>::queue(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Container, typename Destructor>
+queue<T, Container, Destructor>::queue(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Container, typename Destructor>
+auto queue<T, Container, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Container, typename Destructor>
+auto queue<T, Container, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Container, typename Destructor>
+queue<T, Container, Destructor>::~queue()
 {}
 
 
-template <typename T, typename Container>
-void queue<T, Container>::swap(This &other)
+template <typename T, typename Container, typename Destructor>
+void queue<T, Container, Destructor>::swap(This &other)
 {
-    ref().swap(other.ref());
+    allocator_aware_swap(this->c, other.c);
 }
 
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Container = std::deque<T>
+>
+using queue = itl::queue<T, Container, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <typename T>
+using queue = itl::queue<T, std::pmr::deque<T>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
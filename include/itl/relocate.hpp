@@ -0,0 +1,161 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Detect if moving T and destroying the source equals a memcpy.
+ *
+ *  True for trivially copyable types. Specialize to opt in types
+ *  holding no pointers into themselves, such as smart pointers.
+ */
+template <typename T>
+struct is_trivially_relocatable: std::integral_constant<bool,
+    std::is_trivially_copyable<T>::value>
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<const T>: is_trivially_relocatable<T>
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<volatile T>: is_trivially_relocatable<T>
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<const volatile T>: is_trivially_relocatable<T>
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>>: std::true_type
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>>: std::true_type
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>>: std::true_type
+{};
+
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>>: std::true_type
+{};
+
+
+/** \brief Type values are relocated as between container slots.
+ *
+ *  Map values are relocated as `std::pair<Key, Value>`, which shares
+ *  the layout of `std::pair<const Key, Value>`, so keys are moved
+ *  rather than copied, as abseil does.
+ */
+template <typename T>
+struct slot_type
+{
+    typedef T type;
+};
+
+
+template <typename Key, typename Value>
+struct slot_type<std::pair<const Key, Value>>
+{
+    typedef std::pair<Key, Value> type;
+};
+
+// FUNCTIONS
+// ---------
+
+
+/** \brief Relocate [first, last) into uninitialized memory at `result`.
+ *
+ *  On return, the source range holds no live objects. The ranges
+ *  must not overlap. Returns the end of the destination range.
+ */
+template <typename T>
+T * uninitialized_relocate(T *first, T *last, T *result);
+
+
+/** \brief Relocate a single object from `source` into uninitialized memory.
+ */
+template <typename T>
+T * relocate_at(T *source, T *result);
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T>
+T * uninitialized_relocate(T *first,
+    T *last,
+    T *result,
+    std::true_type)
+{
+    size_t count = static_cast<size_t>(last - first);
+    if (count) {
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(first), count * sizeof(T));
+    }
+    return result + count;
+}
+
+
+template <typename T>
+T * uninitialized_relocate(T *first,
+    T *last,
+    T *result,
+    std::false_type)
+{
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+        "Relocating a type requires a non-throwing move constructor.");
+
+    for (; first != last; ++first, ++result) {
+        ::new (static_cast<void*>(result)) T(std::move(*first));
+        first->~T();
+    }
+    return result;
+}
+
+
+template <typename T>
+T * uninitialized_relocate(T *first,
+    T *last,
+    T *result)
+{
+    return uninitialized_relocate(first, last, result,
+        std::integral_constant<bool, is_trivially_relocatable<T>::value>());
+}
+
+
+template <typename T>
+T * relocate_at(T *source,
+    T *result)
+{
+    uninitialized_relocate(source, source + 1, result);
+    return result;
+}
+
+}   /* itl */
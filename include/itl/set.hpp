@@ -8,7 +8,12 @@
 
 #pragma once
 
+#include <cassert>
+#include <iterator>
 #include <set>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
 
 
 namespace itl
@@ -22,13 +27,15 @@ namespace itl
 template <
     typename T,
     typename Compare = std::less<T>,
-    typename Alloc = std::allocator<T>
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
 >
-class set: protected std::set<T, Compare, Alloc>
+class set: protected std::set<T, Compare, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::set<T, Compare, Alloc> Base;
-    typedef set<T, Compare, Alloc> This;
+    typedef set<T, Compare, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -37,27 +44,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename C, typename A>
-    friend void swap(set<K, C, A> &left, set<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(set<K, C, A, D> &left, set<K, C, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename K, typename C, typename A>
-    friend bool operator==(const set<K, C, A> &left, const set<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const set<K, C, A, D> &left, const set<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator!=(const set<K, C, A> &left, const set<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const set<K, C, A, D> &left, const set<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator>(const set<K, C, A> &left, const set<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const set<K, C, A, D> &left, const set<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator>=(const set<K, C, A> &left, const set<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const set<K, C, A, D> &left, const set<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator<(const set<K, C, A> &left, const set<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const set<K, C, A, D> &left, const set<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator<=(const set<K, C, A> &left, const set<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const set<K, C, A, D> &left, const set<K, C, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -77,11 +84,25 @@ public:
     using typename Base::const_reverse_iterator;
     using typename Base::difference_type;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+    using typename Base::insert_return_type;
+#endif
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~set();
+    set();
+    set(const This &other);
+    set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    set(const This &other, const allocator_type &alloc);
+    set(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~set();
+
+    template <typename Iter>
+    static This from_sorted(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
 
     // ITERATORS
     using Base::begin;
@@ -104,6 +125,11 @@ public:
     using Base::clear;
     using Base::emplace;
     using Base::emplace_hint;
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
     // OBSERVERS
@@ -116,6 +142,26 @@ public:
     using Base::lower_bound;
     using Base::upper_bound;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_associative_lookup)
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
 
     // ALLOCATOR
     using Base::get_allocator;
@@ -127,13 +173,15 @@ public:
 template <
     typename T,
     typename Compare = std::less<T>,
-    typename Alloc = std::allocator<T>
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
 >
-class multiset: protected std::multiset<T, Compare, Alloc>
+class multiset: protected std::multiset<T, Compare, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::multiset<T, Compare, Alloc> Base;
-    typedef multiset<T, Compare, Alloc> This;
+    typedef multiset<T, Compare, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -142,27 +190,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename C, typename A>
-    friend void swap(multiset<K, C, A> &left, multiset<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend void swap(multiset<K, C, A, D> &left, multiset<K, C, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename K, typename C, typename A>
-    friend bool operator==(const multiset<K, C, A> &left, const multiset<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator==(const multiset<K, C, A, D> &left, const multiset<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator!=(const multiset<K, C, A> &left, const multiset<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator!=(const multiset<K, C, A, D> &left, const multiset<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator>(const multiset<K, C, A> &left, const multiset<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>(const multiset<K, C, A, D> &left, const multiset<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator>=(const multiset<K, C, A> &left, const multiset<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator>=(const multiset<K, C, A, D> &left, const multiset<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator<(const multiset<K, C, A> &left, const multiset<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<(const multiset<K, C, A, D> &left, const multiset<K, C, A, D> &right);
 
-    template <typename K, typename C, typename A>
-    friend bool operator<=(const multiset<K, C, A> &left, const multiset<K, C, A> &right);
+    template <typename K, typename C, typename A, typename D>
+    friend bool operator<=(const multiset<K, C, A, D> &left, const multiset<K, C, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -182,11 +230,24 @@ public:
     using typename Base::const_reverse_iterator;
     using typename Base::difference_type;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+#endif
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~multiset();
+    multiset();
+    multiset(const This &other);
+    multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    multiset(const This &other, const allocator_type &alloc);
+    multiset(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~multiset();
+
+    template <typename Iter>
+    static This from_sorted(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
 
     // ITERATORS
     using Base::begin;
@@ -209,6 +270,11 @@ public:
     using Base::clear;
     using Base::emplace;
     using Base::emplace_hint;
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
     // OBSERVERS
@@ -221,6 +287,26 @@ public:
     using Base::lower_bound;
     using Base::upper_bound;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_associative_lookup)
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator lower_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator lower_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    iterator upper_bound(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    const_iterator upper_bound(const K &key) const;
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename C = Compare, typename = typename C::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
 
     // ALLOCATOR
     using Base::get_allocator;
@@ -231,203 +317,651 @@ public:
 // --------------
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto set<Key, Compare, Alloc>::ref() const
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto set<Key, Compare, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto set<Key, Compare, Alloc>::ref()
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto set<Key, Compare, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto set<Key, Compare, Alloc>::forward() const
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto set<Key, Compare, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto set<Key, Compare, Alloc>::forward()
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto set<Key, Compare, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-void swap(set<Key, Compare, Alloc> &left,
-    set<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(set<Key, Compare, Alloc, Destructor> &left,
+    set<Key, Compare, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator==(const set<Key, Compare, Alloc> &left,
-    const set<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const set<Key, Compare, Alloc, Destructor> &left,
+    const set<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator!=(const set<Key, Compare, Alloc> &left,
-    const set<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const set<Key, Compare, Alloc, Destructor> &left,
+    const set<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator>(const set<Key, Compare, Alloc> &left,
-    const set<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const set<Key, Compare, Alloc, Destructor> &left,
+    const set<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator>=(const set<Key, Compare, Alloc> &left,
-    const set<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const set<Key, Compare, Alloc, Destructor> &left,
+    const set<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator<(const set<Key, Compare, Alloc> &left,
-    const set<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const set<Key, Compare, Alloc, Destructor> &left,
+    const set<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator<=(const set<Key, Compare, Alloc> &left,
-    const set<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const set<Key, Compare, Alloc, Destructor> &left,
+    const set<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-set<Key, Compare, Alloc>::~set()
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+set<Key, Compare, Alloc, Destructor>::set()
 {}
 
 
-template <typename Key, typename Compare, typename Alloc>
-void set<Key, Compare, Alloc>::swap(This &other)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+set<Key, Compare, Alloc, Destructor>::set(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+set<Key, Compare, Alloc, Destructor>::set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+set<Key, Compare, Alloc, Destructor>::set(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+set<Key, Compare, Alloc, Destructor>::set(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto set<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto set<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
 {
-    ref().swap(other.ref());
+    Base::operator=(other.forward());
+    return *this;
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto multiset<Key, Compare, Alloc>::ref() const
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+set<Key, Compare, Alloc, Destructor>::~set()
+{}
+
+
+/** \brief Build a set from sorted keys, in linear time.
+ *
+ *  Each key is appended at the end, with one comparison and amortized
+ *  constant rebalancing, and nodes are allocated in key order: with
+ *  `itl::arena::set`, they are contiguous. Duplicate keys are skipped,
+ *  as by `insert`. Debug builds assert that the input is sorted.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename Iter>
+auto set<Key, Compare, Alloc, Destructor>::from_sorted(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc)
+    -> This
+{
+    This result(comp, alloc);
+    for (; first != last; ++first) {
+        auto it = result.emplace_hint(result.end(), *first);
+        // unsorted input silently falls back to a full search
+        assert(std::next(it) == result.end() && "itl::set::from_sorted: unsorted input");
+        (void) it;
+    }
+    return result;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void set<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and erase it from `other`.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void set<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    for (auto it = other.begin(); it != other.end();) {
+        if (Base::insert(*it).second) {
+            it = other.erase(it);
+        } else {
+            ++it;
+        }
+    }
+#endif
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void set<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if !defined(__cpp_lib_generic_associative_lookup)
+
+/** \brief Heterogeneous lookup, for transparent comparators.
+ *
+ *  Before C++14, std ordered containers only search by `key_type`,
+ *  so these convert `key` to a temporary `key_type`, which allocates
+ *  for string keys, and search for that. A `key` equivalent to a
+ *  range of keys, rather than to one, is narrowed to the converted
+ *  key. From C++14, the std overloads compare `key` directly, without
+ *  either cost, and these are not declared.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::count(const K &key) const
+    -> size_type
+{
+    return Base::count(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::lower_bound(const K &key)
+    -> iterator
+{
+    return Base::lower_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::lower_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::lower_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::upper_bound(const K &key)
+    -> iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::upper_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return Base::equal_range(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto set<Key, Compare, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return Base::equal_range(key_type(key));
+}
+
+#endif
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto multiset<Key, Compare, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto multiset<Key, Compare, Alloc>::ref()
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto multiset<Key, Compare, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto multiset<Key, Compare, Alloc>::forward() const
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto multiset<Key, Compare, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-auto multiset<Key, Compare, Alloc>::forward()
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto multiset<Key, Compare, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-void swap(multiset<Key, Compare, Alloc> &left,
-    multiset<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void swap(multiset<Key, Compare, Alloc, Destructor> &left,
+    multiset<Key, Compare, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator==(const multiset<Key, Compare, Alloc> &left,
-    const multiset<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator==(const multiset<Key, Compare, Alloc, Destructor> &left,
+    const multiset<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator!=(const multiset<Key, Compare, Alloc> &left,
-    const multiset<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator!=(const multiset<Key, Compare, Alloc, Destructor> &left,
+    const multiset<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator>(const multiset<Key, Compare, Alloc> &left,
-    const multiset<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>(const multiset<Key, Compare, Alloc, Destructor> &left,
+    const multiset<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator>=(const multiset<Key, Compare, Alloc> &left,
-    const multiset<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator>=(const multiset<Key, Compare, Alloc, Destructor> &left,
+    const multiset<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator<(const multiset<Key, Compare, Alloc> &left,
-    const multiset<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<(const multiset<Key, Compare, Alloc, Destructor> &left,
+    const multiset<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-bool operator<=(const multiset<Key, Compare, Alloc> &left,
-    const multiset<Key, Compare, Alloc> &right)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+bool operator<=(const multiset<Key, Compare, Alloc, Destructor> &left,
+    const multiset<Key, Compare, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename Key, typename Compare, typename Alloc>
-multiset<Key, Compare, Alloc>::~multiset()
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+multiset<Key, Compare, Alloc, Destructor>::multiset()
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+multiset<Key, Compare, Alloc, Destructor>::multiset(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+multiset<Key, Compare, Alloc, Destructor>::multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+multiset<Key, Compare, Alloc, Destructor>::multiset(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+multiset<Key, Compare, Alloc, Destructor>::multiset(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
 {}
 
 
-template <typename Key, typename Compare, typename Alloc>
-void multiset<Key, Compare, Alloc>::swap(This &other)
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto multiset<Key, Compare, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+auto multiset<Key, Compare, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
 {
-    ref().swap(other.ref());
+    Base::operator=(other.forward());
+    return *this;
 }
 
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+multiset<Key, Compare, Alloc, Destructor>::~multiset()
+{}
+
+
+/** \brief Build a multiset from sorted keys, in linear time.
+ *
+ *  Each key is appended at the end, with one comparison and amortized
+ *  constant rebalancing, and nodes are allocated in key order: with
+ *  `itl::arena::multiset`, they are contiguous. Debug builds assert
+ *  that the input is sorted.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename Iter>
+auto multiset<Key, Compare, Alloc, Destructor>::from_sorted(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc)
+    -> This
+{
+    This result(comp, alloc);
+    for (; first != last; ++first) {
+        auto it = result.emplace_hint(result.end(), *first);
+        // unsorted input silently falls back to a full search
+        assert(std::next(it) == result.end() && "itl::multiset::from_sorted: unsorted input");
+        (void) it;
+    }
+    return result;
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void multiset<Key, Compare, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and clear `other`.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void multiset<Key, Compare, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    Base::insert(other.begin(), other.end());
+    other.clear();
+#endif
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+void multiset<Key, Compare, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if !defined(__cpp_lib_generic_associative_lookup)
+
+/** \brief Heterogeneous lookup, for transparent comparators.
+ *
+ *  Before C++14, std ordered containers only search by `key_type`,
+ *  so these convert `key` to a temporary `key_type`, which allocates
+ *  for string keys, and search for that. A `key` equivalent to a
+ *  range of keys, rather than to one, is narrowed to the converted
+ *  key. From C++14, the std overloads compare `key` directly, without
+ *  either cost, and these are not declared.
+ */
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return Base::find(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::count(const K &key) const
+    -> size_type
+{
+    return Base::count(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::lower_bound(const K &key)
+    -> iterator
+{
+    return Base::lower_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::lower_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::lower_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::upper_bound(const K &key)
+    -> iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::upper_bound(const K &key) const
+    -> const_iterator
+{
+    return Base::upper_bound(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return Base::equal_range(key_type(key));
+}
+
+
+template <typename Key, typename Compare, typename Alloc, typename Destructor>
+template <typename K, typename C, typename>
+auto multiset<Key, Compare, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return Base::equal_range(key_type(key));
+}
+
+#endif
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using set = itl::set<T, Compare, Alloc, static_destructor>;
+
+
+template <
+    typename T,
+    typename Compare = std::less<T>,
+    typename Alloc = std::allocator<T>
+>
+using multiset = itl::multiset<T, Compare, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using set = itl::set<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+template <
+    typename T,
+    typename Compare = std::less<T>
+>
+using multiset = itl::multiset<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
@@ -0,0 +1,1172 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace itl
+{
+namespace skiplist
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Epoch-based reclamation domain.
+ *
+ *  Readers announce the global epoch in a slot while they hold
+ *  pointers into the structure. The epoch only advances once every
+ *  announced slot has caught up with it, so memory retired in epoch
+ *  `e` is unreachable by anyone once the epoch reaches `e + 2`.
+ *  Slots are claimed per pin rather than per thread, so pins nest
+ *  and may be released from any thread.
+ *
+ *  Once every slot is pinned, the table grows by a block of overflow
+ *  slots instead of waiting, since the pins may all belong to the
+ *  waiting thread, say through iterators it keeps. Overflow blocks
+ *  live as long as the domain.
+ */
+class epoch
+{
+public:
+    struct slot
+    {
+        std::atomic<uint64_t> value;
+        char padding[64 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    static constexpr uint64_t idle = UINT64_MAX;
+
+    explicit epoch(size_t slots = 0);
+    epoch(const epoch &other) = delete;
+    epoch & operator=(const epoch &other) = delete;
+    ~epoch();
+
+    slot * pin();
+    slot * pin(uint64_t announced);
+    void unpin(slot *pinned) noexcept;
+    uint64_t announced(const slot *pinned) const noexcept;
+    uint64_t current() const noexcept;
+    bool try_advance() noexcept;
+
+private:
+    struct block
+    {
+        static constexpr size_t size = 16;
+
+        slot slots[size];
+        block *next;
+    };
+
+    static bool claim(slot &candidate, uint64_t value) noexcept;
+    slot * acquire(uint64_t value);
+
+    std::vector<slot> slots_;
+    size_t mask_;
+    std::atomic<uint64_t> epoch_;
+    std::atomic<block*> overflow_;
+};
+
+
+/** \brief Pin of an epoch, held for the lifetime of the guard.
+ *
+ *  Copies pin the same epoch as the original, so they protect the
+ *  same memory.
+ */
+class guard
+{
+public:
+    guard() noexcept;
+    explicit guard(epoch *domain);
+    guard(const guard &other);
+    guard(guard &&other) noexcept;
+    guard & operator=(guard other) noexcept;
+    ~guard();
+
+    void swap(guard &other) noexcept;
+
+private:
+    epoch *domain_;
+    epoch::slot *slot_;
+};
+
+
+/** \brief Node of a skip list, followed in memory by its links.
+ *
+ *  The low bit of a link marks the node as erased at that level.
+ *  Marked links never change again.
+ */
+template <typename T>
+struct node
+{
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    node *retired;
+    uint64_t epoch;
+    uint32_t height;
+    std::atomic<bool> linked;
+
+    T * value() noexcept;
+    std::atomic<uintptr_t> & next(size_t level) noexcept;
+    static size_t units(size_t height) noexcept;
+};
+
+
+/** \brief Forward iterator over the values of a list.
+ *
+ *  Holds an epoch pin, so the value it points to stays valid even if
+ *  it is concurrently erased. Erased values are skipped when
+ *  advancing.
+ */
+template <typename Node, typename T>
+class iterator
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef std::forward_iterator_tag iterator_category;
+    typedef typename std::remove_const<T>::type value_type;
+    typedef ptrdiff_t difference_type;
+    typedef const T * pointer;
+    typedef const T & reference;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    iterator() noexcept;
+    iterator(Node *node, skiplist::guard &&pin) noexcept;
+
+    reference operator*() const;
+    pointer operator->() const;
+    iterator & operator++();
+    iterator operator++(int);
+    bool operator==(const iterator &other) const noexcept;
+    bool operator!=(const iterator &other) const noexcept;
+
+private:
+    Node *node_;
+    skiplist::guard guard_;
+};
+
+
+/** \brief Lock-free skip list of unique keys, shared by the concurrent containers.
+ *
+ *  Lookups and inserts never block: lookups skip erased nodes, and
+ *  inserts link a node bottom-up with compare-and-swap, unlinking
+ *  erased nodes they pass. Erase marks every level of a node, then
+ *  unlinks and retires it to the epoch domain, which frees it once
+ *  no reader can still hold it. Values are immutable once inserted.
+ *
+ *  Iteration is weakly consistent: it sees every value present for
+ *  its whole duration, and may or may not see concurrent changes.
+ */
+template <
+    typename Key,
+    typename T,
+    typename Compare,
+    typename Alloc
+>
+class list
+{
+protected:
+    typedef list<Key, T, Compare, Alloc> This;
+    typedef skiplist::node<T> Node;
+    typedef std::allocator_traits<Alloc> AllocTraits;
+    typedef typename AllocTraits::template rebind_alloc<Node> NodeAlloc;
+    typedef std::allocator_traits<NodeAlloc> NodeTraits;
+
+    static constexpr size_t max_height = 16;
+
+    static const Key & key(const T &value);
+    static const Key & key(const T &value, std::true_type);
+    static const Key & key(const T &value, std::false_type);
+    static uintptr_t address(Node *node) noexcept;
+    static Node * pointer_of(uintptr_t link) noexcept;
+    static bool marked(uintptr_t link) noexcept;
+    static size_t random_height() noexcept;
+
+    Node * allocate_node(size_t height);
+    void deallocate_node(Node *node) noexcept;
+    void destroy_node(Node *node) noexcept;
+    void retire(Node *node);
+    void reclaim();
+
+    template <typename K>
+    bool locate(const K &key, Node **preds, Node **succs);
+    template <typename K>
+    bool traverse(const K &key, Node **preds, Node **succs, bool &found);
+    template <typename K>
+    Node * bound(const K &key, bool upper) const;
+    Node * first(Node *node) const noexcept;
+
+    auto insert_value(T &&value) -> std::pair<skiplist::iterator<Node, T>, bool>;
+    bool erase_key(const Key &key);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef Key key_type;
+    typedef T value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef const value_type & reference;
+    typedef const value_type & const_reference;
+    typedef skiplist::iterator<Node, T> iterator;
+    typedef skiplist::iterator<Node, T> const_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    list();
+    explicit list(const key_compare &comp, const allocator_type &alloc = allocator_type());
+    explicit list(const allocator_type &alloc);
+
+    template <typename Iter>
+    list(Iter first, Iter last, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+
+    list(std::initializer_list<value_type> values, const key_compare &comp = key_compare(), const allocator_type &alloc = allocator_type());
+    list(const This &other) = delete;
+    This & operator=(const This &other) = delete;
+    ~list();
+
+    // ITERATORS
+    const_iterator begin() const;
+    const_iterator end() const noexcept;
+    const_iterator cbegin() const;
+    const_iterator cend() const noexcept;
+
+    // CAPACITY
+    bool empty() const;
+    size_type size() const noexcept;
+
+    // MODIFIERS
+    std::pair<iterator, bool> insert(const value_type &value);
+    std::pair<iterator, bool> insert(value_type &&value);
+
+    template <typename Iter>
+    void insert(Iter first, Iter last);
+
+    template <typename... Ts>
+    std::pair<iterator, bool> emplace(Ts&&... ts);
+
+    size_type erase(const key_type &key);
+    void clear();
+
+    // OBSERVERS
+    key_compare key_comp() const;
+
+    // OPERATIONS
+    const_iterator find(const key_type &key) const;
+    size_type count(const key_type &key) const;
+    const_iterator lower_bound(const key_type &key) const;
+    const_iterator upper_bound(const key_type &key) const;
+
+    // ALLOCATOR
+    allocator_type get_allocator() const;
+
+private:
+    mutable epoch epoch_;
+    Node *head_;
+    std::atomic<Node*> retired_;
+    std::atomic<size_t> retirements_;
+    std::atomic<size_t> size_;
+    std::mutex reclaim_mutex_;
+    key_compare comp_;
+    allocator_type alloc_;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+inline epoch::epoch(size_t slots)
+{
+    if (slots == 0) {
+        slots = 4 * std::max<size_t>(std::thread::hardware_concurrency(), 16);
+    }
+    size_t count = 1;
+    while (count < slots) {
+        count *= 2;
+    }
+    slots_ = std::vector<slot>(count);
+    for (slot &s: slots_) {
+        s.value.store(idle, std::memory_order_relaxed);
+    }
+    mask_ = count - 1;
+    epoch_.store(0, std::memory_order_relaxed);
+    overflow_.store(nullptr, std::memory_order_relaxed);
+}
+
+
+inline epoch::~epoch()
+{
+    block *next = overflow_.load(std::memory_order_relaxed);
+    while (next) {
+        block *overflow = next;
+        next = overflow->next;
+        delete overflow;
+    }
+}
+
+
+inline bool epoch::claim(slot &candidate, uint64_t value) noexcept
+{
+    uint64_t expected = idle;
+    return candidate.value.load(std::memory_order_relaxed) == idle
+        && candidate.value.compare_exchange_strong(expected, value);
+}
+
+
+/** \brief Claim a free slot announcing `value`, starting from this thread's slot.
+ */
+inline auto epoch::acquire(uint64_t value)
+    -> slot *
+{
+    size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) & mask_;
+    for (size_t i = 0; i <= mask_; ++i) {
+        slot &candidate = slots_[(start + i) & mask_];
+        if (claim(candidate, value)) {
+            return &candidate;
+        }
+    }
+    for (block *overflow = overflow_.load(); overflow; overflow = overflow->next) {
+        for (slot &candidate: overflow->slots) {
+            if (claim(candidate, value)) {
+                return &candidate;
+            }
+        }
+    }
+
+    // every slot is pinned: publish a new block, its first slot claimed
+    block *overflow = new block;
+    for (slot &candidate: overflow->slots) {
+        candidate.value.store(idle, std::memory_order_relaxed);
+    }
+    overflow->slots[0].value.store(value, std::memory_order_relaxed);
+    overflow->next = overflow_.load();
+    while (!overflow_.compare_exchange_weak(overflow->next, overflow)) {
+    }
+    return &overflow->slots[0];
+}
+
+
+/** \brief Announce the current epoch, returning the slot to unpin.
+ */
+inline auto epoch::pin()
+    -> slot *
+{
+    uint64_t value = epoch_.load();
+    slot *pinned = acquire(value);
+    // republish until the announcement is current, so no advance misses it
+    for (uint64_t now = epoch_.load(); now != value; now = epoch_.load()) {
+        value = now;
+        pinned->value.store(value);
+    }
+    return pinned;
+}
+
+
+/** \brief Announce an epoch already announced by another pin.
+ */
+inline auto epoch::pin(uint64_t announced)
+    -> slot *
+{
+    return acquire(announced);
+}
+
+
+inline void epoch::unpin(slot *pinned) noexcept
+{
+    pinned->value.store(idle, std::memory_order_release);
+}
+
+
+inline uint64_t epoch::announced(const slot *pinned) const noexcept
+{
+    return pinned->value.load(std::memory_order_relaxed);
+}
+
+
+inline uint64_t epoch::current() const noexcept
+{
+    return epoch_.load();
+}
+
+
+/** \brief Advance the epoch, unless a pin still announces an older one.
+ */
+inline bool epoch::try_advance() noexcept
+{
+    uint64_t value = epoch_.load();
+    auto behind = [value](const slot &s) {
+        uint64_t announced = s.value.load();
+        return announced != idle && announced != value;
+    };
+    for (const slot &s: slots_) {
+        if (behind(s)) {
+            return false;
+        }
+    }
+    for (block *overflow = overflow_.load(); overflow; overflow = overflow->next) {
+        for (const slot &s: overflow->slots) {
+            if (behind(s)) {
+                return false;
+            }
+        }
+    }
+    return epoch_.compare_exchange_strong(value, value + 1);
+}
+
+
+inline guard::guard() noexcept:
+    domain_(nullptr),
+    slot_(nullptr)
+{}
+
+
+inline guard::guard(epoch *domain):
+    domain_(domain),
+    slot_(domain->pin())
+{}
+
+
+inline guard::guard(const guard &other):
+    domain_(other.domain_),
+    slot_(other.domain_ ? other.domain_->pin(other.domain_->announced(other.slot_)) : nullptr)
+{}
+
+
+inline guard::guard(guard &&other) noexcept:
+    domain_(other.domain_),
+    slot_(other.slot_)
+{
+    other.domain_ = nullptr;
+}
+
+
+inline guard & guard::operator=(guard other) noexcept
+{
+    swap(other);
+    return *this;
+}
+
+
+inline guard::~guard()
+{
+    if (domain_) {
+        domain_->unpin(slot_);
+    }
+}
+
+
+inline void guard::swap(guard &other) noexcept
+{
+    std::swap(domain_, other.domain_);
+    std::swap(slot_, other.slot_);
+}
+
+
+template <typename T>
+T * node<T>::value() noexcept
+{
+    return reinterpret_cast<T*>(&storage);
+}
+
+
+template <typename T>
+std::atomic<uintptr_t> & node<T>::next(size_t level) noexcept
+{
+    return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1)[level];
+}
+
+
+/** \brief Nodes worth of memory holding the header and `height` links.
+ */
+template <typename T>
+size_t node<T>::units(size_t height) noexcept
+{
+    return 1 + (height * sizeof(std::atomic<uintptr_t>) + sizeof(node) - 1) / sizeof(node);
+}
+
+
+template <typename Node, typename T>
+iterator<Node, T>::iterator() noexcept:
+    node_(nullptr)
+{}
+
+
+template <typename Node, typename T>
+iterator<Node, T>::iterator(Node *node,
+        skiplist::guard &&pin) noexcept:
+    node_(node),
+    guard_(std::move(pin))
+{}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator*() const
+    -> reference
+{
+    return *node_->value();
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator->() const
+    -> pointer
+{
+    return node_->value();
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator++()
+    -> iterator &
+{
+    Node *next = reinterpret_cast<Node*>(node_->next(0).load() & ~uintptr_t(1));
+    while (next && (next->next(0).load() & 1)) {
+        next = reinterpret_cast<Node*>(next->next(0).load() & ~uintptr_t(1));
+    }
+    node_ = next;
+    if (!node_) {
+        guard_ = skiplist::guard();
+    }
+    return *this;
+}
+
+
+template <typename Node, typename T>
+auto iterator<Node, T>::operator++(int)
+    -> iterator
+{
+    iterator copy(*this);
+    operator++();
+    return copy;
+}
+
+
+template <typename Node, typename T>
+bool iterator<Node, T>::operator==(const iterator &other) const noexcept
+{
+    return node_ == other.node_;
+}
+
+
+template <typename Node, typename T>
+bool iterator<Node, T>::operator!=(const iterator &other) const noexcept
+{
+    return !operator==(other);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::key(const T &value)
+    -> const Key &
+{
+    return key(value, std::is_same<Key, T>());
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::key(const T &value,
+        std::true_type)
+    -> const Key &
+{
+    return value;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::key(const T &value,
+        std::false_type)
+    -> const Key &
+{
+    return value.first;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+uintptr_t list<Key, T, Compare, Alloc>::address(Node *node) noexcept
+{
+    return reinterpret_cast<uintptr_t>(node);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::pointer_of(uintptr_t link) noexcept
+    -> Node *
+{
+    return reinterpret_cast<Node*>(link & ~uintptr_t(1));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool list<Key, T, Compare, Alloc>::marked(uintptr_t link) noexcept
+{
+    return (link & 1) != 0;
+}
+
+
+/** \brief Geometric height with ratio 1/4, from a per-thread generator.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+size_t list<Key, T, Compare, Alloc>::random_height() noexcept
+{
+    static thread_local uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    uint64_t bits = state * 0x2545F4914F6CDD1DULL;
+    size_t height = 1;
+    while (height < max_height && (bits & 3) == 0) {
+        ++height;
+        bits >>= 2;
+    }
+    return height;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::allocate_node(size_t height)
+    -> Node *
+{
+    NodeAlloc alloc(alloc_);
+    Node *node = ::new (static_cast<void*>(NodeTraits::allocate(alloc, Node::units(height)))) Node;
+    node->retired = nullptr;
+    node->epoch = 0;
+    node->height = static_cast<uint32_t>(height);
+    node->linked.store(false, std::memory_order_relaxed);
+    for (size_t level = 0; level < height; ++level) {
+        ::new (static_cast<void*>(&node->next(level))) std::atomic<uintptr_t>(0);
+    }
+    return node;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void list<Key, T, Compare, Alloc>::deallocate_node(Node *node) noexcept
+{
+    NodeAlloc alloc(alloc_);
+    NodeTraits::deallocate(alloc, node, Node::units(node->height));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+void list<Key, T, Compare, Alloc>::destroy_node(Node *node) noexcept
+{
+    AllocTraits::destroy(alloc_, node->value());
+    deallocate_node(node);
+}
+
+
+/** \brief Hand an unlinked node to the epoch domain.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+void list<Key, T, Compare, Alloc>::retire(Node *node)
+{
+    node->epoch = epoch_.current();
+    Node *head = retired_.load(std::memory_order_relaxed);
+    do {
+        node->retired = head;
+    } while (!retired_.compare_exchange_weak(head, node));
+}
+
+
+/** \brief Free retired nodes that no pin can still reach.
+ *
+ *  Only one thread reclaims at a time, and the others skip rather
+ *  than wait for it.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+void list<Key, T, Compare, Alloc>::reclaim()
+{
+    std::unique_lock<std::mutex> lock(reclaim_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    epoch_.try_advance();
+    uint64_t safe = epoch_.current();
+    Node *node = retired_.exchange(nullptr);
+    Node *kept = nullptr;
+    Node *last = nullptr;
+    while (node) {
+        Node *next = node->retired;
+        if (node->epoch + 2 <= safe) {
+            destroy_node(node);
+        } else {
+            node->retired = kept;
+            last = kept ? last : node;
+            kept = node;
+        }
+        node = next;
+    }
+    if (kept) {
+        Node *head = retired_.load(std::memory_order_relaxed);
+        do {
+            last->retired = head;
+        } while (!retired_.compare_exchange_weak(head, kept));
+    }
+}
+
+
+/** \brief Predecessors and successors of `key` at every level.
+ *
+ *  Unlinks erased nodes on the way, and returns if the level 0
+ *  successor holds `key`.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename K>
+bool list<Key, T, Compare, Alloc>::locate(const K &key,
+    Node **preds,
+    Node **succs)
+{
+    bool found = false;
+    while (!traverse(key, preds, succs, found)) {}
+    return found;
+}
+
+
+/** \brief One attempt of `locate`, failing if a predecessor changed under it.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename K>
+bool list<Key, T, Compare, Alloc>::traverse(const K &key,
+    Node **preds,
+    Node **succs,
+    bool &found)
+{
+    Node *pred = head_;
+    Node *curr = nullptr;
+    for (size_t level = max_height; level-- > 0;) {
+        curr = pointer_of(pred->next(level).load());
+        while (curr) {
+            uintptr_t succ = curr->next(level).load();
+            while (marked(succ)) {
+                uintptr_t expected = address(curr);
+                if (!pred->next(level).compare_exchange_strong(expected, succ & ~uintptr_t(1))) {
+                    return false;
+                }
+                curr = pointer_of(succ);
+                if (!curr) {
+                    break;
+                }
+                succ = curr->next(level).load();
+            }
+            if (!curr || !comp_(This::key(*curr->value()), key)) {
+                break;
+            }
+            pred = curr;
+            curr = pointer_of(succ);
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    found = curr && !comp_(key, This::key(*curr->value()));
+    return true;
+}
+
+
+/** \brief First live node not less than `key`, or greater if `upper`, without writing.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename K>
+auto list<Key, T, Compare, Alloc>::bound(const K &key,
+        bool upper) const
+    -> Node *
+{
+    Node *pred = head_;
+    Node *curr = nullptr;
+    for (size_t level = max_height; level-- > 0;) {
+        curr = pointer_of(pred->next(level).load(std::memory_order_acquire));
+        while (curr) {
+            uintptr_t succ = curr->next(level).load(std::memory_order_acquire);
+            while (marked(succ)) {
+                curr = pointer_of(succ);
+                if (!curr) {
+                    break;
+                }
+                succ = curr->next(level).load(std::memory_order_acquire);
+            }
+            if (!curr) {
+                break;
+            }
+            const Key &k = This::key(*curr->value());
+            if (upper ? comp_(key, k) : !comp_(k, key)) {
+                break;
+            }
+            pred = curr;
+            curr = pointer_of(succ);
+        }
+    }
+    return curr;
+}
+
+
+/** \brief First live node from `node` onward.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::first(Node *node) const noexcept
+    -> Node *
+{
+    while (node && marked(node->next(0).load(std::memory_order_acquire))) {
+        node = pointer_of(node->next(0).load(std::memory_order_acquire));
+    }
+    return node;
+}
+
+
+/** \brief Link a node for `value` bottom-up, unless its key is present.
+ *
+ *  The node is visible once linked at level 0, and may only be
+ *  erased once linked at every level.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::insert_value(T &&value)
+    -> std::pair<iterator, bool>
+{
+    guard pin(&epoch_);
+    Node *preds[max_height];
+    Node *succs[max_height];
+    if (locate(key(value), preds, succs)) {
+        return std::make_pair(iterator(succs[0], std::move(pin)), false);
+    }
+
+    size_t height = random_height();
+    Node *node = allocate_node(height);
+    try {
+        AllocTraits::construct(alloc_, node->value(), std::move(value));
+    } catch (...) {
+        deallocate_node(node);
+        throw;
+    }
+    const Key &k = key(*node->value());
+    while (true) {
+        for (size_t level = 0; level < height; ++level) {
+            node->next(level).store(address(succs[level]), std::memory_order_relaxed);
+        }
+        uintptr_t expected = address(succs[0]);
+        if (preds[0]->next(0).compare_exchange_strong(expected, address(node))) {
+            break;
+        }
+        if (locate(k, preds, succs)) {
+            destroy_node(node);
+            return std::make_pair(iterator(succs[0], std::move(pin)), false);
+        }
+    }
+
+    for (size_t level = 1; level < height; ++level) {
+        while (true) {
+            node->next(level).store(address(succs[level]));
+            uintptr_t expected = address(succs[level]);
+            if (preds[level]->next(level).compare_exchange_strong(expected, address(node))) {
+                break;
+            }
+            locate(k, preds, succs);
+        }
+    }
+    node->linked.store(true, std::memory_order_release);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return std::make_pair(iterator(node, std::move(pin)), true);
+}
+
+
+/** \brief Mark the node of `key` from the top level down, then unlink it.
+ *
+ *  Marking level 0 decides which of several concurrent erases wins.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool list<Key, T, Compare, Alloc>::erase_key(const Key &key)
+{
+    guard pin(&epoch_);
+    Node *preds[max_height];
+    Node *succs[max_height];
+    while (true) {
+        if (!locate(key, preds, succs)) {
+            return false;
+        }
+        Node *node = succs[0];
+        if (!node->linked.load(std::memory_order_acquire)) {
+            // an insert is still linking the upper levels
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t level = node->height; level-- > 1;) {
+            uintptr_t succ = node->next(level).load();
+            while (!marked(succ) && !node->next(level).compare_exchange_weak(succ, succ | 1)) {}
+        }
+        uintptr_t succ = node->next(0).load();
+        while (!marked(succ)) {
+            if (node->next(0).compare_exchange_weak(succ, succ | 1)) {
+                locate(key, preds, succs);
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                retire(node);
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+list<Key, T, Compare, Alloc>::list():
+    list(key_compare())
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+list<Key, T, Compare, Alloc>::list(const key_compare &comp,
+        const allocator_type &alloc):
+    head_(nullptr),
+    retired_(nullptr),
+    retirements_(0),
+    size_(0),
+    comp_(comp),
+    alloc_(alloc)
+{
+    head_ = allocate_node(max_height);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+list<Key, T, Compare, Alloc>::list(const allocator_type &alloc):
+    list(key_compare(), alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename Iter>
+list<Key, T, Compare, Alloc>::list(Iter first,
+        Iter last,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    list(comp, alloc)
+{
+    insert(first, last);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+list<Key, T, Compare, Alloc>::list(std::initializer_list<value_type> values,
+        const key_compare &comp,
+        const allocator_type &alloc):
+    This(values.begin(), values.end(), comp, alloc)
+{}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+list<Key, T, Compare, Alloc>::~list()
+{
+    Node *node = pointer_of(head_->next(0).load());
+    while (node) {
+        Node *next = pointer_of(node->next(0).load());
+        destroy_node(node);
+        node = next;
+    }
+    node = retired_.load();
+    while (node) {
+        Node *next = node->retired;
+        destroy_node(node);
+        node = next;
+    }
+    deallocate_node(head_);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::begin() const
+    -> const_iterator
+{
+    guard pin(&epoch_);
+    Node *node = first(pointer_of(head_->next(0).load(std::memory_order_acquire)));
+    return node ? const_iterator(node, std::move(pin)) : end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::end() const noexcept
+    -> const_iterator
+{
+    return const_iterator();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::cbegin() const
+    -> const_iterator
+{
+    return begin();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::cend() const noexcept
+    -> const_iterator
+{
+    return end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+bool list<Key, T, Compare, Alloc>::empty() const
+{
+    guard pin(&epoch_);
+    return first(pointer_of(head_->next(0).load(std::memory_order_acquire))) == nullptr;
+}
+
+
+/** \brief Number of values, which may be stale under concurrent writes.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::size() const noexcept
+    -> size_type
+{
+    return size_.load(std::memory_order_relaxed);
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::insert(const value_type &value)
+    -> std::pair<iterator, bool>
+{
+    return insert_value(T(value));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::insert(value_type &&value)
+    -> std::pair<iterator, bool>
+{
+    return insert_value(std::move(value));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename Iter>
+void list<Key, T, Compare, Alloc>::insert(Iter first,
+    Iter last)
+{
+    for (; first != last; ++first) {
+        insert_value(T(*first));
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+template <typename... Ts>
+auto list<Key, T, Compare, Alloc>::emplace(Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    return insert_value(T(std::forward<Ts>(ts)...));
+}
+
+
+/** \brief Erase the value of `key`, reclaiming retired nodes every so often.
+ *
+ *  Waits for a concurrent insert of the same key to finish linking.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::erase(const key_type &key)
+    -> size_type
+{
+    if (!erase_key(key)) {
+        return 0;
+    }
+    // reclaim outside the pin, which would hold back the epoch
+    if (retirements_.fetch_add(1, std::memory_order_relaxed) % 64 == 63) {
+        reclaim();
+    }
+    return 1;
+}
+
+
+/** \brief Erase every value, including any inserted concurrently.
+ */
+template <typename Key, typename T, typename Compare, typename Alloc>
+void list<Key, T, Compare, Alloc>::clear()
+{
+    for (const_iterator it = begin(); it != end(); it = begin()) {
+        erase(key(*it));
+    }
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::key_comp() const
+    -> key_compare
+{
+    return comp_;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::find(const key_type &key) const
+    -> const_iterator
+{
+    guard pin(&epoch_);
+    Node *node = bound(key, false);
+    if (!node || comp_(key, This::key(*node->value()))) {
+        return end();
+    }
+    return const_iterator(node, std::move(pin));
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::count(const key_type &key) const
+    -> size_type
+{
+    guard pin(&epoch_);
+    Node *node = bound(key, false);
+    return node && !comp_(key, This::key(*node->value())) ? 1 : 0;
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::lower_bound(const key_type &key) const
+    -> const_iterator
+{
+    guard pin(&epoch_);
+    Node *node = bound(key, false);
+    return node ? const_iterator(node, std::move(pin)) : end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::upper_bound(const key_type &key) const
+    -> const_iterator
+{
+    guard pin(&epoch_);
+    Node *node = bound(key, true);
+    return node ? const_iterator(node, std::move(pin)) : end();
+}
+
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+auto list<Key, T, Compare, Alloc>::get_allocator() const
+    -> allocator_type
+{
+    return alloc_;
+}
+
+}   /* skiplist */
+}   /* itl */
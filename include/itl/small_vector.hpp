@@ -0,0 +1,808 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "allocator.hpp"
+#include "destructor.hpp"
+#include "span.hpp"
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Inline storage for up to N objects of type T.
+ */
+template <
+    typename T,
+    size_t N
+>
+class small_buffer
+{
+public:
+    small_buffer() noexcept;
+    small_buffer(const small_buffer &) = delete;
+    small_buffer & operator=(const small_buffer &) = delete;
+
+    T * data() noexcept;
+    const T * data() const noexcept;
+    bool used() const noexcept;
+    void used(bool value) noexcept;
+
+private:
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type storage_;
+    bool used_;
+};
+
+
+/** \brief Allocator serving the first N-element request from a small_buffer.
+ *
+ *  Any other request, or any request once the buffer is in use, is
+ *  forwarded to the heap allocator `Alloc`. Two allocators compare
+ *  equal only when they share a buffer, so containers using it never
+ *  transfer inline storage on move or swap.
+ */
+template <
+    typename T,
+    size_t N,
+    typename Alloc = std::allocator<T>
+>
+class small_allocator: private Alloc
+{
+protected:
+    typedef std::allocator_traits<Alloc> Traits;
+
+    template <typename U, size_t M, typename A>
+    friend class small_allocator;
+
+    template <typename U, size_t M, typename A>
+    friend bool operator==(const small_allocator<U, M, A> &left, const small_allocator<U, M, A> &right) noexcept;
+
+    template <typename U, size_t M, typename A>
+    friend bool operator!=(const small_allocator<U, M, A> &left, const small_allocator<U, M, A> &right) noexcept;
+
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T value_type;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef std::false_type propagate_on_container_copy_assignment;
+    typedef std::false_type propagate_on_container_move_assignment;
+    typedef std::false_type propagate_on_container_swap;
+    typedef std::false_type is_always_equal;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef small_allocator<U, N, typename Traits::template rebind_alloc<U>> other;
+    };
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    small_allocator() noexcept;
+    explicit small_allocator(small_buffer<T, N> *buffer, const Alloc &alloc = Alloc()) noexcept;
+
+    template <typename U, typename A>
+    small_allocator(const small_allocator<U, N, A> &other) noexcept;
+
+    T * allocate(size_type n);
+    void deallocate(T *p, size_type n);
+
+    template <typename U, typename... Ts>
+    void construct(U *p, Ts&&... ts);
+
+    small_allocator select_on_container_copy_construction() const;
+    const Alloc & heap_allocator() const noexcept;
+
+private:
+    small_buffer<T, N> *buffer_;
+};
+
+
+/** \brief Inheritable STL vector storing up to N elements inline.
+ *
+ *  Exports the same members as `itl::vector`. Storage spills to the
+ *  heap allocator once the size exceeds N. Inline storage cannot
+ *  change owners, so moving or swapping an inline small_vector moves
+ *  its elements. With libstdc++, heap storage is handed over instead,
+ *  when the heap allocators compare equal.
+ */
+template <
+    typename T,
+    size_t N,
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
+>
+class small_vector: private small_buffer<T, N>,
+    protected std::vector<T, small_allocator<T, N, Alloc>>,
+    protected Destructor
+{
+    static_assert(N > 0, "small_vector requires a non-zero inline capacity.");
+
+protected:
+    typedef small_buffer<T, N> Buffer;
+    typedef std::vector<T, small_allocator<T, N, Alloc>> Base;
+    typedef small_vector<T, N, Alloc, Destructor> This;
+
+    const Base & ref() const;
+    Base & ref();
+    const Base && forward() const;
+    Base && forward();
+    const Buffer * buffer() const;
+    void reset(size_t n);
+
+    // STORAGE
+    // -------
+    // Only libstdc++ exposes the std::vector storage to derived classes,
+    // so only there can heap storage change owners.
+#if defined(__GLIBCXX__)
+    typedef std::true_type steals;
+#else
+    typedef std::false_type steals;
+#endif
+
+    bool stealable(const This &other) const noexcept;
+    void steal(This &other, std::true_type) noexcept;
+    void steal(This &other, std::false_type) noexcept;
+    void swap_inline(This &other);
+    void swap_spilled(This &other, std::true_type);
+    void swap_spilled(This &other, std::false_type);
+
+    // NON-MEMBER FUNCTIONS
+    // --------------------
+    template <typename V, size_t M, typename A, typename D>
+    friend void swap(small_vector<V, M, A, D> &left, small_vector<V, M, A, D> &right);
+
+    // RELATIONAL OPERATORS
+    template <typename V, size_t M, typename A, typename D>
+    friend bool operator==(const small_vector<V, M, A, D> &left, const small_vector<V, M, A, D> &right);
+
+    template <typename V, size_t M, typename A, typename D>
+    friend bool operator!=(const small_vector<V, M, A, D> &left, const small_vector<V, M, A, D> &right);
+
+    template <typename V, size_t M, typename A, typename D>
+    friend bool operator>(const small_vector<V, M, A, D> &left, const small_vector<V, M, A, D> &right);
+
+    template <typename V, size_t M, typename A, typename D>
+    friend bool operator>=(const small_vector<V, M, A, D> &left, const small_vector<V, M, A, D> &right);
+
+    template <typename V, size_t M, typename A, typename D>
+    friend bool operator<(const small_vector<V, M, A, D> &left, const small_vector<V, M, A, D> &right);
+
+    template <typename V, size_t M, typename A, typename D>
+    friend bool operator<=(const small_vector<V, M, A, D> &left, const small_vector<V, M, A, D> &right);
+
+public:
+    // MEMBER TYPES
+    // ------------
+    using typename Base::value_type;
+    using typename Base::allocator_type;
+    using typename Base::reference;
+    using typename Base::const_reference;
+    using typename Base::pointer;
+    using typename Base::const_pointer;
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    using typename Base::reverse_iterator;
+    using typename Base::const_reverse_iterator;
+    using typename Base::difference_type;
+    using typename Base::size_type;
+
+    // MEMBER VARIABLES
+    // ----------------
+    static const size_type inline_capacity = N;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    small_vector();
+    explicit small_vector(size_type n);
+    small_vector(size_type n, const value_type &value);
+    small_vector(std::initializer_list<value_type> list);
+
+    template <
+        typename Iter,
+        typename = typename std::enable_if<!std::is_integral<Iter>::value>::type
+    >
+    small_vector(Iter first, Iter last);
+
+    small_vector(const This &other);
+    small_vector(This &&other) noexcept(steals::value && std::is_nothrow_move_constructible<T>::value);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(steals::value && std::is_nothrow_move_constructible<T>::value && std::allocator_traits<Alloc>::is_always_equal::value);
+    ~small_vector();
+
+    // ITERATORS
+    using Base::begin;
+    using Base::end;
+    using Base::rbegin;
+    using Base::rend;
+    using Base::cbegin;
+    using Base::cend;
+    using Base::crbegin;
+    using Base::crend;
+
+    // CAPACITY
+    using Base::size;
+    using Base::max_size;
+    using Base::resize;
+    void resize_default_init(size_type n);
+    using Base::empty;
+    using Base::reserve;
+    using Base::capacity;
+    void shrink_to_fit();
+
+    // ELEMENT ACCESS
+    using Base::operator[];
+    using Base::at;
+    using Base::front;
+    using Base::back;
+    using Base::data;
+
+    // MODIFIERS
+    using Base::assign;
+    using Base::push_back;
+    using Base::pop_back;
+    using Base::insert;
+    using Base::erase;
+    using Base::clear;
+    using Base::emplace;
+    using Base::emplace_back;
+    span<T> append_uninitialized(size_type n);
+    void swap(This &other);
+
+    // ALLOCATORS
+    using Base::get_allocator;
+
+    // SMALL BUFFER
+    bool is_inline() const noexcept;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T, size_t N>
+small_buffer<T, N>::small_buffer() noexcept:
+    used_(false)
+{}
+
+
+template <typename T, size_t N>
+T * small_buffer<T, N>::data() noexcept
+{
+    return reinterpret_cast<T*>(&storage_);
+}
+
+
+template <typename T, size_t N>
+const T * small_buffer<T, N>::data() const noexcept
+{
+    return reinterpret_cast<const T*>(&storage_);
+}
+
+
+template <typename T, size_t N>
+bool small_buffer<T, N>::used() const noexcept
+{
+    return used_;
+}
+
+
+template <typename T, size_t N>
+void small_buffer<T, N>::used(bool value) noexcept
+{
+    used_ = value;
+}
+
+
+template <typename T, size_t N, typename Alloc>
+small_allocator<T, N, Alloc>::small_allocator() noexcept:
+    buffer_(nullptr)
+{}
+
+
+template <typename T, size_t N, typename Alloc>
+small_allocator<T, N, Alloc>::small_allocator(small_buffer<T, N> *buffer,
+        const Alloc &alloc) noexcept:
+    Alloc(alloc),
+    buffer_(buffer)
+{}
+
+
+template <typename T, size_t N, typename Alloc>
+template <typename U, typename A>
+small_allocator<T, N, Alloc>::small_allocator(const small_allocator<U, N, A> &other) noexcept:
+    Alloc(static_cast<const A&>(other)),
+    buffer_(nullptr)
+{}
+
+
+template <typename T, size_t N, typename Alloc>
+T * small_allocator<T, N, Alloc>::allocate(size_type n)
+{
+    if (buffer_ && !buffer_->used() && n <= N) {
+        buffer_->used(true);
+        return buffer_->data();
+    }
+    return Traits::allocate(*this, n);
+}
+
+
+template <typename T, size_t N, typename Alloc>
+void small_allocator<T, N, Alloc>::deallocate(T *p,
+    size_type n)
+{
+    if (buffer_ && p == buffer_->data()) {
+        buffer_->used(false);
+    } else {
+        Traits::deallocate(*this, p, n);
+    }
+}
+
+
+/** \brief Construct through the heap allocator, so it may default-initialize.
+ */
+template <typename T, size_t N, typename Alloc>
+template <typename U, typename... Ts>
+void small_allocator<T, N, Alloc>::construct(U *p,
+    Ts&&... ts)
+{
+    Traits::construct(static_cast<Alloc&>(*this), p, std::forward<Ts>(ts)...);
+}
+
+
+template <typename T, size_t N, typename Alloc>
+auto small_allocator<T, N, Alloc>::select_on_container_copy_construction() const
+    -> small_allocator
+{
+    return small_allocator(nullptr, Traits::select_on_container_copy_construction(*this));
+}
+
+
+template <typename T, size_t N, typename Alloc>
+auto small_allocator<T, N, Alloc>::heap_allocator() const noexcept
+    -> const Alloc &
+{
+    return static_cast<const Alloc&>(*this);
+}
+
+
+template <typename T, size_t N, typename Alloc>
+bool operator==(const small_allocator<T, N, Alloc> &left,
+    const small_allocator<T, N, Alloc> &right) noexcept
+{
+    return left.buffer_ == right.buffer_;
+}
+
+
+template <typename T, size_t N, typename Alloc>
+bool operator!=(const small_allocator<T, N, Alloc> &left,
+    const small_allocator<T, N, Alloc> &right) noexcept
+{
+    return left.buffer_ != right.buffer_;
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::ref() const
+    -> const Base &
+{
+    return static_cast<const Base&>(*this);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::ref()
+    -> Base &
+{
+    return static_cast<Base&>(*this);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::forward() const
+    -> const Base &&
+{
+    return static_cast<const Base&&>(*this);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::forward()
+    -> Base &&
+{
+    return static_cast<Base&&>(*this);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::buffer() const
+    -> const Buffer *
+{
+    return static_cast<const Buffer*>(this);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::reset(size_t n)
+{
+    // release heap storage when `n` elements fit inline
+    Base::clear();
+    if (n <= N && !is_inline()) {
+        Base::shrink_to_fit();
+    }
+    Base::reserve(std::max(n, N));
+}
+
+
+/** \brief Check if the heap storage of `other` may be handed over.
+ */
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool small_vector<T, N, Alloc, Destructor>::stealable(const This &other) const noexcept
+{
+    return steals::value && !other.is_inline()
+        && get_allocator().heap_allocator() == other.get_allocator().heap_allocator();
+}
+
+
+/** \brief Free this storage, and take the heap storage of `other`.
+ *
+ *  `other` is left empty, with its inline buffer reserved.
+ */
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::steal(This &other,
+    std::true_type) noexcept
+{
+    auto &impl = this->_M_impl;
+    auto &source = other._M_impl;
+    Base::clear();
+    this->_M_deallocate(impl._M_start, impl._M_end_of_storage - impl._M_start);
+    impl._M_start = source._M_start;
+    impl._M_finish = source._M_finish;
+    impl._M_end_of_storage = source._M_end_of_storage;
+    source._M_start = source._M_finish = source._M_end_of_storage = nullptr;
+    other.Base::reserve(N);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::steal(This &,
+    std::false_type) noexcept
+{}
+
+
+/** \brief Swap two inline vectors, element by element.
+ */
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::swap_inline(This &other)
+{
+    This &large = size() < other.size() ? other : *this;
+    This &small = size() < other.size() ? *this : other;
+    size_type common = small.size();
+    std::swap_ranges(small.begin(), small.end(), large.begin());
+    for (size_type i = common; i < large.size(); ++i) {
+        small.Base::emplace_back(std::move(large[i]));
+    }
+    large.Base::erase(large.begin() + common, large.end());
+}
+
+
+/** \brief Swap when either vector spilled to an equal heap allocator.
+ *
+ *  Heap storage changes owners. The elements of an inline vector move
+ *  into the unused inline buffer of the other. If a move throws, the
+ *  spilled vector keeps its heap storage.
+ */
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::swap_spilled(This &other,
+    std::true_type)
+{
+    if (!is_inline() && !other.is_inline()) {
+        auto &left = this->_M_impl;
+        auto &right = other._M_impl;
+        std::swap(left._M_start, right._M_start);
+        std::swap(left._M_finish, right._M_finish);
+        std::swap(left._M_end_of_storage, right._M_end_of_storage);
+        return;
+    }
+
+    This &large = is_inline() ? other : *this;
+    This &small = is_inline() ? *this : other;
+    auto &heap = large._M_impl;
+    auto start = heap._M_start;
+    auto finish = heap._M_finish;
+    auto end_of_storage = heap._M_end_of_storage;
+    heap._M_start = heap._M_finish = heap._M_end_of_storage = nullptr;
+    large.Base::reserve(N);
+    try {
+        for (auto &value: small) {
+            large.Base::emplace_back(std::move(value));
+        }
+    } catch (...) {
+        large.Base::clear();
+        large._M_deallocate(heap._M_start, heap._M_end_of_storage - heap._M_start);
+        heap._M_start = start;
+        heap._M_finish = finish;
+        heap._M_end_of_storage = end_of_storage;
+        throw;
+    }
+
+    auto &impl = small._M_impl;
+    small.Base::clear();
+    small._M_deallocate(impl._M_start, impl._M_end_of_storage - impl._M_start);
+    impl._M_start = start;
+    impl._M_finish = finish;
+    impl._M_end_of_storage = end_of_storage;
+}
+
+
+/** \brief Swap through a temporary, where storage cannot change owners.
+ */
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::swap_spilled(This &other,
+    std::false_type)
+{
+    This temp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(temp);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void swap(small_vector<T, N, Alloc, Destructor> &left,
+    small_vector<T, N, Alloc, Destructor> &right)
+{
+    left.swap(right);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool operator==(const small_vector<T, N, Alloc, Destructor> &left,
+    const small_vector<T, N, Alloc, Destructor> &right)
+{
+    return left.ref() == right.ref();
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool operator!=(const small_vector<T, N, Alloc, Destructor> &left,
+    const small_vector<T, N, Alloc, Destructor> &right)
+{
+    return left.ref() != right.ref();
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool operator>(const small_vector<T, N, Alloc, Destructor> &left,
+    const small_vector<T, N, Alloc, Destructor> &right)
+{
+    return left.ref() > right.ref();
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool operator>=(const small_vector<T, N, Alloc, Destructor> &left,
+    const small_vector<T, N, Alloc, Destructor> &right)
+{
+    return left.ref() >= right.ref();
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool operator<(const small_vector<T, N, Alloc, Destructor> &left,
+    const small_vector<T, N, Alloc, Destructor> &right)
+{
+    return left.ref() < right.ref();
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool operator<=(const small_vector<T, N, Alloc, Destructor> &left,
+    const small_vector<T, N, Alloc, Destructor> &right)
+{
+    return left.ref() <= right.ref();
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+const typename small_vector<T, N, Alloc, Destructor>::size_type small_vector<T, N, Alloc, Destructor>::inline_capacity;
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+small_vector<T, N, Alloc, Destructor>::small_vector():
+    Base(allocator_type(static_cast<Buffer*>(this)))
+{
+    Base::reserve(N);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+small_vector<T, N, Alloc, Destructor>::small_vector(size_type n):
+    Base(allocator_type(static_cast<Buffer*>(this)))
+{
+    Base::reserve(std::max(n, N));
+    Base::resize(n);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+small_vector<T, N, Alloc, Destructor>::small_vector(size_type n,
+        const value_type &value):
+    Base(allocator_type(static_cast<Buffer*>(this)))
+{
+    Base::reserve(std::max(n, N));
+    Base::assign(n, value);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+small_vector<T, N, Alloc, Destructor>::small_vector(std::initializer_list<value_type> list):
+    Base(allocator_type(static_cast<Buffer*>(this)))
+{
+    Base::reserve(std::max(list.size(), N));
+    Base::assign(list);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+template <typename Iter, typename>
+small_vector<T, N, Alloc, Destructor>::small_vector(Iter first,
+        Iter last):
+    Base(allocator_type(static_cast<Buffer*>(this)))
+{
+    Base::reserve(N);
+    Base::assign(first, last);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+small_vector<T, N, Alloc, Destructor>::small_vector(const This &other):
+    Base(allocator_type(static_cast<Buffer*>(this), other.get_allocator().heap_allocator()))
+{
+    Base::reserve(std::max(other.size(), N));
+    Base::assign(other.begin(), other.end());
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+small_vector<T, N, Alloc, Destructor>::small_vector(This &&other) noexcept(steals::value && std::is_nothrow_move_constructible<T>::value):
+    Base(allocator_type(static_cast<Buffer*>(this), other.get_allocator().heap_allocator()))
+{
+    if (stealable(other)) {
+        steal(other, steals());
+    } else {
+        Base::reserve(std::max(other.size(), N));
+        Base::assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+    }
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    if (this != &other) {
+        reset(other.size());
+        Base::assign(other.begin(), other.end());
+    }
+    return *this;
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::operator=(This &&other) noexcept(steals::value && std::is_nothrow_move_constructible<T>::value && std::allocator_traits<Alloc>::is_always_equal::value)
+    -> This &
+{
+    if (this == &other) {
+        return *this;
+    } else if (stealable(other)) {
+        steal(other, steals());
+    } else {
+        reset(other.size());
+        Base::assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        other.clear();
+    }
+    return *this;
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+small_vector<T, N, Alloc, Destructor>::~small_vector()
+{}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::shrink_to_fit()
+{
+    // the inline buffer is never shrunk, since that would spill to the heap
+    if (!is_inline()) {
+        Base::shrink_to_fit();
+    }
+}
+
+
+/** \brief Resize the vector, default-initializing new elements.
+ *
+ *  As with `itl::vector`, only a heap allocator of
+ *  `default_init_allocator<T>` leaves new elements uninitialized.
+ */
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::resize_default_init(size_type n)
+{
+    static_assert(is_default_init_allocator<Alloc>::value,
+        "resize_default_init requires Alloc = itl::default_init_allocator<T, ...>.");
+    Base::resize(n);
+}
+
+
+/** \brief Append `n` default-initialized elements for writing.
+ */
+template <typename T, size_t N, typename Alloc, typename Destructor>
+auto small_vector<T, N, Alloc, Destructor>::append_uninitialized(size_type n)
+    -> span<T>
+{
+    size_type offset = size();
+    resize_default_init(offset + n);
+    return span<T>(data() + offset, n);
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+void small_vector<T, N, Alloc, Destructor>::swap(This &other)
+{
+    if (this == &other) {
+        return;
+    } else if (is_inline() && other.is_inline()) {
+        swap_inline(other);
+    } else if (stealable(other) || other.stealable(*this)) {
+        swap_spilled(other, steals());
+    } else {
+        swap_spilled(other, std::false_type());
+    }
+}
+
+
+template <typename T, size_t N, typename Alloc, typename Destructor>
+bool small_vector<T, N, Alloc, Destructor>::is_inline() const noexcept
+{
+    return Base::data() == buffer()->data();
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    size_t N,
+    typename Alloc = std::allocator<T>
+>
+using small_vector = itl::small_vector<T, N, Alloc, static_destructor>;
+
+}   /* static_ */
+
+}   /* itl */
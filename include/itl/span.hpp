@@ -0,0 +1,124 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+
+namespace itl
+{
+// DECLARATION
+// -----------
+
+
+/** \brief Non-owning view over contiguous elements.
+ */
+template <typename T>
+class span
+{
+public:
+    // MEMBER TYPES
+    // ------------
+    typedef T element_type;
+    typedef T value_type;
+    typedef T & reference;
+    typedef T * pointer;
+    typedef T * iterator;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    // MEMBER FUNCTIONS
+    // ----------------
+    span() noexcept;
+    span(pointer data, size_type size) noexcept;
+
+    // ITERATORS
+    iterator begin() const noexcept;
+    iterator end() const noexcept;
+
+    // CAPACITY
+    size_type size() const noexcept;
+    bool empty() const noexcept;
+
+    // ELEMENT ACCESS
+    reference operator[](size_type index) const;
+    pointer data() const noexcept;
+
+private:
+    pointer data_;
+    size_type size_;
+};
+
+
+// IMPLEMENTATION
+// --------------
+
+
+template <typename T>
+span<T>::span() noexcept:
+    data_(nullptr),
+    size_(0)
+{}
+
+
+template <typename T>
+span<T>::span(pointer data,
+        size_type size) noexcept:
+    data_(data),
+    size_(size)
+{}
+
+
+template <typename T>
+auto span<T>::begin() const noexcept
+    -> iterator
+{
+    return data_;
+}
+
+
+template <typename T>
+auto span<T>::end() const noexcept
+    -> iterator
+{
+    return data_ + size_;
+}
+
+
+template <typename T>
+auto span<T>::size() const noexcept
+    -> size_type
+{
+    return size_;
+}
+
+
+template <typename T>
+bool span<T>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename T>
+auto span<T>::operator[](size_type index) const
+    -> reference
+{
+    return data_[index];
+}
+
+
+template <typename T>
+auto span<T>::data() const noexcept
+    -> pointer
+{
+    return data_;
+}
+
+}   /* itl */
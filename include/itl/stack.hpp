@@ -9,6 +9,9 @@
 #pragma once
 
 #include <stack>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
 
 
 namespace itl
@@ -21,13 +24,15 @@ namespace itl
  */
 template <
     typename T,
-    typename Container = std::deque<T>
+    typename Container = std::deque<T>,
+    typename Destructor = virtual_destructor
 >
-class stack: protected std::stack<T, Container>
+class stack: protected std::stack<T, Container>,
+    protected Destructor
 {
 protected:
     typedef std::stack<T, Container> Base;
-    typedef stack<T, Container> This;
+    typedef stack<T, Container, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -36,27 +41,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename V, typename C>
-    friend void swap(stack<V, C> &left, stack<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend void swap(stack<V, C, D> &left, stack<V, C, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename V, typename C>
-    friend bool operator==(const stack<V, C> &left, const stack<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator==(const stack<V, C, D> &left, const stack<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator!=(const stack<V, C> &left, const stack<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator!=(const stack<V, C, D> &left, const stack<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator>(const stack<V, C> &left, const stack<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator>(const stack<V, C, D> &left, const stack<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator>=(const stack<V, C> &left, const stack<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator>=(const stack<V, C, D> &left, const stack<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator<(const stack<V, C> &left, const stack<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator<(const stack<V, C, D> &left, const stack<V, C, D> &right);
 
-    template <typename V, typename C>
-    friend bool operator<=(const stack<V, C> &left, const stack<V, C> &right);
+    template <typename V, typename C, typename D>
+    friend bool operator<=(const stack<V, C, D> &left, const stack<V, C, D> &right);
 
 public:
     // MEMBER TYPES
@@ -70,7 +75,12 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~stack();
+    stack();
+    stack(const This &other);
+    stack(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~stack();
 
     using Base::empty;
     using Base::size;
@@ -86,103 +96,169 @@ public:
 // --------------
 
 
-template <typename T, typename Container>
-auto stack<T, Container>::ref() const
+template <typename T, typename Container, typename Destructor>
+auto stack<T, Container, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename T, typename Container>
-auto stack<T, Container>::ref()
+template <typename T, typename Container, typename Destructor>
+auto stack<T, Container, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename T, typename Container>
-auto stack<T, Container>::forward() const
+template <typename T, typename Container, typename Destructor>
+auto stack<T, Container, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename T, typename Container>
-auto stack<T, Container>::forward()
+template <typename T, typename Container, typename Destructor>
+auto stack<T, Container, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename T, typename Container>
-void swap(stack<T, Container> &left,
-    stack<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+void swap(stack<T, Container, Destructor> &left,
+    stack<T, Container, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename T, typename Container>
-bool operator==(const stack<T, Container> &left,
-    const stack<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator==(const stack<T, Container, Destructor> &left,
+    const stack<T, Container, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator!=(const stack<T, Container> &left,
-    const stack<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator!=(const stack<T, Container, Destructor> &left,
+    const stack<T, Container, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator>(const stack<T, Container> &left,
-    const stack<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator>(const stack<T, Container, Destructor> &left,
+    const stack<T, Container, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator>=(const stack<T, Container> &left,
-    const stack<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator>=(const stack<T, Container, Destructor> &left,
+    const stack<T, Container, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator<(const stack<T, Container> &left,
-    const stack<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator<(const stack<T, Container, Destructor> &left,
+    const stack<T, Container, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename T, typename Container>
-bool operator<=(const stack<T, Container> &left,
-    const stack<T, Container> &right)
+template <typename T, typename Container, typename Destructor>
+bool operator<=(const stack<T, Container, Destructor> &left,
+    const stack<T, Container, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename T, typename Container>
-stack<T, Container>::~stack()
+template <typename T, typename Container, typename Destructor>
+stack<T, Container, Destructor>::stack()
+{}
+
+
+template <typename T, typename Container, typename Destructor>
+stack<T, Container, Destructor>::stack(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Container, typename Destructor>
+stack<T, Container, Destructor>::stack(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Container, typename Destructor>
+auto stack<T, Container, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Container, typename Destructor>
+auto stack<T, Container, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Container, typename Destructor>
+stack<T, Container, Destructor>::~stack()
 {}
 
 
-template <typename T, typename Container>
-void stack<T, Container>::swap(This &other)
+template <typename T, typename Container, typename Destructor>
+void stack<T, Container, Destructor>::swap(This &other)
 {
-    ref().swap(other.ref());
+    allocator_aware_swap(this->c, other.c);
 }
 
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Container = std::deque<T>
+>
+using stack = itl::stack<T, Container, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <typename T>
+using stack = itl::stack<T, std::pmr::deque<T>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
@@ -9,6 +9,13 @@
 #pragma once
 
 #include <string>
+#include <type_traits>
+#if __cplusplus >= 201703L
+#   include <string_view>
+#endif
+#include "allocator.hpp"
+#include "destructor.hpp"
+#include "span.hpp"
 
 
 namespace itl
@@ -22,13 +29,15 @@ namespace itl
 template <
     typename Char,
     typename Traits = std::char_traits<Char>,
-    typename Alloc = std::allocator<Char>
+    typename Alloc = std::allocator<Char>,
+    typename Destructor = virtual_destructor
 >
-class basic_string: protected std::basic_string<Char, Traits, Alloc>
+class basic_string: protected std::basic_string<Char, Traits, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::basic_string<Char, Traits, Alloc> Base;
-    typedef basic_string<Char, Traits, Alloc> This;
+    typedef basic_string<Char, Traits, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -37,156 +46,159 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename C, typename T, typename A>
-    friend void swap(basic_string<C, T, A> &left, basic_string<C, T, A> &right);
+    template <typename C, typename T, typename A, typename D>
+    friend void swap(basic_string<C, T, A, D> &left, basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend std::basic_istream<C, T> & operator>>(std::basic_istream<C, T> &stream,
-        basic_string<C, T, A> &str);
+        basic_string<C, T, A, D> &str);
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend std::basic_ostream<C, T> & operator<<(std::basic_ostream<C, T> &stream,
-        basic_string<C, T, A> &str);
+        basic_string<C, T, A, D> &str);
 
     // OPERATOR+
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(const basic_string<C, T, A> &left, const basic_string<C, T, A> &right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(const basic_string<C, T, A, D> &left, const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(basic_string<C, T, A> &&left,
-        basic_string<C, T, A> &&right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(basic_string<C, T, A, D> &&left,
+        basic_string<C, T, A, D> &&right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(basic_string<C, T, A> &&left,
-        const basic_string<C, T, A> &right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(basic_string<C, T, A, D> &&left,
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(const basic_string<C, T, A> &left,
-        basic_string<C, T, A> &&right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(const basic_string<C, T, A, D> &left,
+        basic_string<C, T, A, D> &&right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(const basic_string<C, T, A, D> &left,
         const C *right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(basic_string<C, T, A> &&left,
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(basic_string<C, T, A, D> &&left,
         const C *right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(const C *left,
-        const basic_string<C, T, A> &right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(const C *left,
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(const C *left,
-        basic_string<C, T, A> &&right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(const C *left,
+        basic_string<C, T, A, D> &&right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(const basic_string<C, T, A, D> &left,
         C right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(basic_string<C, T, A> &&left,
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(basic_string<C, T, A, D> &&left,
         C right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(C left,
-        const basic_string<C, T, A> &right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(C left,
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend basic_string<C, T, A> operator+(C left,
-        basic_string<C, T, A> &&right);
+    template <typename C, typename T, typename A, typename D>
+    friend basic_string<C, T, A, D> operator+(C left,
+        basic_string<C, T, A, D> &&right);
 
     // RELATIONAL OPERATORS
-    template <typename C, typename T, typename A>
-    friend bool operator==(const basic_string<C, T, A> &left,
-        const basic_string<C, T, A> &right) noexcept;
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator==(const basic_string<C, T, A, D> &left,
+        const basic_string<C, T, A, D> &right) noexcept;
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend bool operator==(const C *left,
-        const basic_string<C, T, A> &right);
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator==(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator==(const basic_string<C, T, A, D> &left,
         const C *right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator!=(const basic_string<C, T, A> &left,
-        const basic_string<C, T, A> &right) noexcept;
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator!=(const basic_string<C, T, A, D> &left,
+        const basic_string<C, T, A, D> &right) noexcept;
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend bool operator!=(const C *left,
-        const basic_string<C, T, A> &right);
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator!=(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator!=(const basic_string<C, T, A, D> &left,
         const C *right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator<(const basic_string<C, T, A> &left,
-        const basic_string<C, T, A> &right) noexcept;
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator<(const basic_string<C, T, A, D> &left,
+        const basic_string<C, T, A, D> &right) noexcept;
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend bool operator<(const C *left,
-        const basic_string<C, T, A> &right);
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator<(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator<(const basic_string<C, T, A, D> &left,
         const C *right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator<=(const basic_string<C, T, A> &left,
-        const basic_string<C, T, A> &right) noexcept;
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator<=(const basic_string<C, T, A, D> &left,
+        const basic_string<C, T, A, D> &right) noexcept;
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend bool operator<=(const C *left,
-        const basic_string<C, T, A> &right);
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator<=(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator<=(const basic_string<C, T, A, D> &left,
         const C *right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator>(const basic_string<C, T, A> &left,
-        const basic_string<C, T, A> &right) noexcept;
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator>(const basic_string<C, T, A, D> &left,
+        const basic_string<C, T, A, D> &right) noexcept;
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend bool operator>(const C *left,
-        const basic_string<C, T, A> &right);
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator>(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator>(const basic_string<C, T, A, D> &left,
         const C *right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator>=(const basic_string<C, T, A> &left,
-        const basic_string<C, T, A> &right) noexcept;
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator>=(const basic_string<C, T, A, D> &left,
+        const basic_string<C, T, A, D> &right) noexcept;
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend bool operator>=(const C *left,
-        const basic_string<C, T, A> &right);
+        const basic_string<C, T, A, D> &right);
 
-    template <typename C, typename T, typename A>
-    friend bool operator>=(const basic_string<C, T, A> &left,
+    template <typename C, typename T, typename A, typename D>
+    friend bool operator>=(const basic_string<C, T, A, D> &left,
         const C *right);
 
     // GETLINE
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend std::basic_istream<C, T> & getline(std::basic_istream<C, T> &stream,
-        basic_string<C, T, A> &str,
+        basic_string<C, T, A, D> &str,
         C delim);
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend std::basic_istream<C, T> & getline(std::basic_istream<C, T> &&stream,
-        basic_string<C, T, A> &str,
+        basic_string<C, T, A, D> &str,
         C delim);
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend std::basic_istream<C, T> & getline(std::basic_istream<C, T> &stream,
-        basic_string<C, T, A> &str);
+        basic_string<C, T, A, D> &str);
 
-    template <typename C, typename T, typename A>
+    template <typename C, typename T, typename A, typename D>
     friend std::basic_istream<C, T> & getline(std::basic_istream<C, T> &&stream,
-        basic_string<C, T, A> &str);
+        basic_string<C, T, A, D> &str);
+
+    // HASH
+    friend struct std::hash<This>;
 
 public:
     // MEMBER TYPES
@@ -212,7 +224,14 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~basic_string();
+    basic_string();
+    basic_string(const This &other);
+    basic_string(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    basic_string(const This &other, const allocator_type &alloc);
+    basic_string(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~basic_string();
 
     // ITERATORS
     using Base::begin;
@@ -229,6 +248,9 @@ public:
     using Base::length;
     using Base::max_size;
     using Base::resize;
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    void resize_default_init(size_type n);
+#endif
     using Base::capacity;
     using Base::reserve;
     using Base::clear;
@@ -250,6 +272,9 @@ public:
     using Base::erase;
     using Base::replace;
     using Base::pop_back;
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    span<Char> append_uninitialized(size_type n);
+#endif
     void swap(This &other);
 
     // STRING OPERATIONS
@@ -264,7 +289,72 @@ public:
     using Base::find_first_not_of;
     using Base::find_last_not_of;
     using Base::compare;
-    basic_string<Char, Traits, Alloc> substr(size_type pos = 0, size_type len = npos) const;
+    basic_string<Char, Traits, Alloc, Destructor> substr(size_type pos = 0, size_type len = npos) const;
+};
+
+
+/** \brief Borrowed characters of any string type, for transparent lookup.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+struct basic_string_key
+{
+    const Char *data;
+    size_t size;
+
+    basic_string_key(const Char *s);
+    template <typename A>
+    basic_string_key(const std::basic_string<Char, Traits, A> &s);
+    template <typename A, typename D>
+    basic_string_key(const basic_string<Char, Traits, A, D> &s);
+#if __cplusplus >= 201703L
+    basic_string_key(std::basic_string_view<Char, Traits> s);
+#endif
+};
+
+
+/** \brief Transparent string hash.
+ *
+ *  Hashes `const Char*`, std and itl strings alike, so unordered
+ *  containers keyed by strings are searched without a temporary key.
+ *  Hashes match `std::hash` for the same characters.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+struct basic_string_hash
+{
+    typedef void is_transparent;
+    size_t operator()(basic_string_key<Char, Traits> key) const noexcept;
+};
+
+
+/** \brief Transparent string equality.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+struct basic_string_equal_to
+{
+    typedef void is_transparent;
+    bool operator()(basic_string_key<Char, Traits> left, basic_string_key<Char, Traits> right) const noexcept;
+};
+
+
+/** \brief Transparent string ordering.
+ */
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+struct basic_string_less
+{
+    typedef void is_transparent;
+    bool operator()(basic_string_key<Char, Traits> left, basic_string_key<Char, Traits> right) const noexcept;
 };
 
 
@@ -272,372 +362,523 @@ public:
 // --------------
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto basic_string<Char, Traits, Alloc>::ref() const
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto basic_string<Char, Traits, Alloc>::ref()
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto basic_string<Char, Traits, Alloc>::forward() const
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto basic_string<Char, Traits, Alloc>::forward()
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-void swap(basic_string<Char, Traits, Alloc> &left,
-    basic_string<Char, Traits, Alloc> &right)
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+void swap(basic_string<Char, Traits, Alloc, Destructor> &left,
+    basic_string<Char, Traits, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 std::basic_istream<Char, Traits> & operator>>(std::basic_istream<Char, Traits> &stream,
-    basic_string<Char, Traits, Alloc> &str)
+    basic_string<Char, Traits, Alloc, Destructor> &str)
 {
     return operator>>(stream, str.ref());
 }
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 std::basic_ostream<Char, Traits> & operator<<(std::basic_ostream<Char, Traits> &stream,
-    basic_string<Char, Traits, Alloc> &str)
+    basic_string<Char, Traits, Alloc, Destructor> &str)
 {
     return operator<<(stream, str.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(const basic_string<Char, Traits, Alloc> &left,
-        const basic_string<Char, Traits, Alloc> &right)
-    -> basic_string<Char, Traits, Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(const basic_string<Char, Traits, Alloc, Destructor> &left,
+        const basic_string<Char, Traits, Alloc, Destructor> &right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.ref() + right.ref();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(basic_string<Char, Traits, Alloc> &&left,
-        basic_string<Char, Traits, Alloc> &&right)
-    -> basic_string<Char, Traits, Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(basic_string<Char, Traits, Alloc, Destructor> &&left,
+        basic_string<Char, Traits, Alloc, Destructor> &&right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.forward() + right.forward();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(basic_string<Char, Traits, Alloc> &&left,
-        const basic_string<Char, Traits, Alloc> &right)
-    -> basic_string<Char, Traits, Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(basic_string<Char, Traits, Alloc, Destructor> &&left,
+        const basic_string<Char, Traits, Alloc, Destructor> &right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.forward() + right.ref();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(const basic_string<Char, Traits, Alloc> &left,
-        basic_string<Char, Traits, Alloc> &&right)
-    -> basic_string<Char, Traits, Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(const basic_string<Char, Traits, Alloc, Destructor> &left,
+        basic_string<Char, Traits, Alloc, Destructor> &&right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.ref() + right.forward();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(const basic_string<Char, Traits, Alloc, Destructor> &left,
         const Char *right)
-    -> basic_string<Char, Traits, Alloc>
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.ref() + right;
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(basic_string<Char, Traits, Alloc> &&left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(basic_string<Char, Traits, Alloc, Destructor> &&left,
         const Char *right)
-    -> basic_string<Char, Traits, Alloc>
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.forward() + right;
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 auto operator+(const Char *left,
-        const basic_string<Char, Traits, Alloc> &right)
-    -> basic_string<Char, Traits, Alloc>
+        const basic_string<Char, Traits, Alloc, Destructor> &right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left + right.ref();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 auto operator+(const Char *left,
-        basic_string<Char, Traits, Alloc> &&right)
-    -> basic_string<Char, Traits, Alloc>
+        basic_string<Char, Traits, Alloc, Destructor> &&right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left + right.forward();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(const basic_string<Char, Traits, Alloc, Destructor> &left,
         Char right)
-    -> basic_string<Char, Traits, Alloc>
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.ref() + right;
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto operator+(basic_string<Char, Traits, Alloc> &&left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto operator+(basic_string<Char, Traits, Alloc, Destructor> &&left,
         Char right)
-    -> basic_string<Char, Traits, Alloc>
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left.forward() + right;
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 auto operator+(Char left,
-        const basic_string<Char, Traits, Alloc> &right)
-    -> basic_string<Char, Traits, Alloc>
+        const basic_string<Char, Traits, Alloc, Destructor> &right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left + right.ref();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 auto operator+(Char left,
-        basic_string<Char, Traits, Alloc> &&right)
-    -> basic_string<Char, Traits, Alloc>
+        basic_string<Char, Traits, Alloc, Destructor> &&right)
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return left + right.forward();
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator==(const basic_string<Char, Traits, Alloc> &left,
-    const basic_string<Char, Traits, Alloc> &right) noexcept
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator==(const basic_string<Char, Traits, Alloc, Destructor> &left,
+    const basic_string<Char, Traits, Alloc, Destructor> &right) noexcept
 {
     return operator==(left.ref(), right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 bool operator==(const Char *left,
-    const basic_string<Char, Traits, Alloc> &right)
+    const basic_string<Char, Traits, Alloc, Destructor> &right)
 {
     return operator==(left, right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator==(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator==(const basic_string<Char, Traits, Alloc, Destructor> &left,
     const Char *right)
 {
     return operator==(left.ref(), right);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator!=(const basic_string<Char, Traits, Alloc> &left,
-    const basic_string<Char, Traits, Alloc> &right) noexcept
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator!=(const basic_string<Char, Traits, Alloc, Destructor> &left,
+    const basic_string<Char, Traits, Alloc, Destructor> &right) noexcept
 {
     return operator!=(left.ref(), right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 bool operator!=(const Char *left,
-    const basic_string<Char, Traits, Alloc> &right)
+    const basic_string<Char, Traits, Alloc, Destructor> &right)
 {
     return operator!=(left, right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator!=(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator!=(const basic_string<Char, Traits, Alloc, Destructor> &left,
     const Char *right)
 {
     return operator!=(left.ref(), right);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator<(const basic_string<Char, Traits, Alloc> &left,
-    const basic_string<Char, Traits, Alloc> &right) noexcept
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator<(const basic_string<Char, Traits, Alloc, Destructor> &left,
+    const basic_string<Char, Traits, Alloc, Destructor> &right) noexcept
 {
     return operator<(left.ref(), right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 bool operator<(const Char *left,
-    const basic_string<Char, Traits, Alloc> &right)
+    const basic_string<Char, Traits, Alloc, Destructor> &right)
 {
     return operator<(left, right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator<(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator<(const basic_string<Char, Traits, Alloc, Destructor> &left,
     const Char *right)
 {
     return operator<(left.ref(), right);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator<=(const basic_string<Char, Traits, Alloc> &left,
-    const basic_string<Char, Traits, Alloc> &right) noexcept
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator<=(const basic_string<Char, Traits, Alloc, Destructor> &left,
+    const basic_string<Char, Traits, Alloc, Destructor> &right) noexcept
 {
     return operator<=(left.ref(), right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 bool operator<=(const Char *left,
-    const basic_string<Char, Traits, Alloc> &right)
+    const basic_string<Char, Traits, Alloc, Destructor> &right)
 {
     return operator<=(left, right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator<=(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator<=(const basic_string<Char, Traits, Alloc, Destructor> &left,
     const Char *right)
 {
     return operator<=(left.ref(), right);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator>(const basic_string<Char, Traits, Alloc> &left,
-    const basic_string<Char, Traits, Alloc> &right) noexcept
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator>(const basic_string<Char, Traits, Alloc, Destructor> &left,
+    const basic_string<Char, Traits, Alloc, Destructor> &right) noexcept
 {
     return operator>(left.ref(), right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 bool operator>(const Char *left,
-    const basic_string<Char, Traits, Alloc> &right)
+    const basic_string<Char, Traits, Alloc, Destructor> &right)
 {
     return operator>(left, right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator>(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator>(const basic_string<Char, Traits, Alloc, Destructor> &left,
     const Char *right)
 {
     return operator>(left.ref(), right);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator>=(const basic_string<Char, Traits, Alloc> &left,
-    const basic_string<Char, Traits, Alloc> &right) noexcept
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator>=(const basic_string<Char, Traits, Alloc, Destructor> &left,
+    const basic_string<Char, Traits, Alloc, Destructor> &right) noexcept
 {
     return operator>=(left.ref(), right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 bool operator>=(const Char *left,
-    const basic_string<Char, Traits, Alloc> &right)
+    const basic_string<Char, Traits, Alloc, Destructor> &right)
 {
     return operator>=(left, right.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-bool operator>=(const basic_string<Char, Traits, Alloc> &left,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+bool operator>=(const basic_string<Char, Traits, Alloc, Destructor> &left,
     const Char *right)
 {
     return operator>=(left.ref(), right);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 std::basic_istream<Char, Traits> & getline(std::basic_istream<Char, Traits> &stream,
-    basic_string<Char, Traits, Alloc> &str,
+    basic_string<Char, Traits, Alloc, Destructor> &str,
     Char delim)
 {
     return getline(stream, str.ref(), delim);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 std::basic_istream<Char, Traits> & getline(std::basic_istream<Char, Traits> &&stream,
-    basic_string<Char, Traits, Alloc> &str,
+    basic_string<Char, Traits, Alloc, Destructor> &str,
     Char delim)
 {
     return getline(std::forward(stream), str.ref(), delim);
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 std::basic_istream<Char, Traits> & getline(std::basic_istream<Char, Traits> &stream,
-    basic_string<Char, Traits, Alloc> &str)
+    basic_string<Char, Traits, Alloc, Destructor> &str)
 {
     return getline(stream, str.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
 std::basic_istream<Char, Traits> & getline(std::basic_istream<Char, Traits> &&stream,
-    basic_string<Char, Traits, Alloc> &str)
+    basic_string<Char, Traits, Alloc, Destructor> &str)
 {
     return getline(std::forward(stream), str.ref());
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-const typename basic_string<Char, Traits, Alloc>::size_type basic_string<Char, Traits, Alloc>::npos;
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+const typename basic_string<Char, Traits, Alloc, Destructor>::size_type basic_string<Char, Traits, Alloc, Destructor>::npos;
 
 
-template <typename Char, typename Traits, typename Alloc>
-basic_string<Char, Traits, Alloc>::~basic_string()
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+basic_string<Char, Traits, Alloc, Destructor>::basic_string()
 {}
 
 
-template <typename Char, typename Traits, typename Alloc>
-void basic_string<Char, Traits, Alloc>::swap(This &other)
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+basic_string<Char, Traits, Alloc, Destructor>::basic_string(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+basic_string<Char, Traits, Alloc, Destructor>::basic_string(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+basic_string<Char, Traits, Alloc, Destructor>::basic_string(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+basic_string<Char, Traits, Alloc, Destructor>::basic_string(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
 {
-    ref().swap(other.ref());
+    Base::operator=(other.forward());
+    return *this;
 }
 
 
-template <typename Char, typename Traits, typename Alloc>
-auto basic_string<Char, Traits, Alloc>::substr(size_type pos,
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+basic_string<Char, Traits, Alloc, Destructor>::~basic_string()
+{}
+
+
+#if defined(__cpp_lib_string_resize_and_overwrite)
+
+/** \brief Resize the string, leaving new characters uninitialized.
+ *
+ *  Only declared with `resize_and_overwrite` (C++23). Before it, no
+ *  standard library grows a string without writing the new characters.
+ */
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+void basic_string<Char, Traits, Alloc, Destructor>::resize_default_init(size_type n)
+{
+    Base::resize_and_overwrite(n, [](Char *, size_type count) {
+        return count;
+    });
+}
+
+
+/** \brief Append `n` uninitialized characters for writing.
+ */
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::append_uninitialized(size_type n)
+    -> span<Char>
+{
+    size_type offset = size();
+    resize_default_init(offset + n);
+    return span<Char>(&Base::operator[](0) + offset, n);
+}
+
+#endif
+
+
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+void basic_string<Char, Traits, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+auto basic_string<Char, Traits, Alloc, Destructor>::substr(size_type pos,
         size_type len) const
-    -> basic_string<Char, Traits, Alloc>
+    -> basic_string<Char, Traits, Alloc, Destructor>
 {
     return This(*this, pos, len, get_allocator());
 }
 
 
+template <typename Char, typename Traits>
+basic_string_key<Char, Traits>::basic_string_key(const Char *s):
+    data(s),
+    size(Traits::length(s))
+{}
+
+
+template <typename Char, typename Traits>
+template <typename A>
+basic_string_key<Char, Traits>::basic_string_key(const std::basic_string<Char, Traits, A> &s):
+    data(s.data()),
+    size(s.size())
+{}
+
+
+template <typename Char, typename Traits>
+template <typename A, typename D>
+basic_string_key<Char, Traits>::basic_string_key(const basic_string<Char, Traits, A, D> &s):
+    data(s.data()),
+    size(s.size())
+{}
+
+
+#if __cplusplus >= 201703L
+
+template <typename Char, typename Traits>
+basic_string_key<Char, Traits>::basic_string_key(std::basic_string_view<Char, Traits> s):
+    data(s.data()),
+    size(s.size())
+{}
+
+#endif
+
+
+template <typename Char, typename Traits>
+size_t basic_string_hash<Char, Traits>::operator()(basic_string_key<Char, Traits> key) const noexcept
+{
+#if __cplusplus >= 201703L
+    return std::hash<std::basic_string_view<Char, Traits>>()(std::basic_string_view<Char, Traits>(key.data, key.size));
+#elif defined(__GLIBCXX__)
+    return std::_Hash_impl::hash(key.data, key.size * sizeof(Char));
+#else
+    // FNV-1a
+    const unsigned char *bytes = reinterpret_cast<const unsigned char*>(key.data);
+    size_t hash = sizeof(size_t) == 8 ? size_t(14695981039346656037ULL) : size_t(2166136261U);
+    size_t prime = sizeof(size_t) == 8 ? size_t(1099511628211ULL) : size_t(16777619U);
+    for (size_t i = 0; i < key.size * sizeof(Char); ++i) {
+        hash = (hash ^ bytes[i]) * prime;
+    }
+    return hash;
+#endif
+}
+
+
+template <typename Char, typename Traits>
+bool basic_string_equal_to<Char, Traits>::operator()(basic_string_key<Char, Traits> left,
+    basic_string_key<Char, Traits> right) const noexcept
+{
+    return left.size == right.size && Traits::compare(left.data, right.data, left.size) == 0;
+}
+
+
+template <typename Char, typename Traits>
+bool basic_string_less<Char, Traits>::operator()(basic_string_key<Char, Traits> left,
+    basic_string_key<Char, Traits> right) const noexcept
+{
+    size_t size = left.size < right.size ? left.size : right.size;
+    int compare = Traits::compare(left.data, right.data, size);
+    return compare < 0 || (compare == 0 && left.size < right.size);
+}
+
+
 // TYPES
 // -----
 
@@ -646,4 +887,88 @@ typedef basic_string<wchar_t> wstring;
 typedef basic_string<char16_t> u16string;
 typedef basic_string<char32_t> u32string;
 
+typedef basic_string_hash<char> string_hash;
+typedef basic_string_hash<wchar_t> wstring_hash;
+typedef basic_string_hash<char16_t> u16string_hash;
+typedef basic_string_hash<char32_t> u32string_hash;
+
+typedef basic_string_equal_to<char> string_equal_to;
+typedef basic_string_equal_to<wchar_t> wstring_equal_to;
+typedef basic_string_equal_to<char16_t> u16string_equal_to;
+typedef basic_string_equal_to<char32_t> u32string_equal_to;
+
+typedef basic_string_less<char> string_less;
+typedef basic_string_less<wchar_t> wstring_less;
+typedef basic_string_less<char16_t> u16string_less;
+typedef basic_string_less<char32_t> u32string_less;
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>,
+    typename Alloc = std::allocator<Char>
+>
+using basic_string = itl::basic_string<Char, Traits, Alloc, static_destructor>;
+
+typedef basic_string<char> string;
+typedef basic_string<wchar_t> wstring;
+typedef basic_string<char16_t> u16string;
+typedef basic_string<char32_t> u32string;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Char,
+    typename Traits = std::char_traits<Char>
+>
+using basic_string = itl::basic_string<Char, Traits, std::pmr::polymorphic_allocator<Char>>;
+
+typedef basic_string<char> string;
+typedef basic_string<wchar_t> wstring;
+typedef basic_string<char16_t> u16string;
+typedef basic_string<char32_t> u32string;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
+
+
+namespace std
+{
+// SPECIALIZATION
+// --------------
+
+
+/** \brief Hash of an `itl::basic_string`, equal to that of `std::basic_string`.
+ *
+ *  Deliberately not `noexcept`: libstdc++ caches the hash codes of
+ *  hashes that may throw in unordered container nodes, as it does for
+ *  `std::string`, so rehashing and bucket scans never rehash the keys.
+ */
+template <typename Char, typename Traits, typename Alloc, typename Destructor>
+struct hash<itl::basic_string<Char, Traits, Alloc, Destructor>>
+{
+    size_t operator()(const itl::basic_string<Char, Traits, Alloc, Destructor> &x) const
+    {
+        return hash<std::basic_string<Char, Traits, Alloc>>()(x.ref());
+    }
+};
+
+}   /* std */
@@ -9,6 +9,11 @@
 #pragma once
 
 #include <unordered_map>
+#include <tuple>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
+#include "hashed.hpp"
 
 
 namespace itl
@@ -22,15 +27,17 @@ template <
     typename Value,
     typename Hash = std::hash<Key>,
     typename Pred = std::equal_to<Key>,
-    typename Alloc = std::allocator<std::pair<const Key, Value>>
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
 >
 /** \brief Inheritable STL unordered_map.
  */
-class unordered_map: protected std::unordered_map<Key, Value, Hash, Pred, Alloc>
+class unordered_map: protected std::unordered_map<Key, Value, Hash, Pred, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::unordered_map<Key, Value, Hash, Pred, Alloc> Base;
-    typedef unordered_map<Key, Value, Hash, Pred, Alloc> This;
+    typedef unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -39,16 +46,16 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename V, typename H, typename P, typename A>
-    friend void swap(unordered_map<K, V, H, P, A> &left, unordered_map<K, V, H, P, A> &right);
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend void swap(unordered_map<K, V, H, P, A, D> &left, unordered_map<K, V, H, P, A, D> &right);
 
     // RELATIONAL OPERATORS
     // --------------------
-    template <typename K, typename V, typename H, typename P, typename A>
-    friend bool operator==(const unordered_map<K, V, H, P, A> &left, const unordered_map<K, V, H, P, A> &right);
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator==(const unordered_map<K, V, H, P, A, D> &left, const unordered_map<K, V, H, P, A, D> &right);
 
-    template <typename K, typename V, typename H, typename P, typename A>
-    friend bool operator!=(const unordered_map<K, V, H, P, A> &left, const unordered_map<K, V, H, P, A> &right);
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator!=(const unordered_map<K, V, H, P, A, D> &left, const unordered_map<K, V, H, P, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -68,12 +75,23 @@ public:
     using typename Base::local_iterator;
     using typename Base::const_local_iterator;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+    using typename Base::insert_return_type;
+#endif
     using typename Base::difference_type;
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~unordered_map();
+    unordered_map();
+    unordered_map(const This &other);
+    unordered_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    unordered_map(const This &other, const allocator_type &alloc);
+    unordered_map(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~unordered_map();
 
     // CAPACITY
     using Base::empty;
@@ -94,6 +112,21 @@ public:
     using Base::find;
     using Base::count;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_unordered_lookup)
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
+    iterator find_hashed(const key_type &key, size_type hash);
+    const_iterator find_hashed(const key_type &key, size_type hash) const;
+    size_type count_hashed(const key_type &key, size_type hash) const;
 
     // MODIFIERS
     using Base::emplace;
@@ -101,8 +134,40 @@ public:
     using Base::insert;
     using Base::erase;
     using Base::clear;
+#if __cplusplus >= 201703L
+    using Base::try_emplace;
+    using Base::insert_or_assign;
+#else
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(const key_type &key, Ts&&... ts);
+    template <typename... Ts>
+    std::pair<iterator, bool> try_emplace(key_type &&key, Ts&&... ts);
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, const key_type &key, Ts&&... ts);
+    template <typename... Ts>
+    iterator try_emplace(const_iterator hint, key_type &&key, Ts&&... ts);
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const key_type &key, V &&value);
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(key_type &&key, V &&value);
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, const key_type &key, V &&value);
+    template <typename V>
+    iterator insert_or_assign(const_iterator hint, key_type &&key, V &&value);
+#endif
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
+    template <typename... Ts>
+    std::pair<iterator, bool> emplace_hashed(const key_type &key, size_type hash, Ts&&... ts);
+    template <typename... Ts>
+    std::pair<iterator, bool> emplace_hashed(key_type &&key, size_type hash, Ts&&... ts);
+    size_type erase_hashed(const key_type &key, size_type hash);
+
     // BUCKETS
     using Base::bucket_count;
     using Base::max_bucket_count;
@@ -127,15 +192,17 @@ template <
     typename Value,
     typename Hash = std::hash<Key>,
     typename Pred = std::equal_to<Key>,
-    typename Alloc = std::allocator<std::pair<const Key, Value>>
+    typename Alloc = std::allocator<std::pair<const Key, Value>>,
+    typename Destructor = virtual_destructor
 >
 /** \brief Inheritable STL unordered_multimap.
  */
-class unordered_multimap: protected std::unordered_multimap<Key, Value, Hash, Pred, Alloc>
+class unordered_multimap: protected std::unordered_multimap<Key, Value, Hash, Pred, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::unordered_multimap<Key, Value, Hash, Pred, Alloc> Base;
-    typedef unordered_multimap<Key, Value, Hash, Pred, Alloc> This;
+    typedef unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -144,16 +211,16 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename V, typename H, typename P, typename A>
-    friend void swap(unordered_multimap<K, V, H, P, A> &left, unordered_multimap<K, V, H, P, A> &right);
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend void swap(unordered_multimap<K, V, H, P, A, D> &left, unordered_multimap<K, V, H, P, A, D> &right);
 
     // RELATIONAL OPERATORS
     // --------------------
-    template <typename K, typename V, typename H, typename P, typename A>
-    friend bool operator==(const unordered_multimap<K, V, H, P, A> &left, const unordered_multimap<K, V, H, P, A> &right);
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator==(const unordered_multimap<K, V, H, P, A, D> &left, const unordered_multimap<K, V, H, P, A, D> &right);
 
-    template <typename K, typename V, typename H, typename P, typename A>
-    friend bool operator!=(const unordered_multimap<K, V, H, P, A> &left, const unordered_multimap<K, V, H, P, A> &right);
+    template <typename K, typename V, typename H, typename P, typename A, typename D>
+    friend bool operator!=(const unordered_multimap<K, V, H, P, A, D> &left, const unordered_multimap<K, V, H, P, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -173,12 +240,22 @@ public:
     using typename Base::local_iterator;
     using typename Base::const_local_iterator;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+#endif
     using typename Base::difference_type;
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~unordered_multimap();
+    unordered_multimap();
+    unordered_multimap(const This &other);
+    unordered_multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    unordered_multimap(const This &other, const allocator_type &alloc);
+    unordered_multimap(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~unordered_multimap();
 
     // CAPACITY
     using Base::empty;
@@ -195,6 +272,21 @@ public:
     using Base::find;
     using Base::count;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_unordered_lookup)
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
+    iterator find_hashed(const key_type &key, size_type hash);
+    const_iterator find_hashed(const key_type &key, size_type hash) const;
+    size_type count_hashed(const key_type &key, size_type hash) const;
 
     // MODIFIERS
     using Base::emplace;
@@ -202,8 +294,19 @@ public:
     using Base::insert;
     using Base::erase;
     using Base::clear;
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
+    template <typename... Ts>
+    iterator emplace_hashed(const key_type &key, size_type hash, Ts&&... ts);
+    template <typename... Ts>
+    iterator emplace_hashed(key_type &&key, size_type hash, Ts&&... ts);
+    size_type erase_hashed(const key_type &key, size_type hash);
+
     // BUCKETS
     using Base::bucket_count;
     using Base::max_bucket_count;
@@ -226,139 +329,724 @@ public:
 // --------------
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_map<Key, Value, Hash, Pred, Alloc>::ref() const
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_map<Key, Value, Hash, Pred, Alloc>::ref()
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_map<Key, Value, Hash, Pred, Alloc>::forward() const
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_map<Key, Value, Hash, Pred, Alloc>::forward()
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-void swap(unordered_map<Key, Value, Hash, Pred, Alloc> &left,
-    unordered_map<Key, Value, Hash, Pred, Alloc> &right)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void swap(unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-bool operator==(const unordered_map<Key, Value, Hash, Pred, Alloc> &left,
-    const unordered_map<Key, Value, Hash, Pred, Alloc> &right)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator==(const unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator==(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-bool operator!=(const unordered_map<Key, Value, Hash, Pred, Alloc> &left,
-    const unordered_map<Key, Value, Hash, Pred, Alloc> &right)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator!=(const unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_map<Key, Value, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator!=(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-unordered_map<Key, Value, Hash, Pred, Alloc>::~unordered_map()
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_map()
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_map(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_map(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_map(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_map(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
 {}
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-void unordered_map<Key, Value, Hash, Pred, Alloc>::swap(This &other)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::~unordered_map()
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and erase it from `other`.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    for (auto it = other.begin(); it != other.end();) {
+        if (Base::insert(*it).second) {
+            it = other.erase(it);
+        } else {
+            ++it;
+        }
+    }
+#endif
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if __cplusplus < 201703L
+
+/** \brief Construct a value in place, unless `key` is already present.
+ *
+ *  Unlike `emplace`, nothing is constructed for an existing key. This
+ *  is the standard C++17 member, provided for older libraries.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::try_emplace(const key_type &key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::find(key);
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(std::piecewise_construct,
+        std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(ts)...)).first, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::try_emplace(key_type &&key,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::find(key);
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(std::piecewise_construct,
+        std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(ts)...)).first, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::try_emplace(const_iterator,
+        const key_type &key,
+        Ts&&... ts)
+    -> iterator
+{
+    return try_emplace(key, std::forward<Ts>(ts)...).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::try_emplace(const_iterator,
+        key_type &&key,
+        Ts&&... ts)
+    -> iterator
+{
+    return try_emplace(std::move(key), std::forward<Ts>(ts)...).first;
+}
+
+
+/** \brief Assign to the value of `key`, or insert it if absent.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename V>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert_or_assign(const key_type &key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::find(key);
+    if (it != end()) {
+        it->second = std::forward<V>(value);
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(key, std::forward<V>(value)).first, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename V>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert_or_assign(key_type &&key,
+        V &&value)
+    -> std::pair<iterator, bool>
+{
+    iterator it = Base::find(key);
+    if (it != end()) {
+        it->second = std::forward<V>(value);
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(std::move(key), std::forward<V>(value)).first, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename V>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert_or_assign(const_iterator,
+        const key_type &key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(key, std::forward<V>(value)).first;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename V>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::insert_or_assign(const_iterator,
+        key_type &&key,
+        V &&value)
+    -> iterator
+{
+    return insert_or_assign(std::move(key), std::forward<V>(value)).first;
+}
+
+#endif
+
+
+#if !defined(__cpp_lib_generic_unordered_lookup)
+
+/** \brief Heterogeneous lookup, for a transparent hash and predicate.
+ *
+ *  Before C++20, std unordered containers only search by `key_type`,
+ *  so `key` is hashed once and its bucket scanned directly. Hits are
+ *  converted in place with libstdc++, and otherwise looked up again by
+ *  the stored key, which hashes that too. From C++20, the std
+ *  overloads search by `key` and these are not declared.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::count(const K &key) const
+    -> size_type
+{
+    return hashed::count(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return hashed::equal_range<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return hashed::equal_range<const_iterator>(ref(), key, hash_function()(key));
+}
+
+#endif
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::count_hashed(const key_type &key,
+        size_type hash) const
+    -> size_type
+{
+    return hashed::count(ref(), key, hash);
+}
+
+
+/** \brief Emplace a value for `key`, whose hash is `hash`, unless present.
+ *
+ *  Like `try_emplace`, `ts` construct the mapped value only once the
+ *  lookup by `hash` missed. The std table still hashes the new node,
+ *  since its buckets are not addressable.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_hashed(const key_type &key,
+        size_type hash,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = find_hashed(key, hash);
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(std::piecewise_construct,
+        std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(ts)...)).first, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_hashed(key_type &&key,
+        size_type hash,
+        Ts&&... ts)
+    -> std::pair<iterator, bool>
+{
+    iterator it = find_hashed(key, hash);
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(std::piecewise_construct,
+        std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(ts)...)).first, true);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_map<Key, Value, Hash, Pred, Alloc, Destructor>::erase_hashed(const key_type &key,
+        size_type hash)
+    -> size_type
 {
-    ref().swap(other.ref());
+    return hashed::erase(ref(), key, hash);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_multimap<Key, Value, Hash, Pred, Alloc>::ref() const
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_multimap<Key, Value, Hash, Pred, Alloc>::ref()
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_multimap<Key, Value, Hash, Pred, Alloc>::forward() const
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-auto unordered_multimap<Key, Value, Hash, Pred, Alloc>::forward()
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-void swap(unordered_multimap<Key, Value, Hash, Pred, Alloc> &left,
-    unordered_multimap<Key, Value, Hash, Pred, Alloc> &right)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void swap(unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-bool operator==(const unordered_multimap<Key, Value, Hash, Pred, Alloc> &left,
-    const unordered_multimap<Key, Value, Hash, Pred, Alloc> &right)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator==(const unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator==(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-bool operator!=(const unordered_multimap<Key, Value, Hash, Pred, Alloc> &left,
-    const unordered_multimap<Key, Value, Hash, Pred, Alloc> &right)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator!=(const unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator!=(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-unordered_multimap<Key, Value, Hash, Pred, Alloc>::~unordered_multimap()
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_multimap()
 {}
 
 
-template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc>
-void unordered_multimap<Key, Value, Hash, Pred, Alloc>::swap(This &other)
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_multimap(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_multimap(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_multimap(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::unordered_multimap(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::~unordered_multimap()
+{}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and clear `other`.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    Base::insert(other.begin(), other.end());
+    other.clear();
+#endif
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if !defined(__cpp_lib_generic_unordered_lookup)
+
+/** \brief Heterogeneous lookup, for a transparent hash and predicate.
+ *
+ *  Before C++20, std unordered containers only search by `key_type`,
+ *  so `key` is hashed once and its bucket scanned directly. Hits are
+ *  converted in place with libstdc++, and otherwise looked up again by
+ *  the stored key, which hashes that too. From C++20, the std
+ *  overloads search by `key` and these are not declared.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::count(const K &key) const
+    -> size_type
+{
+    return hashed::count(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return hashed::equal_range<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return hashed::equal_range<const_iterator>(ref(), key, hash_function()(key));
+}
+
+#endif
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::count_hashed(const key_type &key,
+        size_type hash) const
+    -> size_type
+{
+    return hashed::count(ref(), key, hash);
+}
+
+
+/** \brief Emplace a value for `key`, whose hash is `hash`.
+ *
+ *  The elements equivalent to `key`, found by `hash`, hint where the
+ *  new element goes, so the std table links it in beside them rather
+ *  than scanning the bucket. The std table still hashes the new node.
+ */
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_hashed(const key_type &key,
+        size_type hash,
+        Ts&&... ts)
+    -> iterator
 {
-    ref().swap(other.ref());
+    return Base::emplace_hint(find_hashed(key, hash), std::piecewise_construct,
+        std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Ts>(ts)...));
 }
 
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::emplace_hashed(key_type &&key,
+        size_type hash,
+        Ts&&... ts)
+    -> iterator
+{
+    return Base::emplace_hint(find_hashed(key, hash), std::piecewise_construct,
+        std::forward_as_tuple(std::move(key)), std::forward_as_tuple(std::forward<Ts>(ts)...));
+}
+
+
+template <typename Key, typename Value, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multimap<Key, Value, Hash, Pred, Alloc, Destructor>::erase_hashed(const key_type &key,
+        size_type hash)
+    -> size_type
+{
+    return hashed::erase(ref(), key, hash);
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using unordered_map = itl::unordered_map<Key, Value, Hash, Pred, Alloc, static_destructor>;
+
+
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<std::pair<const Key, Value>>
+>
+using unordered_multimap = itl::unordered_multimap<Key, Value, Hash, Pred, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>
+>
+using unordered_map = itl::unordered_map<Key, Value, Hash, Pred, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>
+>
+using unordered_multimap = itl::unordered_multimap<Key, Value, Hash, Pred, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
@@ -9,6 +9,10 @@
 #pragma once
 
 #include <unordered_set>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
+#include "hashed.hpp"
 
 
 namespace itl
@@ -23,13 +27,15 @@ template <
     typename Key,
     typename Hash = std::hash<Key>,
     typename Pred = std::equal_to<Key>,
-    typename Alloc = std::allocator<Key>
+    typename Alloc = std::allocator<Key>,
+    typename Destructor = virtual_destructor
 >
-class unordered_set: protected std::unordered_set<Key, Hash, Pred, Alloc>
+class unordered_set: protected std::unordered_set<Key, Hash, Pred, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::unordered_set<Key, Hash, Pred, Alloc> Base;
-    typedef unordered_set<Key, Hash, Pred, Alloc> This;
+    typedef unordered_set<Key, Hash, Pred, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -38,16 +44,16 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename H, typename P, typename A>
-    friend void swap(unordered_set<K, H, P, A> &left, unordered_set<K, H, P, A> &right);
+    template <typename K, typename H, typename P, typename A, typename D>
+    friend void swap(unordered_set<K, H, P, A, D> &left, unordered_set<K, H, P, A, D> &right);
 
     // RELATIONAL OPERATORS
     // --------------------
-    template <typename K, typename H, typename P, typename A>
-    friend bool operator==(const unordered_set<K, H, P, A> &left, const unordered_set<K, H, P, A> &right);
+    template <typename K, typename H, typename P, typename A, typename D>
+    friend bool operator==(const unordered_set<K, H, P, A, D> &left, const unordered_set<K, H, P, A, D> &right);
 
-    template <typename K, typename H, typename P, typename A>
-    friend bool operator!=(const unordered_set<K, H, P, A> &left, const unordered_set<K, H, P, A> &right);
+    template <typename K, typename H, typename P, typename A, typename D>
+    friend bool operator!=(const unordered_set<K, H, P, A, D> &left, const unordered_set<K, H, P, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -66,12 +72,23 @@ public:
     using typename Base::local_iterator;
     using typename Base::const_local_iterator;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+    using typename Base::insert_return_type;
+#endif
     using typename Base::difference_type;
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~unordered_set();
+    unordered_set();
+    unordered_set(const This &other);
+    unordered_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    unordered_set(const This &other, const allocator_type &alloc);
+    unordered_set(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~unordered_set();
 
     // CAPACITY
     using Base::empty;
@@ -88,6 +105,21 @@ public:
     using Base::find;
     using Base::count;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_unordered_lookup)
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
+    iterator find_hashed(const key_type &key, size_type hash);
+    const_iterator find_hashed(const key_type &key, size_type hash) const;
+    size_type count_hashed(const key_type &key, size_type hash) const;
 
     // MODIFIERS
     using Base::emplace;
@@ -95,8 +127,17 @@ public:
     using Base::insert;
     using Base::erase;
     using Base::clear;
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
+    std::pair<iterator, bool> emplace_hashed(const key_type &key, size_type hash);
+    std::pair<iterator, bool> emplace_hashed(key_type &&key, size_type hash);
+    size_type erase_hashed(const key_type &key, size_type hash);
+
     // BUCKETS
     using Base::bucket_count;
     using Base::max_bucket_count;
@@ -122,13 +163,15 @@ template <
     typename Key,
     typename Hash = std::hash<Key>,
     typename Pred = std::equal_to<Key>,
-    typename Alloc = std::allocator<Key>
+    typename Alloc = std::allocator<Key>,
+    typename Destructor = virtual_destructor
 >
-class unordered_multiset: protected std::unordered_multiset<Key, Hash, Pred, Alloc>
+class unordered_multiset: protected std::unordered_multiset<Key, Hash, Pred, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::unordered_multiset<Key, Hash, Pred, Alloc> Base;
-    typedef unordered_multiset<Key, Hash, Pred, Alloc> This;
+    typedef unordered_multiset<Key, Hash, Pred, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -137,16 +180,16 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename K, typename H, typename P, typename A>
-    friend void swap(unordered_multiset<K, H, P, A> &left, unordered_multiset<K, H, P, A> &right);
+    template <typename K, typename H, typename P, typename A, typename D>
+    friend void swap(unordered_multiset<K, H, P, A, D> &left, unordered_multiset<K, H, P, A, D> &right);
 
     // RELATIONAL OPERATORS
     // --------------------
-    template <typename K, typename H, typename P, typename A>
-    friend bool operator==(const unordered_multiset<K, H, P, A> &left, const unordered_multiset<K, H, P, A> &right);
+    template <typename K, typename H, typename P, typename A, typename D>
+    friend bool operator==(const unordered_multiset<K, H, P, A, D> &left, const unordered_multiset<K, H, P, A, D> &right);
 
-    template <typename K, typename H, typename P, typename A>
-    friend bool operator!=(const unordered_multiset<K, H, P, A> &left, const unordered_multiset<K, H, P, A> &right);
+    template <typename K, typename H, typename P, typename A, typename D>
+    friend bool operator!=(const unordered_multiset<K, H, P, A, D> &left, const unordered_multiset<K, H, P, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -165,12 +208,22 @@ public:
     using typename Base::local_iterator;
     using typename Base::const_local_iterator;
     using typename Base::size_type;
+#if defined(__cpp_lib_node_extract)
+    using typename Base::node_type;
+#endif
     using typename Base::difference_type;
 
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~unordered_multiset();
+    unordered_multiset();
+    unordered_multiset(const This &other);
+    unordered_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    unordered_multiset(const This &other, const allocator_type &alloc);
+    unordered_multiset(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~unordered_multiset();
 
     // CAPACITY
     using Base::empty;
@@ -187,6 +240,21 @@ public:
     using Base::find;
     using Base::count;
     using Base::equal_range;
+#if !defined(__cpp_lib_generic_unordered_lookup)
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    iterator find(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    const_iterator find(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    size_type count(const K &key) const;
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<iterator, iterator> equal_range(const K &key);
+    template <typename K, typename H = Hash, typename P = Pred, typename = typename H::is_transparent, typename = typename P::is_transparent>
+    std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+#endif
+    iterator find_hashed(const key_type &key, size_type hash);
+    const_iterator find_hashed(const key_type &key, size_type hash) const;
+    size_type count_hashed(const key_type &key, size_type hash) const;
 
     // MODIFIERS
     using Base::emplace;
@@ -194,8 +262,17 @@ public:
     using Base::insert;
     using Base::erase;
     using Base::clear;
+#if defined(__cpp_lib_node_extract)
+    using Base::extract;
+#endif
+    void merge(This &other);
+    void merge(This &&other);
     void swap(This &other);
 
+    iterator emplace_hashed(const key_type &key, size_type hash);
+    iterator emplace_hashed(key_type &&key, size_type hash);
+    size_type erase_hashed(const key_type &key, size_type hash);
+
     // BUCKETS
     using Base::bucket_count;
     using Base::max_bucket_count;
@@ -219,139 +296,593 @@ public:
 // --------------
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_set<Key, Hash, Pred, Alloc>::ref() const
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_set<Key, Hash, Pred, Alloc>::ref()
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_set<Key, Hash, Pred, Alloc>::forward() const
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_set<Key, Hash, Pred, Alloc>::forward()
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-void swap(unordered_set<Key, Hash, Pred, Alloc> &left,
-    unordered_set<Key, Hash, Pred, Alloc> &right)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void swap(unordered_set<Key, Hash, Pred, Alloc, Destructor> &left,
+    unordered_set<Key, Hash, Pred, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-bool operator==(const unordered_set<Key, Hash, Pred, Alloc> &left,
-    const unordered_set<Key, Hash, Pred, Alloc> &right)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator==(const unordered_set<Key, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_set<Key, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator==(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-bool operator!=(const unordered_set<Key, Hash, Pred, Alloc> &left,
-    const unordered_set<Key, Hash, Pred, Alloc> &right)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator!=(const unordered_set<Key, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_set<Key, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator!=(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-unordered_set<Key, Hash, Pred, Alloc>::~unordered_set()
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_set<Key, Hash, Pred, Alloc, Destructor>::unordered_set()
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_set<Key, Hash, Pred, Alloc, Destructor>::unordered_set(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_set<Key, Hash, Pred, Alloc, Destructor>::unordered_set(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_set<Key, Hash, Pred, Alloc, Destructor>::unordered_set(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_set<Key, Hash, Pred, Alloc, Destructor>::unordered_set(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_set<Key, Hash, Pred, Alloc, Destructor>::~unordered_set()
 {}
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-void unordered_set<Key, Hash, Pred, Alloc>::swap(This &other)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_set<Key, Hash, Pred, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move the elements of `other` whose keys are absent here.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and erase it from `other`.
+ */
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_set<Key, Hash, Pred, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    for (auto it = other.begin(); it != other.end();) {
+        if (Base::insert(*it).second) {
+            it = other.erase(it);
+        } else {
+            ++it;
+        }
+    }
+#endif
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_set<Key, Hash, Pred, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if !defined(__cpp_lib_generic_unordered_lookup)
+
+/** \brief Heterogeneous lookup, for a transparent hash and predicate.
+ *
+ *  Before C++20, std unordered containers only search by `key_type`,
+ *  so `key` is hashed once and its bucket scanned directly. Hits are
+ *  converted in place with libstdc++, and otherwise looked up again by
+ *  the stored key, which hashes that too. From C++20, the std
+ *  overloads search by `key` and these are not declared.
+ */
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::count(const K &key) const
+    -> size_type
 {
-    ref().swap(other.ref());
+    return hashed::count(ref(), key, hash_function()(key));
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_multiset<Key, Hash, Pred, Alloc>::ref() const
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return hashed::equal_range<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return hashed::equal_range<const_iterator>(ref(), key, hash_function()(key));
+}
+
+#endif
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::count_hashed(const key_type &key,
+        size_type hash) const
+    -> size_type
+{
+    return hashed::count(ref(), key, hash);
+}
+
+
+/** \brief Insert `key`, whose hash is `hash`, unless present.
+ *
+ *  `key` is only copied or moved into a node once the lookup by `hash`
+ *  missed. The std table still hashes the new node, since its buckets
+ *  are not addressable.
+ */
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::emplace_hashed(const key_type &key,
+        size_type hash)
+    -> std::pair<iterator, bool>
+{
+    iterator it = find_hashed(key, hash);
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(key).first, true);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::emplace_hashed(key_type &&key,
+        size_type hash)
+    -> std::pair<iterator, bool>
+{
+    iterator it = find_hashed(key, hash);
+    if (it != end()) {
+        return std::make_pair(it, false);
+    }
+    return std::make_pair(Base::emplace(std::move(key)).first, true);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_set<Key, Hash, Pred, Alloc, Destructor>::erase_hashed(const key_type &key,
+        size_type hash)
+    -> size_type
+{
+    return hashed::erase(ref(), key, hash);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_multiset<Key, Hash, Pred, Alloc>::ref()
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_multiset<Key, Hash, Pred, Alloc>::forward() const
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-auto unordered_multiset<Key, Hash, Pred, Alloc>::forward()
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-void swap(unordered_multiset<Key, Hash, Pred, Alloc> &left,
-    unordered_multiset<Key, Hash, Pred, Alloc> &right)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void swap(unordered_multiset<Key, Hash, Pred, Alloc, Destructor> &left,
+    unordered_multiset<Key, Hash, Pred, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-bool operator==(const unordered_multiset<Key, Hash, Pred, Alloc> &left,
-    const unordered_multiset<Key, Hash, Pred, Alloc> &right)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator==(const unordered_multiset<Key, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_multiset<Key, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator==(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-bool operator!=(const unordered_multiset<Key, Hash, Pred, Alloc> &left,
-    const unordered_multiset<Key, Hash, Pred, Alloc> &right)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+bool operator!=(const unordered_multiset<Key, Hash, Pred, Alloc, Destructor> &left,
+    const unordered_multiset<Key, Hash, Pred, Alloc, Destructor> &right)
 {
     return operator!=(left.ref(), right.ref());
 }
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-unordered_multiset<Key, Hash, Pred, Alloc>::~unordered_multiset()
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::unordered_multiset()
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::unordered_multiset(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::unordered_multiset(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
 {}
 
 
-template <typename Key, typename Hash, typename Pred, typename Alloc>
-void unordered_multiset<Key, Hash, Pred, Alloc>::swap(This &other)
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::unordered_multiset(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::unordered_multiset(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
 {
-    ref().swap(other.ref());
+    Base::operator=(other.forward());
+    return *this;
 }
 
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::~unordered_multiset()
+{}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+/** \brief Move every element of `other`.
+ *
+ *  With node handles, nodes are relinked without allocating. Older
+ *  libraries copy each element and clear `other`.
+ */
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::merge(This &other)
+{
+    if (&other == this) {
+        return;
+    }
+
+#if defined(__cpp_lib_node_extract)
+    Base::merge(other.ref());
+#else
+    Base::insert(other.begin(), other.end());
+    other.clear();
+#endif
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+void unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::merge(This &&other)
+{
+    merge(other);
+}
+
+
+#if !defined(__cpp_lib_generic_unordered_lookup)
+
+/** \brief Heterogeneous lookup, for a transparent hash and predicate.
+ *
+ *  Before C++20, std unordered containers only search by `key_type`,
+ *  so `key` is hashed once and its bucket scanned directly. Hits are
+ *  converted in place with libstdc++, and otherwise looked up again by
+ *  the stored key, which hashes that too. From C++20, the std
+ *  overloads search by `key` and these are not declared.
+ */
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::find(const K &key)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::find(const K &key) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::count(const K &key) const
+    -> size_type
+{
+    return hashed::count(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::equal_range(const K &key)
+    -> std::pair<iterator, iterator>
+{
+    return hashed::equal_range<iterator>(ref(), key, hash_function()(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+template <typename K, typename H, typename P, typename, typename>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::equal_range(const K &key) const
+    -> std::pair<const_iterator, const_iterator>
+{
+    return hashed::equal_range<const_iterator>(ref(), key, hash_function()(key));
+}
+
+#endif
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash)
+    -> iterator
+{
+    return hashed::find<iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::find_hashed(const key_type &key,
+        size_type hash) const
+    -> const_iterator
+{
+    return hashed::find<const_iterator>(ref(), key, hash);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::count_hashed(const key_type &key,
+        size_type hash) const
+    -> size_type
+{
+    return hashed::count(ref(), key, hash);
+}
+
+
+/** \brief Insert `key`, whose hash is `hash`.
+ *
+ *  The elements equivalent to `key`, found by `hash`, hint where the
+ *  new element goes, so the std table links it in beside them rather
+ *  than scanning the bucket. The std table still hashes the new node.
+ */
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::emplace_hashed(const key_type &key,
+        size_type hash)
+    -> iterator
+{
+    return Base::emplace_hint(find_hashed(key, hash), key);
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::emplace_hashed(key_type &&key,
+        size_type hash)
+    -> iterator
+{
+    return Base::emplace_hint(find_hashed(key, hash), std::move(key));
+}
+
+
+template <typename Key, typename Hash, typename Pred, typename Alloc, typename Destructor>
+auto unordered_multiset<Key, Hash, Pred, Alloc, Destructor>::erase_hashed(const key_type &key,
+        size_type hash)
+    -> size_type
+{
+    return hashed::erase(ref(), key, hash);
+}
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename Key,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<Key>
+>
+using unordered_set = itl::unordered_set<Key, Hash, Pred, Alloc, static_destructor>;
+
+
+template <
+    typename Key,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>,
+    typename Alloc = std::allocator<Key>
+>
+using unordered_multiset = itl::unordered_multiset<Key, Hash, Pred, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <
+    typename Key,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>
+>
+using unordered_set = itl::unordered_set<Key, Hash, Pred, std::pmr::polymorphic_allocator<Key>>;
+
+template <
+    typename Key,
+    typename Hash = std::hash<Key>,
+    typename Pred = std::equal_to<Key>
+>
+using unordered_multiset = itl::unordered_multiset<Key, Hash, Pred, std::pmr::polymorphic_allocator<Key>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
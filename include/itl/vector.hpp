@@ -8,7 +8,13 @@
 
 #pragma once
 
+#include <stdexcept>
 #include <vector>
+#include <type_traits>
+#include "allocator.hpp"
+#include "destructor.hpp"
+#include "relocate.hpp"
+#include "span.hpp"
 
 
 namespace itl
@@ -21,13 +27,15 @@ namespace itl
  */
 template <
     typename T,
-    typename Alloc = std::allocator<T>
+    typename Alloc = std::allocator<T>,
+    typename Destructor = virtual_destructor
 >
-class vector: protected std::vector<T, Alloc>
+class vector: protected std::vector<T, Alloc>,
+    protected Destructor
 {
 protected:
     typedef std::vector<T, Alloc> Base;
-    typedef vector<T, Alloc> This;
+    typedef vector<T, Alloc, Destructor> This;
 
     const Base & ref() const;
     Base & ref();
@@ -36,27 +44,27 @@ protected:
 
     // NON-MEMBER FUNCTIONS
     // --------------------
-    template <typename V, typename A>
-    friend void swap(vector<V, A> &left, vector<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend void swap(vector<V, A, D> &left, vector<V, A, D> &right);
 
     // RELATIONAL OPERATORS
-    template <typename V, typename A>
-    friend bool operator==(const vector<V, A> &left, const vector<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator==(const vector<V, A, D> &left, const vector<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator!=(const vector<V, A> &left, const vector<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator!=(const vector<V, A, D> &left, const vector<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>(const vector<V, A> &left, const vector<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>(const vector<V, A, D> &left, const vector<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator>=(const vector<V, A> &left, const vector<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator>=(const vector<V, A, D> &left, const vector<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<(const vector<V, A> &left, const vector<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<(const vector<V, A, D> &left, const vector<V, A, D> &right);
 
-    template <typename V, typename A>
-    friend bool operator<=(const vector<V, A> &left, const vector<V, A> &right);
+    template <typename V, typename A, typename D>
+    friend bool operator<=(const vector<V, A, D> &left, const vector<V, A, D> &right);
 
 public:
     // MEMBER TYPES
@@ -77,7 +85,14 @@ public:
     // MEMBER FUNCTIONS
     // ----------------
     using Base::Base;
-    virtual ~vector();
+    vector();
+    vector(const This &other);
+    vector(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value);
+    vector(const This &other, const allocator_type &alloc);
+    vector(This &&other, const allocator_type &alloc);
+    This & operator=(const This &other);
+    This & operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value);
+    ~vector();
 
     // ITERATORS
     using Base::begin;
@@ -93,8 +108,10 @@ public:
     using Base::size;
     using Base::max_size;
     using Base::resize;
+    void resize_default_init(size_type n);
     using Base::empty;
-    using Base::reserve;
+    void reserve(size_type n);
+    using Base::capacity;
     using Base::shrink_to_fit;
 
     // ELEMENT ACCESS
@@ -106,17 +123,42 @@ public:
 
     // MODIFIERS
     using Base::assign;
-    using Base::push_back;
+    void push_back(const value_type &value);
+    void push_back(value_type &&value);
     using Base::pop_back;
     using Base::insert;
     using Base::erase;
     using Base::clear;
     using Base::emplace;
-    using Base::emplace_back;
+    template <typename... Ts>
+    reference emplace_back(Ts&&... ts);
+    span<T> append_uninitialized(size_type n);
     void swap(This &other);
 
     // ALLOCATORS
     using Base::get_allocator;
+
+protected:
+    // GROWTH
+    // ------
+    // Only libstdc++ exposes the std::vector storage to derived classes,
+    // and only `std::allocator` has no construct side effects to skip.
+#if defined(__GLIBCXX__)
+    typedef std::integral_constant<bool,
+        is_trivially_relocatable<T>::value
+        && std::is_same<Alloc, std::allocator<T>>::value
+    > relocates;
+#else
+    typedef std::false_type relocates;
+#endif
+
+    void reserve(size_type n, std::true_type);
+    void reserve(size_type n, std::false_type);
+    template <typename... Ts>
+    void realloc_append(std::true_type, Ts&&... ts);
+    template <typename... Ts>
+    void realloc_append(std::false_type, Ts&&... ts);
+    void adopt(pointer first, size_type count) noexcept;
 };
 
 
@@ -124,103 +166,335 @@ public:
 // --------------
 
 
-template <typename T, typename Alloc>
-auto vector<T, Alloc>::ref() const
+template <typename T, typename Alloc, typename Destructor>
+auto vector<T, Alloc, Destructor>::ref() const
     -> const Base &
 {
     return static_cast<const Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto vector<T, Alloc>::ref()
+template <typename T, typename Alloc, typename Destructor>
+auto vector<T, Alloc, Destructor>::ref()
     -> Base &
 {
     return static_cast<Base&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto vector<T, Alloc>::forward() const
+template <typename T, typename Alloc, typename Destructor>
+auto vector<T, Alloc, Destructor>::forward() const
     -> const Base &&
 {
     return static_cast<const Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-auto vector<T, Alloc>::forward()
+template <typename T, typename Alloc, typename Destructor>
+auto vector<T, Alloc, Destructor>::forward()
     -> Base &&
 {
     return static_cast<Base&&>(*this);
 }
 
 
-template <typename T, typename Alloc>
-void swap(vector<T, Alloc> &left,
-    vector<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+void swap(vector<T, Alloc, Destructor> &left,
+    vector<T, Alloc, Destructor> &right)
 {
     left.swap(right);
 }
 
 
-template <typename T, typename Alloc>
-bool operator==(const vector<T, Alloc> &left,
-    const vector<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator==(const vector<T, Alloc, Destructor> &left,
+    const vector<T, Alloc, Destructor> &right)
 {
     return left.ref() == right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator!=(const vector<T, Alloc> &left,
-    const vector<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator!=(const vector<T, Alloc, Destructor> &left,
+    const vector<T, Alloc, Destructor> &right)
 {
     return left.ref() != right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>(const vector<T, Alloc> &left,
-    const vector<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>(const vector<T, Alloc, Destructor> &left,
+    const vector<T, Alloc, Destructor> &right)
 {
     return left.ref() > right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator>=(const vector<T, Alloc> &left,
-    const vector<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator>=(const vector<T, Alloc, Destructor> &left,
+    const vector<T, Alloc, Destructor> &right)
 {
     return left.ref() >= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<(const vector<T, Alloc> &left,
-    const vector<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<(const vector<T, Alloc, Destructor> &left,
+    const vector<T, Alloc, Destructor> &right)
 {
     return left.ref() < right.ref();
 }
 
 
-template <typename T, typename Alloc>
-bool operator<=(const vector<T, Alloc> &left,
-    const vector<T, Alloc> &right)
+template <typename T, typename Alloc, typename Destructor>
+bool operator<=(const vector<T, Alloc, Destructor> &left,
+    const vector<T, Alloc, Destructor> &right)
 {
     return left.ref() <= right.ref();
 }
 
 
-template <typename T, typename Alloc>
-vector<T, Alloc>::~vector()
+template <typename T, typename Alloc, typename Destructor>
+vector<T, Alloc, Destructor>::vector()
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+vector<T, Alloc, Destructor>::vector(const This &other):
+    Base(other.ref())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+vector<T, Alloc, Destructor>::vector(This &&other) noexcept(std::is_nothrow_move_constructible<Base>::value):
+    Base(other.forward())
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+vector<T, Alloc, Destructor>::vector(const This &other,
+        const allocator_type &alloc):
+    Base(other.ref(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+vector<T, Alloc, Destructor>::vector(This &&other,
+        const allocator_type &alloc):
+    Base(other.forward(), alloc)
+{}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto vector<T, Alloc, Destructor>::operator=(const This &other)
+    -> This &
+{
+    Base::operator=(other.ref());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+auto vector<T, Alloc, Destructor>::operator=(This &&other) noexcept(std::is_nothrow_move_assignable<Base>::value)
+    -> This &
+{
+    Base::operator=(other.forward());
+    return *this;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+vector<T, Alloc, Destructor>::~vector()
 {}
 
 
-template <typename T, typename Alloc>
-void vector<T, Alloc>::swap(This &other)
+/** \brief Resize the vector, default-initializing new elements.
+ *
+ *  `std::vector` constructs new elements through the allocator, which
+ *  value-initializes them, so only `Alloc = default_init_allocator<T>`
+ *  leaves them uninitialized. Other allocators fail to compile, rather
+ *  than silently zero-filling.
+ */
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::resize_default_init(size_type n)
+{
+    static_assert(is_default_init_allocator<Alloc>::value,
+        "resize_default_init requires Alloc = itl::default_init_allocator<T, ...>.");
+    Base::resize(n);
+}
+
+
+/** \brief Reserve storage for at least `n` elements.
+ *
+ *  Trivially relocatable elements move to the new storage with a
+ *  single memcpy, rather than a move and destroy per element.
+ */
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::reserve(size_type n)
+{
+    reserve(n, relocates());
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::reserve(size_type n,
+    std::true_type)
+{
+    if (n > max_size()) {
+        throw std::length_error("itl::vector::reserve");
+    }
+    if (n > capacity()) {
+        adopt(this->_M_allocate(n), n);
+    }
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::reserve(size_type n,
+    std::false_type)
+{
+    Base::reserve(n);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::push_back(const value_type &value)
+{
+    emplace_back(value);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::push_back(value_type &&value)
+{
+    emplace_back(std::move(value));
+}
+
+
+/** \brief Construct an element in place at the end of the vector.
+ *
+ *  Returns a reference to the new element, in every language mode.
+ */
+template <typename T, typename Alloc, typename Destructor>
+template <typename... Ts>
+auto vector<T, Alloc, Destructor>::emplace_back(Ts&&... ts)
+    -> reference
+{
+    if (relocates::value && size() == capacity()) {
+        realloc_append(relocates(), std::forward<Ts>(ts)...);
+    } else {
+        Base::emplace_back(std::forward<Ts>(ts)...);
+    }
+    return back();
+}
+
+
+/** \brief Append to a full vector, relocating into grown storage.
+ *
+ *  The new element is constructed before the old elements move, so
+ *  arguments may alias them, and a throw leaves the vector unchanged.
+ *  The growth factor matches `std::vector`.
+ */
+template <typename T, typename Alloc, typename Destructor>
+template <typename... Ts>
+void vector<T, Alloc, Destructor>::realloc_append(std::true_type,
+    Ts&&... ts)
+{
+    size_type n = size();
+    size_type count = this->_M_check_len(1, "itl::vector::realloc_append");
+    pointer first = this->_M_allocate(count);
+    try {
+        std::allocator_traits<Alloc>::construct(this->_M_get_Tp_allocator(),
+            first + n, std::forward<Ts>(ts)...);
+    } catch (...) {
+        this->_M_deallocate(first, count);
+        throw;
+    }
+    adopt(first, count);
+    ++this->_M_impl._M_finish;
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+template <typename... Ts>
+void vector<T, Alloc, Destructor>::realloc_append(std::false_type,
+    Ts&&... ts)
+{
+    Base::emplace_back(std::forward<Ts>(ts)...);
+}
+
+
+/** \brief Relocate the elements into `count` slots at `first`.
+ */
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::adopt(pointer first,
+    size_type count) noexcept
 {
-    ref().swap(other.ref());
+    auto &impl = this->_M_impl;
+    pointer last = uninitialized_relocate(impl._M_start, impl._M_finish, first);
+    this->_M_deallocate(impl._M_start, impl._M_end_of_storage - impl._M_start);
+    impl._M_start = first;
+    impl._M_finish = last;
+    impl._M_end_of_storage = first + count;
 }
 
+
+/** \brief Append `n` default-initialized elements for writing.
+ */
+template <typename T, typename Alloc, typename Destructor>
+auto vector<T, Alloc, Destructor>::append_uninitialized(size_type n)
+    -> span<T>
+{
+    size_type offset = size();
+    resize_default_init(offset + n);
+    return span<T>(data() + offset, n);
+}
+
+
+template <typename T, typename Alloc, typename Destructor>
+void vector<T, Alloc, Destructor>::swap(This &other)
+{
+    allocator_aware_swap(ref(), other.ref());
+}
+
+
+// TRAITS
+// ------
+
+
+template <typename T, typename Alloc, typename Destructor>
+struct is_trivially_relocatable<vector<T, Alloc, Destructor>>: is_trivially_relocatable<Alloc>
+{};
+
+
+// STATIC
+// ------
+
+namespace static_
+{
+
+template <
+    typename T,
+    typename Alloc = std::allocator<T>
+>
+using vector = itl::vector<T, Alloc, static_destructor>;
+
+}   /* static_ */
+
+
+// PMR
+// ---
+
+#if defined(ITL_HAS_PMR)
+
+namespace pmr
+{
+
+template <typename T>
+using vector = itl::vector<T, std::pmr::polymorphic_allocator<T>>;
+
+}   /* pmr */
+
+#endif
+
 }   /* itl */
@@ -0,0 +1,105 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/arena.hpp>
+
+#include <thread>
+
+// TESTS
+// -----
+
+
+TEST(arena, MemberFunctions)
+{
+    itl::arena arena(64);
+    void *x = arena.allocate(24, 8);
+    void *y = arena.allocate(1, 1);
+    void *z = arena.allocate(8, 16);
+    EXPECT_EQ(static_cast<char*>(y), static_cast<char*>(x) + 24);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(z) % 16, 0);
+
+    // only the most recent allocation is reclaimed
+    arena.deallocate(z, 8);
+    EXPECT_EQ(arena.allocate(8, 16), z);
+
+    // allocations larger than a chunk spill into a new chunk
+    void *large = arena.allocate(1024, 8);
+    EXPECT_NE(large, nullptr);
+
+    arena.release();
+    EXPECT_NE(arena.allocate(8, 8), nullptr);
+
+    // sizes that overflow with their alignment or chunk header
+    EXPECT_THROW(arena.allocate(SIZE_MAX - 4, 8), std::bad_alloc);
+    EXPECT_THROW(arena.allocate(SIZE_MAX - 20, 8), std::bad_alloc);
+    EXPECT_NE(arena.allocate(8, 8), nullptr);
+}
+
+
+TEST(arena, Scope)
+{
+    itl::arena request;
+    itl::arena &local = itl::arena::current();
+    {
+        itl::arena::scope scope(request);
+        EXPECT_EQ(&itl::arena::current(), &request);
+        itl::arena::vector<int> x = {1, 2, 3};
+        EXPECT_EQ(x.get_allocator().resource(), &request);
+    }
+    EXPECT_EQ(&itl::arena::current(), &local);
+
+    // every thread has its own arena
+    itl::arena *other = nullptr;
+    std::thread thread([&other]() {
+        other = &itl::arena::current();
+    });
+    thread.join();
+    EXPECT_NE(other, &local);
+}
+
+
+TEST(arena, Containers)
+{
+    itl::arena request;
+    itl::arena::scope scope(request);
+    {
+        itl::arena::vector<int> vector = {5, 4, 3, 2};
+        for (int i = 0; i < 100; ++i) {
+            vector.push_back(i);
+        }
+        EXPECT_EQ(vector.size(), 104);
+        EXPECT_EQ(vector.back(), 99);
+
+        itl::arena::string string(64, 'A');
+        itl::arena::map<int, itl::arena::string> map;
+        map[1] = string;
+        EXPECT_EQ(map[1].size(), 64);
+
+        itl::arena::unordered_map<int, int> unordered;
+        unordered[1] = 2;
+        EXPECT_EQ(unordered.at(1), 2);
+
+        itl::arena::set<int> set = {3, 1, 2};
+        EXPECT_EQ(*set.begin(), 1);
+
+        itl::arena::deque<int> deque = {1, 2};
+        itl::arena::list<int> list = {1, 2};
+        itl::arena::forward_list<int> forward_list = {1, 2};
+        itl::arena::queue<int> queue;
+        itl::arena::stack<int> stack;
+        queue.push(1);
+        stack.push(1);
+        EXPECT_EQ(deque.size() + list.size(), 4);
+
+        // copies share the arena of the allocator
+        itl::arena::vector<int> copy(vector);
+        EXPECT_EQ(copy, vector);
+    }
+    request.release();
+}
@@ -0,0 +1,356 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/btree_map.hpp>
+#include <itl/string.hpp>
+
+#include <iterator>
+#include <map>
+#include <stdexcept>
+
+// HELPERS
+// -------
+
+
+/** \brief Key counting its copies, whose copies throw on demand.
+ */
+struct counted_key
+{
+    static int copies;
+    static bool throwing;
+    int value;
+
+    counted_key(int value):
+        value(value)
+    {}
+
+    counted_key(const counted_key &other):
+        value(other.value)
+    {
+        if (throwing) {
+            throw std::runtime_error("counted_key: copy");
+        }
+        ++copies;
+    }
+
+    counted_key(counted_key &&other) noexcept:
+        value(other.value)
+    {}
+
+    counted_key & operator=(const counted_key &other) = default;
+
+    bool operator<(const counted_key &other) const
+    {
+        return value < other.value;
+    }
+};
+
+int counted_key::copies = 0;
+bool counted_key::throwing = false;
+
+
+/** \brief Key with only a copy constructor, which may throw.
+ */
+struct legacy_key
+{
+    static bool throwing;
+    int value;
+
+    legacy_key(int value):
+        value(value)
+    {}
+
+    legacy_key(const legacy_key &other):
+        value(other.value)
+    {
+        if (throwing) {
+            throw std::runtime_error("legacy_key: copy");
+        }
+    }
+
+    bool operator<(const legacy_key &other) const
+    {
+        return value < other.value;
+    }
+};
+
+bool legacy_key::throwing = false;
+
+// TESTS
+// -----
+
+
+TEST(btree_map, MemberFunctions)
+{
+    itl::btree_map<int, int> x = {{5, 4}, {3, 2}};
+    itl::btree_map<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_EQ(x.begin(), x.end());
+    EXPECT_EQ(y.at(5), 4);
+    EXPECT_THROW(y.at(4), std::out_of_range);
+    EXPECT_EQ(y.lower_bound(4)->first, 5);
+    EXPECT_EQ(y.upper_bound(3)->first, 5);
+    EXPECT_EQ(y.rbegin()->first, 5);
+    EXPECT_EQ(std::prev(y.rend())->first, 3);
+
+    EXPECT_TRUE(y.try_emplace(7, 8).second);
+    EXPECT_FALSE(y.insert_or_assign(7, 9).second);
+    EXPECT_EQ(y[7], 9);
+    auto it = y.emplace_hint(y.end(), 9, 10);
+    EXPECT_EQ(it->first, 9);
+    EXPECT_EQ(y.erase(7), 1);
+    EXPECT_EQ(y.erase(y.find(3))->first, 5);
+    EXPECT_EQ(y.size(), 2);
+}
+
+
+TEST(btree_map, NonMemberFunctions)
+{
+    itl::btree_map<int, int> x = {{0, 1}};
+    itl::btree_map<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x[2], 3);
+    EXPECT_EQ(y[0], 1);
+}
+
+
+TEST(btree_multimap, MemberFunctions)
+{
+    itl::btree_multimap<int, int> x = {{5, 4}, {3, 2}, {3, 1}};
+    itl::btree_multimap<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 3);
+    EXPECT_EQ(y.count(3), 2);
+
+    // equal keys keep their insertion order
+    auto range = y.equal_range(3);
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+    EXPECT_EQ(range.first->second, 2);
+    EXPECT_EQ(std::next(range.first)->second, 1);
+    EXPECT_EQ(y.erase(3), 2);
+    EXPECT_EQ(y.size(), 1);
+}
+
+
+TEST(btree_multimap, NonMemberFunctions)
+{
+    itl::btree_multimap<int, int> x = {{0, 1}};
+    itl::btree_multimap<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x.find(2)->second, 3);
+    EXPECT_EQ(y.find(0)->second, 1);
+}
+
+
+TEST(btree_map, MoveSemantics)
+{
+    itl::btree_map<itl::string, int> x = {{"a", 4}, {"b", 2}};
+    auto address = &*x.begin();
+    itl::btree_map<itl::string, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+    EXPECT_TRUE(x.empty());
+
+    itl::btree_map<itl::string, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+
+    itl::btree_map<itl::string, int> copy(z);
+    EXPECT_EQ(copy, z);
+}
+
+
+TEST(btree_multimap, MoveSemantics)
+{
+    itl::btree_multimap<int, int> x = {{5, 4}, {3, 2}};
+    auto address = &*x.begin();
+    itl::btree_multimap<int, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::btree_multimap<int, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(btree_map, Model)
+{
+    // random inserts, lookups and erases must agree with std::map
+    itl::btree_map<int, int> x;
+    std::map<int, int> y;
+    unsigned state = 1;
+    for (int i = 0; i < 200000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 5000);
+        switch ((state >> 4) % 4) {
+            case 0:
+                x[key] = i;
+                y[key] = i;
+                break;
+            case 1:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 2: {
+                auto it = x.lower_bound(key);
+                auto expected = y.lower_bound(key);
+                ASSERT_EQ(it == x.end(), expected == y.end());
+                if (expected != y.end()) {
+                    EXPECT_EQ(it->first, expected->first);
+                }
+                break;
+            }
+            case 3: {
+                // erase returns the following element
+                auto it = x.find(key);
+                auto expected = y.find(key);
+                ASSERT_EQ(it == x.end(), expected == y.end());
+                if (expected != y.end()) {
+                    it = x.erase(it);
+                    expected = y.erase(expected);
+                    ASSERT_EQ(it == x.end(), expected == y.end());
+                    if (expected != y.end()) {
+                        EXPECT_EQ(it->first, expected->first);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    ASSERT_EQ(x.size(), y.size());
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+    EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), y.rbegin()));
+
+    // sorted appends and erasing everything by iterator
+    itl::btree_map<int, int> z;
+    for (int i = 0; i < 100000; ++i) {
+        z.emplace_hint(z.end(), i, i);
+    }
+    auto it = z.begin();
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(it->first, i);
+        it = z.erase(it);
+    }
+    EXPECT_EQ(it, z.end());
+    EXPECT_TRUE(z.empty());
+}
+
+
+TEST(btree_map, Transparent)
+{
+    itl::btree_map<itl::string, int, itl::string_less> x = {{"a", 1}, {"b", 2}};
+    EXPECT_EQ(x.find("b")->second, 2);
+    EXPECT_EQ(x.count("c"), 0);
+    EXPECT_EQ(x.lower_bound("aa")->second, 2);
+}
+
+
+TEST(btree_map, Merge)
+{
+    itl::btree_map<int, int> x = {{1, 1}, {2, 2}};
+    itl::btree_map<int, int> y = {{2, 3}, {4, 4}};
+    x.merge(y);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x.at(2), 2);
+    EXPECT_EQ(y.size(), 1);
+    EXPECT_EQ(y.at(2), 3);
+}
+
+
+TEST(btree_map, Relocation)
+{
+    // descending inserts shift every value, which must move keys
+    itl::btree_map<counted_key, int> x;
+    for (int i = 1000; i > 0; --i) {
+        x.emplace(i, i);
+    }
+    EXPECT_EQ(counted_key::copies, 1000);
+    for (int i = 1; i <= 1000; i += 2) {
+        x.erase(i);
+    }
+    EXPECT_EQ(counted_key::copies, 1000);
+
+    // a throwing insert leaves the values in place
+    counted_key::throwing = true;
+    for (int key: {0, 3, 501, 2000}) {
+        EXPECT_THROW(x.emplace(key, key), std::runtime_error);
+    }
+    counted_key::throwing = false;
+    ASSERT_EQ(x.size(), 500);
+    int expected = 2;
+    for (const auto &item: x) {
+        ASSERT_EQ(item.first.value, expected);
+        expected += 2;
+    }
+    EXPECT_TRUE(x.emplace(3, 3).second);
+    EXPECT_EQ(x.size(), 501);
+
+    itl::btree_map<counted_key, int> empty;
+    counted_key::throwing = true;
+    EXPECT_THROW(empty.emplace(1, 1), std::runtime_error);
+    counted_key::throwing = false;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.begin(), empty.end());
+}
+
+
+TEST(btree_map, Boxed)
+{
+    // values that cannot move without throwing stay in place
+    itl::btree_map<legacy_key, int> x;
+    for (int i = 1000; i > 0; --i) {
+        x.emplace(i, i);
+    }
+    const int *address = &x.at(500);
+    for (int i = 1; i <= 1000; i += 2) {
+        x.erase(i);
+    }
+    EXPECT_EQ(&x.at(500), address);
+    EXPECT_EQ(x.size(), 500);
+
+    legacy_key::throwing = true;
+    for (int key: {0, 3, 501, 2000}) {
+        EXPECT_THROW(x.emplace(key, key), std::runtime_error);
+    }
+    legacy_key::throwing = false;
+    ASSERT_EQ(x.size(), 500);
+    int expected = 2;
+    for (const auto &item: x) {
+        ASSERT_EQ(item.first.value, expected);
+        expected += 2;
+    }
+
+    itl::btree_map<legacy_key, int> y(x);
+    EXPECT_EQ(y.size(), 500);
+    y.merge(x);
+    EXPECT_EQ(x.size(), 500);
+    y.clear();
+    y.merge(x);
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(y.at(1000), 1000);
+}
@@ -0,0 +1,126 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/btree_set.hpp>
+
+#include <iterator>
+#include <set>
+
+
+TEST(btree_set, MemberFunctions)
+{
+    itl::btree_set<int> x = {5, 4, 3, 2};
+    itl::btree_set<int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 4);
+    EXPECT_FALSE(y.insert(3).second);
+    EXPECT_EQ(*y.lower_bound(1), 2);
+    EXPECT_EQ(y.upper_bound(5), y.end());
+    EXPECT_EQ(*y.rbegin(), 5);
+}
+
+
+TEST(btree_set, NonMemberFunctions)
+{
+    itl::btree_set<int> x = {0, 1};
+    itl::btree_set<int> y = {2, 3};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(*x.begin(), 2);
+    EXPECT_EQ(*y.begin(), 0);
+}
+
+
+TEST(btree_multiset, MemberFunctions)
+{
+    itl::btree_multiset<int> x = {5, 4, 3, 3};
+    itl::btree_multiset<int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 4);
+    EXPECT_EQ(y.count(3), 2);
+    EXPECT_EQ(*y.insert(3), 3);
+    EXPECT_EQ(y.count(3), 3);
+}
+
+
+TEST(btree_multiset, NonMemberFunctions)
+{
+    itl::btree_multiset<int> x = {0, 1};
+    itl::btree_multiset<int> y = {2, 3};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(*x.begin(), 2);
+    EXPECT_EQ(*y.begin(), 0);
+}
+
+
+TEST(btree_set, MoveSemantics)
+{
+    itl::btree_set<int> x = {5, 4, 3, 2};
+    auto address = &*x.begin();
+    itl::btree_set<int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::btree_set<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(btree_multiset, Model)
+{
+    // random inserts and erases must agree with std::multiset
+    itl::btree_multiset<int> x;
+    std::multiset<int> y;
+    unsigned state = 7;
+    for (int i = 0; i < 200000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 2000);
+        switch ((state >> 4) % 3) {
+            case 0:
+                x.insert(key);
+                y.insert(key);
+                break;
+            case 1:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 2:
+                EXPECT_EQ(x.count(key), y.count(key));
+                break;
+        }
+    }
+    ASSERT_EQ(x.size(), y.size());
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+    EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), y.rbegin()));
+
+    auto first = x.lower_bound(500);
+    auto last = x.upper_bound(1500);
+    auto it = x.erase(first, last);
+    y.erase(y.lower_bound(500), y.upper_bound(1500));
+    EXPECT_EQ(*it, *y.upper_bound(1500));
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+}
@@ -0,0 +1,211 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/concurrent_map.hpp>
+#include <itl/concurrent_set.hpp>
+#include <itl/string.hpp>
+
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+// TESTS
+// -----
+
+
+TEST(concurrent_map, MemberFunctions)
+{
+    itl::concurrent_map<int, itl::string> x = {{3, "c"}, {1, "a"}};
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_FALSE(x.empty());
+
+    EXPECT_TRUE(x.insert({2, "b"}).second);
+    auto result = x.emplace(2, "z");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first->second, "b");
+    EXPECT_EQ(x.count(2), 1);
+    EXPECT_EQ(x.find(4), x.end());
+    EXPECT_EQ(x.find(3)->second, "c");
+    EXPECT_EQ(x.lower_bound(2)->first, 2);
+    EXPECT_EQ(x.upper_bound(2)->first, 3);
+    EXPECT_EQ(x.upper_bound(3), x.end());
+
+    std::vector<int> keys;
+    for (const auto &item: x) {
+        keys.push_back(item.first);
+    }
+    EXPECT_EQ(keys, std::vector<int>({1, 2, 3}));
+
+    // an iterator keeps its element alive past an erase
+    auto it = x.find(2);
+    EXPECT_EQ(x.erase(2), 1);
+    EXPECT_EQ(x.erase(2), 0);
+    EXPECT_EQ(it->second, "b");
+    EXPECT_EQ((++it)->first, 3);
+    EXPECT_EQ(x.size(), 2);
+
+    x.clear();
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(x.begin(), x.end());
+}
+
+
+TEST(concurrent_set, MemberFunctions)
+{
+    itl::concurrent_set<int, std::greater<int>> x = {1, 5, 3};
+    EXPECT_EQ(*x.begin(), 5);
+    EXPECT_EQ(*x.lower_bound(4), 3);
+    EXPECT_FALSE(x.insert(3).second);
+    EXPECT_EQ(x.erase(5), 1);
+    EXPECT_EQ(*x.begin(), 3);
+}
+
+
+TEST(concurrent_map, Iterators)
+{
+    // one thread holds more iterators than there are epoch slots
+    itl::concurrent_map<int, int> x;
+    for (int i = 0; i < 5000; ++i) {
+        x.insert({i, -i});
+    }
+    std::vector<itl::concurrent_map<int, int>::iterator> its;
+    for (int i = 0; i < 5000; ++i) {
+        its.push_back(x.find(i));
+    }
+    std::vector<itl::concurrent_map<int, int>::iterator> copies(its);
+
+    // erased elements stay alive while any iterator pins them
+    for (int i = 0; i < 5000; i += 2) {
+        EXPECT_EQ(x.erase(i), 1);
+    }
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_EQ(its[i]->first, i);
+        EXPECT_EQ(copies[i]->second, -i);
+    }
+    its.clear();
+    copies.clear();
+    EXPECT_EQ(x.size(), 2500);
+    EXPECT_TRUE(x.insert({0, 0}).second);
+    EXPECT_EQ(x.find(1)->second, -1);
+}
+
+
+TEST(concurrent_map, Model)
+{
+    // a single thread must agree with std::map
+    itl::concurrent_map<int, int> x;
+    std::map<int, int> y;
+    unsigned state = 3;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 2000);
+        switch ((state >> 4) % 3) {
+            case 0:
+                EXPECT_EQ(x.insert({key, i}).second, y.insert({key, i}).second);
+                break;
+            case 1:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 2: {
+                auto it = x.lower_bound(key);
+                auto expected = y.lower_bound(key);
+                ASSERT_EQ(it == x.end(), expected == y.end());
+                if (expected != y.end()) {
+                    EXPECT_EQ(it->first, expected->first);
+                    EXPECT_EQ(it->second, expected->second);
+                }
+                break;
+            }
+        }
+    }
+    EXPECT_EQ(x.size(), y.size());
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+}
+
+
+TEST(concurrent_map, Threads)
+{
+    // writers insert and erase disjoint keys while readers scan
+    itl::concurrent_map<int, int> x;
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 2; ++t) {
+        readers.emplace_back([&x, &done]() {
+            while (!done.load()) {
+                int previous = -1;
+                for (const auto &item: x) {
+                    // scans stay sorted and see consistent values
+                    ASSERT_LT(previous, item.first);
+                    ASSERT_EQ(item.second, item.first * 2);
+                    previous = item.first;
+                }
+            }
+        });
+    }
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&x, t]() {
+            for (int round = 0; round < 3; ++round) {
+                for (int i = t; i < 8000; i += 4) {
+                    x.insert({i, i * 2});
+                }
+                for (int i = t; i < 8000; i += 8) {
+                    x.erase(i);
+                }
+            }
+        });
+    }
+    for (auto &thread: writers) {
+        thread.join();
+    }
+    done.store(true);
+    for (auto &thread: readers) {
+        thread.join();
+    }
+
+    EXPECT_EQ(x.size(), 4000);
+    size_t count = 0;
+    for (const auto &item: x) {
+        EXPECT_EQ(item.first % 8 >= 4, true);
+        ++count;
+    }
+    EXPECT_EQ(count, 4000);
+}
+
+
+TEST(concurrent_map, Contention)
+{
+    // every thread races on the same keys
+    itl::concurrent_map<int, int> x;
+    std::atomic<size_t> inserted(0);
+    std::atomic<size_t> erased(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 20000; ++i) {
+                int key = i % 64;
+                if (x.insert({key, key}).second) {
+                    ++inserted;
+                }
+                erased += x.erase((key + 17) % 64);
+                auto it = x.find(key);
+                if (it != x.end()) {
+                    EXPECT_EQ(it->second, key);
+                }
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    EXPECT_EQ(inserted.load() - erased.load(), x.size());
+    EXPECT_EQ(static_cast<size_t>(std::distance(x.begin(), x.end())), x.size());
+}
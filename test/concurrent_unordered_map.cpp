@@ -0,0 +1,100 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/concurrent_unordered_map.hpp>
+
+#include <thread>
+#include <vector>
+
+// TESTS
+// -----
+
+
+TEST(concurrent_unordered_map, MemberFunctions)
+{
+    itl::concurrent_unordered_map<int, int> x(3);
+    EXPECT_EQ(x.shard_count(), 4);
+    EXPECT_TRUE(x.empty());
+
+    EXPECT_TRUE(x.insert({1, 2}));
+    EXPECT_FALSE(x.insert({1, 3}));
+    EXPECT_TRUE(x.emplace(2, 4));
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_EQ(x.count(1), 1);
+
+    int value = 0;
+    EXPECT_TRUE(x.find_and(1, [&value](const std::pair<const int, int> &item) {
+        value = item.second;
+    }));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(x.find_and(3, [](const std::pair<const int, int> &) {}));
+
+    EXPECT_TRUE(x.find_and_update(1, [](std::pair<const int, int> &item) {
+        item.second = 5;
+    }));
+    EXPECT_FALSE(x.insert_or_visit({1, 0}, [](std::pair<const int, int> &item) {
+        ++item.second;
+    }));
+    EXPECT_FALSE(x.insert_or_assign(2, 7));
+    x.find_and(1, [&value](const std::pair<const int, int> &item) {
+        value = item.second;
+    });
+    EXPECT_EQ(value, 6);
+
+    int sum = 0;
+    x.for_each([&sum](const std::pair<const int, int> &item) {
+        sum += item.second;
+    });
+    EXPECT_EQ(sum, 13);
+
+    EXPECT_FALSE(x.erase_if(1, [](const std::pair<const int, int> &item) {
+        return item.second != 6;
+    }));
+    EXPECT_TRUE(x.erase_if(1, [](const std::pair<const int, int> &item) {
+        return item.second == 6;
+    }));
+    EXPECT_EQ(x.erase(2), 1);
+    EXPECT_TRUE(x.empty());
+}
+
+
+TEST(concurrent_unordered_map, Threads)
+{
+    itl::concurrent_unordered_map<int, int> x;
+    x.reserve(4000);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&x]() {
+            for (int i = 0; i < 4000; ++i) {
+                x.insert_or_visit({i, 1}, [](std::pair<const int, int> &item) {
+                    ++item.second;
+                });
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(x.size(), 4000);
+    size_t total = 0;
+    x.for_each([&total](const std::pair<const int, int> &item) {
+        total += static_cast<size_t>(item.second);
+    });
+    EXPECT_EQ(total, 8 * 4000);
+
+    size_t erased = x.erase_if([](const std::pair<const int, int> &item) {
+        return item.first % 2 == 0;
+    });
+    EXPECT_EQ(erased, 2000);
+    EXPECT_EQ(x.size(), 2000);
+    x.clear();
+    EXPECT_TRUE(x.empty());
+}
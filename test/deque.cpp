@@ -40,3 +40,21 @@ TEST(deque, NonMemberFunctions)
     EXPECT_EQ(x[0], 2);
     EXPECT_EQ(y[0], 1);
 }
+
+
+TEST(deque, MoveSemantics)
+{
+    typedef itl::deque<int> Itl;
+    typedef std::deque<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::deque<int> x = {5, 4, 3, 2};
+    auto address = &x.front();
+    itl::deque<int> y(std::move(x));
+    EXPECT_EQ(&y.front(), address);
+
+    itl::deque<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&z.front(), address);
+}
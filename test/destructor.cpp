@@ -0,0 +1,106 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/map.hpp>
+#include <itl/string.hpp>
+#include <itl/unordered_map.hpp>
+#include <itl/vector.hpp>
+
+#include <type_traits>
+#include <utility>
+
+// HELPERS
+// -------
+
+
+template <typename T, typename = void>
+struct is_deletable: std::false_type
+{};
+
+
+template <typename T>
+struct is_deletable<T, decltype(delete std::declval<T*>())>: std::true_type
+{};
+
+
+// opts back in to the heap by hiding the policy's deleted operators
+struct heap_vector: itl::static_::vector<int>
+{
+    static void * operator new(std::size_t size)
+    {
+        return ::operator new(size);
+    }
+
+    static void operator delete(void *ptr)
+    {
+        ::operator delete(ptr);
+    }
+};
+
+// TESTS
+// -----
+
+
+TEST(static_destructor, Layout)
+{
+    EXPECT_EQ(sizeof(itl::static_::vector<int>), sizeof(std::vector<int>));
+    EXPECT_EQ(sizeof(itl::static_::string), sizeof(std::string));
+    EXPECT_EQ(sizeof(itl::static_::map<int, int>), sizeof(std::map<int, int>));
+    EXPECT_GT(sizeof(itl::vector<int>), sizeof(std::vector<int>));
+
+    EXPECT_FALSE(std::is_polymorphic<itl::static_::vector<int>>::value);
+    EXPECT_FALSE(std::is_polymorphic<itl::static_::string>::value);
+    EXPECT_TRUE(std::is_polymorphic<itl::vector<int>>::value);
+    EXPECT_TRUE(std::has_virtual_destructor<itl::string>::value);
+}
+
+
+TEST(static_destructor, Delete)
+{
+    EXPECT_FALSE(is_deletable<itl::static_::vector<int>>::value);
+    EXPECT_FALSE(is_deletable<itl::static_::string>::value);
+    EXPECT_TRUE(is_deletable<itl::vector<int>>::value);
+    EXPECT_TRUE(is_deletable<itl::string>::value);
+
+    // derived classes inherit the restriction unless they opt out
+    struct derived: itl::static_::vector<int>
+    {};
+    EXPECT_FALSE(is_deletable<derived>::value);
+    EXPECT_TRUE(is_deletable<heap_vector>::value);
+
+    heap_vector *ptr = new heap_vector;
+    EXPECT_TRUE(ptr->empty());
+    delete ptr;
+}
+
+
+TEST(static_destructor, MemberFunctions)
+{
+    itl::static_::vector<int> x = {5, 4, 3, 2};
+    itl::static_::vector<int> y;
+    x.swap(y);
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 4);
+
+    itl::static_::unordered_map<itl::static_::string, int> map;
+    map.emplace("key", 1);
+    EXPECT_EQ(map.size(), 1);
+}
+
+
+TEST(static_destructor, NonMemberFunctions)
+{
+    itl::static_::string x = "a";
+    itl::static_::string y = "b";
+    EXPECT_TRUE(x < y);
+
+    std::swap(x, y);
+    EXPECT_EQ(x, "b");
+    EXPECT_EQ(y, "a");
+}
@@ -0,0 +1,291 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/flat_hash_map.hpp>
+#include <itl/string.hpp>
+
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+// counts copies, and throws from them on request
+template <bool NothrowMove>
+struct counted_key
+{
+    static int copies;
+    static bool throwing;
+    int value;
+
+    counted_key(int value):
+        value(value)
+    {}
+
+    counted_key(const counted_key &other):
+        value(other.value)
+    {
+        if (throwing) {
+            throw std::runtime_error("counted_key: copy");
+        }
+        ++copies;
+    }
+
+    counted_key(counted_key &&other) noexcept(NothrowMove):
+        value(other.value)
+    {
+        if (!NothrowMove) {
+            ++copies;
+        }
+    }
+
+    bool operator==(const counted_key &other) const
+    {
+        return value == other.value;
+    }
+};
+
+template <bool NothrowMove>
+int counted_key<NothrowMove>::copies = 0;
+
+template <bool NothrowMove>
+bool counted_key<NothrowMove>::throwing = false;
+
+
+struct counted_hash
+{
+    template <bool NothrowMove>
+    size_t operator()(const counted_key<NothrowMove> &key) const
+    {
+        return std::hash<int>()(key.value);
+    }
+};
+
+// TESTS
+// -----
+
+
+TEST(flat_hash_map, MemberFunctions)
+{
+    itl::flat_hash_map<int, int> x = {{5, 4}, {3, 2}};
+    itl::flat_hash_map<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_EQ(y.at(5), 4);
+    EXPECT_THROW(y.at(4), std::out_of_range);
+    EXPECT_EQ(y.count(3), 1);
+    EXPECT_EQ(y.count(4), 0);
+    EXPECT_EQ(x.find(3), x.end());
+    EXPECT_EQ(std::distance(y.begin(), y.end()), 2);
+
+    auto range = y.equal_range(3);
+    EXPECT_EQ(std::distance(range.first, range.second), 1);
+    EXPECT_EQ(range.first->second, 2);
+
+    EXPECT_FALSE(y.emplace(3, 7).second);
+    EXPECT_TRUE(y.insert({7, 8}).second);
+    EXPECT_EQ(y[7], 8);
+    EXPECT_EQ(y.erase(7), 1);
+    EXPECT_EQ(y.erase(7), 0);
+    EXPECT_LE(y.load_factor(), y.max_load_factor());
+
+    y.clear();
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(y.begin(), y.end());
+}
+
+
+TEST(flat_hash_map, NonMemberFunctions)
+{
+    itl::flat_hash_map<int, int> x = {{0, 1}};
+    itl::flat_hash_map<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x[2], 3);
+    EXPECT_EQ(y[0], 1);
+}
+
+
+TEST(flat_hash_map, MoveSemantics)
+{
+    itl::flat_hash_map<itl::string, int> x;
+    x["key"] = 1;
+    auto address = &*x.begin();
+    itl::flat_hash_map<itl::string, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+    EXPECT_TRUE(x.empty());
+
+    itl::flat_hash_map<itl::string, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+
+    itl::flat_hash_map<itl::string, int> copy(z);
+    EXPECT_EQ(copy, z);
+}
+
+
+TEST(flat_hash_map, Allocators)
+{
+#if defined(ITL_HAS_PMR)
+    typedef std::pmr::polymorphic_allocator<std::pair<const itl::string, int>> allocator;
+    typedef itl::flat_hash_map<itl::string, int, std::hash<itl::string>, std::equal_to<itl::string>, allocator> pmr_map;
+    std::pmr::unsynchronized_pool_resource first;
+    std::pmr::unsynchronized_pool_resource second;
+    pmr_map x(&first);
+    pmr_map y(&second);
+    pmr_map z(&second);
+    for (int i = 0; i < 100; ++i) {
+        x[std::to_string(i).c_str()] = i;
+    }
+
+    // unequal allocators do not propagate, so elements move one by one
+    y = std::move(x);
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(y.get_allocator().resource(), &second);
+    EXPECT_EQ(y.size(), 100);
+    EXPECT_EQ(y.at("42"), 42);
+
+    // equal allocators hand the table over
+    auto address = &*y.begin();
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+    EXPECT_EQ(z.get_allocator().resource(), &second);
+    EXPECT_FALSE(std::is_nothrow_move_assignable<pmr_map>::value);
+
+    // copies and swaps keep each map's allocator
+    pmr_map w(&first);
+    w = z;
+    EXPECT_EQ(w, z);
+    EXPECT_EQ(w.get_allocator().resource(), &first);
+    w["extra"] = 1;
+    swap(w, z);
+    EXPECT_EQ(z.size(), 101);
+    EXPECT_EQ(w.size(), 100);
+    EXPECT_EQ(z.get_allocator().resource(), &second);
+    EXPECT_EQ(w.get_allocator().resource(), &first);
+    x = w;
+    x.swap(w);
+    EXPECT_EQ(x, w);
+#endif
+    EXPECT_TRUE((std::is_nothrow_move_assignable<itl::flat_hash_map<int, int>>::value));
+    EXPECT_TRUE(noexcept(std::declval<itl::flat_hash_map<int, int>&>().swap(std::declval<itl::flat_hash_map<int, int>&>())));
+}
+
+
+TEST(flat_hash_map, Relocation)
+{
+    // keys move between tables as the map grows
+    typedef counted_key<true> key;
+    itl::flat_hash_map<key, itl::string, counted_hash> x;
+    key::copies = 0;
+    for (int i = 0; i < 1000; ++i) {
+        x.emplace(key(i), "value");
+    }
+    EXPECT_EQ(key::copies, 0);
+    EXPECT_EQ(x.size(), 1000);
+    EXPECT_EQ(x.at(key(999)), "value");
+
+    // keys whose move may throw are copied, and a throw keeps the table
+    typedef counted_key<false> fragile;
+    itl::flat_hash_map<fragile, int, counted_hash> y;
+    for (int i = 0; i < 14; ++i) {
+        y.emplace(fragile(i), i);
+    }
+    ASSERT_EQ(y.bucket_count(), 15);
+    fragile::throwing = true;
+    EXPECT_THROW(y.emplace(fragile(14), 14), std::runtime_error);
+    fragile::throwing = false;
+    EXPECT_EQ(y.size(), 14);
+    EXPECT_EQ(y.bucket_count(), 15);
+    EXPECT_EQ(std::distance(y.begin(), y.end()), 14);
+    for (int i = 0; i < 14; ++i) {
+        EXPECT_EQ(y.at(fragile(i)), i);
+    }
+    EXPECT_TRUE(y.emplace(fragile(14), 14).second);
+    EXPECT_EQ(y.size(), 15);
+}
+
+
+TEST(flat_hash_map, Model)
+{
+    // random inserts and erases must agree with std::unordered_map
+    itl::flat_hash_map<int, int> x;
+    std::unordered_map<int, int> y;
+    unsigned state = 1;
+    for (int i = 0; i < 200000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 5000);
+        switch ((state >> 4) % 3) {
+            case 0:
+                x[key] = i;
+                y[key] = i;
+                break;
+            case 1:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 2:
+                EXPECT_EQ(x.count(key), y.count(key));
+                break;
+        }
+    }
+    EXPECT_EQ(x.size(), y.size());
+    for (const auto &value: y) {
+        EXPECT_EQ(x.at(value.first), value.second);
+    }
+
+    size_t count = 0;
+    for (auto it = x.begin(); it != x.end();) {
+        it = it->first % 2 ? x.erase(it) : std::next(it);
+        ++count;
+    }
+    EXPECT_EQ(count, y.size());
+    for (const auto &value: x) {
+        EXPECT_EQ(value.first % 2, 0);
+    }
+
+    x.reserve(100000);
+    EXPECT_GE(x.bucket_count() * 7 / 8, 100000);
+    x.rehash(0);
+    EXPECT_LT(x.bucket_count(), 100000);
+}
+
+
+TEST(flat_hash_map, FindBatch)
+{
+    itl::flat_hash_map<int, int> x;
+    std::vector<int> keys;
+    for (int i = 0; i < 1000; ++i) {
+        x.emplace(i, -i);
+        keys.push_back(2 * i);
+    }
+
+    std::vector<itl::flat_hash_map<int, int>::iterator> found;
+    x.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+    ASSERT_EQ(found.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(found[i], x.find(keys[i]));
+    }
+
+    const auto &y = x;
+    itl::flat_hash_map<int, int> z;
+    std::vector<itl::flat_hash_map<int, int>::const_iterator> missing(2);
+    y.find_batch(keys.begin() + 500, keys.begin() + 502, missing.begin());
+    EXPECT_EQ(missing[0], y.end());
+    EXPECT_EQ(missing[1], y.end());
+    z.find_batch(keys.begin(), keys.begin() + 1, missing.begin());
+    EXPECT_EQ(missing[0], z.end());
+}
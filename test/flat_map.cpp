@@ -0,0 +1,245 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/flat_map.hpp>
+#include <itl/string.hpp>
+
+#include <iterator>
+#include <map>
+#include <vector>
+
+
+TEST(flat_map, MemberFunctions)
+{
+    itl::flat_map<int, int> x = {{5, 4}, {3, 2}};
+    itl::flat_map<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_EQ(x.begin(), x.end());
+    EXPECT_EQ(y.at(5), 4);
+    EXPECT_THROW(y.at(4), std::out_of_range);
+    EXPECT_EQ(y.lower_bound(4)->first, 5);
+    EXPECT_EQ(y.upper_bound(3)->first, 5);
+    EXPECT_EQ((*y.rbegin()).first, 5);
+    EXPECT_EQ((*std::prev(y.rend())).first, 3);
+    EXPECT_EQ(y.end() - y.begin(), 2);
+
+    EXPECT_TRUE(y.try_emplace(7, 8).second);
+    EXPECT_FALSE(y.insert_or_assign(7, 9).second);
+    EXPECT_EQ(y[7], 9);
+    auto it = y.emplace_hint(y.end(), 9, 10);
+    EXPECT_EQ(it->first, 9);
+    it->second = 11;
+    EXPECT_EQ(y.at(9), 11);
+    EXPECT_EQ(y.erase(7), 1);
+    EXPECT_EQ(y.erase(y.find(3))->first, 5);
+    EXPECT_EQ(y.size(), 2);
+}
+
+
+TEST(flat_map, NonMemberFunctions)
+{
+    itl::flat_map<int, int> x = {{0, 1}};
+    itl::flat_map<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x[2], 3);
+    EXPECT_EQ(y[0], 1);
+}
+
+
+TEST(flat_multimap, MemberFunctions)
+{
+    itl::flat_multimap<int, int> x = {{5, 4}, {3, 2}, {3, 1}};
+    itl::flat_multimap<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 3);
+    EXPECT_EQ(y.count(3), 2);
+
+    // equal keys keep their insertion order
+    auto range = y.equal_range(3);
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+    EXPECT_EQ(range.first->second, 2);
+    EXPECT_EQ(std::next(range.first)->second, 1);
+    y.emplace(3, 0);
+    EXPECT_EQ(std::prev(y.upper_bound(3))->second, 0);
+    EXPECT_EQ(y.erase(3), 3);
+    EXPECT_EQ(y.size(), 1);
+}
+
+
+TEST(flat_multimap, NonMemberFunctions)
+{
+    itl::flat_multimap<int, int> x = {{0, 1}};
+    itl::flat_multimap<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x.find(2)->second, 3);
+    EXPECT_EQ(y.find(0)->second, 1);
+}
+
+
+TEST(flat_map, MoveSemantics)
+{
+    itl::flat_map<itl::string, int> x = {{"a", 4}, {"b", 2}};
+    auto address = x.keys().data();
+    itl::flat_map<itl::string, int> y(std::move(x));
+    EXPECT_EQ(y.keys().data(), address);
+    EXPECT_TRUE(x.empty());
+
+    itl::flat_map<itl::string, int> z;
+    z = std::move(y);
+    EXPECT_EQ(z.keys().data(), address);
+
+    itl::flat_map<itl::string, int> copy(z);
+    EXPECT_EQ(copy, z);
+}
+
+
+TEST(flat_multimap, MoveSemantics)
+{
+    itl::flat_multimap<int, int> x = {{5, 4}, {3, 2}};
+    auto address = x.values().data();
+    itl::flat_multimap<int, int> y(std::move(x));
+    EXPECT_EQ(y.values().data(), address);
+
+    itl::flat_multimap<int, int> z;
+    z = std::move(y);
+    EXPECT_EQ(z.values().data(), address);
+}
+
+
+TEST(flat_map, SortedUnique)
+{
+    std::vector<std::pair<int, int>> sorted = {{1, 1}, {2, 2}, {4, 4}};
+    itl::flat_map<int, int> x(itl::sorted_unique, sorted.begin(), sorted.end());
+    EXPECT_EQ(x.size(), 3);
+
+    // bulk inserts merge into place, keeping values already present
+    x.insert(itl::sorted_unique, {{0, 0}, {2, 3}, {5, 5}});
+    x.insert({{9, 9}, {3, 3}, {3, 4}});
+    EXPECT_EQ(x.at(2), 2);
+    EXPECT_EQ(x.at(3), 3);
+
+    // keys and values are stored in separate sorted arrays
+    std::vector<int> keys(x.keys().begin(), x.keys().end());
+    std::vector<int> values(x.values().begin(), x.values().end());
+    EXPECT_EQ(keys, std::vector<int>({0, 1, 2, 3, 4, 5, 9}));
+    EXPECT_EQ(values, std::vector<int>({0, 1, 2, 3, 4, 5, 9}));
+
+    itl::flat_multimap<int, int> y(itl::sorted_equivalent, {{1, 1}, {1, 2}});
+    y.insert({{1, 3}, {0, 0}});
+    EXPECT_EQ(y.count(1), 3);
+    EXPECT_EQ(std::prev(y.end())->second, 3);
+}
+
+
+TEST(flat_map, Model)
+{
+    // random inserts, lookups and erases must agree with std::map
+    itl::flat_map<int, int> x;
+    std::map<int, int> y;
+    unsigned state = 1;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 5000);
+        switch ((state >> 4) % 4) {
+            case 0:
+                x[key] = i;
+                y[key] = i;
+                break;
+            case 1:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 2: {
+                auto it = x.upper_bound(key);
+                auto expected = y.upper_bound(key);
+                ASSERT_EQ(it == x.end(), expected == y.end());
+                if (expected != y.end()) {
+                    EXPECT_EQ(it->first, expected->first);
+                }
+                break;
+            }
+            case 3: {
+                auto it = x.find(key);
+                auto expected = y.find(key);
+                ASSERT_EQ(it == x.end(), expected == y.end());
+                if (expected != y.end()) {
+                    it = x.erase(it);
+                    expected = y.erase(expected);
+                    ASSERT_EQ(it == x.end(), expected == y.end());
+                    if (expected != y.end()) {
+                        EXPECT_EQ(it->first, expected->first);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    ASSERT_EQ(x.size(), y.size());
+    auto equal = [](std::pair<const int &, const int &> left, const std::pair<const int, int> &right) {
+        return left.first == right.first && left.second == right.second;
+    };
+    EXPECT_TRUE(std::equal(x.cbegin(), x.cend(), y.begin(), equal));
+
+    // bulk inserts of unsorted input with duplicates
+    std::vector<std::pair<int, int>> input;
+    for (int i = 0; i < 10000; ++i) {
+        state = state * 1103515245 + 12345;
+        input.emplace_back(static_cast<int>((state >> 8) % 20000), i);
+    }
+    x.insert(input.begin(), input.end());
+    y.insert(input.begin(), input.end());
+    ASSERT_EQ(x.size(), y.size());
+    EXPECT_TRUE(std::equal(x.cbegin(), x.cend(), y.begin(), equal));
+}
+
+
+TEST(flat_map, Transparent)
+{
+    itl::flat_map<itl::string, int, itl::string_less> x = {{"a", 1}, {"b", 2}};
+    EXPECT_EQ(x.find("b")->second, 2);
+    EXPECT_EQ(x.count("c"), 0);
+    EXPECT_EQ(x.lower_bound("aa")->second, 2);
+}
+
+
+TEST(flat_map, Merge)
+{
+    itl::flat_map<int, int> x = {{1, 1}, {2, 2}};
+    itl::flat_map<int, int> y = {{2, 3}, {4, 4}};
+    x.merge(y);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x.at(2), 2);
+    EXPECT_EQ(y.size(), 1);
+    EXPECT_EQ(y.at(2), 3);
+
+    itl::flat_multimap<int, int> z = {{2, 1}};
+    z.merge(itl::flat_multimap<int, int>({{2, 2}, {0, 0}}));
+    EXPECT_EQ(z.size(), 3);
+    EXPECT_EQ(std::prev(z.end())->second, 2);
+}
@@ -0,0 +1,159 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/flat_set.hpp>
+
+#include <iterator>
+#include <set>
+
+
+TEST(flat_set, MemberFunctions)
+{
+    itl::flat_set<int> x = {5, 4, 3, 2};
+    itl::flat_set<int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 4);
+    EXPECT_FALSE(y.insert(3).second);
+    EXPECT_EQ(*y.lower_bound(1), 2);
+    EXPECT_EQ(y.upper_bound(5), y.end());
+    EXPECT_EQ(*y.rbegin(), 5);
+    EXPECT_EQ(*y.emplace_hint(y.begin(), 1), 1);
+    EXPECT_EQ(*y.insert(y.begin(), 6), 6);
+    EXPECT_EQ(y.erase(4), 1);
+    EXPECT_EQ(*y.erase(y.find(3)), 5);
+}
+
+
+TEST(flat_set, NonMemberFunctions)
+{
+    itl::flat_set<int> x = {0, 1};
+    itl::flat_set<int> y = {2, 3};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(*x.begin(), 2);
+    EXPECT_EQ(*y.begin(), 0);
+}
+
+
+TEST(flat_multiset, MemberFunctions)
+{
+    itl::flat_multiset<int> x = {5, 4, 3, 3};
+    itl::flat_multiset<int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 4);
+    EXPECT_EQ(y.count(3), 2);
+    EXPECT_EQ(*y.insert(3), 3);
+    EXPECT_EQ(y.count(3), 3);
+}
+
+
+TEST(flat_multiset, NonMemberFunctions)
+{
+    itl::flat_multiset<int> x = {0, 1};
+    itl::flat_multiset<int> y = {2, 3};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(*x.begin(), 2);
+    EXPECT_EQ(*y.begin(), 0);
+}
+
+
+TEST(flat_set, MoveSemantics)
+{
+    itl::flat_set<int> x = {5, 4, 3, 2};
+    auto address = &*x.begin();
+    itl::flat_set<int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::flat_set<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(flat_multiset, Model)
+{
+    // random inserts and erases must agree with std::multiset
+    itl::flat_multiset<int> x;
+    std::multiset<int> y;
+    unsigned state = 7;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 2000);
+        switch ((state >> 4) % 3) {
+            case 0:
+                x.insert(key);
+                y.insert(key);
+                break;
+            case 1:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 2:
+                EXPECT_EQ(x.count(key), y.count(key));
+                break;
+        }
+    }
+    ASSERT_EQ(x.size(), y.size());
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+    EXPECT_TRUE(std::equal(x.rbegin(), x.rend(), y.rbegin()));
+
+    auto first = x.lower_bound(500);
+    auto last = x.upper_bound(1500);
+    auto it = x.erase(first, last);
+    y.erase(y.lower_bound(500), y.upper_bound(1500));
+    EXPECT_EQ(*it, *y.upper_bound(1500));
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+}
+
+
+TEST(flat_set, SortedUnique)
+{
+    int sorted[] = {1, 2, 4};
+    itl::flat_set<int> x(itl::sorted_unique, std::begin(sorted), std::end(sorted));
+    x.insert(itl::sorted_unique, {0, 2, 5});
+    x.insert({9, 3, 3});
+    EXPECT_EQ(x, itl::flat_set<int>({0, 1, 2, 3, 4, 5, 9}));
+
+    itl::flat_multiset<int> y(itl::sorted_equivalent, {1, 1});
+    y.insert({1, 0});
+    EXPECT_EQ(y.count(1), 3);
+}
+
+
+TEST(flat_set, Merge)
+{
+    itl::flat_set<int> x = {1, 2};
+    itl::flat_set<int> y = {2, 4};
+    x.merge(y);
+    EXPECT_EQ(x, itl::flat_set<int>({1, 2, 4}));
+    EXPECT_EQ(y, itl::flat_set<int>({2}));
+
+    itl::flat_multiset<int> z = {2};
+    z.merge(itl::flat_multiset<int>({2, 0}));
+    EXPECT_EQ(z.count(2), 2);
+    EXPECT_EQ(z.size(), 3);
+}
@@ -48,3 +48,21 @@ TEST(forward_list, NonMemberFunctions)
     EXPECT_FALSE(y.empty());
     EXPECT_TRUE(x.empty());
 }
+
+
+TEST(forward_list, MoveSemantics)
+{
+    typedef itl::forward_list<int> Itl;
+    typedef std::forward_list<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::forward_list<int> x = {5, 4, 3, 2};
+    auto address = &x.front();
+    itl::forward_list<int> y(std::move(x));
+    EXPECT_EQ(&y.front(), address);
+
+    itl::forward_list<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&z.front(), address);
+}
@@ -0,0 +1,160 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/incremental_unordered_map.hpp>
+#include <itl/string.hpp>
+
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+// TESTS
+// -----
+
+
+TEST(incremental_unordered_map, MemberFunctions)
+{
+    itl::incremental_unordered_map<int, int> x = {{5, 4}, {3, 2}};
+    itl::incremental_unordered_map<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_EQ(y.at(5), 4);
+    EXPECT_THROW(y.at(4), std::out_of_range);
+    EXPECT_EQ(y.count(3), 1);
+    EXPECT_EQ(y.count(4), 0);
+    EXPECT_EQ(x.find(3), x.end());
+    EXPECT_EQ(std::distance(y.begin(), y.end()), 2);
+
+    auto range = y.equal_range(3);
+    EXPECT_EQ(std::distance(range.first, range.second), 1);
+    EXPECT_EQ(range.first->second, 2);
+
+    EXPECT_FALSE(y.emplace(3, 7).second);
+    EXPECT_TRUE(y.insert({7, 8}).second);
+    EXPECT_EQ(y[7], 8);
+    EXPECT_EQ(y.erase(7), 1);
+    EXPECT_EQ(y.erase(7), 0);
+    EXPECT_LE(y.load_factor(), y.max_load_factor());
+
+    y.clear();
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(y.begin(), y.end());
+}
+
+
+TEST(incremental_unordered_map, NonMemberFunctions)
+{
+    itl::incremental_unordered_map<int, int> x = {{0, 1}};
+    itl::incremental_unordered_map<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x[2], 3);
+    EXPECT_EQ(y[0], 1);
+}
+
+
+TEST(incremental_unordered_map, MoveSemantics)
+{
+    itl::incremental_unordered_map<itl::string, int> x;
+    x["key"] = 1;
+    auto address = &*x.begin();
+    itl::incremental_unordered_map<itl::string, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+    EXPECT_TRUE(x.empty());
+
+    itl::incremental_unordered_map<itl::string, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+
+    itl::incremental_unordered_map<itl::string, int> copy(z);
+    EXPECT_EQ(copy, z);
+}
+
+
+TEST(incremental_unordered_map, IncrementalRehash)
+{
+    itl::incremental_unordered_map<int, int> x;
+    std::unordered_map<int, int> model;
+    const int *first = nullptr;
+    bool rehashing = false;
+
+    for (int i = 0; i < 5000; ++i) {
+        x.emplace(i, -i);
+        model.emplace(i, -i);
+        if (i == 1) {
+            first = &x.at(1);
+        }
+        rehashing |= x.rehashing();
+
+        // erase mid-migration, through both bucket arrays
+        if (i % 7 == 0) {
+            EXPECT_EQ(x.erase(i / 2), model.erase(i / 2));
+        }
+        if (i % 97 == 0) {
+            EXPECT_EQ(x.size(), model.size());
+            EXPECT_EQ(static_cast<size_t>(std::distance(x.begin(), x.end())), model.size());
+            for (const auto &value: model) {
+                ASSERT_EQ(x.at(value.first), value.second);
+            }
+        }
+    }
+    EXPECT_TRUE(rehashing);
+    EXPECT_EQ(&x.at(1), first);
+
+    // erase while iterating, leaving only odd keys
+    for (auto it = x.begin(); it != x.end();) {
+        if (it->first % 2 == 0) {
+            it = x.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (const auto &value: x) {
+        EXPECT_EQ(value.first % 2, 1);
+        EXPECT_EQ(model.count(value.first), 1);
+    }
+
+    x.rehash(0);
+    EXPECT_FALSE(x.rehashing());
+    EXPECT_LE(x.load_factor(), x.max_load_factor());
+    x.reserve(20000);
+    EXPECT_GE(x.bucket_count(), 20000);
+}
+
+
+TEST(incremental_unordered_map, FindBatch)
+{
+    itl::incremental_unordered_map<int, int> x;
+    std::vector<int> keys;
+    for (int i = 0; i < 1000; ++i) {
+        x.emplace(i, -i);
+        keys.push_back(2 * i);
+    }
+
+    std::vector<itl::incremental_unordered_map<int, int>::iterator> found;
+    x.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+    ASSERT_EQ(found.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(found[i], x.find(keys[i]));
+    }
+
+    const auto &y = x;
+    itl::incremental_unordered_map<int, int> z;
+    std::vector<itl::incremental_unordered_map<int, int>::const_iterator> missing(2);
+    y.find_batch(keys.begin() + 500, keys.begin() + 502, missing.begin());
+    EXPECT_EQ(missing[0], y.end());
+    EXPECT_EQ(missing[1], y.end());
+    z.find_batch(keys.begin(), keys.begin() + 1, missing.begin());
+    EXPECT_EQ(missing[0], z.end());
+}
@@ -0,0 +1,169 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/interval_map.hpp>
+
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+
+TEST(interval_map, MemberFunctions)
+{
+    itl::interval_map<int, char> x = {{{0, 10}, 'a'}, {{20, 30}, 'b'}};
+    itl::interval_map<int, char> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_EQ(y.at(0), 'a');
+    EXPECT_EQ(y.at(29), 'b');
+    EXPECT_THROW(y.at(10), std::out_of_range);
+    EXPECT_TRUE(y.contains(9));
+    EXPECT_FALSE(y.contains(-1));
+    EXPECT_FALSE(y.contains(30));
+    EXPECT_EQ(y.find(15), y.end());
+
+    auto range = y.overlap({5, 21});
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+    range = y.overlap({10, 20});
+    EXPECT_EQ(range.first, range.second);
+    range = y.overlap({5, 5});
+    EXPECT_EQ(range.first, range.second);
+}
+
+
+TEST(interval_map, NonMemberFunctions)
+{
+    itl::interval_map<int, int> x = {{{0, 1}, 1}};
+    itl::interval_map<int, int> y = {{{2, 3}, 1}};
+
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x.at(2), 1);
+    EXPECT_EQ(y.at(0), 1);
+}
+
+
+TEST(interval_map, Assign)
+{
+    itl::interval_map<int, char> x;
+    x.assign({0, 100}, 'a');
+
+    // splits the range it lands inside
+    auto it = x.assign({40, 60}, 'b');
+    EXPECT_EQ(it->first, (itl::interval<int> {40, 60}));
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x.at(39), 'a');
+    EXPECT_EQ(x.at(40), 'b');
+    EXPECT_EQ(x.at(60), 'a');
+
+    // touching ranges coalesce only with equal values
+    x.assign({60, 70}, 'b');
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x.find(65)->first, (itl::interval<int> {40, 70}));
+    x.assign({30, 80}, 'a');
+    EXPECT_EQ(x.size(), 1);
+    EXPECT_EQ(x.begin()->first, (itl::interval<int> {0, 100}));
+
+    // values aliasing an erased range survive
+    x.assign({200, 300}, 'c');
+    x.assign({0, 300}, x.at(250));
+    EXPECT_EQ(x.size(), 1);
+    EXPECT_EQ(x.at(0), 'c');
+
+    x.erase({100, 150});
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_FALSE(x.contains(120));
+    x.erase({-5, 500});
+    EXPECT_TRUE(x.empty());
+}
+
+
+TEST(interval_map, FromSorted)
+{
+    std::vector<std::pair<itl::interval<int>, int>> input;
+    for (int i = 0; i < 100; ++i) {
+        input.push_back({{i * 10, i * 10 + 10}, i / 2});
+    }
+    auto x = itl::interval_map<int, int>::from_sorted(input.begin(), input.end());
+    EXPECT_EQ(x.size(), 50);
+    EXPECT_EQ(x.at(25), 1);
+    EXPECT_EQ(x.find(25)->first, (itl::interval<int> {20, 40}));
+
+    // overlapping input falls back to assignment, so later ranges win
+    input = {{{0, 10}, 1}, {{5, 15}, 2}, {{15, 15}, 3}, {{1, 2}, 3}};
+    auto y = itl::interval_map<int, int>::from_sorted(input.begin(), input.end());
+    EXPECT_EQ(y.size(), 4);
+    EXPECT_EQ(y.at(1), 3);
+    EXPECT_EQ(y.at(4), 1);
+    EXPECT_EQ(y.at(14), 2);
+}
+
+
+TEST(interval_map, Model)
+{
+    // every key must map to what a plain array says, and adjacent
+    // ranges must never hold equal values
+    const int keys = 64;
+    itl::interval_map<int, int> x;
+    std::vector<int> y(keys, -1);
+    unsigned state = 5;
+    for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245 + 12345;
+        int lower = static_cast<int>((state >> 8) % keys);
+        int upper = static_cast<int>((state >> 16) % (keys + 1));
+        int value = static_cast<int>((state >> 24) % 3);
+        if (state & 1) {
+            x.assign({lower, upper}, value);
+            for (int k = lower; k < upper; ++k) {
+                y[k] = value;
+            }
+        } else {
+            x.erase({lower, upper});
+            for (int k = lower; k < upper; ++k) {
+                y[k] = -1;
+            }
+        }
+
+        for (int k = 0; k < keys; ++k) {
+            auto it = x.find(k);
+            ASSERT_EQ(it == x.end() ? -1 : it->second, y[k]);
+        }
+        for (auto it = x.begin(); it != x.end(); ++it) {
+            auto next = std::next(it);
+            ASSERT_LT(it->first.lower, it->first.upper);
+            ASSERT_TRUE(next == x.end() || it->first.upper < next->first.lower || it->second != next->second);
+        }
+        auto range = x.overlap({lower, upper});
+        int covered = 0;
+        for (int k = lower; k < upper; ++k) {
+            covered += y[k] >= 0 && (k == lower || y[k - 1] != y[k]);
+        }
+        ASSERT_EQ(covered, std::distance(range.first, range.second));
+    }
+}
+
+
+TEST(interval_map, MoveSemantics)
+{
+    typedef itl::interval_map<int, int> Itl;
+    EXPECT_TRUE(std::is_nothrow_move_constructible<Itl>::value);
+
+    Itl x = {{{0, 5}, 1}, {{5, 9}, 2}};
+    auto address = &*x.begin();
+    Itl y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    Itl z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
@@ -0,0 +1,135 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/interval_set.hpp>
+
+#include <iterator>
+#include <vector>
+
+
+TEST(interval_set, MemberFunctions)
+{
+    itl::interval_set<int> x = {{0, 10}, {20, 30}};
+    itl::interval_set<int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_TRUE(y.contains(0));
+    EXPECT_TRUE(y.contains(29));
+    EXPECT_FALSE(y.contains(10));
+    EXPECT_EQ(y.find(25)->lower, 20);
+    EXPECT_EQ(y.find(35), y.end());
+
+    auto range = y.overlap({9, 20});
+    EXPECT_EQ(std::distance(range.first, range.second), 1);
+    range = y.overlap({9, 21});
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+}
+
+
+TEST(interval_set, NonMemberFunctions)
+{
+    itl::interval_set<int> x = {{0, 1}};
+    itl::interval_set<int> y = {{2, 3}};
+
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_TRUE(x.contains(2));
+    EXPECT_TRUE(y.contains(0));
+}
+
+
+TEST(interval_set, Insert)
+{
+    itl::interval_set<int> x = {{0, 10}, {20, 30}, {40, 50}};
+
+    // touching ranges coalesce
+    auto it = x.insert({10, 20});
+    EXPECT_EQ(*it, (itl::interval<int> {0, 30}));
+    EXPECT_EQ(x.size(), 2);
+    x.insert({-5, 45});
+    EXPECT_EQ(x.size(), 1);
+    EXPECT_EQ(*x.begin(), (itl::interval<int> {-5, 50}));
+    EXPECT_EQ(x.insert({3, 3}), x.end());
+
+    x.erase({10, 20});
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_FALSE(x.contains(15));
+    EXPECT_TRUE(x.contains(20));
+}
+
+
+TEST(interval_set, FromSorted)
+{
+    std::vector<itl::interval<int>> input;
+    for (int i = 0; i < 100; ++i) {
+        input.push_back({i * 10, i * 10 + 5 + 5 * (i % 2)});
+    }
+    input.push_back({3, 4});
+    auto x = itl::interval_set<int>::from_sorted(input.begin(), input.end());
+    EXPECT_EQ(x.size(), 51);
+    EXPECT_EQ(*x.begin(), (itl::interval<int> {0, 5}));
+    EXPECT_EQ(*x.find(15), (itl::interval<int> {10, 25}));
+}
+
+
+TEST(interval_set, Model)
+{
+    const int keys = 64;
+    itl::interval_set<int> x;
+    std::vector<bool> y(keys);
+    unsigned state = 9;
+    for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245 + 12345;
+        int lower = static_cast<int>((state >> 8) % keys);
+        int upper = static_cast<int>((state >> 16) % (keys + 1));
+        if (state & 1) {
+            x.insert({lower, upper});
+        } else {
+            x.erase({lower, upper});
+        }
+        for (int k = lower; k < upper; ++k) {
+            y[k] = state & 1;
+        }
+
+        size_t runs = 0;
+        for (int k = 0; k < keys; ++k) {
+            ASSERT_EQ(x.contains(k), y[k]);
+            runs += y[k] && (k == 0 || !y[k - 1]);
+        }
+        // coalesced, so one range per run of keys
+        ASSERT_EQ(x.size(), runs);
+
+        size_t overlapping = 0;
+        for (int k = lower; k < upper; ++k) {
+            overlapping += y[k] && (k == lower || !y[k - 1]);
+        }
+        auto range = x.overlap({lower, upper});
+        ASSERT_EQ(static_cast<size_t>(std::distance(range.first, range.second)), overlapping);
+    }
+}
+
+
+TEST(interval_set, MoveSemantics)
+{
+    typedef itl::interval_set<int> Itl;
+    EXPECT_TRUE(std::is_nothrow_move_constructible<Itl>::value);
+
+    Itl x = {{0, 5}, {6, 9}};
+    auto address = &*x.begin();
+    Itl y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    Itl z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
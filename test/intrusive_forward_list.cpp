@@ -0,0 +1,234 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/intrusive_forward_list.hpp>
+
+#include <algorithm>
+#include <forward_list>
+#include <random>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+struct item
+{
+    int key;
+    int id;
+    itl::forward_list_hook hook;
+
+    item(int key = 0, int id = 0):
+        key(key),
+        id(id)
+    {}
+
+    bool operator==(const item &other) const
+    {
+        return key == other.key;
+    }
+
+    bool operator<(const item &other) const
+    {
+        return key < other.key;
+    }
+};
+
+typedef itl::intrusive_forward_list<item, &item::hook> item_list;
+
+
+template <typename List>
+std::vector<int> keys(const List &list)
+{
+    std::vector<int> result;
+    for (const item &value: list) {
+        result.push_back(value.key);
+    }
+    return result;
+}
+
+// TESTS
+// -----
+
+
+TEST(intrusive_forward_list, MemberFunctions)
+{
+    std::vector<item> items = {1, 2, 3, 4};
+    item_list x;
+    EXPECT_TRUE(x.empty());
+    EXPECT_FALSE(items[0].hook.linked());
+
+    x.push_front(items[0]);
+    x.insert_after(x.begin(), items.begin() + 1, items.end());
+    EXPECT_EQ(x.front().key, 1);
+    EXPECT_TRUE(items[3].hook.linked());
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 2, 3, 4}));
+
+    // erase the successor of a known element
+    auto it = x.erase_after(x.iterator_to(items[1]));
+    EXPECT_EQ(it->key, 4);
+    EXPECT_FALSE(items[2].hook.linked());
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 2, 4}));
+
+    x.pop_front();
+    EXPECT_EQ(keys(x), (std::vector<int> {2, 4}));
+    EXPECT_FALSE(items[0].hook.linked());
+
+    // copies of an element start unlinked
+    item copy = items[1];
+    EXPECT_FALSE(copy.hook.linked());
+
+    x.erase_after(x.before_begin(), x.end());
+    EXPECT_TRUE(x.empty());
+    EXPECT_FALSE(items[3].hook.linked());
+
+    x.insert_after(x.before_begin(), items.begin(), items.end());
+    x.clear();
+    EXPECT_TRUE(x.empty());
+    EXPECT_TRUE(std::none_of(items.begin(), items.end(), [](const item &value) {
+        return value.hook.linked();
+    }));
+}
+
+
+TEST(intrusive_forward_list, NonMemberFunctions)
+{
+    std::vector<item> left = {1, 2};
+    std::vector<item> right = {1, 3};
+    item_list x(left.begin(), left.end());
+    item_list y(right.begin(), right.end());
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    swap(x, y);
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 3}));
+    EXPECT_EQ(keys(y), (std::vector<int> {1, 2}));
+}
+
+
+TEST(intrusive_forward_list, Operations)
+{
+    // stable sort and merge, with equal keys told apart by id
+    std::vector<item> items;
+    for (int i = 0; i < 101; ++i) {
+        items.emplace_back((i * 37) % 10, i);
+    }
+    std::vector<item> more = {1, 2, 3, 4, 5};
+    item_list x(items.begin(), items.begin() + 50);
+    item_list y(items.begin() + 50, items.end());
+    x.sort();
+    y.sort();
+    x.merge(y);
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(std::distance(x.begin(), x.end()), 101);
+    for (auto it = x.begin(); std::next(it) != x.end(); ++it) {
+        auto next = std::next(it);
+        EXPECT_TRUE(it->key < next->key || (it->key == next->key && it->id < next->id));
+    }
+
+    EXPECT_EQ(x.unique(), 91);
+    EXPECT_EQ(keys(x), (std::vector<int> {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(x.remove_if([](const item &value) { return value.key % 2 == 1; }), 5);
+    EXPECT_EQ(x.remove(item(4)), 1);
+    x.reverse();
+    EXPECT_EQ(keys(x), (std::vector<int> {8, 6, 2, 0}));
+    x.sort([](const item &left, const item &right) { return left.key > right.key; });
+    EXPECT_EQ(keys(x), (std::vector<int> {8, 6, 2, 0}));
+
+    // splice single elements, ranges and whole lists
+    x.clear();
+    x.insert_after(x.before_begin(), more.begin(), more.end());
+    y.splice_after(y.before_begin(), x, x.iterator_to(more[1]));
+    EXPECT_EQ(keys(y), (std::vector<int> {3}));
+    y.splice_after(y.begin(), x, x.begin(), x.end());
+    EXPECT_EQ(keys(y), (std::vector<int> {3, 2, 4, 5}));
+    EXPECT_EQ(keys(x), (std::vector<int> {1}));
+    y.splice_after(y.before_begin(), y, y.begin(), std::next(y.begin(), 3));
+    EXPECT_EQ(keys(y), (std::vector<int> {2, 4, 3, 5}));
+    y.splice_after(y.before_begin(), x);
+    EXPECT_EQ(keys(y), (std::vector<int> {1, 2, 4, 3, 5}));
+    EXPECT_TRUE(x.empty());
+}
+
+
+TEST(intrusive_forward_list, MoveSemantics)
+{
+    EXPECT_TRUE(std::is_nothrow_move_constructible<item_list>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<item_list>::value);
+    EXPECT_FALSE(std::is_copy_constructible<item_list>::value);
+
+    std::vector<item> items = {1, 2, 3};
+    item_list x(items.begin(), items.end());
+    item_list y(std::move(x));
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(keys(y), (std::vector<int> {1, 2, 3}));
+
+    x = std::move(y);
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 2, 3}));
+
+    std::vector<item> others = {7, 8};
+    itl::static_::intrusive_forward_list<item, &item::hook> z(others.begin(), others.end());
+    EXPECT_EQ(keys(z), (std::vector<int> {7, 8}));
+    z.clear();
+
+#if !defined(NDEBUG) && GTEST_HAS_DEATH_TEST
+    EXPECT_DEATH(x.push_front(items[1]), "already linked");
+#endif
+}
+
+
+TEST(intrusive_forward_list, Model)
+{
+    // random pushes, sorts and removals against std::forward_list
+    std::mt19937 gen(11);
+    std::vector<item> items;
+    for (int i = 0; i < 300; ++i) {
+        items.emplace_back(static_cast<int>(gen() % 50), i);
+    }
+    item_list x;
+    std::forward_list<item*> model;
+    size_t next = 0;
+
+    for (int step = 0; step < 200; ++step) {
+        switch (gen() % 4) {
+            case 0:
+            case 1:
+                if (next < items.size()) {
+                    x.push_front(items[next]);
+                    model.push_front(&items[next]);
+                    ++next;
+                }
+                break;
+            case 2:
+                x.sort();
+                model.sort([](const item *left, const item *right) {
+                    return *left < *right;
+                });
+                break;
+            default: {
+                int key = static_cast<int>(gen() % 50);
+                x.remove_if([key](const item &value) { return value.key == key; });
+                model.remove_if([key](const item *value) { return value->key == key; });
+                break;
+            }
+        }
+        auto expected = model.begin();
+        for (item &value: x) {
+            ASSERT_EQ(&value, *expected++);
+        }
+        ASSERT_EQ(expected, model.end());
+    }
+    x.clear();
+}
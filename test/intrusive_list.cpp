@@ -0,0 +1,273 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/intrusive_list.hpp>
+
+#include <list>
+#include <random>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+struct task
+{
+    int key;
+    int id;
+    itl::list_hook hook;
+
+    task(int key = 0, int id = 0):
+        key(key),
+        id(id)
+    {}
+
+    bool operator==(const task &other) const
+    {
+        return key == other.key;
+    }
+
+    bool operator<(const task &other) const
+    {
+        return key < other.key;
+    }
+};
+
+
+// hook behind a vtable and other members, to check the member offset
+struct job
+{
+    virtual ~job() {}
+    double weight = 0;
+    itl::list_hook ready;
+    itl::list_hook timer;
+};
+
+typedef itl::intrusive_list<task, &task::hook> task_list;
+
+
+std::vector<int> keys(const task_list &list)
+{
+    std::vector<int> result;
+    for (const task &item: list) {
+        result.push_back(item.key);
+    }
+    return result;
+}
+
+// TESTS
+// -----
+
+
+TEST(intrusive_list, MemberFunctions)
+{
+    std::vector<task> tasks = {1, 2, 3, 4};
+    task_list x;
+    EXPECT_TRUE(x.empty());
+    EXPECT_FALSE(tasks[0].hook.linked());
+
+    x.push_back(tasks[1]);
+    x.push_front(tasks[0]);
+    x.insert(x.end(), tasks.begin() + 2, tasks.end());
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.front().key, 1);
+    EXPECT_EQ(x.back().key, 4);
+    EXPECT_TRUE(tasks[2].hook.linked());
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 2, 3, 4}));
+    EXPECT_EQ(std::vector<int>({4, 3, 2, 1}), std::vector<int>({x.rbegin()->key, std::next(x.rbegin())->key, std::prev(x.rend(), 2)->key, std::prev(x.rend())->key}));
+
+    // erase by element, without a search
+    auto it = x.erase(x.iterator_to(tasks[1]));
+    EXPECT_EQ(it->key, 3);
+    EXPECT_FALSE(tasks[1].hook.linked());
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 3, 4}));
+
+    x.pop_front();
+    x.pop_back();
+    EXPECT_EQ(keys(x), (std::vector<int> {3}));
+    EXPECT_FALSE(tasks[0].hook.linked());
+    EXPECT_FALSE(tasks[3].hook.linked());
+
+    // copies of an element start unlinked
+    task copy = tasks[2];
+    EXPECT_FALSE(copy.hook.linked());
+
+    x.clear();
+    EXPECT_TRUE(x.empty());
+    EXPECT_FALSE(tasks[2].hook.linked());
+
+    x.insert(x.begin(), tasks.begin(), tasks.end());
+    x.erase(std::next(x.begin()), std::prev(x.end()));
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 4}));
+    EXPECT_FALSE(tasks[1].hook.linked());
+}
+
+
+TEST(intrusive_list, NonMemberFunctions)
+{
+    std::vector<task> left = {1, 2};
+    std::vector<task> right = {1, 3};
+    task_list x(left.begin(), left.end());
+    task_list y(right.begin(), right.end());
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    swap(x, y);
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 3}));
+    EXPECT_EQ(keys(y), (std::vector<int> {1, 2}));
+    EXPECT_EQ(&x.back(), &right[1]);
+}
+
+
+TEST(intrusive_list, Operations)
+{
+    // stable sort and merge, with equal keys told apart by id
+    std::vector<task> tasks;
+    for (int i = 0; i < 100; ++i) {
+        tasks.emplace_back((i * 37) % 10, i);
+    }
+    std::vector<task> more = {1, 2, 3, 4, 5};
+    task_list x(tasks.begin(), tasks.begin() + 50);
+    task_list y(tasks.begin() + 50, tasks.end());
+    x.sort();
+    y.sort();
+    x.merge(y);
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(x.size(), 100);
+    for (auto it = x.begin(); std::next(it) != x.end(); ++it) {
+        auto next = std::next(it);
+        EXPECT_TRUE(it->key < next->key || (it->key == next->key && it->id < next->id));
+    }
+
+    EXPECT_EQ(x.unique(), 90);
+    EXPECT_EQ(keys(x), (std::vector<int> {0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    EXPECT_EQ(x.remove_if([](const task &item) { return item.key % 2 == 1; }), 5);
+    EXPECT_EQ(x.remove(task(4)), 1);
+    x.reverse();
+    EXPECT_EQ(keys(x), (std::vector<int> {8, 6, 2, 0}));
+    EXPECT_EQ(x.size(), 4);
+
+    x.sort([](const task &left, const task &right) { return left.key > right.key; });
+    EXPECT_EQ(keys(x), (std::vector<int> {8, 6, 2, 0}));
+
+    // splice single elements, ranges and whole lists
+    x.clear();
+    x.insert(x.end(), more.begin(), more.end());
+    y.splice(y.end(), x, x.iterator_to(more[2]));
+    EXPECT_EQ(keys(y), (std::vector<int> {3}));
+    y.splice(y.begin(), x, std::next(x.begin()), x.end());
+    EXPECT_EQ(keys(y), (std::vector<int> {2, 4, 5, 3}));
+    EXPECT_EQ(x.size(), 1);
+    EXPECT_EQ(y.size(), 4);
+    y.splice(y.end(), y, y.begin(), std::next(y.begin(), 2));
+    EXPECT_EQ(keys(y), (std::vector<int> {5, 3, 2, 4}));
+    y.splice(y.begin(), x);
+    EXPECT_EQ(keys(y), (std::vector<int> {1, 5, 3, 2, 4}));
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(y.size(), 5);
+}
+
+
+TEST(intrusive_list, MoveSemantics)
+{
+    EXPECT_TRUE(std::is_nothrow_move_constructible<task_list>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<task_list>::value);
+    EXPECT_FALSE(std::is_copy_constructible<task_list>::value);
+
+    std::vector<task> tasks = {1, 2, 3};
+    task_list x(tasks.begin(), tasks.end());
+    task_list y(std::move(x));
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(keys(y), (std::vector<int> {1, 2, 3}));
+
+    x = std::move(y);
+    EXPECT_TRUE(y.empty());
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 2, 3}));
+    x.pop_back();
+    EXPECT_EQ(keys(x), (std::vector<int> {1, 2}));
+}
+
+
+TEST(intrusive_list, Hooks)
+{
+    // one element in several lists through several hooks
+    std::vector<job> jobs(3);
+    itl::intrusive_list<job, &job::ready> ready;
+    itl::static_::intrusive_list<job, &job::timer> timers;
+    for (job &item: jobs) {
+        ready.push_back(item);
+        timers.push_front(item);
+    }
+    EXPECT_EQ(&ready.front(), &jobs[0]);
+    EXPECT_EQ(&timers.front(), &jobs[2]);
+    ready.erase(ready.iterator_to(jobs[1]));
+    EXPECT_FALSE(jobs[1].ready.linked());
+    EXPECT_TRUE(jobs[1].timer.linked());
+    EXPECT_EQ(&*std::next(ready.begin()), &jobs[2]);
+    ready.clear();
+    timers.clear();
+
+#if !defined(NDEBUG) && GTEST_HAS_DEATH_TEST
+    task item;
+    task_list x;
+    x.push_back(item);
+    EXPECT_DEATH(x.push_back(item), "already linked");
+    x.clear();
+#endif
+}
+
+
+TEST(intrusive_list, Model)
+{
+    // move tasks at random between lists, like a scheduler
+    std::mt19937 gen(7);
+    std::vector<task> tasks;
+    for (int i = 0; i < 200; ++i) {
+        tasks.emplace_back(i, i);
+    }
+    std::vector<task_list> lists(3);
+    std::vector<std::list<task*>> model(3);
+    std::vector<int> owner(tasks.size(), -1);
+
+    for (int step = 0; step < 5000; ++step) {
+        size_t index = gen() % tasks.size();
+        int target = static_cast<int>(gen() % 3);
+        task &item = tasks[index];
+        if (owner[index] >= 0) {
+            lists[owner[index]].erase(lists[owner[index]].iterator_to(item));
+            model[owner[index]].remove(&item);
+        }
+        if (gen() % 4 != 0) {
+            if (gen() % 2) {
+                lists[target].push_back(item);
+                model[target].push_back(&item);
+            } else {
+                lists[target].push_front(item);
+                model[target].push_front(&item);
+            }
+            owner[index] = target;
+        } else {
+            owner[index] = -1;
+        }
+    }
+
+    for (size_t i = 0; i < lists.size(); ++i) {
+        ASSERT_EQ(lists[i].size(), model[i].size());
+        auto expected = model[i].begin();
+        for (task &item: lists[i]) {
+            EXPECT_EQ(&item, *expected++);
+        }
+        lists[i].clear();
+    }
+}
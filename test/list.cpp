@@ -48,3 +48,21 @@ TEST(list, NonMemberFunctions)
     EXPECT_EQ(y.size(), 2);
     EXPECT_EQ(x.size(), 0);
 }
+
+
+TEST(list, MoveSemantics)
+{
+    typedef itl::list<int> Itl;
+    typedef std::list<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::list<int> x = {5, 4, 3, 2};
+    auto address = &x.front();
+    itl::list<int> y(std::move(x));
+    EXPECT_EQ(&y.front(), address);
+
+    itl::list<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&z.front(), address);
+}
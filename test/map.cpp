@@ -8,6 +8,9 @@
 
 #include <gtest/gtest.h>
 #include <itl/map.hpp>
+#include <itl/string.hpp>
+
+#include <vector>
 
 
 TEST(map, MemberFunctions)
@@ -66,3 +69,140 @@ TEST(multimap, NonMemberFunctions)
     EXPECT_EQ(x.find(2)->second, 3);
     EXPECT_EQ(y.find(0)->second, 1);
 }
+
+
+TEST(map, MoveSemantics)
+{
+    typedef itl::map<int, int> Itl;
+    typedef std::map<int, int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::map<int, int> x = {{5, 4}, {3, 2}};
+    auto address = &*x.begin();
+    itl::map<int, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::map<int, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(multimap, MoveSemantics)
+{
+    typedef itl::multimap<int, int> Itl;
+    typedef std::multimap<int, int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::multimap<int, int> x = {{5, 4}, {3, 2}};
+    auto address = &*x.begin();
+    itl::multimap<int, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::multimap<int, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(map, Transparent)
+{
+    // keys past the SSO length, found without a temporary string
+    itl::map<itl::string, int, itl::string_less> x = {
+        {"a key longer than the small string buffer", 1},
+        {"b key longer than the small string buffer", 2},
+    };
+    const char *key = "b key longer than the small string buffer";
+    EXPECT_EQ(x.find(key)->second, 2);
+    EXPECT_EQ(x.count(key), 1);
+    EXPECT_EQ(x.count("c"), 0);
+    EXPECT_EQ(x.lower_bound("b")->second, 2);
+    EXPECT_EQ(x.upper_bound("a")->second, 1);
+    EXPECT_EQ(x.equal_range(key).first, x.find(key));
+
+    const auto &y = x;
+    EXPECT_EQ(y.find("c"), y.end());
+}
+
+
+TEST(multimap, Transparent)
+{
+    itl::multimap<itl::string, int, itl::string_less> x = {{"a", 1}, {"b", 2}, {"b", 3}};
+    EXPECT_EQ(x.count("b"), 2);
+    auto range = x.equal_range("b");
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+    EXPECT_EQ(x.lower_bound("b"), range.first);
+    EXPECT_EQ(x.upper_bound("b"), range.second);
+}
+
+
+TEST(map, TryEmplace)
+{
+    itl::map<int, itl::string> x;
+    EXPECT_TRUE(x.try_emplace(1, 3, 'a').second);
+    itl::string value("moved");
+    EXPECT_FALSE(x.try_emplace(1, std::move(value)).second);
+    EXPECT_EQ(value, "moved");
+    EXPECT_EQ(x.at(1), "aaa");
+    EXPECT_EQ(x.try_emplace(x.end(), 2, "b")->second, "b");
+
+    EXPECT_FALSE(x.insert_or_assign(1, "c").second);
+    EXPECT_EQ(x.at(1), "c");
+    EXPECT_TRUE(x.insert_or_assign(3, "d").second);
+    EXPECT_EQ(x.insert_or_assign(x.end(), 3, "e")->second, "e");
+    EXPECT_EQ(x.size(), 3);
+}
+
+
+TEST(map, Merge)
+{
+    itl::map<int, int> x = {{1, 1}, {2, 2}};
+    itl::map<int, int> y = {{2, 3}, {4, 4}};
+    x.merge(y);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x.at(2), 2);
+    EXPECT_EQ(y.size(), 1);
+    EXPECT_EQ(y.at(2), 3);
+
+#if defined(__cpp_lib_node_extract)
+    // nodes move between containers without reallocating
+    auto address = &*x.find(4);
+    y.insert(x.extract(4));
+    EXPECT_EQ(&*y.find(4), address);
+    EXPECT_EQ(x.count(4), 0);
+#endif
+}
+
+
+TEST(multimap, Merge)
+{
+    itl::multimap<int, int> x = {{1, 1}, {2, 2}};
+    x.merge(itl::multimap<int, int>({{2, 3}, {4, 4}}));
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+
+    // merging into itself leaves the elements alone
+    x.merge(x);
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+}
+
+
+TEST(map, FromSorted)
+{
+    std::vector<std::pair<int, int>> input;
+    for (int i = 0; i < 1000; ++i) {
+        input.emplace_back(i / 2 * 2, i);
+    }
+    auto x = itl::map<int, int>::from_sorted(input.begin(), input.end());
+    EXPECT_EQ(x.size(), 500);
+    EXPECT_EQ(x.at(2), 2);
+    EXPECT_EQ(x.rbegin()->first, 998);
+
+    auto y = itl::multimap<int, int, std::greater<int>>::from_sorted(input.rbegin(), input.rend(), std::greater<int>());
+    EXPECT_EQ(y.size(), 1000);
+    EXPECT_EQ(y.begin()->first, 998);
+    EXPECT_EQ(y.count(4), 2);
+}
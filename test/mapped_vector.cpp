@@ -0,0 +1,149 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/mapped_vector.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+// HELPERS
+// -------
+
+
+/** \brief Write `count` sequential integers to a temporary file.
+ */
+static std::string write_file(const char *name,
+    int count)
+{
+    std::string path = testing::TempDir() + name;
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    for (int i = 0; i < count; ++i) {
+        stream.write(reinterpret_cast<const char*>(&i), sizeof(i));
+    }
+    return path;
+}
+
+
+static size_t file_size(const std::string &path)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    return static_cast<size_t>(stream.tellg());
+}
+
+// TESTS
+// -----
+
+
+TEST(mapped_vector, MemberFunctions)
+{
+    std::string path = write_file("itl_mapped_vector_read", 1000);
+    itl::mapped_vector<const int> x(path);
+    const itl::mapped_vector<const int> &view = x;
+    EXPECT_TRUE(x.is_open());
+    EXPECT_EQ(x.mode(), itl::map_mode::read_only);
+    EXPECT_EQ(x.size(), 1000);
+    EXPECT_EQ(view.front(), 0);
+    EXPECT_EQ(view.back(), 999);
+    EXPECT_EQ(view.at(500), 500);
+    EXPECT_THROW(view.at(1000), std::out_of_range);
+    EXPECT_EQ(std::accumulate(x.cbegin(), x.cend(), 0), 499500);
+    EXPECT_EQ(*x.crbegin(), 999);
+
+    x.advise(itl::map_advice::sequential);
+    x.advise(itl::map_advice::random);
+
+    itl::mapped_vector<const int> y(std::move(x));
+    EXPECT_FALSE(x.is_open());
+    EXPECT_EQ(y.size(), 1000);
+    y.close();
+    EXPECT_TRUE(y.empty());
+
+    EXPECT_THROW(itl::mapped_vector<const int>(testing::TempDir() + "itl_missing/file"), std::system_error);
+    std::remove(path.c_str());
+}
+
+
+TEST(mapped_vector, ReadOnly)
+{
+    // const elements map read-only, and hand out const references
+    std::string path = write_file("itl_mapped_vector_read_only", 10);
+    {
+        itl::mapped_vector<const int> x(path);
+        EXPECT_EQ(x.mode(), itl::map_mode::read_only);
+        EXPECT_TRUE((std::is_same<decltype(x[0]), const int &>::value));
+        EXPECT_TRUE((std::is_same<decltype(x.begin()), const int *>::value));
+        EXPECT_EQ(x[9], 9);
+        EXPECT_EQ(x.at(3), 3);
+        EXPECT_EQ(x.front(), 0);
+        EXPECT_EQ(x.back(), 9);
+        EXPECT_EQ(std::accumulate(x.begin(), x.end(), 0), 45);
+        EXPECT_EQ(*x.rbegin(), 9);
+
+        // shrinking writes nothing, growing past the file would
+        x.pop_back();
+        x.resize_default_init(8);
+        EXPECT_EQ(x.size(), 8);
+        EXPECT_THROW(x.resize_default_init(11), std::logic_error);
+        EXPECT_EQ(x.size(), 8);
+    }
+
+    // the element type decides between read-only and writable mappings
+    EXPECT_THROW(itl::mapped_vector<int>(path, itl::map_mode::read_only), std::invalid_argument);
+    EXPECT_THROW(itl::mapped_vector<const int>(path, itl::map_mode::copy_on_write), std::invalid_argument);
+
+    itl::mapped_vector<int> x(path, itl::map_mode::copy_on_write);
+    EXPECT_EQ(x.size(), 10);
+    EXPECT_EQ(x[9], 9);
+    std::remove(path.c_str());
+}
+
+
+TEST(mapped_vector, CopyOnWrite)
+{
+    std::string path = write_file("itl_mapped_vector_cow", 10);
+    {
+        itl::mapped_vector<int> x(path, itl::map_mode::copy_on_write);
+        x[0] = 42;
+        EXPECT_EQ(x[0], 42);
+    }
+
+    const itl::mapped_vector<const int> x(path);
+    EXPECT_EQ(x[0], 0);
+    std::remove(path.c_str());
+}
+
+
+TEST(mapped_vector, Growth)
+{
+    std::string path = write_file("itl_mapped_vector_write", 10);
+    {
+        itl::mapped_vector<int> x(path, itl::map_mode::read_write);
+        for (int i = 10; i < 100; ++i) {
+            x.push_back(i);
+        }
+        EXPECT_EQ(x.size(), 100);
+        EXPECT_GE(x.capacity(), 100);
+
+        auto span = x.append_uninitialized(2);
+        span[0] = 100;
+        span[1] = 101;
+        x.resize(110);
+        EXPECT_EQ(x[101], 101);
+        EXPECT_EQ(x[109], 0);
+        x.flush();
+    }
+    EXPECT_EQ(file_size(path), 110 * sizeof(int));
+
+    const itl::mapped_vector<const int> x(path);
+    EXPECT_EQ(x.size(), 110);
+    EXPECT_EQ(x[99], 99);
+    EXPECT_EQ(x[101], 101);
+    std::remove(path.c_str());
+}
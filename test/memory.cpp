@@ -84,3 +84,33 @@ TEST(weak_ptr, MemberFunctions)
 
     itl::shared_ptr<int> z(w1);
 }
+
+
+TEST(shared_ptr, MoveSemantics)
+{
+    EXPECT_TRUE(std::is_nothrow_move_constructible<itl::shared_ptr<int>>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<itl::shared_ptr<int>>::value);
+
+    itl::shared_ptr<int> x(new int(5));
+    itl::shared_ptr<int> y(std::move(x));
+    EXPECT_FALSE(x);
+    EXPECT_EQ(y.use_count(), 1);
+
+    itl::shared_ptr<int> z;
+    z = std::move(y);
+    EXPECT_FALSE(y);
+    EXPECT_EQ(z.use_count(), 1);
+}
+
+
+TEST(weak_ptr, MoveSemantics)
+{
+    EXPECT_TRUE(std::is_nothrow_move_constructible<itl::weak_ptr<int>>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<itl::weak_ptr<int>>::value);
+
+    itl::shared_ptr<int> x(new int(5));
+    itl::weak_ptr<int> w1(x);
+    itl::weak_ptr<int> w2(std::move(w1));
+    EXPECT_TRUE(w1.expired());
+    EXPECT_FALSE(w2.expired());
+}
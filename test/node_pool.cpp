@@ -0,0 +1,115 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/node_pool.hpp>
+
+#include <thread>
+#include <vector>
+
+// TESTS
+// -----
+
+
+TEST(node_pool, MemberFunctions)
+{
+    itl::node_pool_allocator<double> allocator;
+    double *x = allocator.allocate(1);
+    double *y = allocator.allocate(1);
+    EXPECT_NE(x, y);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(x) % alignof(double), 0);
+
+    // freed nodes are reused first
+    allocator.deallocate(y, 1);
+    EXPECT_EQ(allocator.allocate(1), y);
+
+    // arrays bypass the pool
+    double *array = allocator.allocate(100);
+    array[99] = 1;
+    allocator.deallocate(array, 100);
+    allocator.deallocate(x, 1);
+    allocator.deallocate(y, 1);
+
+    // stateless, and equal across types
+    itl::node_pool_allocator<int> other(allocator);
+    EXPECT_TRUE(other == allocator);
+    EXPECT_FALSE(other != allocator);
+}
+
+
+TEST(node_pool, Containers)
+{
+    itl::pooled::list<int> list = {5, 4, 3};
+    list.push_back(2);
+    list.sort();
+    EXPECT_EQ(list.front(), 2);
+
+    itl::pooled::forward_list<int> forward_list = {1, 2};
+    forward_list.push_front(0);
+    EXPECT_EQ(forward_list.front(), 0);
+
+    itl::pooled::map<int, int> map;
+    itl::pooled::multimap<int, int> multimap;
+    itl::pooled::set<int> set;
+    itl::pooled::multiset<int> multiset;
+    for (int i = 0; i < 10000; ++i) {
+        map[i % 1000] = i;
+        multimap.emplace(i % 10, i);
+        set.insert(i % 100);
+        multiset.insert(i % 10);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        map.erase(i);
+    }
+    EXPECT_EQ(map.size(), 500);
+    EXPECT_EQ(map.at(999), 9999);
+    EXPECT_EQ(multimap.count(3), 1000);
+    EXPECT_EQ(set.size(), 100);
+    EXPECT_EQ(multiset.count(9), 1000);
+
+    itl::pooled::map<int, int> copy(map);
+    EXPECT_TRUE(copy == map);
+}
+
+
+TEST(node_pool, Threads)
+{
+    // nodes may be freed by another thread than the one allocating them
+    std::vector<itl::pooled::list<int>> lists(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < lists.size(); ++t) {
+        threads.emplace_back([&lists, t]() {
+            for (int i = 0; i < 10000; ++i) {
+                lists[t].push_back(i);
+            }
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    for (size_t t = 0; t < lists.size(); ++t) {
+        threads.emplace_back([&lists, t]() {
+            itl::pooled::set<int> set;
+            for (int i = 0; i < 10000; ++i) {
+                set.insert(i);
+                if (i % 3 == 0) {
+                    set.erase(i / 2);
+                }
+            }
+            lists[(t + 1) % lists.size()].clear();
+        });
+    }
+    for (auto &thread: threads) {
+        thread.join();
+    }
+    for (auto &list: lists) {
+        EXPECT_TRUE(list.empty());
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/order_statistic_map.hpp>
+#include <itl/string.hpp>
+
+#include <iterator>
+#include <map>
+
+
+TEST(order_statistic_map, MemberFunctions)
+{
+    itl::order_statistic_map<int, int> x = {{5, 4}, {3, 2}};
+    itl::order_statistic_map<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_EQ(y.at(5), 4);
+    EXPECT_THROW(y.at(4), std::out_of_range);
+    EXPECT_EQ(y.nth(1)->first, 5);
+    EXPECT_EQ(y.rank(5), 1);
+
+    EXPECT_TRUE(y.try_emplace(7, 8).second);
+    EXPECT_FALSE(y.insert_or_assign(7, 9).second);
+    EXPECT_EQ(y[7], 9);
+    EXPECT_EQ(y.rank(7), 2);
+    EXPECT_EQ(y.count_range(4, 8), 2);
+    EXPECT_EQ(y.erase(y.find(3))->first, 5);
+    EXPECT_EQ(y.nth(0)->first, 5);
+
+    const auto &z = y;
+    EXPECT_EQ(z.nth(1)->second, 9);
+}
+
+
+TEST(order_statistic_map, NonMemberFunctions)
+{
+    itl::order_statistic_map<int, int> x = {{0, 1}};
+    itl::order_statistic_map<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x[2], 3);
+    EXPECT_EQ(y[0], 1);
+}
+
+
+TEST(order_statistic_multimap, MemberFunctions)
+{
+    itl::order_statistic_multimap<int, int> x = {{5, 4}, {3, 2}, {3, 1}};
+    EXPECT_EQ(x.rank(5), 2);
+    EXPECT_EQ(x.count_range(3, 5), 2);
+    EXPECT_EQ(x.nth(2)->second, 4);
+}
+
+
+TEST(order_statistic_map, Model)
+{
+    // ranks and selects must agree with std::map through splits and merges
+    itl::order_statistic_map<int, int> x;
+    std::map<int, int> y;
+    unsigned state = 1;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 5000);
+        switch ((state >> 4) % 4) {
+            case 0:
+                x[key] = i;
+                y[key] = i;
+                break;
+            case 1:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 2: {
+                size_t rank = static_cast<size_t>(std::distance(y.begin(), y.lower_bound(key)));
+                EXPECT_EQ(x.rank(key), rank);
+                auto it = x.nth(rank);
+                ASSERT_EQ(it == x.end(), rank == y.size());
+                if (rank < y.size()) {
+                    EXPECT_EQ(it->first, y.lower_bound(key)->first);
+                }
+                break;
+            }
+            case 3: {
+                auto it = x.find(key);
+                if (it != x.end()) {
+                    x.erase(it);
+                    y.erase(key);
+                }
+                break;
+            }
+        }
+    }
+    ASSERT_EQ(x.size(), y.size());
+    EXPECT_TRUE(std::equal(x.begin(), x.end(), y.begin()));
+
+    // sorted appends pack nodes, then erasing from the front merges them
+    itl::order_statistic_map<int, int> z;
+    for (int i = 0; i < 100000; ++i) {
+        z.emplace_hint(z.end(), i, i);
+    }
+    EXPECT_EQ(z.nth(54321)->first, 54321);
+    for (int i = 0; i < 50000; ++i) {
+        z.erase(z.begin());
+    }
+    EXPECT_EQ(z.nth(4321)->first, 54321);
+    EXPECT_EQ(z.rank(54321), 4321);
+    EXPECT_EQ(z.count_range(0, 60000), 10000);
+}
+
+
+TEST(order_statistic_map, Transparent)
+{
+    itl::order_statistic_map<itl::string, int, itl::string_less> x = {{"a", 1}, {"b", 2}, {"c", 3}};
+    EXPECT_EQ(x.rank("b"), 1);
+    EXPECT_EQ(x.count_range("aa", "c"), 1);
+    EXPECT_EQ(x.find("b")->second, 2);
+}
+
+
+TEST(order_statistic_map, CopyOnlyValues)
+{
+    // mapped values with only a copy constructor are boxed
+    struct legacy
+    {
+        int value;
+
+        legacy(int value):
+            value(value)
+        {}
+
+        legacy(const legacy &other):
+            value(other.value)
+        {}
+    };
+
+    itl::order_statistic_map<int, legacy> x;
+    for (int i = 0; i < 1000; ++i) {
+        x.emplace(999 - i, i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        x.erase(i);
+    }
+    EXPECT_EQ(x.size(), 500);
+    EXPECT_EQ(x.nth(10)->first, 21);
+    EXPECT_EQ(x.nth(10)->second.value, 978);
+    EXPECT_EQ(x.rank(21), 10);
+}
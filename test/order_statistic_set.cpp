@@ -0,0 +1,106 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/order_statistic_set.hpp>
+
+#include <iterator>
+#include <set>
+
+
+TEST(order_statistic_set, MemberFunctions)
+{
+    itl::order_statistic_set<int> x = {50, 40, 30, 20};
+    itl::order_statistic_set<int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(x.nth(0), x.end());
+    EXPECT_EQ(x.rank(1), 0);
+    EXPECT_EQ(y.size(), 4);
+    EXPECT_EQ(*y.nth(0), 20);
+    EXPECT_EQ(*y.nth(3), 50);
+    EXPECT_EQ(y.nth(4), y.end());
+    EXPECT_EQ(y.rank(20), 0);
+    EXPECT_EQ(y.rank(35), 2);
+    EXPECT_EQ(y.rank(99), 4);
+    EXPECT_EQ(y.count_range(20, 50), 3);
+    EXPECT_EQ(y.count_range(21, 51), 3);
+    EXPECT_EQ(y.count_range(50, 20), 0);
+}
+
+
+TEST(order_statistic_set, NonMemberFunctions)
+{
+    itl::order_statistic_set<int> x = {0, 1};
+    itl::order_statistic_set<int> y = {2, 3};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(*x.nth(0), 2);
+    EXPECT_EQ(*y.nth(1), 1);
+}
+
+
+TEST(order_statistic_multiset, MemberFunctions)
+{
+    itl::order_statistic_multiset<int> x = {5, 4, 3, 3};
+    EXPECT_EQ(x.rank(3), 0);
+    EXPECT_EQ(x.rank(4), 2);
+    EXPECT_EQ(x.count_range(3, 4), 2);
+    EXPECT_EQ(*x.nth(1), 3);
+    EXPECT_EQ(*x.nth(2), 4);
+
+    // copies keep their subtree sizes
+    itl::order_statistic_multiset<int> y(x);
+    y.insert(3);
+    EXPECT_EQ(y.rank(4), 3);
+    EXPECT_EQ(x.rank(4), 2);
+}
+
+
+TEST(order_statistic_multiset, Model)
+{
+    // ranks must agree with std::multiset through splits and merges
+    itl::order_statistic_multiset<int> x;
+    std::multiset<int> y;
+    unsigned state = 7;
+    for (int i = 0; i < 100000; ++i) {
+        state = state * 1103515245 + 12345;
+        int key = static_cast<int>((state >> 8) % 2000);
+        switch ((state >> 4) % 4) {
+            case 0:
+            case 1:
+                x.insert(key);
+                y.insert(key);
+                break;
+            case 2:
+                EXPECT_EQ(x.erase(key), y.erase(key));
+                break;
+            case 3:
+                EXPECT_EQ(x.rank(key), static_cast<size_t>(std::distance(y.begin(), y.lower_bound(key))));
+                break;
+        }
+    }
+    ASSERT_EQ(x.size(), y.size());
+    size_t k = 0;
+    for (int value: y) {
+        ASSERT_EQ(*x.nth(k++), value);
+    }
+
+    x.erase(x.lower_bound(500), x.upper_bound(1500));
+    y.erase(y.lower_bound(500), y.upper_bound(1500));
+    EXPECT_EQ(x.count_range(0, 2000), y.size());
+    EXPECT_EQ(*x.nth(x.rank(1501)), *y.lower_bound(1501));
+}
@@ -0,0 +1,157 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/persistent_map.hpp>
+#include <itl/string.hpp>
+
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+
+TEST(persistent_map, MemberFunctions)
+{
+    itl::persistent_map<int, int> x = {{5, 4}, {3, 2}};
+    itl::persistent_map<int, int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(x.begin(), x.end());
+    EXPECT_EQ(y.size(), 2);
+    EXPECT_EQ(y.begin()->first, 3);
+    EXPECT_EQ(y.at(5), 4);
+    EXPECT_THROW(y.at(4), std::out_of_range);
+    EXPECT_EQ(y.count(3), 1);
+    EXPECT_EQ(y.find(4), y.end());
+    EXPECT_EQ(y.lower_bound(4)->first, 5);
+    EXPECT_EQ(y.upper_bound(3)->first, 5);
+    EXPECT_EQ(y.upper_bound(5), y.end());
+}
+
+
+TEST(persistent_map, NonMemberFunctions)
+{
+    itl::persistent_map<int, int> x = {{0, 1}};
+    itl::persistent_map<int, int> y = {{2, 3}};
+
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(x == x);
+    EXPECT_TRUE(x.set(2, 3).erase(0) == y);
+
+    std::swap(x, y);
+    EXPECT_EQ(x.at(2), 3);
+    EXPECT_EQ(y.at(0), 1);
+}
+
+
+TEST(persistent_map, Versions)
+{
+    itl::persistent_map<int, itl::string> x = {{1, "a"}, {2, "b"}};
+    auto y = x.set(2, "c");
+    auto z = y.insert({3, "d"}).insert({1, "e"});
+    auto w = z.erase(1).erase(9);
+
+    // every version keeps its own contents
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_EQ(x.at(2), "b");
+    EXPECT_EQ(y.at(2), "c");
+    EXPECT_EQ(z.size(), 3);
+    EXPECT_EQ(z.at(1), "a");
+    EXPECT_EQ(w.size(), 2);
+    EXPECT_EQ(w.count(1), 0);
+    EXPECT_EQ(w.begin()->second, "c");
+
+    // nodes off the edited path are shared, not copied
+    auto v = z.insert({0, "f"});
+    EXPECT_EQ(&v.at(3), &z.at(3));
+}
+
+
+TEST(persistent_map, Transient)
+{
+    itl::persistent_map<int, int> x = {{1, 1}, {2, 2}};
+    auto t = x.transient();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(t.insert_or_assign(i, -i), i != 1 && i != 2);
+    }
+    EXPECT_FALSE(t.insert({5, 5}));
+    EXPECT_EQ(t.erase(50), 1);
+    EXPECT_EQ(t.erase(50), 0);
+
+    // nodes the transient owns are edited in place
+    auto address = &t.at(10);
+    t.insert_or_assign(10, 7);
+    EXPECT_EQ(&t.at(10), address);
+
+    auto y = t.persistent();
+    t.insert_or_assign(10, 8);
+    t.clear();
+
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_EQ(x.at(2), 2);
+    EXPECT_EQ(y.size(), 99);
+    EXPECT_EQ(y.at(1), -1);
+    EXPECT_EQ(y.at(2), -2);
+    EXPECT_EQ(y.at(10), 7);
+    EXPECT_TRUE(t.empty());
+}
+
+
+TEST(persistent_map, Model)
+{
+    // every retained version must agree with the std::map it was derived as
+    std::vector<itl::persistent_map<int, int>> versions(1);
+    std::vector<std::map<int, int>> models(1);
+    unsigned state = 11;
+    for (int i = 0; i < 4000; ++i) {
+        state = state * 1103515245 + 12345;
+        size_t from = (state >> 8) % versions.size();
+        int key = static_cast<int>((state >> 16) % 256);
+        auto version = versions[from];
+        auto model = models[from];
+        if (state & 1) {
+            version = version.set(key, i);
+            model[key] = i;
+        } else {
+            version = version.erase(key);
+            model.erase(key);
+        }
+        versions.push_back(version);
+        models.push_back(model);
+    }
+
+    for (size_t i = 0; i < versions.size(); ++i) {
+        ASSERT_EQ(versions[i].size(), models[i].size());
+        ASSERT_TRUE(std::equal(models[i].begin(), models[i].end(), versions[i].begin()));
+        int key = static_cast<int>(i % 256);
+        auto it = versions[i].lower_bound(key);
+        auto expected = models[i].lower_bound(key);
+        ASSERT_EQ(it == versions[i].end(), expected == models[i].end());
+    }
+}
+
+
+TEST(persistent_map, MoveSemantics)
+{
+    typedef itl::persistent_map<int, int> Itl;
+    EXPECT_TRUE(std::is_nothrow_move_constructible<Itl>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<Itl>::value);
+
+    Itl x = {{5, 4}, {3, 2}};
+    auto address = &*x.begin();
+    Itl y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+    EXPECT_TRUE(x.empty());
+
+    auto t = y.transient();
+    decltype(t) u;
+    u = std::move(t);
+    EXPECT_EQ(&*u.begin(), address);
+}
@@ -0,0 +1,159 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/persistent_vector.hpp>
+#include <itl/string.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+TEST(persistent_vector, MemberFunctions)
+{
+    itl::persistent_vector<int> x = {1, 2, 3};
+    itl::persistent_vector<int> y;
+    x.swap(y);
+
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(x.begin(), x.end());
+    EXPECT_EQ(y.size(), 3);
+    EXPECT_EQ(y.front(), 1);
+    EXPECT_EQ(y.back(), 3);
+    EXPECT_EQ(y[1], 2);
+    EXPECT_THROW(y.at(3), std::out_of_range);
+    EXPECT_EQ(y.end() - y.begin(), 3);
+    EXPECT_EQ(*y.rbegin(), 3);
+}
+
+
+TEST(persistent_vector, NonMemberFunctions)
+{
+    itl::persistent_vector<int> x = {0, 1};
+    itl::persistent_vector<int> y = {0, 2};
+
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(x == x);
+    EXPECT_TRUE(x.set(1, 2) == y);
+
+    std::swap(x, y);
+    EXPECT_EQ(x[1], 2);
+    EXPECT_EQ(y[1], 1);
+}
+
+
+TEST(persistent_vector, Versions)
+{
+    itl::persistent_vector<itl::string> x;
+    for (int i = 0; i < 100; ++i) {
+        x = x.push_back(itl::string(1, char('a' + i % 26)));
+    }
+    auto y = x.set(5, "z").set(90, "y");
+    auto z = y.pop_back().pop_back();
+
+    EXPECT_EQ(x[5], "f");
+    EXPECT_EQ(x[90], "m");
+    EXPECT_EQ(y[5], "z");
+    EXPECT_EQ(y[90], "y");
+    EXPECT_EQ(y.size(), 100);
+    EXPECT_EQ(z.size(), 98);
+    EXPECT_EQ(z.back(), "t");
+
+    // leaves outside the edited paths are shared
+    EXPECT_EQ(&x[40], &y[40]);
+}
+
+
+TEST(persistent_vector, Transient)
+{
+    itl::persistent_vector<int> x = {1, 2};
+    auto t = x.transient();
+    for (int i = 2; i < 5000; ++i) {
+        t.push_back(i + 1);
+    }
+    t.set(0, -1);
+    t.emplace_back(0);
+    t.pop_back();
+
+    // nodes the transient owns are edited in place
+    auto address = &t[100];
+    t.set(100, 7);
+    EXPECT_EQ(&t[100], address);
+
+    auto y = t.persistent();
+    t.set(100, 8);
+    t.clear();
+
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_EQ(x[0], 1);
+    EXPECT_EQ(y.size(), 5000);
+    EXPECT_EQ(y[0], -1);
+    EXPECT_EQ(y[100], 7);
+    EXPECT_EQ(y[4999], 5000);
+    EXPECT_TRUE(t.empty());
+}
+
+
+TEST(persistent_vector, Model)
+{
+    // grow past three trie levels and shrink back, keeping every version
+    std::vector<itl::persistent_vector<int>> versions(1);
+    std::vector<std::vector<int>> models(1);
+    itl::persistent_vector<int> x;
+    std::vector<int> y;
+    for (int i = 0; i < 40000; ++i) {
+        x = x.push_back(i);
+        y.push_back(i);
+        if (i % 4093 == 0) {
+            versions.push_back(x);
+            models.push_back(y);
+        }
+    }
+    unsigned state = 3;
+    for (int i = 0; i < 1000; ++i) {
+        state = state * 1103515245 + 12345;
+        size_t j = (state >> 8) % y.size();
+        x = x.set(j, -i);
+        y[j] = -i;
+    }
+    while (!y.empty()) {
+        if (y.size() % 1021 == 0) {
+            versions.push_back(x);
+            models.push_back(y);
+        }
+        x = x.pop_back();
+        y.pop_back();
+    }
+    EXPECT_TRUE(x.empty());
+
+    for (size_t i = 0; i < versions.size(); ++i) {
+        ASSERT_EQ(versions[i].size(), models[i].size());
+        ASSERT_TRUE(std::equal(models[i].begin(), models[i].end(), versions[i].begin()));
+        ASSERT_TRUE(std::equal(models[i].rbegin(), models[i].rend(), versions[i].rbegin()));
+    }
+}
+
+
+TEST(persistent_vector, MoveSemantics)
+{
+    typedef itl::persistent_vector<int> Itl;
+    EXPECT_TRUE(std::is_nothrow_move_constructible<Itl>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<Itl>::value);
+
+    Itl x = {1, 2, 3};
+    auto address = &x[0];
+    Itl y(std::move(x));
+    EXPECT_EQ(&y[0], address);
+    EXPECT_TRUE(x.empty());
+
+    auto t = y.transient();
+    decltype(t) u;
+    u = std::move(t);
+    EXPECT_EQ(&u[0], address);
+}
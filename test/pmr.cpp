@@ -0,0 +1,97 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/deque.hpp>
+#include <itl/forward_list.hpp>
+#include <itl/list.hpp>
+#include <itl/map.hpp>
+#include <itl/queue.hpp>
+#include <itl/set.hpp>
+#include <itl/stack.hpp>
+#include <itl/string.hpp>
+#include <itl/unordered_map.hpp>
+#include <itl/unordered_set.hpp>
+#include <itl/vector.hpp>
+
+#if defined(ITL_HAS_PMR)
+
+// TESTS
+// -----
+
+
+TEST(pmr, Aliases)
+{
+    std::pmr::monotonic_buffer_resource resource;
+    itl::pmr::vector<int> vector({1, 2, 3}, &resource);
+    itl::pmr::deque<int> deque({1, 2, 3}, &resource);
+    itl::pmr::list<int> list({1, 2, 3}, &resource);
+    itl::pmr::forward_list<int> forward_list({1, 2, 3}, &resource);
+    itl::pmr::string string("ASCII", &resource);
+    itl::pmr::map<int, int> map(&resource);
+    itl::pmr::multimap<int, int> multimap(&resource);
+    itl::pmr::set<int> set(&resource);
+    itl::pmr::multiset<int> multiset(&resource);
+    itl::pmr::unordered_map<int, int> unordered_map(&resource);
+    itl::pmr::unordered_multimap<int, int> unordered_multimap(&resource);
+    itl::pmr::unordered_set<int> unordered_set(&resource);
+    itl::pmr::unordered_multiset<int> unordered_multiset(&resource);
+    itl::pmr::queue<int> queue;
+    itl::pmr::stack<int> stack;
+
+    map[1] = 2;
+    set.insert(1);
+    unordered_map[1] = 2;
+    queue.push(1);
+    stack.push(1);
+    EXPECT_EQ(vector.get_allocator().resource(), &resource);
+    EXPECT_EQ(string.get_allocator().resource(), &resource);
+    EXPECT_EQ(map.get_allocator().resource(), &resource);
+    EXPECT_EQ(unordered_map.get_allocator().resource(), &resource);
+}
+
+
+TEST(pmr, MoveSemantics)
+{
+    std::pmr::monotonic_buffer_resource first;
+    std::pmr::unsynchronized_pool_resource second;
+
+    itl::pmr::vector<int> x({1, 2, 3}, &first);
+    itl::pmr::vector<int> y({4, 5}, &second);
+    x.swap(y);
+    EXPECT_EQ(x.size(), 2);
+    EXPECT_EQ(y.size(), 3);
+    EXPECT_EQ(x.get_allocator().resource(), &first);
+    EXPECT_EQ(y.get_allocator().resource(), &second);
+
+    itl::pmr::map<int, itl::pmr::string> m(&first);
+    itl::pmr::map<int, itl::pmr::string> n(&second);
+    m[1] = "A";
+    n[2] = "B";
+    n[3] = "C";
+    std::swap(m, n);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(n.at(1), "A");
+    EXPECT_EQ(m.get_allocator().resource(), &first);
+    EXPECT_EQ(m.at(2).get_allocator().resource(), &first);
+
+    // moves between resources copy into the destination resource
+    itl::pmr::string s(64, 'A', &first);
+    itl::pmr::string t(&second);
+    t = std::move(s);
+    EXPECT_EQ(t.size(), 64);
+    EXPECT_EQ(t.get_allocator().resource(), &second);
+
+    itl::pmr::stack<int> a(std::pmr::deque<int>({1, 2}, &first));
+    itl::pmr::stack<int> b(std::pmr::deque<int>({3}, &second));
+    a.swap(b);
+    EXPECT_EQ(a.top(), 3);
+    EXPECT_EQ(b.top(), 2);
+}
+
+#endif
@@ -40,3 +40,21 @@ TEST(queue, NonMemberFunctions)
     EXPECT_EQ(x.front(), 2);
     EXPECT_EQ(y.front(), 1);
 }
+
+
+TEST(queue, MoveSemantics)
+{
+    typedef itl::queue<int> Itl;
+    typedef std::queue<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::queue<int> x(std::deque<int> {5, 4, 3, 2});
+    auto address = &x.front();
+    itl::queue<int> y(std::move(x));
+    EXPECT_EQ(&y.front(), address);
+
+    itl::queue<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&z.front(), address);
+}
@@ -0,0 +1,85 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/memory.hpp>
+#include <itl/relocate.hpp>
+#include <itl/string.hpp>
+#include <itl/vector.hpp>
+
+#include <list>
+
+// HELPERS
+// -------
+
+
+struct point
+{
+    int x;
+    int y;
+};
+
+// TESTS
+// -----
+
+
+TEST(relocate, Traits)
+{
+    EXPECT_TRUE(itl::is_trivially_relocatable<int>::value);
+    EXPECT_TRUE(itl::is_trivially_relocatable<point>::value);
+    EXPECT_TRUE(itl::is_trivially_relocatable<const point>::value);
+    EXPECT_TRUE(itl::is_trivially_relocatable<std::unique_ptr<int>>::value);
+    EXPECT_TRUE(itl::is_trivially_relocatable<itl::shared_ptr<int>>::value);
+    EXPECT_TRUE(itl::is_trivially_relocatable<itl::weak_ptr<int>>::value);
+    EXPECT_TRUE(itl::is_trivially_relocatable<itl::vector<int>>::value);
+    EXPECT_TRUE(itl::is_trivially_relocatable<itl::static_::vector<int>>::value);
+    EXPECT_FALSE(itl::is_trivially_relocatable<std::list<int>>::value);
+    EXPECT_FALSE(itl::is_trivially_relocatable<itl::string>::value);
+}
+
+
+TEST(relocate, Trivial)
+{
+    point source[3] = {{1, 2}, {3, 4}, {5, 6}};
+    point destination[3];
+    point *end = itl::uninitialized_relocate(source, source + 3, destination);
+
+    EXPECT_EQ(end, destination + 3);
+    EXPECT_EQ(destination[2].x, 5);
+    EXPECT_EQ(destination[2].y, 6);
+}
+
+
+TEST(relocate, NonTrivial)
+{
+    typedef itl::shared_ptr<int> pointer;
+    std::allocator<pointer> alloc;
+    pointer *source = alloc.allocate(2);
+    pointer *destination = alloc.allocate(2);
+    ::new (source) pointer(itl::make_shared<int>(1));
+    ::new (source + 1) pointer(itl::make_shared<int>(2));
+
+    itl::weak_ptr<int> weak(source[0]);
+    itl::uninitialized_relocate(source, source + 2, destination);
+    EXPECT_EQ(*destination[0], 1);
+    EXPECT_EQ(*destination[1], 2);
+    EXPECT_EQ(destination[0].use_count(), 1);
+
+    itl::string *strings = std::allocator<itl::string>().allocate(2);
+    ::new (strings) itl::string(64, 'A');
+    itl::relocate_at(strings, strings + 1);
+    EXPECT_EQ(strings[1], itl::string(64, 'A'));
+    strings[1].~basic_string();
+    std::allocator<itl::string>().deallocate(strings, 2);
+
+    destination[0].~pointer();
+    destination[1].~pointer();
+    EXPECT_TRUE(weak.expired());
+    alloc.deallocate(source, 2);
+    alloc.deallocate(destination, 2);
+}
@@ -8,6 +8,9 @@
 
 #include <gtest/gtest.h>
 #include <itl/set.hpp>
+#include <itl/string.hpp>
+
+#include <vector>
 
 
 TEST(set, MemberFunctions)
@@ -66,3 +69,108 @@ TEST(multiset, NonMemberFunctions)
     EXPECT_EQ(*x.find(2), 2);
     EXPECT_EQ(*y.find(0), 0);
 }
+
+
+TEST(set, MoveSemantics)
+{
+    typedef itl::set<int> Itl;
+    typedef std::set<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::set<int> x = {5, 4, 3, 2};
+    auto address = &*x.begin();
+    itl::set<int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::set<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(multiset, MoveSemantics)
+{
+    typedef itl::multiset<int> Itl;
+    typedef std::multiset<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::multiset<int> x = {5, 4, 3, 2};
+    auto address = &*x.begin();
+    itl::multiset<int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::multiset<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(set, Transparent)
+{
+    itl::set<itl::string, itl::string_less> x = {"a", "ab", "b"};
+    EXPECT_EQ(*x.find("ab"), "ab");
+    EXPECT_EQ(x.count("b"), 1);
+    EXPECT_EQ(x.count("c"), 0);
+    EXPECT_EQ(*x.lower_bound("aa"), "ab");
+    EXPECT_EQ(*x.upper_bound("ab"), "b");
+
+    const auto &y = x;
+    auto range = y.equal_range("a");
+    EXPECT_EQ(std::distance(range.first, range.second), 1);
+}
+
+
+TEST(multiset, Transparent)
+{
+    itl::multiset<itl::string, itl::string_less> x = {"a", "b", "b"};
+    EXPECT_EQ(x.count("b"), 2);
+    auto range = x.equal_range("b");
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+}
+
+
+TEST(set, Merge)
+{
+    itl::set<int> x = {1, 2};
+    itl::set<int> y = {2, 4};
+    x.merge(y);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(y.size(), 1);
+    EXPECT_EQ(y.count(2), 1);
+
+#if defined(__cpp_lib_node_extract)
+    auto address = &*x.find(4);
+    y.insert(x.extract(4));
+    EXPECT_EQ(&*y.find(4), address);
+    EXPECT_EQ(x.count(4), 0);
+#endif
+}
+
+
+TEST(multiset, Merge)
+{
+    itl::multiset<int> x = {1, 2};
+    x.merge(itl::multiset<int>({2, 4}));
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+
+    // merging into itself leaves the elements alone
+    x.merge(x);
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+}
+
+
+TEST(set, FromSorted)
+{
+    std::vector<int> input = {1, 2, 2, 3, 5, 8};
+    auto x = itl::set<int>::from_sorted(input.begin(), input.end());
+    EXPECT_EQ(x.size(), 5);
+    EXPECT_EQ(*x.rbegin(), 8);
+
+    auto y = itl::multiset<int>::from_sorted(input.begin(), input.end());
+    EXPECT_EQ(y.size(), 6);
+    EXPECT_EQ(y.count(2), 2);
+}
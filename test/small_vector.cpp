@@ -0,0 +1,178 @@
+/*
+ *  :author: The Regents of the University of California.
+ *  :license: Public Domain
+ *
+ *  This file has been placed in the public domain.
+ *  There are no restrictions on its use.
+ */
+
+#include <gtest/gtest.h>
+#include <itl/small_vector.hpp>
+#include <itl/string.hpp>
+
+#include <vector>
+
+// TESTS
+// -----
+
+
+TEST(small_vector, MemberFunctions)
+{
+    itl::small_vector<int, 4> x = {5, 4, 3, 2};
+    itl::small_vector<int, 4> y;
+    EXPECT_TRUE(x.is_inline());
+    EXPECT_TRUE(y.is_inline());
+
+    x.swap(y);
+    EXPECT_EQ(x.size(), 0);
+    EXPECT_EQ(y.size(), 4);
+    EXPECT_TRUE(y.is_inline());
+
+    // spill to the heap, and return once shrunk
+    y.push_back(1);
+    EXPECT_FALSE(y.is_inline());
+    EXPECT_EQ(y.size(), 5);
+    EXPECT_EQ(y[0], 5);
+    EXPECT_EQ(y.back(), 1);
+
+    y.pop_back();
+    y.shrink_to_fit();
+    EXPECT_TRUE(y.is_inline());
+    EXPECT_EQ(y.back(), 2);
+
+    itl::small_vector<int, 4> z(10, 1);
+    EXPECT_FALSE(z.is_inline());
+    EXPECT_EQ(z.size(), 10);
+}
+
+
+TEST(small_vector, NonMemberFunctions)
+{
+    itl::small_vector<int, 2> x = {1};
+    itl::small_vector<int, 2> y = {2};
+
+    EXPECT_TRUE(x < y);
+    EXPECT_TRUE(x <= y);
+    EXPECT_TRUE(x != y);
+    EXPECT_TRUE(y > x);
+    EXPECT_TRUE(y >= x);
+    EXPECT_TRUE(x == x);
+
+    std::swap(x, y);
+    EXPECT_EQ(x[0], 2);
+    EXPECT_EQ(y[0], 1);
+}
+
+
+TEST(small_vector, CopyAndMove)
+{
+    itl::small_vector<itl::string, 2> x = {"a", "b"};
+    itl::small_vector<itl::string, 2> y(x);
+    EXPECT_TRUE(y.is_inline());
+    EXPECT_EQ(y, x);
+
+    itl::small_vector<itl::string, 2> z(std::move(x));
+    EXPECT_TRUE(z.is_inline());
+    EXPECT_TRUE(x.empty());
+    EXPECT_EQ(z, y);
+
+    // mixing inline and heap storage
+    itl::small_vector<itl::string, 2> w = {"a", "b", "c"};
+    EXPECT_FALSE(w.is_inline());
+    w.swap(z);
+    EXPECT_TRUE(w.is_inline());
+    EXPECT_FALSE(z.is_inline());
+    EXPECT_EQ(w.size(), 2);
+    EXPECT_EQ(z.size(), 3);
+
+    x = z;
+    EXPECT_EQ(x, z);
+    y = std::move(z);
+    EXPECT_EQ(y.size(), 3);
+    EXPECT_EQ(y[2], "c");
+}
+
+
+TEST(small_vector, StealHeap)
+{
+    typedef itl::small_vector<itl::string, 2> vector;
+#if defined(__GLIBCXX__)
+    EXPECT_TRUE(std::is_nothrow_move_constructible<vector>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<vector>::value);
+
+    // spilled storage changes owners, and the source returns inline
+    vector x = {"a", "b", "c"};
+    auto data = x.data();
+    vector y(std::move(x));
+    EXPECT_EQ(y.data(), data);
+    EXPECT_TRUE(x.is_inline());
+    EXPECT_TRUE(x.empty());
+    x = std::move(y);
+    EXPECT_EQ(x.data(), data);
+    EXPECT_TRUE(y.is_inline());
+
+    // so do spilled vectors in a reallocating std::vector
+    std::vector<vector> list(1, vector(3, "a"));
+    auto element = list[0].data();
+    list.resize(list.capacity() + 1);
+    EXPECT_EQ(list[0].data(), element);
+
+    // swaps hand heap storage over in both directions
+    vector z = {"d"};
+    x.swap(z);
+    EXPECT_EQ(z.data(), data);
+    EXPECT_TRUE(x.is_inline());
+    EXPECT_EQ(x[0], "d");
+    z.swap(x);
+    EXPECT_EQ(x.data(), data);
+    EXPECT_EQ(z, vector({"d"}));
+    vector w(4, "e");
+    auto other = w.data();
+    w.swap(x);
+    EXPECT_EQ(w.data(), data);
+    EXPECT_EQ(x.data(), other);
+#endif
+
+    // inline swaps exchange elements in place
+    vector u = {"a"};
+    vector v = {"b", "c"};
+    u.swap(v);
+    EXPECT_EQ(u, vector({"b", "c"}));
+    EXPECT_EQ(v, vector({"a"}));
+    EXPECT_TRUE(u.is_inline());
+    EXPECT_TRUE(v.is_inline());
+}
+
+
+TEST(small_vector, DefaultInit)
+{
+    itl::small_vector<int, 4, itl::default_init_allocator<int>> x = {1, 2};
+    EXPECT_GE(x.capacity(), 4);
+    x.resize_default_init(3);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x[1], 2);
+
+    auto tail = x.append_uninitialized(5);
+    EXPECT_EQ(tail.size(), 5);
+    EXPECT_EQ(tail.data(), x.data() + 3);
+    for (auto &value: tail) {
+        value = 7;
+    }
+    EXPECT_EQ(x.size(), 8);
+    EXPECT_FALSE(x.is_inline());
+    EXPECT_EQ(x.back(), 7);
+}
+
+
+TEST(small_vector, Inheritance)
+{
+    struct derived: itl::small_vector<int, 4>
+    {
+        using itl::small_vector<int, 4>::small_vector;
+    };
+
+    itl::small_vector<int, 4> *ptr = new derived;
+    ptr->push_back(1);
+    EXPECT_EQ(ptr->size(), 1);
+    delete ptr;
+}
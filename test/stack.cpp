@@ -40,3 +40,21 @@ TEST(stack, NonMemberFunctions)
     EXPECT_EQ(x.top(), 2);
     EXPECT_EQ(y.top(), 1);
 }
+
+
+TEST(stack, MoveSemantics)
+{
+    typedef itl::stack<int> Itl;
+    typedef std::stack<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::stack<int> x(std::deque<int> {5, 4, 3, 2});
+    auto address = &x.top();
+    itl::stack<int> y(std::move(x));
+    EXPECT_EQ(&y.top(), address);
+
+    itl::stack<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&z.top(), address);
+}
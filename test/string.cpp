@@ -10,6 +10,7 @@
 #include <itl/string.hpp>
 
 #include <sstream>
+#include <vector>
 
 
 TEST(basic_string, MemberFunctions)
@@ -50,3 +51,69 @@ TEST(basic_string, NonMemberFunctions)
     EXPECT_TRUE(line > empty);
     EXPECT_TRUE(line >= empty);
 }
+
+
+TEST(basic_string, MoveSemantics)
+{
+    EXPECT_TRUE(std::is_nothrow_move_constructible<itl::string>::value);
+    EXPECT_TRUE(std::is_nothrow_move_assignable<itl::string>::value);
+
+    // use a string longer than any short-string buffer
+    itl::string x(64, 'A');
+    const char *address = x.data();
+    itl::string y(std::move(x));
+    EXPECT_EQ(y.data(), address);
+
+    itl::string z;
+    z = std::move(y);
+    EXPECT_EQ(z.data(), address);
+
+    // reallocation must move, not copy, the elements
+    std::vector<itl::string> vector;
+    vector.emplace_back(64, 'B');
+    address = vector.front().data();
+    vector.reserve(vector.capacity() + 1);
+    EXPECT_EQ(vector.front().data(), address);
+}
+
+
+TEST(basic_string, UninitializedGrowth)
+{
+#if defined(__cpp_lib_string_resize_and_overwrite)
+    itl::string x = "AS";
+    x.resize_default_init(4);
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x[0], 'A');
+    EXPECT_EQ(x[1], 'S');
+
+    auto span = x.append_uninitialized(3);
+    EXPECT_EQ(x.size(), 7);
+    EXPECT_EQ(span.size(), 3);
+    EXPECT_EQ(span.data(), x.c_str() + 4);
+    x[2] = x[3] = 'C';
+    for (auto &c: span) {
+        c = 'I';
+    }
+    EXPECT_EQ(x, "ASCCIII");
+    EXPECT_EQ(x.c_str()[x.size()], '\0');
+#endif
+}
+
+
+TEST(basic_string, TransparentFunctors)
+{
+    itl::string x("key");
+    std::string y("key");
+    EXPECT_TRUE(itl::string_equal_to()(x, "key"));
+    EXPECT_TRUE(itl::string_equal_to()(y, x));
+    EXPECT_FALSE(itl::string_equal_to()("ke", x));
+    EXPECT_TRUE(itl::string_less()("ke", x));
+    EXPECT_FALSE(itl::string_less()(x, "ke"));
+    EXPECT_TRUE(itl::string_less()("abc", "abd"));
+    EXPECT_EQ(itl::string_hash()("key"), std::hash<std::string>()(y));
+    EXPECT_EQ(itl::string_hash()(x), itl::string_hash()(y));
+#if __cplusplus >= 201703L
+    EXPECT_TRUE(itl::string_equal_to()(std::string_view("key"), x));
+    EXPECT_EQ(itl::string_hash()(std::string_view("key")), itl::string_hash()(x));
+#endif
+}
@@ -7,8 +7,45 @@
  */
 
 #include <gtest/gtest.h>
+#include <itl/string.hpp>
 #include <itl/unordered_map.hpp>
 
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// HELPERS
+// -------
+
+
+// counts calls, and is not noexcept, so std tables cache its codes
+struct counting_hash
+{
+    static int calls;
+
+    size_t operator()(int key) const
+    {
+        ++calls;
+        return std::hash<int>()(key);
+    }
+};
+
+int counting_hash::calls = 0;
+
+
+struct counting_string_hash: itl::string_hash
+{
+    static int calls;
+
+    size_t operator()(itl::basic_string_key<char> key) const noexcept
+    {
+        ++calls;
+        return itl::string_hash::operator()(key);
+    }
+};
+
+int counting_string_hash::calls = 0;
+
 
 TEST(unordered_map, MemberFunctions)
 {
@@ -58,3 +95,214 @@ TEST(unordered_multimap, NonMemberFunctions)
     EXPECT_EQ(x.find(2)->second, 3);
     EXPECT_EQ(y.find(0)->second, 1);
 }
+
+
+TEST(unordered_map, MoveSemantics)
+{
+    typedef itl::unordered_map<int, int> Itl;
+    typedef std::unordered_map<int, int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::unordered_map<int, int> x = {{5, 4}, {3, 2}};
+    auto address = &*x.begin();
+    itl::unordered_map<int, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::unordered_map<int, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(unordered_multimap, MoveSemantics)
+{
+    typedef itl::unordered_multimap<int, int> Itl;
+    typedef std::unordered_multimap<int, int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::unordered_multimap<int, int> x = {{5, 4}, {3, 2}};
+    auto address = &*x.begin();
+    itl::unordered_multimap<int, int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::unordered_multimap<int, int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(unordered_map, Hashed)
+{
+    itl::unordered_map<itl::string, int> x;
+    itl::unordered_map<itl::string, int> y = {{"key", 1}};
+    itl::string key = "key";
+    size_t hash = x.hash_function()(key);
+
+    EXPECT_EQ(x.find_hashed(key, hash), x.end());
+    EXPECT_EQ(x.count_hashed(key, hash), 0);
+    EXPECT_TRUE(x.emplace_hashed(key, hash, 2).second);
+    EXPECT_FALSE(x.emplace_hashed(key, hash, 3).second);
+    EXPECT_EQ(x.find_hashed(key, hash)->second, 2);
+    EXPECT_EQ(y.find_hashed(key, hash)->second, 1);
+    EXPECT_EQ(y.find_hashed(key, hash), y.find(key));
+
+    for (int i = 0; i < 100; ++i) {
+        itl::string other(std::to_string(i).c_str());
+        size_t code = x.hash_function()(other);
+        x.emplace_hashed(std::move(other), code, i);
+    }
+    EXPECT_EQ(x.count_hashed(key, hash), 1);
+    EXPECT_EQ(x.erase_hashed(key, hash), 1);
+    EXPECT_EQ(x.erase_hashed(key, hash), 0);
+    EXPECT_EQ(x.size(), 100);
+
+    // the mapped value is only constructed on a miss
+    itl::unordered_map<int, std::unique_ptr<int>> z;
+    std::unique_ptr<int> value(new int(1));
+    EXPECT_TRUE(z.emplace_hashed(1, z.hash_function()(1), std::move(value)).second);
+    value.reset(new int(2));
+    EXPECT_FALSE(z.emplace_hashed(1, z.hash_function()(1), std::move(value)).second);
+    EXPECT_EQ(*value, 2);
+    EXPECT_EQ(*z.at(1), 1);
+
+    // libstdc++ hits are converted in place, without hashing again
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)
+    itl::unordered_map<int, int, counting_hash> w = {{1, 2}, {3, 4}};
+    size_t code = w.hash_function()(3);
+    counting_hash::calls = 0;
+    EXPECT_EQ(w.find_hashed(3, code)->second, 4);
+    EXPECT_FALSE(w.emplace_hashed(3, code, 5).second);
+    EXPECT_EQ(w.erase_hashed(3, code), 1);
+#   if defined(NDEBUG)
+    EXPECT_EQ(counting_hash::calls, 0);
+#   else
+    // only the assertions that `code` is the hash of the key
+    EXPECT_EQ(counting_hash::calls, 3);
+#   endif
+#endif
+}
+
+
+TEST(unordered_multimap, Hashed)
+{
+    itl::unordered_multimap<int, int> x;
+    size_t hash = x.hash_function()(1);
+
+    x.emplace_hashed(1, hash, 2);
+    x.emplace_hashed(1, hash, 3);
+    x.emplace(2, 4);
+    EXPECT_EQ(x.count_hashed(1, hash), 2);
+    EXPECT_EQ(x.find_hashed(1, hash)->first, 1);
+
+    // a wrong hash probes the wrong bucket, which debug builds catch
+    size_t wrong = hash + 1;
+#if !defined(NDEBUG) && GTEST_HAS_DEATH_TEST
+    EXPECT_DEATH(x.find_hashed(1, wrong), "hash_function");
+    EXPECT_DEATH(x.count_hashed(1, wrong), "hash_function");
+    EXPECT_DEATH(x.emplace_hashed(1, wrong, 5), "hash_function");
+    EXPECT_DEATH(x.erase_hashed(1, wrong), "hash_function");
+#elif defined(NDEBUG)
+    EXPECT_EQ(x.find_hashed(1, wrong), x.end());
+    EXPECT_EQ(x.count_hashed(1, wrong), 0);
+    EXPECT_EQ(x.erase_hashed(1, wrong), 0);
+#endif
+
+    EXPECT_EQ(x.erase_hashed(1, hash), 2);
+    EXPECT_EQ(x.size(), 1);
+}
+
+
+TEST(unordered_map, Transparent)
+{
+    typedef itl::unordered_map<itl::string, int, itl::string_hash, itl::string_equal_to> map;
+    map x = {
+        {"a key longer than the small string buffer", 1},
+        {"b key longer than the small string buffer", 2},
+    };
+    const char *key = "b key longer than the small string buffer";
+    EXPECT_EQ(itl::string_hash()(key), std::hash<itl::string>()(itl::string(key)));
+    EXPECT_EQ(x.find(key)->second, 2);
+    EXPECT_EQ(x.count(std::string(key)), 1);
+    EXPECT_EQ(x.count("c"), 0);
+    EXPECT_EQ(x.equal_range(key).first, x.find(key));
+
+    const auto &y = x;
+    EXPECT_EQ(y.find("c"), y.end());
+    auto range = y.equal_range("c");
+    EXPECT_EQ(range.first, range.second);
+
+    // a hit hashes the borrowed key once, and never the stored key
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)
+    itl::unordered_map<itl::string, int, counting_string_hash, itl::string_equal_to> z(x.begin(), x.end());
+    counting_string_hash::calls = 0;
+    EXPECT_EQ(z.find(key)->second, 2);
+#   if defined(NDEBUG) || defined(__cpp_lib_generic_unordered_lookup)
+    EXPECT_EQ(counting_string_hash::calls, 1);
+#   else
+    EXPECT_EQ(counting_string_hash::calls, 2);
+#   endif
+#endif
+}
+
+
+TEST(unordered_multimap, Transparent)
+{
+    itl::unordered_multimap<itl::string, int, itl::string_hash, itl::string_equal_to> x = {{"a", 1}, {"b", 2}, {"b", 3}};
+    EXPECT_EQ(x.count("b"), 2);
+    auto range = x.equal_range("b");
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+}
+
+
+TEST(unordered_map, TryEmplace)
+{
+    itl::unordered_map<int, itl::string> x;
+    EXPECT_TRUE(x.try_emplace(1, 3, 'a').second);
+    itl::string value("moved");
+    EXPECT_FALSE(x.try_emplace(1, std::move(value)).second);
+    EXPECT_EQ(value, "moved");
+    EXPECT_EQ(x.at(1), "aaa");
+    EXPECT_EQ(x.try_emplace(x.end(), 2, "b")->second, "b");
+
+    EXPECT_FALSE(x.insert_or_assign(1, "c").second);
+    EXPECT_EQ(x.at(1), "c");
+    EXPECT_TRUE(x.insert_or_assign(3, "d").second);
+    EXPECT_EQ(x.insert_or_assign(x.end(), 3, "e")->second, "e");
+    EXPECT_EQ(x.size(), 3);
+}
+
+
+TEST(unordered_map, Merge)
+{
+    itl::unordered_map<int, int> x = {{1, 1}, {2, 2}};
+    itl::unordered_map<int, int> y = {{2, 3}, {4, 4}};
+    x.merge(y);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(x.at(2), 2);
+    EXPECT_EQ(y.size(), 1);
+    EXPECT_EQ(y.at(2), 3);
+
+#if defined(__cpp_lib_node_extract)
+    // nodes move between containers without reallocating
+    auto address = &*x.find(4);
+    y.insert(x.extract(4));
+    EXPECT_EQ(&*y.find(4), address);
+    EXPECT_EQ(x.count(4), 0);
+#endif
+}
+
+
+TEST(unordered_multimap, Merge)
+{
+    itl::unordered_multimap<int, int> x = {{1, 1}, {2, 2}};
+    x.merge(itl::unordered_multimap<int, int>({{2, 3}, {4, 4}}));
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+
+    // merging into itself leaves the elements alone
+    x.merge(x);
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+}
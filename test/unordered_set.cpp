@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 #include <itl/unordered_set.hpp>
+#include <itl/string.hpp>
 
 
 TEST(unordered_set, MemberFunctions)
@@ -58,3 +59,135 @@ TEST(unordered_multiset, NonMemberFunctions)
     EXPECT_EQ(*x.find(2), 2);
     EXPECT_EQ(*y.find(0), 0);
 }
+
+
+TEST(unordered_set, MoveSemantics)
+{
+    typedef itl::unordered_set<int> Itl;
+    typedef std::unordered_set<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::unordered_set<int> x = {5, 4, 3, 2};
+    auto address = &*x.begin();
+    itl::unordered_set<int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::unordered_set<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(unordered_multiset, MoveSemantics)
+{
+    typedef itl::unordered_multiset<int> Itl;
+    typedef std::unordered_multiset<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::unordered_multiset<int> x = {5, 4, 3, 2};
+    auto address = &*x.begin();
+    itl::unordered_multiset<int> y(std::move(x));
+    EXPECT_EQ(&*y.begin(), address);
+
+    itl::unordered_multiset<int> z;
+    z = std::move(y);
+    EXPECT_EQ(&*z.begin(), address);
+}
+
+
+TEST(unordered_set, Hashed)
+{
+    itl::unordered_set<int> x = {1, 2, 3};
+    size_t hash = x.hash_function()(2);
+
+    EXPECT_EQ(*x.find_hashed(2, hash), 2);
+    EXPECT_EQ(x.count_hashed(2, hash), 1);
+    EXPECT_FALSE(x.emplace_hashed(2, hash).second);
+    EXPECT_EQ(x.erase_hashed(2, hash), 1);
+    EXPECT_EQ(x.find_hashed(2, hash), x.end());
+    EXPECT_TRUE(x.emplace_hashed(2, hash).second);
+}
+
+
+TEST(unordered_multiset, Hashed)
+{
+    itl::unordered_multiset<int> x = {1, 2, 2, 3};
+    size_t hash = x.hash_function()(2);
+
+    EXPECT_EQ(x.count_hashed(2, hash), 2);
+    x.emplace_hashed(2, hash);
+    EXPECT_EQ(x.count_hashed(2, hash), 3);
+    EXPECT_EQ(*x.find_hashed(2, hash), 2);
+
+    // a wrong hash probes the wrong bucket, which debug builds catch
+    size_t wrong = hash + 1;
+#if !defined(NDEBUG) && GTEST_HAS_DEATH_TEST
+    EXPECT_DEATH(x.find_hashed(2, wrong), "hash_function");
+    EXPECT_DEATH(x.count_hashed(2, wrong), "hash_function");
+    EXPECT_DEATH(x.emplace_hashed(2, wrong), "hash_function");
+    EXPECT_DEATH(x.erase_hashed(2, wrong), "hash_function");
+#elif defined(NDEBUG)
+    EXPECT_EQ(x.find_hashed(2, wrong), x.end());
+    EXPECT_EQ(x.count_hashed(2, wrong), 0);
+    EXPECT_EQ(x.erase_hashed(2, wrong), 0);
+#endif
+
+    EXPECT_EQ(x.erase_hashed(2, hash), 3);
+    EXPECT_EQ(x.size(), 2);
+}
+
+
+TEST(unordered_set, Transparent)
+{
+    itl::unordered_set<itl::string, itl::string_hash, itl::string_equal_to> x = {"a", "ab", "b"};
+    EXPECT_EQ(*x.find("ab"), "ab");
+    EXPECT_EQ(x.count(std::string("b")), 1);
+    EXPECT_EQ(x.count("c"), 0);
+
+    const auto &y = x;
+    auto range = y.equal_range("a");
+    EXPECT_EQ(std::distance(range.first, range.second), 1);
+}
+
+
+TEST(unordered_multiset, Transparent)
+{
+    itl::unordered_multiset<itl::string, itl::string_hash, itl::string_equal_to> x = {"a", "b", "b"};
+    EXPECT_EQ(x.count("b"), 2);
+    auto range = x.equal_range("b");
+    EXPECT_EQ(std::distance(range.first, range.second), 2);
+}
+
+
+TEST(unordered_set, Merge)
+{
+    itl::unordered_set<int> x = {1, 2};
+    itl::unordered_set<int> y = {2, 4};
+    x.merge(y);
+    EXPECT_EQ(x.size(), 3);
+    EXPECT_EQ(y.size(), 1);
+    EXPECT_EQ(y.count(2), 1);
+
+#if defined(__cpp_lib_node_extract)
+    auto address = &*x.find(4);
+    y.insert(x.extract(4));
+    EXPECT_EQ(&*y.find(4), address);
+    EXPECT_EQ(x.count(4), 0);
+#endif
+}
+
+
+TEST(unordered_multiset, Merge)
+{
+    itl::unordered_multiset<int> x = {1, 2};
+    x.merge(itl::unordered_multiset<int>({2, 4}));
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+
+    // merging into itself leaves the elements alone
+    x.merge(x);
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x.count(2), 2);
+}
@@ -7,8 +7,36 @@
  */
 
 #include <gtest/gtest.h>
+#include <itl/allocator.hpp>
 #include <itl/vector.hpp>
 
+#include <memory>
+#include <stdexcept>
+
+// HELPERS
+// -------
+
+
+// relocatable, but throws when constructed from a negative value
+struct fragile
+{
+    std::unique_ptr<int> value;
+
+    fragile(int x):
+        value(x < 0 ? throw std::runtime_error("fragile") : new int(x))
+    {}
+};
+
+
+namespace itl
+{
+
+template <>
+struct is_trivially_relocatable<fragile>: std::true_type
+{};
+
+}   /* itl */
+
 // TESTS
 // -----
 
@@ -40,3 +68,87 @@ TEST(vector, NonMemberFunctions)
     EXPECT_EQ(x[0], 2);
     EXPECT_EQ(y[0], 1);
 }
+
+
+TEST(vector, MoveSemantics)
+{
+    typedef itl::vector<int> Itl;
+    typedef std::vector<int> Std;
+    EXPECT_EQ(std::is_nothrow_move_constructible<Itl>::value, std::is_nothrow_move_constructible<Std>::value);
+    EXPECT_EQ(std::is_nothrow_move_assignable<Itl>::value, std::is_nothrow_move_assignable<Std>::value);
+
+    itl::vector<int> x = {5, 4, 3, 2};
+    auto address = x.data();
+    itl::vector<int> y(std::move(x));
+    EXPECT_EQ(y.data(), address);
+
+    itl::vector<int> z;
+    z = std::move(y);
+    EXPECT_EQ(z.data(), address);
+}
+
+
+TEST(vector, UninitializedGrowth)
+{
+    itl::vector<int, itl::default_init_allocator<int>> x = {1, 2};
+    x.resize_default_init(4);
+    EXPECT_EQ(x.size(), 4);
+    EXPECT_EQ(x[0], 1);
+    EXPECT_EQ(x[1], 2);
+
+    auto span = x.append_uninitialized(3);
+    EXPECT_EQ(x.size(), 7);
+    EXPECT_EQ(span.size(), 3);
+    EXPECT_EQ(span.data(), x.data() + 4);
+    for (size_t i = 0; i < span.size(); ++i) {
+        span[i] = static_cast<int>(i) + 5;
+    }
+    EXPECT_EQ(x[6], 7);
+
+    // construction with arguments is forwarded to the allocator
+    x.emplace_back(8);
+    x.push_back(9);
+    EXPECT_EQ(x.back(), 9);
+
+    // other allocators would value-initialize, and are rejected
+    EXPECT_TRUE((itl::is_default_init_allocator<itl::default_init_allocator<int>>::value));
+    EXPECT_FALSE((itl::is_default_init_allocator<std::allocator<int>>::value));
+}
+
+
+TEST(vector, Relocation)
+{
+    // growth keeps the elements, including pointers into the heap
+    itl::vector<std::unique_ptr<int>> x;
+    std::vector<int*> addresses;
+    for (int i = 0; i < 1000; ++i) {
+        auto &item = x.emplace_back(new int(i));
+        addresses.push_back(item.get());
+    }
+    x.reserve(5000);
+    EXPECT_GE(x.capacity(), 5000);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(x[i].get(), addresses[i]);
+        EXPECT_EQ(*x[i], i);
+    }
+
+    // arguments may alias the elements of a full vector
+    itl::vector<std::shared_ptr<int>> y = {std::make_shared<int>(1)};
+    ASSERT_EQ(y.size(), y.capacity());
+    y.push_back(y[0]);
+    y.push_back(y[1]);
+    EXPECT_EQ(y.size(), 3);
+    EXPECT_EQ(y[2].get(), y[0].get());
+    EXPECT_EQ(y[0].use_count(), 3);
+
+    // a throwing constructor leaves a full vector unchanged
+    itl::vector<fragile> z;
+    z.emplace_back(1);
+    ASSERT_EQ(z.size(), z.capacity());
+    auto data = z.data();
+    EXPECT_THROW(z.emplace_back(-1), std::runtime_error);
+    EXPECT_EQ(z.size(), 1);
+    EXPECT_EQ(z.data(), data);
+    EXPECT_EQ(*z[0].value, 1);
+    EXPECT_THROW(z.reserve(z.max_size() + 1), std::length_error);
+}